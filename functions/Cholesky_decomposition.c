@@ -1,6 +1,247 @@
-#include "LinearAlgebraBasics.h"
+#include "kernels.h"
+#include <omp.h>
 #include <string.h>
 
+/**
+ * @brief Order of the square tiles of the tiled Cholesky factorization.
+ */
+
+#define CHOLESKY_TILE 256
+
+/**
+ * @brief Order under which the diagonal blocks and triangular solves are computed without recursion.
+ */
+
+#define CHOLESKY_BASE 16
+
+/**
+ * @brief Tiles of a row updated by one task of the parallel factorization.
+ */
+
+#define CHOLESKY_UPDATE_TILES 4
+
+/**
+ * @brief Order of the tiles in which the symmetry check and L^T read the matrix by columns.
+ */
+
+#define CHOLESKY_TRANSPOSE_TILE 64
+
+/*
+ * The tiled Cholesky factorization works on the lower triangle of A cut in
+ * CHOLESKY_TILE x CHOLESKY_TILE tiles A_ij. At step k:
+ * 1. POTRF: the diagonal tile A_kk is factored as L_kk L_kk^T,
+ * 2. TRSM: each tile A_ik below it becomes L_ik = A_ik L_kk^-T,
+ * 3. SYRK and GEMM: each tile A_ij of the trailing triangle receives A_ij -= L_ik L_jk^T.
+ * POTRF and TRSM are recursive, so that the GEMM engine also does most of their work,
+ * and the updates of neighbouring tiles of a row are made by one product.
+ * Every operation on a tile is an OpenMP task with a dependency on the tiles it
+ * reads and writes, so the tasks of successive steps overlap: the factorization of
+ * A_(k+1)(k+1) starts as soon as its own update by step k is done, while the
+ * threads are still updating the rest of the trailing triangle.
+ */
+
+/*
+ * B = B L^-T for the n x n lower triangle L and the rows x n block B. Narrow triangles are
+ * solved row after row (x L^T = b against the rows of L, too short for the dot kernel); wider ones are
+ * split in two halves, the GEMM B2 -= X1 L21^T between the two recursive solves carrying
+ * most of the work.
+ */
+
+static void lower_transposed_solve(index_t rows, index_t n, const REAL *L, index_t ldl, REAL *B, index_t ldb,
+				   REAL *P_packed, REAL *Q_packed) {
+
+    if (n <= CHOLESKY_BASE) {
+	for (index_t r = 0; r < rows; r++) {
+	    REAL *B_r = B + (size_t) r * ldb;
+	    for (index_t j = 0; j < n; j++) {
+		const REAL *L_j = L + (size_t) j * ldl;
+		REAL sum = B_r[j];
+		for (index_t p = 0; p < j; p++)
+		    sum -= B_r[p] * L_j[p];
+		B_r[j] = sum / L_j[j];
+	    }
+	}
+	return;
+    }
+
+    index_t n1 = n / 2, n2 = n - n1;
+
+    lower_transposed_solve(rows, n1, L, ldl, B, ldb, P_packed, Q_packed);
+    FN(blocked_general_product_packed)(OP_NO_TRANSPOSE, OP_TRANSPOSE, rows, n2, n1, -1.0, B, ldb,
+				       L + (size_t) n1 * ldl, ldl, 1.0, B + n1, ldb, P_packed, Q_packed);
+    lower_transposed_solve(rows, n2, L + (size_t) n1 * ldl + n1, ldl, B + n1, ldb, P_packed, Q_packed);
+
+}
+
+/*
+ * Cholesky factorization of the n x n diagonal block A in place (POTRF). Narrow blocks are
+ * factored row after row, from products of contiguous rows; wider ones recursively, as
+ * A11 = L11 L11^T, L21 = A21 L11^-T, A22 -= L21 L21^T and A22 = L22 L22^T. The lower
+ * triangle receives L; the strictly upper triangle is used as workspace.
+ *
+ * Returns the first row with a non-positive pivot, or -1 when the block is positive definite.
+ */
+
+static index_t factor_diagonal_block(index_t n, REAL *A, index_t lda, REAL *P_packed, REAL *Q_packed) {
+
+    if (n <= CHOLESKY_BASE) {
+	for (index_t i = 0; i < n; i++) {
+	    REAL *A_i = A + (size_t) i * lda;
+	    REAL diagonal = A_i[i];
+
+	    for (index_t j = 0; j < i; j++) {
+		const REAL *A_j = A + (size_t) j * lda;
+		REAL sum = A_i[j];
+		for (index_t p = 0; p < j; p++)
+		    sum -= A_i[p] * A_j[p];
+		A_i[j] = sum / A_j[j];
+		diagonal -= A_i[j] * A_i[j];
+	    }
+
+	    if (diagonal <= 0.0) return i;
+
+	    A_i[i] = sqrt(diagonal);
+	}
+	return -1;
+    }
+
+    index_t n1 = n / 2, n2 = n - n1;
+    REAL *A21 = A + (size_t) n1 * lda, *A22 = A21 + n1;
+    index_t row = factor_diagonal_block(n1, A, lda, P_packed, Q_packed);
+
+    if (row >= 0) return row;
+
+    lower_transposed_solve(n2, n1, A, lda, A21, lda, P_packed, Q_packed);
+    FN(blocked_general_product_packed)(OP_NO_TRANSPOSE, OP_TRANSPOSE, n2, n2, n1, -1.0, A21, lda, A21, lda,
+				       1.0, A22, lda, P_packed, Q_packed);
+
+    row = factor_diagonal_block(n2, A22, lda, P_packed, Q_packed);
+
+    return row >= 0 ? n1 + row : -1;
+
+}
+
+/**
+ * @brief Factors the lower triangle of the n x n symmetric matrix A in place as L L^T with a tiled Cholesky.
+ *
+ * On return, the lower triangle of A holds L. The strictly upper triangle is used as
+ * workspace and left with meaningless values. The factorization and updates of the
+ * tiles are OpenMP tasks ordered by dependencies on the tiles.
+ *
+ * @param n Order of A (must be positive).
+ * @param A Pointer to the matrix (size: n x n, leading dimension lda), overwritten by L.
+ * @param lda Leading dimension of A (must be >= n).
+ * @param parallel 1 to run the tasks on all the OpenMP threads, 0 to run them on the calling thread only.
+ *
+ * @return 0 on success, or -1 on failure due to a matrix that is not positive definite
+ *         or memory allocation errors.
+ */
+
+int FN(tiled_Cholesky_factorization)(index_t n, REAL *A, index_t lda, int parallel) {
+
+    index_t tiles = (n + CHOLESKY_TILE - 1) / CHOLESKY_TILE;
+    int threads = parallel ? omp_get_max_threads() : 1;
+    index_t group = parallel ? CHOLESKY_UPDATE_TILES : tiles;
+
+    // One dependency sentinel per tile, and packing buffers per thread
+    char *tile = malloc((size_t) tiles * tiles);
+    REAL **P_packed = calloc(threads, sizeof(REAL *));
+    REAL **Q_packed = calloc(threads, sizeof(REAL *));
+    int failed = !tile || !P_packed || !Q_packed;
+    index_t failed_row = -1;
+
+    for (int t = 0; t < threads && !failed; t++) {
+	P_packed[t] = aligned_buffer(sizeof(REAL) * GEMM_P_BUFFER_SIZE(CHOLESKY_TILE, CHOLESKY_TILE));
+	Q_packed[t] = aligned_buffer(sizeof(REAL) * GEMM_Q_BUFFER_SIZE(group * CHOLESKY_TILE, CHOLESKY_TILE));
+	failed = !P_packed[t] || !Q_packed[t];
+    }
+
+    if (failed) {
+        fprintf(stderr, "Error: Memory allocation failed for packing buffers in tiled_Cholesky_factorization.\n");
+    } else {
+#pragma omp parallel num_threads(threads)
+#pragma omp single
+	for (index_t k = 0; k < tiles; k++) {
+
+	    index_t K = k * CHOLESKY_TILE;
+	    index_t nk = n - K < CHOLESKY_TILE ? n - K : CHOLESKY_TILE;
+	    REAL *A_kk = A + (size_t) K * lda + K;
+
+#pragma omp task depend(inout: tile[k * tiles + k]) priority(1)
+	    {
+		int skip;
+#pragma omp atomic read
+		skip = failed;
+
+		int t = omp_get_thread_num();
+		index_t row = skip ? -1 : factor_diagonal_block(nk, A_kk, lda, P_packed[t], Q_packed[t]);
+
+		if (row >= 0) {
+#pragma omp atomic write
+		    failed_row = K + row;
+#pragma omp atomic write
+		    failed = 1;
+		}
+	    }
+
+	    for (index_t i = k + 1; i < tiles; i++) {
+		index_t I = i * CHOLESKY_TILE;
+		index_t ni = n - I < CHOLESKY_TILE ? n - I : CHOLESKY_TILE;
+
+#pragma omp task depend(in: tile[k * tiles + k]) depend(inout: tile[i * tiles + k]) priority(1)
+		{
+		    int t = omp_get_thread_num(), skip;
+#pragma omp atomic read
+		    skip = failed;
+
+		    if (!skip)
+			lower_transposed_solve(ni, nk, A_kk, lda, A + (size_t) I * lda + K, lda, P_packed[t], Q_packed[t]);
+		}
+	    }
+
+	    // Trailing update of the tiles on and below the diagonal, A_ij -= L_ik L_jk^T, with the
+	    // tiles of a row grouped by CHOLESKY_UPDATE_TILES in parallel and all together otherwise
+	    for (index_t i = k + 1; i < tiles; i++) {
+		for (index_t j = k + 1; j <= i; j += group) {
+		    index_t end = j + group <= i + 1 ? j + group : i + 1;
+		    index_t I = i * CHOLESKY_TILE, J = j * CHOLESKY_TILE;
+		    index_t ni = n - I < CHOLESKY_TILE ? n - I : CHOLESKY_TILE;
+		    index_t nj = (end * CHOLESKY_TILE < n ? end * CHOLESKY_TILE : n) - J;
+
+#pragma omp task depend(in: tile[i * tiles + k]) depend(iterator(c = j : end), in: tile[c * tiles + k]) \
+    depend(iterator(c = j : end), inout: tile[i * tiles + c]) priority(i == k + 1)
+		    {
+			int t = omp_get_thread_num(), skip;
+#pragma omp atomic read
+			skip = failed;
+
+			if (!skip)
+			    FN(blocked_general_product_packed)(OP_NO_TRANSPOSE, OP_TRANSPOSE, ni, nj, nk, -1.0,
+							       A + (size_t) I * lda + K, lda, A + (size_t) J * lda + K, lda,
+							       1.0, A + (size_t) I * lda + J, lda, P_packed[t], Q_packed[t]);
+		    }
+		}
+	    }
+
+	}
+
+	if (failed_row >= 0)
+	    fprintf(stderr, "Error: Matrix is not positive definite at row %" PRId64 " in tiled_Cholesky_factorization.\n", failed_row);
+    }
+
+    for (int t = 0; P_packed && Q_packed && t < threads; t++) {
+	free(P_packed[t]);
+	free(Q_packed[t]);
+    }
+
+    free(P_packed);
+    free(Q_packed);
+    free(tile);
+
+    return failed ? -1 : 0;
+
+}
+
 /**
  * @brief Allocates and initializes a Cholesky decomposition structure.
  *
@@ -15,7 +256,7 @@
  *         invalid dimensions or memory allocation errors.
  */
 
-Cholesky *create_Cholesky(double *A, int size) {
+FN(Cholesky) *FN(create_Cholesky)(REAL *A, index_t size) {
 
     if (!A) {
 	fprintf(stderr, "Error: Null pointer detected for input matrix A in create_Cholesky.\n");
@@ -23,11 +264,11 @@ Cholesky *create_Cholesky(double *A, int size) {
     }
     
     if (size <= 0) {
-	fprintf(stderr, "Error: Invalid size (%d). Must be strictly positive.\n", size);
+	fprintf(stderr, "Error: Invalid size (%" PRId64 "). Must be strictly positive.\n", size);
 	return NULL;
     }
     
-    Cholesky *Cholesky_decomposition = malloc(sizeof(Cholesky));
+    FN(Cholesky) *Cholesky_decomposition = malloc(sizeof(FN(Cholesky)));
 
     if (!Cholesky_decomposition) {
         fprintf(stderr, "Memory allocation failed for Cholesky structure.\n");
@@ -36,22 +277,100 @@ Cholesky *create_Cholesky(double *A, int size) {
 
     Cholesky_decomposition->size = size;
 
-    Cholesky_decomposition->A = malloc(size * size * sizeof(double));
-    Cholesky_decomposition->L = calloc(size * size, sizeof(double));
-    Cholesky_decomposition->L_t = calloc(size * size, sizeof(double));
+    Cholesky_decomposition->A = malloc(size * size * sizeof(REAL));
+    Cholesky_decomposition->L = calloc(size * size, sizeof(REAL));
+    Cholesky_decomposition->L_t = calloc(size * size, sizeof(REAL));
 
     if (!Cholesky_decomposition->A || !Cholesky_decomposition->L || !Cholesky_decomposition->L_t) {
         fprintf(stderr, "Memory allocation failed for matrices in Cholesky structure.\n");
-        free_Cholesky(Cholesky_decomposition);
+        FN(free_Cholesky)(Cholesky_decomposition);
         return NULL;
     }
 
-    memcpy(Cholesky_decomposition->A, A, size * size * sizeof(double));
+    memcpy(Cholesky_decomposition->A, A, size * size * sizeof(REAL));
 
     return Cholesky_decomposition;
 
 }
 
+/*
+ * Checks the requirements of the Cholesky decompositions that are cheap to verify:
+ * exact symmetry and a positive diagonal.
+ */
+
+static int symmetric_with_positive_diagonal(REAL *A, index_t size) {
+
+    for (index_t i = 0; i < size; i++) {
+        if (A[i * size + i] <= 0) {
+            fprintf(stderr, "Matrix is not positive definite.\n");
+            return 0;
+        }
+    }
+
+    // Tile by tile, so that the columns read against the rows stay in cache
+    for (index_t I = 0; I < size; I += CHOLESKY_TRANSPOSE_TILE)
+	for (index_t J = I; J < size; J += CHOLESKY_TRANSPOSE_TILE)
+	    for (index_t i = I; i < size && i < I + CHOLESKY_TRANSPOSE_TILE; i++)
+		for (index_t j = (J > i + 1 ? J : i + 1); j < size && j < J + CHOLESKY_TRANSPOSE_TILE; j++)
+		    if (A[i * size + j] != A[j * size + i]) {
+			fprintf(stderr, "Matrix is not symmetric.\n");
+			return 0;
+		    }
+
+    return 1;
+
+}
+
+/*
+ * Shared by Cholesky_decomposition and Cholesky_decomposition_parallel: factors a copy of A
+ * in L, then clears its upper triangle and transposes it into L_t.
+ */
+
+static FN(Cholesky) *Cholesky_decomposition_blocked(REAL *A, index_t size, int parallel, const char *name) {
+
+    if (!A) {
+	fprintf(stderr, "Error: Null input matrix in %s.\n", name);
+	return NULL;
+    }
+    
+    if (size <= 0) {
+	fprintf(stderr, "Error: Invalid size (%" PRId64 ") in %s.\n", size, name);
+	return NULL;
+    }
+
+    if (!symmetric_with_positive_diagonal(A, size)) return NULL;
+
+    FN(Cholesky) *Cholesky_decomp = FN(create_Cholesky)(A, size);
+    
+    if (!Cholesky_decomp) {
+	fprintf(stderr, "Memory allocation failed for Cholesky structure.\n");
+	return NULL;
+    }
+
+    REAL *L = Cholesky_decomp->L, *L_t = Cholesky_decomp->L_t;
+
+    memcpy(L, A, size * size * sizeof(REAL));
+
+    if (FN(tiled_Cholesky_factorization)(size, L, size, parallel)) {
+	FN(free_Cholesky)(Cholesky_decomp);
+	return NULL;
+    }
+
+#pragma omp parallel for if(parallel) schedule(dynamic)
+    for (index_t I = 0; I < size; I += CHOLESKY_TRANSPOSE_TILE) {
+	for (index_t i = I; i < size && i < I + CHOLESKY_TRANSPOSE_TILE; i++)
+	    for (index_t j = i + 1; j < size; j++)
+		L[i * size + j] = 0.0;
+	for (index_t J = 0; J <= I; J += CHOLESKY_TRANSPOSE_TILE)
+	    for (index_t i = I; i < size && i < I + CHOLESKY_TRANSPOSE_TILE; i++)
+		for (index_t j = J; j <= i && j < J + CHOLESKY_TRANSPOSE_TILE; j++)
+		    L_t[j * size + i] = L[i * size + j];
+    }
+    
+    return Cholesky_decomp;
+
+}
+
 /**
  * @brief Performs Cholesky decomposition on a symmetric positive-definite matrix.
  *
@@ -59,6 +378,9 @@ Cholesky *create_Cholesky(double *A, int size) {
  * such that \( A = L \cdot L^T \). The resulting matrices L and Lᵀ are stored in the Cholesky structure.
  *
  * The function checks if the input matrix is symmetric and positive definite before performing the decomposition.
+ * The factorization is blocked: each diagonal block is factored, the blocks below it are solved
+ * against it, and the trailing matrix receives a symmetric rank update, the last two carried out
+ * almost entirely by the packed GEMM engine.
  *
  * @param A Pointer to the input square matrix (size: size x size).
  * @param size Dimension of the square matrix A (must be positive).
@@ -68,72 +390,108 @@ Cholesky *create_Cholesky(double *A, int size) {
  *         or memory allocation errors.
  */
 
-Cholesky *Cholesky_decomposition(double *A, int size) {
+FN(Cholesky) *FN(Cholesky_decomposition)(REAL *A, index_t size) {
+
+    return Cholesky_decomposition_blocked(A, size, 0, "Cholesky_decomposition");
+
+}
+
+/**
+ * @brief Performs parallelized Cholesky decomposition on a symmetric positive-definite matrix using OpenMP.
+ *
+ * Same as Cholesky_decomposition, computed by the tiled factorization: the factorization
+ * of the diagonal tiles, the triangular solves of the tiles below them and the updates
+ * of the trailing tiles by the packed GEMM engine are OpenMP tasks ordered by their
+ * dependencies on the tiles, so the work of successive steps overlaps.
+ *
+ * @param A Pointer to the input square matrix (size: size x size).
+ * @param size Dimension of the square matrix A (must be positive).
+ *
+ * @return Pointer to the Cholesky structure containing matrices A, L, and Lᵀ on success,
+ *         or NULL on failure due to invalid dimensions, non-symmetric matrix, non-positive definite matrix,
+ *         or memory allocation errors.
+ */
+
+FN(Cholesky) *FN(Cholesky_decomposition_parallel)(REAL *A, index_t size) {
+
+    return Cholesky_decomposition_blocked(A, size, 1, "Cholesky_decomposition_parallel");
+
+}
+
+/*
+ * Shared by Cholesky_factorization_into and Cholesky_factorization_parallel_into.
+ */
+
+static int Cholesky_factorization_compact(REAL *A, index_t size, REAL *L, int parallel, const char *name) {
 
-    if (!A) {
-	fprintf(stderr, "Error: Null input matrix in Cholesky_decomposition.\n");
-	return NULL;
-    }
-    
     if (size <= 0) {
-	fprintf(stderr, "Error: Invalid size (%d) in Cholesky_decomposition.\n", size);
-	return NULL;
+	fprintf(stderr, "Error: Invalid size (%" PRId64 ") in %s.\n", size, name);
+	return -1;
     }
 
-    for (int i = 0; i < size; i++) {
-        for (int j = i + 1; j < size; j++) {
-            if (A[i * size + j] != A[j * size + i]) {
-                fprintf(stderr, "Matrix is not symmetric.\n");
-                return NULL;
-            }
-        }
-        if (A[i * size + i] <= 0) {
-            fprintf(stderr, "Matrix is not positive definite.\n");
-            return NULL;
-        }
+    if (!A || !L) {
+	fprintf(stderr, "Error: Null pointer detected in %s.\n", name);
+	return -1;
     }
 
-    Cholesky *Cholesky_decomp = create_Cholesky(A, size);
-    
-    if (!Cholesky_decomp) {
-	fprintf(stderr, "Memory allocation failed for Cholesky structure.\n");
-	return NULL;
+    if (L != A && ranges_overlap(L, (size_t) size * size, A, (size_t) size * size)) {
+        fprintf(stderr, "Error: Output matrix partially overlaps the input matrix in %s.\n", name);
+        return -1;
     }
 
-    for (int i = 0; i < size; i++) {
-        for (int j = 0; j <= i; j++) {
-            double sum = 0.0;
+    if (L != A)
+	memcpy(L, A, (size_t) size * size * sizeof(REAL));
 
-            if (j == i) { 
-                for (int k = 0; k < j; k++)
-                    sum += Cholesky_decomp->L[j * size + k] * Cholesky_decomp->L[j * size + k];
+    if (FN(tiled_Cholesky_factorization)(size, L, size, parallel)) return -1;
 
-                double diag_value = A[j * size + j] - sum;
-		
-                if (diag_value <= 0) {
-                    fprintf(stderr, "Matrix is not positive definite at row %d.\n", j);
-                    free_Cholesky(Cholesky_decomp);
-                    return NULL;
-                }
+#pragma omp parallel for if(parallel)
+    for (index_t i = 0; i < size; i++)
+	for (index_t j = i + 1; j < size; j++)
+	    L[i * size + j] = 0.0;
 
-                Cholesky_decomp->L[j * size + j] = sqrt(diag_value);
-            }
-	    else { 
-                for (int k = 0; k < j; k++)
-                    sum += Cholesky_decomp->L[i * size + k] * Cholesky_decomp->L[j * size + k];
+    return 0;
 
-                Cholesky_decomp->L[i * size + j] = (A[i * size + j] - sum) / Cholesky_decomp->L[j * size + j];
-            }
-        }
-    }
+}
+
+/**
+ * @brief Performs Cholesky decomposition on a symmetric positive-definite matrix into a single caller-provided matrix.
+ *
+ * This function computes A = L L^T like Cholesky_decomposition, without the copies of A and
+ * L^T of the Cholesky structure: only the lower triangle of A is read (the symmetry of A is
+ * not checked), and L is written with zeros above its diagonal. L may be A, which is then
+ * factored in place and no other matrix is allocated.
+ *
+ * @param A Pointer to the input square matrix (size: size x size).
+ * @param size Dimension of the square matrix A (must be positive).
+ * @param L Pointer to the output lower triangular factor (size: size x size), may be A.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         partially overlapping output, non-positive definite matrix or memory allocation errors.
+ */
+
+int FN(Cholesky_factorization_into)(REAL *A, index_t size, REAL *L) {
+
+    return Cholesky_factorization_compact(A, size, L, 0, "Cholesky_factorization_into");
+
+}
+
+/**
+ * @brief Performs parallelized Cholesky decomposition into a single caller-provided matrix using OpenMP.
+ *
+ * Same as Cholesky_factorization_into, with the tasks of Cholesky_decomposition_parallel.
+ *
+ * @param A Pointer to the input square matrix (size: size x size).
+ * @param size Dimension of the square matrix A (must be positive).
+ * @param L Pointer to the output lower triangular factor (size: size x size), may be A.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         partially overlapping output, non-positive definite matrix or memory allocation errors.
+ */
+
+int FN(Cholesky_factorization_parallel_into)(REAL *A, index_t size, REAL *L) {
+
+    return Cholesky_factorization_compact(A, size, L, 1, "Cholesky_factorization_parallel_into");
 
-    for (int i = 0; i < size; i++) {
-	for (int j = 0; j < size; j++) {
-	    Cholesky_decomp->L_t[j * size + i] = Cholesky_decomp->L[i * size + j];
-	}
-    }
-    
-    return Cholesky_decomp;
 }
 
 /**
@@ -145,7 +503,7 @@ Cholesky *Cholesky_decomposition(double *A, int size) {
  * @param Cholesky_decomposition Pointer to the Cholesky structure to free.
  */
 
-void free_Cholesky(Cholesky *Cholesky_decomposition) {
+void FN(free_Cholesky)(FN(Cholesky) *Cholesky_decomposition) {
 
     if (!Cholesky_decomposition) return;
 
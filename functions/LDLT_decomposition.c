@@ -1,4 +1,4 @@
-#include "LinearAlgebraBasics.h"
+#include "precision.h"
 #include <string.h>
 
 /**
@@ -15,7 +15,7 @@
  *         invalid dimensions or memory allocation errors.
  */
 
-LDLT *create_LDLT(double *A, int size) {
+FN(LDLT) *FN(create_LDLT)(REAL *A, index_t size) {
 
     if (!A) {
 	fprintf(stderr, "Error: Null pointer detected for input matrix A in create_LDLT.\n");
@@ -23,11 +23,11 @@ LDLT *create_LDLT(double *A, int size) {
     }
 
     if (size <= 0) {
-	fprintf(stderr, "Error: Invalid size (%d). Must be strictly positive.\n", size);
+	fprintf(stderr, "Error: Invalid size (%" PRId64 "). Must be strictly positive.\n", size);
 	return NULL;
     }
 
-    LDLT *LDLT_decomposition = malloc(sizeof(LDLT));
+    FN(LDLT) *LDLT_decomposition = malloc(sizeof(FN(LDLT)));
 
     if (!LDLT_decomposition) {
 	fprintf(stderr, "Memory allocation failed for LDLT structure.\n");
@@ -36,18 +36,18 @@ LDLT *create_LDLT(double *A, int size) {
 
     LDLT_decomposition->size = size;
 
-    LDLT_decomposition->A = malloc(size * size * sizeof(double));
-    LDLT_decomposition->L = calloc(size * size, sizeof(double));
-    LDLT_decomposition->D = calloc(size * size, sizeof(double));
-    LDLT_decomposition->L_t = calloc(size * size, sizeof(double));
+    LDLT_decomposition->A = malloc(size * size * sizeof(REAL));
+    LDLT_decomposition->L = calloc(size * size, sizeof(REAL));
+    LDLT_decomposition->D = calloc(size * size, sizeof(REAL));
+    LDLT_decomposition->L_t = calloc(size * size, sizeof(REAL));
 
     if (!LDLT_decomposition->A || !LDLT_decomposition->L || !LDLT_decomposition->D || !LDLT_decomposition->L_t) {
         fprintf(stderr, "Memory allocation failed for matrices in LDLT structure.\n");
-        free_LDLT(LDLT_decomposition);
+        FN(free_LDLT)(LDLT_decomposition);
         return NULL;
     }
 
-    memcpy(LDLT_decomposition->A, A, size * size * sizeof(double));
+    memcpy(LDLT_decomposition->A, A, size * size * sizeof(REAL));
 
     return LDLT_decomposition;
 
@@ -73,7 +73,7 @@ LDLT *create_LDLT(double *A, int size) {
  *         singularity detection, or memory allocation errors.
  */
 
-LDLT *LDLT_decomposition(double *A, int size) {
+FN(LDLT) *FN(LDLT_decomposition)(REAL *A, index_t size) {
 
     if (!A) {
         fprintf(stderr, "Error: Null pointer detected for input matrix A in LDLT_decomposition.\n");
@@ -81,12 +81,12 @@ LDLT *LDLT_decomposition(double *A, int size) {
     }
 
     if (size <= 0) {
-        fprintf(stderr, "Error: Invalid size (%d). Must be strictly positive.\n", size);
+        fprintf(stderr, "Error: Invalid size (%" PRId64 "). Must be strictly positive.\n", size);
         return NULL;
     }
 
-    for (int i = 0; i < size; i++) {
-	for (int j = i + 1; j < size; j++) {
+    for (index_t i = 0; i < size; i++) {
+	for (index_t j = i + 1; j < size; j++) {
 	    if (A[i * size + j] != A[j * size + i]) {
 		fprintf(stderr, "Matrix is not symmetric.\n");
 		return NULL;
@@ -94,24 +94,24 @@ LDLT *LDLT_decomposition(double *A, int size) {
 	}
     }
 
-    LDLT *LDLT_decomp = create_LDLT(A, size);
+    FN(LDLT) *LDLT_decomp = FN(create_LDLT)(A, size);
 
     if (!LDLT_decomp) {
 	fprintf(stderr, "Memory allocation failed for LDLT structure.\n");
 	return NULL;
     }
 
-    for (int i = 0; i < size; i++) {
+    for (index_t i = 0; i < size; i++) {
 	LDLT_decomp->L[i * size + i] = 1.0;
     }
 
-    double epsilon = 1e-12;
+    REAL epsilon = 1e-12;
     
-    for (int i = 0; i < size; i++) {
+    for (index_t i = 0; i < size; i++) {
 	
-	double sum = 0.0;
+	REAL sum = 0.0;
 
-	for (int k = 0; k < i; k++) {
+	for (index_t k = 0; k < i; k++) {
 	    sum += LDLT_decomp->L[i * size + k] * LDLT_decomp->L[i * size + k] * LDLT_decomp->D[k * size + k];
 	}
 
@@ -119,15 +119,15 @@ LDLT *LDLT_decomposition(double *A, int size) {
 
 	if (fabs(LDLT_decomp->D[i * size + i]) < epsilon) {
 	    fprintf(stderr, "Matrix is nearly singular.\n");
-	    free_LDLT(LDLT_decomp);
+	    FN(free_LDLT)(LDLT_decomp);
 	    return NULL;
 	}
 
-	for (int j = i + 1; j < size; j++) {
+	for (index_t j = i + 1; j < size; j++) {
 
-	    double sum = 0.0;
+	    REAL sum = 0.0;
 
-	    for (int k = 0; k < i; k++) {
+	    for (index_t k = 0; k < i; k++) {
 		sum += LDLT_decomp->L[j * size + k] * LDLT_decomp->L[i * size + k] * LDLT_decomp->D[k * size + k];
 	    }
 
@@ -137,8 +137,8 @@ LDLT *LDLT_decomposition(double *A, int size) {
 
     }
 
-    for (int i = 0; i < size; i++) {
-	for (int j = 0; j < size; j++) {
+    for (index_t i = 0; i < size; i++) {
+	for (index_t j = 0; j < size; j++) {
 	    LDLT_decomp->L_t[j * size + i] = LDLT_decomp->L[i * size + j];
 	}
     }
@@ -156,7 +156,7 @@ LDLT *LDLT_decomposition(double *A, int size) {
  * @param LDLT_decomposition Pointer to the LDLT structure to free.
  */
 
-void free_LDLT(LDLT *LDLT_decomposition) {
+void FN(free_LDLT)(FN(LDLT) *LDLT_decomposition) {
 
     if (!LDLT_decomposition) return;
 
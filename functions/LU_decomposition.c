@@ -1,24 +1,278 @@
-#include "LinearAlgebraBasics.h"
+#include "kernels.h"
+#include <omp.h>
 #include <string.h>
 
+/**
+ * @brief Columns factored together by the blocked LU (width of a panel).
+ */
+
+#define LU_BLOCK 128
+
+/**
+ * @brief Panel width under which the recursive panel factorization runs column by column.
+ */
+
+#define LU_PANEL_BASE 8
+
+/**
+ * @brief Update tasks per thread for the blocks beyond the next panel, at each step.
+ */
+
+#define LU_UPDATE_TASKS 4
+
+/*
+ * The blocked LU is right-looking: for each panel of LU_BLOCK columns,
+ * 1. the panel is factored with partial pivoting (recursively, so that most
+ *    of its work is also done by the GEMM engine),
+ * 2. its row interchanges are applied to the columns to its right,
+ * 3. the block row to its right is solved with the unit lower triangle of the
+ *    panel (TRSM),
+ * 4. the trailing matrix receives the rank-LU_BLOCK update A22 -= A21 * A12
+ *    through the packed GEMM engine, which carries almost all the FLOPs.
+ * The interchanges of the later panels are applied to the columns on the left
+ * of a panel once, at the end. Matrices are row-major, so the interchanges
+ * move contiguous rows.
+ *
+ * The steps are OpenMP tasks over blocks of LU_BLOCK columns, ordered by one
+ * dependency per block instead of barriers: the factorization of panel k + 1
+ * only waits for the update of its own block by panel k, so it runs while the
+ * other threads still update the blocks further right with panel k. These are
+ * grouped into a few wide tasks per thread, so that each task packs A21 for
+ * many columns.
+ */
+
+/*
+ * Interchanges row i with row pivots[i] for i in [first, last), over the columns of the
+ * block of width columns starting at A.
+ */
+
+static void swap_rows(REAL *A, index_t lda, index_t columns, const index_t *pivots, index_t first, index_t last) {
+
+    for (index_t i = first; i < last; i++) {
+	index_t p = pivots[i];
+	if (p == i) continue;
+	REAL *row_i = A + (size_t) i * lda, *row_p = A + (size_t) p * lda;
+	for (index_t j = 0; j < columns; j++) {
+	    REAL swap = row_i[j];
+	    row_i[j] = row_p[j];
+	    row_p[j] = swap;
+	}
+    }
+
+}
+
+/*
+ * B = L^-1 B for the n x n unit lower triangle L and the n x columns block B, row after row.
+ */
+
+static void unit_lower_solve(index_t n, index_t columns, const REAL *L, index_t ldl, REAL *B, index_t ldb,
+			     const simd_kernels *kernels) {
+
+    for (index_t i = 1; i < n; i++)
+	for (index_t p = 0; p < i; p++)
+	    if (L[(size_t) i * ldl + p] != 0.0)
+		kernels->axpy(-L[(size_t) i * ldl + p], B + (size_t) p * ldb, B + (size_t) i * ldb, columns);
+
+}
+
+/*
+ * LU factorization with partial pivoting of the m x n panel A (m >= n), pivots relative
+ * to its first row. Narrow panels are factored column by column; wider ones are split in
+ * two halves, the right half being updated by a TRSM and a GEMM between the two recursive
+ * factorizations. A zero pivot column is left as is.
+ */
+
+static void factor_panel(index_t m, index_t n, REAL *A, index_t lda, index_t *pivots, const simd_kernels *kernels,
+			 REAL *P_packed, REAL *Q_packed) {
+
+    if (n <= LU_PANEL_BASE) {
+	for (index_t j = 0; j < n; j++) {
+	    index_t p = j;
+	    for (index_t i = j + 1; i < m; i++)
+		if (fabs(A[(size_t) i * lda + j]) > fabs(A[(size_t) p * lda + j]))
+		    p = i;
+
+	    pivots[j] = p;
+	    swap_rows(A, lda, n, pivots, j, j + 1);
+
+	    REAL diagonal = A[(size_t) j * lda + j];
+	    if (diagonal == 0.0) continue;
+
+	    for (index_t i = j + 1; i < m; i++) {
+		REAL *row = A + (size_t) i * lda;
+		row[j] /= diagonal;
+		for (index_t c = j + 1; c < n; c++)
+		    row[c] -= row[j] * A[(size_t) j * lda + c];
+	    }
+	}
+	return;
+    }
+
+    index_t n1 = n / 2, n2 = n - n1;
+
+    factor_panel(m, n1, A, lda, pivots, kernels, P_packed, Q_packed);
+
+    swap_rows(A + n1, lda, n2, pivots, 0, n1);
+    unit_lower_solve(n1, n2, A, lda, A + n1, lda, kernels);
+    FN(blocked_general_product_packed)(OP_NO_TRANSPOSE, OP_NO_TRANSPOSE, m - n1, n2, n1, -1.0, A + (size_t) n1 * lda, lda,
+				       A + n1, lda, 1.0, A + (size_t) n1 * lda + n1, lda, P_packed, Q_packed);
+
+    factor_panel(m - n1, n2, A + (size_t) n1 * lda + n1, lda, pivots + n1, kernels, P_packed, Q_packed);
+
+    for (index_t i = n1; i < n; i++)
+	pivots[i] += n1;
+
+    swap_rows(A, lda, n1, pivots, n1, n);
+
+}
+
+/*
+ * Applies the interchanges of panel k (columns [k, k + nb)) to the columns [j, j + width) on its
+ * right, solves their block row and updates them below it: one task of the factorization.
+ */
+
+static void update_block(index_t m, REAL *A, index_t lda, const index_t *pivots, index_t k, index_t nb, index_t j,
+			 index_t width, const simd_kernels *kernels, REAL *P_packed, REAL *Q_packed) {
+
+    index_t right = k + nb;
+
+    swap_rows(A + j, lda, width, pivots, k, right);
+    unit_lower_solve(nb, width, A + (size_t) k * lda + k, lda, A + (size_t) k * lda + j, lda, kernels);
+
+    if (m > right)
+	FN(blocked_general_product_packed)(OP_NO_TRANSPOSE, OP_NO_TRANSPOSE, m - right, width, nb, -1.0,
+					   A + (size_t) right * lda + k, lda, A + (size_t) k * lda + j, lda,
+					   1.0, A + (size_t) right * lda + j, lda, P_packed, Q_packed);
+
+}
+
+/**
+ * @brief Factors the m x n matrix A in place as P A = L U with a blocked right-looking LU.
+ *
+ * On return, the strictly lower part of A holds the multipliers of the unit lower
+ * trapezoid L and its upper part holds U. Row i was interchanged with row pivots[i]
+ * at step i (min(m, n) steps). A zero pivot does not stop the factorization: U then
+ * has a zero on its diagonal, which the caller detects.
+ *
+ * @param m Number of rows of A.
+ * @param n Number of columns of A.
+ * @param A Pointer to the matrix (size: m x n, leading dimension lda), overwritten by L and U.
+ * @param lda Leading dimension of A (must be >= n).
+ * @param pivots Pointer to the row interchanges (size: min(m, n)).
+ * @param parallel 1 to run the panel and update tasks on all the OpenMP threads,
+ *                 0 to run them on the calling thread only.
+ *
+ * @return 0 on success, or -1 on failure due to memory allocation errors.
+ */
+
+int FN(blocked_LU_factorization)(index_t m, index_t n, REAL *A, index_t lda, index_t *pivots, int parallel) {
+
+    index_t steps = m < n ? m : n;
+    index_t blocks = (n + LU_BLOCK - 1) / LU_BLOCK;
+    index_t last_panel = (steps - 1) / LU_BLOCK;
+    int threads = parallel ? omp_get_max_threads() : 1;
+    index_t tasks = parallel ? LU_UPDATE_TASKS * threads : 1;
+    const simd_kernels *kernels = FN(active_kernels);
+
+    // One dependency sentinel per block of columns, and packing buffers per thread
+    char *block = malloc(blocks);
+    REAL **P_packed = calloc(threads, sizeof(REAL *));
+    REAL **Q_packed = calloc(threads, sizeof(REAL *));
+    int failed = !block || !P_packed || !Q_packed;
+
+    for (int t = 0; t < threads && !failed; t++) {
+	P_packed[t] = aligned_buffer(sizeof(REAL) * GEMM_P_BUFFER_SIZE(GEMM_MC, LU_BLOCK));
+	Q_packed[t] = aligned_buffer(sizeof(REAL) * GEMM_Q_BUFFER_SIZE(n, LU_BLOCK));
+	failed = !P_packed[t] || !Q_packed[t];
+    }
+
+    if (!failed) {
+#pragma omp parallel num_threads(threads)
+#pragma omp single
+	{
+	    for (index_t b = 0; b <= last_panel; b++) {
+
+		index_t k = b * LU_BLOCK;
+		index_t nb = steps - k < LU_BLOCK ? steps - k : LU_BLOCK;
+
+#pragma omp task depend(inout: block[b]) priority(1)
+		{
+		    int t = omp_get_thread_num();
+		    index_t width = n - k < LU_BLOCK ? n - k : LU_BLOCK;
+
+		    factor_panel(m - k, nb, A + (size_t) k * lda + k, lda, pivots + k, kernels, P_packed[t], Q_packed[t]);
+		    for (index_t i = k; i < k + nb; i++)
+			pivots[i] += k;
+
+		    // A last panel narrower than its block (m < n) leaves columns to update on its right
+		    if (width > nb)
+			update_block(m, A, lda, pivots, k, nb, k + nb, width - nb, kernels, P_packed[t], Q_packed[t]);
+		}
+
+		// In parallel, the block of the next panel is updated alone (look-ahead) and the
+		// others in LU_UPDATE_TASKS tasks per thread
+		index_t lookahead = b + 1 + (parallel != 0);
+		index_t group = (blocks - lookahead + tasks - 1) / tasks;
+
+		for (index_t c = b + 1, end; c < blocks; c = end) {
+		    end = c < lookahead ? lookahead : (c + group < blocks ? c + group : blocks);
+
+#pragma omp task depend(in: block[b]) depend(iterator(i = c : end), inout: block[i])
+		    {
+			int t = omp_get_thread_num();
+			index_t j = c * LU_BLOCK;
+			index_t width = (end * LU_BLOCK < n ? end * LU_BLOCK : n) - j;
+
+			update_block(m, A, lda, pivots, k, nb, j, width, kernels, P_packed[t], Q_packed[t]);
+		    }
+		}
+
+	    }
+
+	    // Interchanges of the later panels on the columns of each panel, once all the pivots are known
+	    for (index_t b = 0; b < last_panel; b++) {
+#pragma omp task depend(in: block[last_panel]) depend(inout: block[b])
+		swap_rows(A + b * LU_BLOCK, lda, LU_BLOCK, pivots, (b + 1) * LU_BLOCK, steps);
+	    }
+	}
+    }
+
+    for (int t = 0; P_packed && Q_packed && t < threads; t++) {
+	free(P_packed[t]);
+	free(Q_packed[t]);
+    }
+
+    free(P_packed);
+    free(Q_packed);
+    free(block);
+
+    if (failed) {
+        fprintf(stderr, "Error: Memory allocation failed for packing buffers in blocked_LU_factorization.\n");
+        return -1;
+    }
+
+    return 0;
+
+}
+
 /**
  * @brief Allocates and initializes an LU decomposition structure.
  *
  * This function creates an LU decomposition structure for a given matrix A
- * and initializes its components (L, U, and A).
+ * and initializes its components (L, U, pivots and A).
  *
  * @param A Pointer to the input matrix (size: rows x columns).
  * @param rows Number of rows in the matrix (must be positive).
  * @param columns Number of columns in the matrix (must be positive).
  *
- * @return Pointer to the LU structure containing L, U, and A matrices on success,
+ * @return Pointer to the LU structure containing L, U, pivots and A on success,
  *         or NULL on failure due to invalid dimensions or memory allocation errors.
  */
 
-LU *create_LU(double *A, int rows, int columns) {
+FN(LU) *FN(create_LU)(REAL *A, index_t rows, index_t columns) {
 
     if (rows <= 0 || columns <= 0) {
-        fprintf(stderr, "Error: Invalid dimensions for LU decomposition (rows=%d, columns=%d). Both must be strictly positive.\n", rows, columns);
+        fprintf(stderr, "Error: Invalid dimensions for LU decomposition (rows=%" PRId64 ", columns=%" PRId64 "). Both must be strictly positive.\n", rows, columns);
         return NULL;
     }
 
@@ -27,7 +281,7 @@ LU *create_LU(double *A, int rows, int columns) {
         return NULL;
     }
 
-    LU *LU_decomposition = malloc(sizeof(LU));
+    FN(LU) *LU_decomposition = malloc(sizeof(FN(LU)));
 
     if (!LU_decomposition) {
         fprintf(stderr, "Error: Memory allocation failed for LU structure.\n");
@@ -37,161 +291,440 @@ LU *create_LU(double *A, int rows, int columns) {
     LU_decomposition->rows = rows;
     LU_decomposition->columns = columns;
 
-    LU_decomposition->A = malloc(rows * columns * sizeof(double));
-    LU_decomposition->L = malloc(rows * columns * sizeof(double));
-    LU_decomposition->U = malloc(rows * columns * sizeof(double));
+    LU_decomposition->A = malloc(rows * columns * sizeof(REAL));
+    LU_decomposition->L = malloc(rows * columns * sizeof(REAL));
+    LU_decomposition->U = malloc(rows * columns * sizeof(REAL));
+    LU_decomposition->pivots = malloc((rows < columns ? rows : columns) * sizeof(index_t));
 
-    if (!LU_decomposition->A || !LU_decomposition->L || !LU_decomposition->U) {
+    if (!LU_decomposition->A || !LU_decomposition->L || !LU_decomposition->U || !LU_decomposition->pivots) {
         fprintf(stderr, "Error: Memory allocation failed for matrices in create_LU.\n");
-        free(LU_decomposition->A);
-        free(LU_decomposition->L);
-        free(LU_decomposition->U);
-        free(LU_decomposition);
+        FN(LU_free)(LU_decomposition);
         return NULL;
     }
 
-    memcpy(LU_decomposition->A, A, rows * columns * sizeof(double));
+    memcpy(LU_decomposition->A, A, rows * columns * sizeof(REAL));
 
     return LU_decomposition;
 
 }
 
-/**
- * @brief Performs LU decomposition on a given matrix using Doolittle's algorithm.
- *
- * This function decomposes a matrix A into a lower triangular matrix L
- * and an upper triangular matrix U such that A = L * U.
- *
- * @param A Pointer to the input matrix (size: rows x columns).
- * @param rows Number of rows in the matrix (must be positive).
- * @param columns Number of columns in the matrix (must be positive).
- *
- * @return Pointer to the LU structure containing L and U matrices on success,
- *         or NULL on failure due to invalid dimensions or memory allocation errors.
+/*
+ * Shared by LU_decomposition and LU_decomposition_parallel: factors a copy of A in U,
+ * then moves the multipliers below the diagonal to L.
  */
 
-LU *LU_decomposition(double *A, int rows, int columns) {
- 
-    LU *LU_decomposition = create_LU(A, rows, columns);
+static FN(LU) *LU_decomposition_blocked(REAL *A, index_t rows, index_t columns, int parallel) {
+
+    FN(LU) *LU_decomposition = FN(create_LU)(A, rows, columns);
 
     if (!LU_decomposition) {
         fprintf(stderr, "Error: Failed to create LU decomposition structure.\n");
         return NULL;
     }
 
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < columns; j++) {
-            if (i == j) {
-                LU_decomposition->L[i * columns + j] = 1;
-	    }
-            else {
-                LU_decomposition->L[i * columns + j] = 0;
-	    }
-            LU_decomposition->U[i * columns + j] = 0;
-        }
-    }
+    REAL *L = LU_decomposition->L, *U = LU_decomposition->U;
 
-    for (int i = 0; i < rows; i++) {
-        for (int j = i; j < columns; j++) {
-            LU_decomposition->U[i * columns + j] = A[i * columns + j];
-            for (int k = 0; k < i; k++) {
-                LU_decomposition->U[i * columns + j] -= LU_decomposition->L[i * columns + k] * LU_decomposition->U[k * columns + j];
-            }
-        }
+    memcpy(U, A, rows * columns * sizeof(REAL));
 
-        for (int j = i + 1; j < columns; j++) {
-            LU_decomposition->L[j * columns + i] = A[j * columns + i];
-            for (int k = 0; k < i; k++) {
-                LU_decomposition->L[j * columns + i] -= LU_decomposition->L[j * columns + k] * LU_decomposition->U[k * columns + i];
-            }
-            LU_decomposition->L[j * columns + i] /= LU_decomposition->U[i * columns + i];
-        }
+    if (FN(blocked_LU_factorization)(rows, columns, U, columns, LU_decomposition->pivots, parallel)) {
+        FN(LU_free)(LU_decomposition);
+        return NULL;
     }
-    
+
+#pragma omp parallel for if(parallel)
+    for (index_t i = 0; i < rows; i++) {
+	for (index_t j = 0; j < columns; j++) {
+	    if (j < i) {
+		L[i * columns + j] = U[i * columns + j];
+		U[i * columns + j] = 0.0;
+	    } else {
+		L[i * columns + j] = (i == j) ? 1.0 : 0.0;
+	    }
+	}
+    }
+
     return LU_decomposition;
 
 }
 
 /**
- * @brief Performs parallelized LU decomposition on a given matrix using OpenMP.
+ * @brief Performs LU decomposition with partial pivoting on a given matrix.
+ *
+ * This function decomposes a matrix A into a unit lower triangular matrix L and an
+ * upper triangular matrix U such that P A = L U, where the permutation P is given by
+ * the pivots of the structure. The factorization is blocked: each panel of columns is
+ * factored with partial pivoting, and the rest of the matrix is updated by a
+ * triangular solve and a matrix product run by the packed GEMM engine.
  *
- * This function decomposes a matrix A into a lower triangular matrix L
- * and an upper triangular matrix U such that A = L * U. The computation is
- * parallelized using OpenMP for improved performance on large matrices.
+ * A singular matrix is factored as well, with zeros on the diagonal of U.
+ * For a rectangular matrix, L is rows x min(rows, columns) and U is min(rows, columns)
+ * x columns, both stored in the top-left part of their rows x columns array.
  *
  * @param A Pointer to the input matrix (size: rows x columns).
  * @param rows Number of rows in the matrix (must be positive).
  * @param columns Number of columns in the matrix (must be positive).
  *
- * @return Pointer to the LU structure containing L and U matrices on success,
+ * @return Pointer to the LU structure containing L, U and pivots on success,
  *         or NULL on failure due to invalid dimensions or memory allocation errors.
  */
 
-LU *LU_decomposition_parallel(double *A, int rows, int columns) {
+FN(LU) *FN(LU_decomposition)(REAL *A, index_t rows, index_t columns) {
 
-    // ASSERTION : THE USER WILL ALWAYS GIVE MATRICES OF THE RIGHT SIZE AS INPUT
+    return LU_decomposition_blocked(A, rows, columns, 0);
 
-    LU *LU_decomposition = create_LU(A, rows, columns);
+}
 
-    if (!LU_decomposition) {
-        fprintf(stderr, "Error: Failed to create LU decomposition structure.\n");
-        return NULL;
-    }
-    
-#pragma omp parallel for
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < columns; j++) {
-            if (i == j) {
-                LU_decomposition->L[i * columns + j] = 1;
-	    }
-	    else {
-                LU_decomposition->L[i * columns + j] = 0;
-	    }
-            LU_decomposition->U[i * columns + j] = 0;
-        }
-    }
+/**
+ * @brief Performs parallelized LU decomposition with partial pivoting on a given matrix using OpenMP.
+ *
+ * Same as LU_decomposition, run as a graph of OpenMP tasks over blocks of columns:
+ * the factorization of each panel depends only on the update of its own block by
+ * the previous panel, so panels and updates of successive steps overlap instead of
+ * being separated by barriers.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive).
+ *
+ * @return Pointer to the LU structure containing L, U and pivots on success,
+ *         or NULL on failure due to invalid dimensions or memory allocation errors.
+ */
 
-    for (int i = 0; i < rows; i++) {
-#pragma omp parallel for
-        for (int j = i; j < columns; j++) {
-            double sum = 0.0;
-            for (int k = 0; k < i; k++) {
-                sum += LU_decomposition->L[i * columns + k] * LU_decomposition->U[k * columns + j];
-            }
-            LU_decomposition->U[i * columns + j] = A[i * columns + j] - sum;
-        }
-	
-#pragma omp parallel for
-        for (int j = i + 1; j < rows; j++) {
-            double sum = 0.0;
-            for (int k = 0; k < i; k++) {
-		sum += LU_decomposition->L[j * columns + k] * LU_decomposition->U[k * columns + i];
-            }
-            LU_decomposition->L[j * columns + i] = (A[j * columns + i] - sum) / LU_decomposition->U[i * columns + i];
-        }
-    }
+FN(LU) *FN(LU_decomposition_parallel)(REAL *A, index_t rows, index_t columns) {
+
+    return LU_decomposition_blocked(A, rows, columns, 1);
 
-    return LU_decomposition;
-    
 }
 
 /**
  * @brief Frees all memory associated with an LU decomposition structure.
  *
  * This function releases the memory allocated for the matrices L, U, and A,
- * as well as the LU structure itself.
+ * the pivots, as well as the LU structure itself.
  *
  * @param LU_decomposition Pointer to the LU structure to free.
  */
 
-void LU_free(LU *LU_decomposition) {
+void FN(LU_free)(FN(LU) *LU_decomposition) {
 
     if (!LU_decomposition) return;
-    
+
     free(LU_decomposition->A);
     free(LU_decomposition->L);
     free(LU_decomposition->U);
+    free(LU_decomposition->pivots);
 
     free(LU_decomposition);
 
 }
+
+/*
+ * Shared by LU_factorization_into and LU_factorization_parallel_into.
+ */
+
+static int LU_factorization_compact(REAL *A, index_t rows, index_t columns, REAL *LU, index_t *pivots, int parallel,
+				    const char *name) {
+
+    if (rows <= 0 || columns <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions for LU factorization (rows=%" PRId64 ", columns=%" PRId64 "). Both must be strictly positive.\n", rows, columns);
+        return -1;
+    }
+
+    if (!A || !LU || !pivots) {
+        fprintf(stderr, "Error: Null pointer detected in %s.\n", name);
+        return -1;
+    }
+
+    if (LU != A && ranges_overlap(LU, (size_t) rows * columns, A, (size_t) rows * columns)) {
+        fprintf(stderr, "Error: Output matrix partially overlaps the input matrix in %s.\n", name);
+        return -1;
+    }
+
+    if (LU != A)
+        memcpy(LU, A, (size_t) rows * columns * sizeof(REAL));
+
+    return FN(blocked_LU_factorization)(rows, columns, LU, columns, pivots, parallel);
+
+}
+
+/**
+ * @brief Performs LU decomposition with partial pivoting into a single caller-provided matrix.
+ *
+ * This function computes P A = L U like LU_decomposition, in the compact storage of
+ * LAPACK: the multipliers of the unit lower triangular L are stored below the diagonal
+ * of LU and U on and above it, with the unit diagonal of L implied. Row i was interchanged
+ * with row pivots[i] at step i. LU may be A, which is then factored in place and no other
+ * matrix is allocated. The factors are read directly by solve_LU_factored_system,
+ * LU_factored_determinant and LU_factored_inverse.
+ *
+ * A singular matrix is factored as well, with zeros on the diagonal of U.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive).
+ * @param LU Pointer to the output factors (size: rows x columns), may be A.
+ * @param pivots Pointer to the row interchanges (size: min(rows, columns)).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         partially overlapping output or memory allocation errors.
+ */
+
+int FN(LU_factorization_into)(REAL *A, index_t rows, index_t columns, REAL *LU, index_t *pivots) {
+
+    return LU_factorization_compact(A, rows, columns, LU, pivots, 0, "LU_factorization_into");
+
+}
+
+/**
+ * @brief Performs parallelized LU decomposition with partial pivoting into a single caller-provided matrix using OpenMP.
+ *
+ * Same as LU_factorization_into, with the tasks of LU_decomposition_parallel.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive).
+ * @param LU Pointer to the output factors (size: rows x columns), may be A.
+ * @param pivots Pointer to the row interchanges (size: min(rows, columns)).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         partially overlapping output or memory allocation errors.
+ */
+
+int FN(LU_factorization_parallel_into)(REAL *A, index_t rows, index_t columns, REAL *LU, index_t *pivots) {
+
+    return LU_factorization_compact(A, rows, columns, LU, pivots, 1, "LU_factorization_parallel_into");
+
+}
+
+/**
+ * @brief Solves a linear system Ax = b from the compact LU factors of A.
+ *
+ * @param LU Pointer to the factors of the square matrix A returned by LU_factorization_into (size: d x d).
+ * @param pivots Pointer to the row interchanges returned by LU_factorization_into (size: d).
+ * @param d Dimension of the square matrix A and vector b (must be positive).
+ * @param b Pointer to the right-hand side vector b (size: d).
+ *
+ * @return Pointer to the solution vector x on success, or NULL on failure due to invalid dimensions,
+ *         null pointers, singular matrix detection or memory allocation errors.
+ */
+
+REAL *FN(solve_LU_factored_system)(const REAL *LU, const index_t *pivots, index_t d, REAL *b) {
+
+    if (d <= 0) {
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", d);
+        return NULL;
+    }
+
+    REAL *x = malloc(d * sizeof(REAL));
+
+    if (!x) {
+        fprintf(stderr, "Error: Memory allocation failed for solution vector in solve_LU_factored_system.\n");
+        return NULL;
+    }
+
+    if (FN(solve_LU_factored_system_into)(LU, pivots, d, b, x)) {
+        free(x);
+        return NULL;
+    }
+
+    return x;
+
+}
+
+/**
+ * @brief Solves a linear system Ax = b from the compact LU factors of A into a caller-provided vector.
+ *
+ * Solves L y = P b then U x = y in x, with dot products of the contiguous rows of LU.
+ * x may be b (the right-hand side is overwritten by the solution).
+ *
+ * @param LU Pointer to the factors of the square matrix A returned by LU_factorization_into (size: d x d).
+ * @param pivots Pointer to the row interchanges returned by LU_factorization_into (size: d).
+ * @param d Dimension of the square matrix A and vector b (must be positive).
+ * @param b Pointer to the right-hand side vector b (size: d).
+ * @param x Pointer to the solution vector x (size: d).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         aliased output or singular matrix detection.
+ */
+
+int FN(solve_LU_factored_system_into)(const REAL *LU, const index_t *pivots, index_t d, REAL *b, REAL *x) {
+
+    if (d <= 0) {
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", d);
+        return -1;
+    }
+
+    if (!LU || !pivots || !b || !x) {
+        fprintf(stderr, "Error: Null pointer detected in solve_LU_factored_system_into.\n");
+        return -1;
+    }
+
+    if (ranges_overlap(x, d, LU, (size_t) d * d)) {
+        fprintf(stderr, "Error: Solution vector overlaps the factors in solve_LU_factored_system_into.\n");
+        return -1;
+    }
+
+    const simd_kernels *kernels = FN(active_kernels);
+
+    if (x != b)
+        memcpy(x, b, d * sizeof(REAL));
+
+    for (index_t i = 0; i < d; i++) {
+        REAL swap = x[i];
+        x[i] = x[pivots[i]];
+        x[pivots[i]] = swap;
+    }
+
+    // Row i of L only reads x[0..i-1], and row i of U only x[i+1..d-1], so both solves run in x
+    for (index_t i = 1; i < d; i++)
+	x[i] -= kernels->dot(LU + (size_t) i * d, x, i);
+
+    for (index_t i = d - 1; i >= 0; i--) {
+	const REAL *U_i = LU + (size_t) i * d;
+	if (fabs(U_i[i]) < 1e-10) {
+            fprintf(stderr, "Error: Singular matrix detected in solve_LU_factored_system at row %" PRId64 ".\n", i);
+            return -1;
+        }
+	x[i] = (x[i] - kernels->dot(U_i + i + 1, x + i + 1, d - i - 1)) / U_i[i];
+    }
+
+    return 0;
+
+}
+
+/**
+ * @brief Computes the determinant of a square matrix A from its compact LU factors.
+ *
+ * The determinant is the product of the diagonal of U, with one sign change per row
+ * interchange. A singular matrix gives a (nearly) zero determinant.
+ *
+ * @param LU Pointer to the factors of the square matrix A returned by LU_factorization_into (size: d x d).
+ * @param pivots Pointer to the row interchanges returned by LU_factorization_into (size: d).
+ * @param d Dimension of the square matrix A (must be positive).
+ *
+ * @return The determinant of the matrix on success, or -1.0 on failure due to invalid dimensions
+ *         or null pointers.
+ */
+
+REAL FN(LU_factored_determinant)(const REAL *LU, const index_t *pivots, index_t d) {
+
+    if (d <= 0) {
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", d);
+        return -1.0;
+    }
+
+    if (!LU || !pivots) {
+        fprintf(stderr, "Error: Null pointer detected in LU_factored_determinant.\n");
+        return -1.0;
+    }
+
+    REAL determinant = 1.0;
+
+    for (index_t i = 0; i < d; i++) {
+        determinant *= LU[(size_t) i * d + i];
+        if (pivots[i] != i)
+            determinant = -determinant;
+    }
+
+    return determinant;
+
+}
+
+/**
+ * @brief Computes the inverse of a square matrix A from its compact LU factors.
+ *
+ * @param LU Pointer to the factors of the square matrix A returned by LU_factorization_into (size: d x d).
+ * @param pivots Pointer to the row interchanges returned by LU_factorization_into (size: d).
+ * @param d Dimension of the square matrix A (must be positive).
+ *
+ * @return Pointer to the inverse matrix on success, or NULL on failure due to invalid dimensions,
+ *         null pointers, singular matrix detection or memory allocation errors.
+ */
+
+REAL *FN(LU_factored_inverse)(const REAL *LU, const index_t *pivots, index_t d) {
+
+    if (d <= 0) {
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", d);
+        return NULL;
+    }
+
+    REAL *inverse = malloc((size_t) d * d * sizeof(REAL));
+
+    if (!inverse) {
+        fprintf(stderr, "Error: Memory allocation failed for inverse matrix in LU_factored_inverse.\n");
+        return NULL;
+    }
+
+    if (FN(LU_factored_inverse_into)(LU, pivots, d, inverse)) {
+        free(inverse);
+        return NULL;
+    }
+
+    return inverse;
+
+}
+
+/**
+ * @brief Computes the inverse of a square matrix A from its compact LU factors into a caller-provided matrix.
+ *
+ * The inverse is formed in place from the permuted identity P, by solving L U X = P for
+ * all its columns at once: both triangular solves combine whole rows of X, so that the
+ * kernels run on contiguous rows instead of one strided column at a time.
+ *
+ * @param LU Pointer to the factors of the square matrix A returned by LU_factorization_into (size: d x d).
+ * @param pivots Pointer to the row interchanges returned by LU_factorization_into (size: d).
+ * @param d Dimension of the square matrix A (must be positive).
+ * @param inverse Pointer to the output matrix (size: d x d), must not overlap LU.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         aliased output or singular matrix detection.
+ */
+
+int FN(LU_factored_inverse_into)(const REAL *LU, const index_t *pivots, index_t d, REAL *inverse) {
+
+    if (d <= 0) {
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", d);
+        return -1;
+    }
+
+    if (!LU || !pivots || !inverse) {
+        fprintf(stderr, "Error: Null pointer detected in LU_factored_inverse_into.\n");
+        return -1;
+    }
+
+    if (ranges_overlap(inverse, (size_t) d * d, LU, (size_t) d * d)) {
+        fprintf(stderr, "Error: Output matrix overlaps the factors in LU_factored_inverse_into.\n");
+        return -1;
+    }
+
+    for (index_t i = 0; i < d; i++) {
+	if (fabs(LU[(size_t) i * d + i]) < 1e-10) {
+            fprintf(stderr, "Error: Singular matrix detected in LU_factored_inverse at row %" PRId64 ".\n", i);
+            return -1;
+        }
+    }
+
+    const simd_kernels *kernels = FN(active_kernels);
+
+    memset(inverse, 0, (size_t) d * d * sizeof(REAL));
+
+    for (index_t i = 0; i < d; i++)
+	inverse[(size_t) i * d + i] = 1.0;
+
+    swap_rows(inverse, d, d, pivots, 0, d);
+    unit_lower_solve(d, d, LU, d, inverse, d, kernels);
+
+    // U X = Y from the last row up: row i of X is row i of Y minus the rows below it, divided by U_ii
+    for (index_t i = d - 1; i >= 0; i--) {
+	REAL *X_i = inverse + (size_t) i * d;
+	const REAL *U_i = LU + (size_t) i * d;
+	for (index_t p = i + 1; p < d; p++)
+	    if (U_i[p] != 0.0)
+		kernels->axpy(-U_i[p], inverse + (size_t) p * d, X_i, d);
+	for (index_t j = 0; j < d; j++)
+	    X_i[j] /= U_i[i];
+    }
+
+    return 0;
+
+}
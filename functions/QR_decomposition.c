@@ -1,6 +1,465 @@
-#include "LinearAlgebraBasics.h"
+#include "kernels.h"
+#include <omp.h>
 #include <string.h>
 
+/**
+ * @brief Columns factored together by the blocked QR (width of a panel and of its block reflector).
+ */
+
+#define QR_BLOCK 64
+
+/**
+ * @brief Columns of the trailing matrix per tile when the block reflectors are applied in parallel.
+ */
+
+#define QR_TILE_COLUMNS 256
+
+/**
+ * @brief Columns of a block under which the reflectors are applied one by one rather than as block reflectors.
+ */
+
+#define QR_APPLY_COLUMNS 16
+
+/*
+ * The blocked QR is the Householder QR of LAPACK (GEQRF). For each panel of
+ * QR_BLOCK columns,
+ * 1. the panel is factored column by column: the reflector H = I - tau v v^T
+ *    of each column zeroes it below the diagonal and is applied to the rest of
+ *    the panel, row after row,
+ * 2. the reflectors of the panel are aggregated in the compact WY form
+ *    H_1 H_2 ... H_nb = I - V T V^T, where V holds the vectors (unit lower
+ *    trapezoid) and T is upper triangular, built from the Gram matrix V^T V,
+ * 3. the trailing matrix C receives H^T C = C - V (T^T (V^T C)): the products
+ *    by V^T and V carry almost all the FLOPs through the packed GEMM engine.
+ * R is left on and above the diagonal and the vectors v, whose first element
+ * is an implied 1, below it. Q is only formed on request, from the last block
+ * reflector to the first (ORGQR).
+ *
+ * Reflectors stay orthogonal to working precision whatever the columns, so
+ * Q^T Q = I even when Gram-Schmidt would lose orthogonality, and (nearly)
+ * dependent columns only give (nearly) zero elements on the diagonal of R.
+ */
+
+/*
+ * Generates the reflector H = I - tau v v^T such that H x = (beta, 0, ..., 0) for the n values
+ * x[i * stride]. x[0] receives beta and x[i * stride] the elements v[i] for i >= 1 (v[0] = 1).
+ * tau is 0 (H = I) when x is already zero below its first element.
+ */
+
+static REAL householder_reflector(index_t n, REAL *x, index_t stride) {
+
+    REAL norm = 0.0;
+
+    for (index_t i = 1; i < n; i++)
+	norm += x[i * stride] * x[i * stride];
+
+    if (norm == 0.0) return 0.0;
+
+    REAL alpha = x[0];
+    REAL beta = -copysign(sqrt(alpha * alpha + norm), alpha);
+    REAL scale = 1.0 / (alpha - beta);
+
+    for (index_t i = 1; i < n; i++)
+	x[i * stride] *= scale;
+
+    x[0] = beta;
+
+    return (beta - alpha) / beta;
+
+}
+
+/*
+ * Unblocked Householder QR of the m x n panel A. Matrices are row-major, so the product
+ * w = v^T A and the update A -= tau v w of each reflector both run along the rows. w holds n values.
+ */
+
+static void factor_panel(index_t m, index_t n, REAL *A, index_t lda, REAL *tau, REAL *w) {
+
+    index_t steps = m < n ? m : n;
+
+    for (index_t j = 0; j < steps; j++) {
+	REAL *A_j = A + (size_t) j * lda + j;
+	index_t width = n - j - 1;
+
+	tau[j] = householder_reflector(m - j, A_j, lda);
+
+	if (tau[j] == 0.0 || width == 0) continue;
+
+	for (index_t c = 0; c < width; c++)
+	    w[c] = A_j[1 + c];
+	for (index_t i = 1; i < m - j; i++) {
+	    const REAL *row = A_j + (size_t) i * lda;
+	    for (index_t c = 0; c < width; c++)
+		w[c] += row[0] * row[1 + c];
+	}
+
+	for (index_t c = 0; c < width; c++)
+	    A_j[1 + c] -= tau[j] * w[c];
+	for (index_t i = 1; i < m - j; i++) {
+	    REAL *row = A_j + (size_t) i * lda;
+	    REAL scale = tau[j] * row[0];
+	    for (index_t c = 0; c < width; c++)
+		row[1 + c] -= scale * w[c];
+	}
+    }
+
+}
+
+/*
+ * Turns the Gram matrix G = V^T V (nb x nb) of nb reflectors, stored in T, into the upper
+ * triangular T such that H_1 ... H_nb = I - V T V^T: column j of T is T[0:j, j] =
+ * -tau_j T[0:j, 0:j] G[0:j, j] and T[j, j] = tau_j. Only G above the diagonal is read,
+ * and the strictly lower triangle of T is zeroed.
+ */
+
+static void triangular_factor(index_t nb, const REAL *tau, REAL *T) {
+
+    for (index_t j = 0; j < nb; j++) {
+	// Rows in increasing order: T[i, j] replaces G[i, j] once the G[p, j] with p < i are read
+	for (index_t i = 0; i < j; i++) {
+	    REAL sum = 0.0;
+	    for (index_t p = i; p < j; p++)
+		sum += T[i * nb + p] * T[p * nb + j];
+	    T[i * nb + j] = -tau[j] * sum;
+	}
+	T[j * nb + j] = tau[j];
+	for (index_t i = j + 1; i < nb; i++)
+	    T[i * nb + j] = 0.0;
+    }
+
+}
+
+/*
+ * Builds the compact WY form of the nb reflectors stored below the diagonal of the m x nb
+ * block A: V (m x nb, leading dimension nb) with its unit diagonal and zeros made explicit,
+ * so that the GEMM engine reads it directly, and the upper triangular T (nb x nb) such that
+ * H_1 ... H_nb = I - V T V^T, from G = V^T V formed in T.
+ */
+
+static void form_block_reflector(index_t m, index_t nb, const REAL *A, index_t lda, const REAL *tau,
+				 REAL *V, REAL *T, REAL *P_packed, REAL *Q_packed) {
+
+    for (index_t i = 0; i < m; i++)
+	for (index_t j = 0; j < nb; j++)
+	    V[(size_t) i * nb + j] = j < i ? A[(size_t) i * lda + j] : (j == i ? 1.0 : 0.0);
+
+    FN(blocked_general_product_packed)(OP_TRANSPOSE, OP_NO_TRANSPOSE, nb, nb, m, 1.0, V, nb, V, nb, 0.0, T, nb,
+				       P_packed, Q_packed);
+
+    triangular_factor(nb, tau, T);
+
+}
+
+/*
+ * Applies the block reflector H = I - V T V^T of form_block_reflector to the m x n block C
+ * from the left: C = H^T C when transpose is OP_TRANSPOSE (factorization, Q^T b), C = H C
+ * otherwise (forming Q). W holds nb x n values.
+ */
+
+void FN(apply_block_reflector)(int transpose, index_t m, index_t n, index_t nb, const REAL *V, const REAL *T,
+			      REAL *C, index_t ldc, REAL *W, REAL *P_packed, REAL *Q_packed,
+			      const simd_kernels *kernels) {
+
+    // W = V^T C
+    FN(blocked_general_product_packed)(OP_TRANSPOSE, OP_NO_TRANSPOSE, nb, n, m, 1.0, V, nb, C, ldc, 0.0, W, n,
+				       P_packed, Q_packed);
+
+    // W = T^T W (rows in decreasing order) or W = T W (rows in increasing order), in place
+    if (transpose == OP_TRANSPOSE)
+	for (index_t i = nb - 1; i >= 0; i--) {
+	    REAL *W_i = W + (size_t) i * n;
+	    for (index_t j = 0; j < n; j++)
+		W_i[j] *= T[i * nb + i];
+	    for (index_t p = 0; p < i; p++)
+		kernels->axpy(T[p * nb + i], W + (size_t) p * n, W_i, n);
+	}
+    else
+	for (index_t i = 0; i < nb; i++) {
+	    REAL *W_i = W + (size_t) i * n;
+	    for (index_t j = 0; j < n; j++)
+		W_i[j] *= T[i * nb + i];
+	    for (index_t p = i + 1; p < nb; p++)
+		kernels->axpy(T[i * nb + p], W + (size_t) p * n, W_i, n);
+	}
+
+    // C -= V W
+    FN(blocked_general_product_packed)(OP_NO_TRANSPOSE, OP_NO_TRANSPOSE, m, n, nb, -1.0, V, nb, W, n, 1.0, C, ldc,
+				       P_packed, Q_packed);
+
+}
+
+/*
+ * Buffers of the blocked QR: the block reflector (V and T) shared by the team, and the
+ * packing buffers and W of each thread, sized for m rows and tiles of up to tile columns.
+ */
+
+typedef struct {
+
+    int threads;
+    REAL *V, *T, *w;
+    REAL **P_packed, **Q_packed, **W;
+
+} QR_workspace;
+
+static void workspace_free(QR_workspace *work) {
+
+    for (int t = 0; work->P_packed && work->Q_packed && work->W && t < work->threads; t++) {
+	free(work->P_packed[t]);
+	free(work->Q_packed[t]);
+	free(work->W[t]);
+    }
+
+    free(work->P_packed);
+    free(work->Q_packed);
+    free(work->W);
+    free(work->V);
+    free(work->T);
+    free(work->w);
+
+}
+
+static int workspace_allocate(QR_workspace *work, index_t m, index_t tile, int parallel) {
+
+    int threads = parallel ? omp_get_max_threads() : 1;
+    index_t width = tile > QR_BLOCK ? tile : QR_BLOCK;
+
+    work->threads = threads;
+    work->V = malloc((size_t) m * QR_BLOCK * sizeof(REAL));
+    work->T = malloc(QR_BLOCK * QR_BLOCK * sizeof(REAL));
+    work->w = malloc(width * sizeof(REAL));
+    work->P_packed = calloc(threads, sizeof(REAL *));
+    work->Q_packed = calloc(threads, sizeof(REAL *));
+    work->W = calloc(threads, sizeof(REAL *));
+
+    int failed = !work->V || !work->T || !work->w || !work->P_packed || !work->Q_packed || !work->W;
+
+    for (int t = 0; t < threads && !failed; t++) {
+	work->P_packed[t] = aligned_buffer(sizeof(REAL) * GEMM_P_BUFFER_SIZE(m, m));
+	work->Q_packed[t] = aligned_buffer(sizeof(REAL) * GEMM_Q_BUFFER_SIZE(width, m));
+	work->W[t] = malloc((size_t) QR_BLOCK * width * sizeof(REAL));
+	failed = !work->P_packed[t] || !work->Q_packed[t] || !work->W[t];
+    }
+
+    if (failed) {
+	workspace_free(work);
+	return -1;
+    }
+
+    return 0;
+
+}
+
+/**
+ * @brief Factors the m x n matrix A in place as A = Q R with a blocked Householder QR.
+ *
+ * On return, R is stored on and above the diagonal of A and the Householder vectors
+ * v_k below it (v_k[k] = 1 is implied), with Q = H_0 H_1 ... H_{s-1}, H_k = I - tau[k] v_k v_k^T
+ * and s = min(m, n). The panels are factored by one thread; with parallel set, their block
+ * reflectors are applied to tiles of the trailing matrix by all the threads of a single
+ * parallel region.
+ *
+ * @param m Number of rows of A.
+ * @param n Number of columns of A.
+ * @param A Pointer to the matrix, overwritten by R and the vectors.
+ * @param lda Leading dimension of A (must be >= n).
+ * @param tau Pointer to the scalars of the reflectors (size: min(m, n)).
+ * @param parallel 1 to apply the block reflectors on all the OpenMP threads, 0 on the calling thread only.
+ *
+ * @return 0 on success, or -1 on failure due to memory allocation errors.
+ */
+
+int FN(blocked_QR_factorization)(index_t m, index_t n, REAL *A, index_t lda, REAL *tau, int parallel) {
+
+    index_t steps = m < n ? m : n;
+    index_t tile = parallel ? QR_TILE_COLUMNS : n;
+    const simd_kernels *kernels = FN(active_kernels);
+    QR_workspace work;
+
+    if (workspace_allocate(&work, m, tile, parallel)) {
+        fprintf(stderr, "Error: Memory allocation failed for the workspace of blocked_QR_factorization.\n");
+        return -1;
+    }
+
+#pragma omp parallel num_threads(work.threads)
+    for (index_t k = 0; k < steps; k += QR_BLOCK) {
+
+	index_t nb = steps - k < QR_BLOCK ? steps - k : QR_BLOCK;
+	index_t right = k + nb, width = n - right;
+	REAL *A_k = A + (size_t) k * lda + k;
+
+#pragma omp single
+	{
+	    int t = omp_get_thread_num();
+
+	    factor_panel(m - k, nb, A_k, lda, tau + k, work.w);
+	    if (width > 0)
+		form_block_reflector(m - k, nb, A_k, lda, tau + k, work.V, work.T, work.P_packed[t], work.Q_packed[t]);
+	}
+
+#pragma omp for schedule(static)
+	for (index_t j = right; j < n; j += tile) {
+	    int t = omp_get_thread_num();
+	    index_t columns = n - j < tile ? n - j : tile;
+
+	    FN(apply_block_reflector)(OP_TRANSPOSE, m - k, columns, nb, work.V, work.T, A + (size_t) k * lda + j, lda,
+				      work.W[t], work.P_packed[t], work.Q_packed[t], kernels);
+	}
+
+    }
+
+    workspace_free(&work);
+
+    return 0;
+
+}
+
+/*
+ * B = Q B (transpose OP_NO_TRANSPOSE) or B = Q^T B (OP_TRANSPOSE) for the m x n block B and the
+ * product Q = H_0 ... H_{k-1} of the k reflectors of blocked_QR_factorization stored in A. Few
+ * columns (vectors) get the reflectors one by one, which reads each vector once per reflector;
+ * the others get block reflectors, applied to tiles of columns of B by the threads of a single
+ * parallel region with parallel set. With forming set, B is [I; 0] (forming Q): block reflector
+ * b only changes the columns from its first one, the others are still [I; 0] in its rows.
+ */
+
+static int apply_reflectors(int transpose, index_t m, index_t n, index_t k, const REAL *A, index_t lda,
+			    const REAL *tau, REAL *B, index_t ldb, int forming, int parallel) {
+
+    if (n < QR_APPLY_COLUMNS && !forming) {
+	REAL *w = malloc(n * sizeof(REAL));
+
+	if (!w) return -1;
+
+	for (index_t step = 0; step < k; step++) {
+	    index_t j = transpose == OP_TRANSPOSE ? step : k - 1 - step;
+	    REAL *B_j = B + (size_t) j * ldb;
+
+	    if (tau[j] == 0.0) continue;
+
+	    for (index_t c = 0; c < n; c++)
+		w[c] = B_j[c];
+	    for (index_t i = j + 1; i < m; i++) {
+		REAL v = A[(size_t) i * lda + j];
+		const REAL *row = B + (size_t) i * ldb;
+		for (index_t c = 0; c < n; c++)
+		    w[c] += v * row[c];
+	    }
+
+	    for (index_t c = 0; c < n; c++)
+		B_j[c] -= tau[j] * w[c];
+	    for (index_t i = j + 1; i < m; i++) {
+		REAL scale = tau[j] * A[(size_t) i * lda + j];
+		REAL *row = B + (size_t) i * ldb;
+		for (index_t c = 0; c < n; c++)
+		    row[c] -= scale * w[c];
+	    }
+	}
+
+	free(w);
+	return 0;
+    }
+
+    index_t tile = parallel ? QR_TILE_COLUMNS : n;
+    index_t blocks = (k + QR_BLOCK - 1) / QR_BLOCK;
+    const simd_kernels *kernels = FN(active_kernels);
+    QR_workspace work;
+
+    if (workspace_allocate(&work, m, tile, parallel)) return -1;
+
+    // Q^T = H_{k-1} ... H_0 takes the block reflectors from the first, Q from the last
+#pragma omp parallel num_threads(work.threads)
+    for (index_t b = 0; b < blocks; b++) {
+
+	index_t start = (transpose == OP_TRANSPOSE ? b : blocks - 1 - b) * QR_BLOCK;
+	index_t nb = k - start < QR_BLOCK ? k - start : QR_BLOCK;
+
+#pragma omp single
+	form_block_reflector(m - start, nb, A + (size_t) start * lda + start, lda, tau + start, work.V, work.T,
+			     work.P_packed[omp_get_thread_num()], work.Q_packed[omp_get_thread_num()]);
+
+#pragma omp for schedule(static)
+	for (index_t j = forming ? start : 0; j < n; j += tile) {
+	    int t = omp_get_thread_num();
+	    index_t columns = n - j < tile ? n - j : tile;
+
+	    FN(apply_block_reflector)(transpose, m - start, columns, nb, work.V, work.T, B + (size_t) start * ldb + j, ldb,
+				      work.W[t], work.P_packed[t], work.Q_packed[t], kernels);
+	}
+
+    }
+
+    workspace_free(&work);
+
+    return 0;
+
+}
+
+/**
+ * @brief Forms the m x n matrix Q with orthonormal columns from the output of blocked_QR_factorization (n <= m).
+ *
+ * Q = H_0 H_1 ... H_{n-1} [I; 0] is built from the last block reflector to the first, each
+ * one applied to the columns it changes only. A and Q must not overlap.
+ *
+ * @param m Number of rows of A and Q.
+ * @param n Number of columns of Q (number of reflectors).
+ * @param A Pointer to the factored matrix (vectors below the diagonal).
+ * @param lda Leading dimension of A (must be >= n).
+ * @param tau Pointer to the scalars of the reflectors (size: n).
+ * @param Q Pointer to the output matrix.
+ * @param ldq Leading dimension of Q (must be >= n).
+ * @param parallel 1 to apply the block reflectors on all the OpenMP threads, 0 on the calling thread only.
+ *
+ * @return 0 on success, or -1 on failure due to memory allocation errors.
+ */
+
+int FN(blocked_QR_form_Q)(index_t m, index_t n, const REAL *A, index_t lda, const REAL *tau, REAL *Q, index_t ldq,
+			  int parallel) {
+
+    for (index_t i = 0; i < m; i++)
+	for (index_t j = 0; j < n; j++)
+	    Q[(size_t) i * ldq + j] = i == j ? 1.0 : 0.0;
+
+    if (apply_reflectors(OP_NO_TRANSPOSE, m, n, n, A, lda, tau, Q, ldq, 1, parallel)) {
+        fprintf(stderr, "Error: Memory allocation failed for the workspace of blocked_QR_form_Q.\n");
+        return -1;
+    }
+
+    return 0;
+
+}
+
+/**
+ * @brief Multiplies the m x n block B by Q or Q^T from the k reflectors of blocked_QR_factorization.
+ *
+ * B = Q B with transpose OP_NO_TRANSPOSE, B = Q^T B with OP_TRANSPOSE, Q = H_0 ... H_{k-1}
+ * (k <= m). A and B must not overlap.
+ *
+ * @param transpose OP_NO_TRANSPOSE or OP_TRANSPOSE.
+ * @param m Number of rows of A and B.
+ * @param n Number of columns of B.
+ * @param k Number of reflectors.
+ * @param A Pointer to the factored matrix (vectors below the diagonal of its first k columns).
+ * @param lda Leading dimension of A (must be >= k).
+ * @param tau Pointer to the scalars of the reflectors (size: k).
+ * @param B Pointer to the block, overwritten by the product.
+ * @param ldb Leading dimension of B (must be >= n).
+ * @param parallel 1 to apply the block reflectors on all the OpenMP threads, 0 on the calling thread only.
+ *
+ * @return 0 on success, or -1 on failure due to memory allocation errors.
+ */
+
+int FN(blocked_QR_apply_Q)(int transpose, index_t m, index_t n, index_t k, const REAL *A, index_t lda, const REAL *tau,
+			   REAL *B, index_t ldb, int parallel) {
+
+    if (apply_reflectors(transpose, m, n, k, A, lda, tau, B, ldb, 0, parallel)) {
+        fprintf(stderr, "Error: Memory allocation failed for the workspace of blocked_QR_apply_Q.\n");
+        return -1;
+    }
+
+    return 0;
+
+}
+
 /**
  * @brief Allocates and initializes a QR decomposition structure.
  *
@@ -15,10 +474,10 @@
  *         or NULL on failure due to invalid dimensions or memory allocation errors.
  */
 
-QR *create_QR(double *A, int rows, int columns) {
+FN(QR) *FN(create_QR)(REAL *A, index_t rows, index_t columns) {
 
     if (rows <= 0 || columns <= 0) {
-        fprintf(stderr, "Error: Invalid dimensions for QR decomposition (rows=%d, columns=%d). Both must be strictly positive.\n", rows, columns);
+        fprintf(stderr, "Error: Invalid dimensions for QR decomposition (rows=%" PRId64 ", columns=%" PRId64 "). Both must be strictly positive.\n", rows, columns);
         return NULL;
     }
 
@@ -27,7 +486,7 @@ QR *create_QR(double *A, int rows, int columns) {
         return NULL;
     }
 
-    QR *QR_decomposition = malloc(sizeof(QR));
+    FN(QR) *QR_decomposition = malloc(sizeof(FN(QR)));
 
     if (!QR_decomposition) {
         fprintf(stderr, "Error: Memory allocation failed for QR structure.\n");
@@ -37,9 +496,9 @@ QR *create_QR(double *A, int rows, int columns) {
     QR_decomposition->rows = rows;
     QR_decomposition->columns = columns;
 
-    QR_decomposition->A = malloc(rows * columns * sizeof(double));
-    QR_decomposition->Q = malloc(rows * columns * sizeof(double));
-    QR_decomposition->R = calloc(columns * columns, sizeof(double));
+    QR_decomposition->A = malloc(rows * columns * sizeof(REAL));
+    QR_decomposition->Q = malloc(rows * columns * sizeof(REAL));
+    QR_decomposition->R = calloc(columns * columns, sizeof(REAL));
 
     if (!QR_decomposition->A || !QR_decomposition->Q || !QR_decomposition->R) {
         fprintf(stderr, "Error: Memory allocation failed for matrices in create_QR.\n");
@@ -50,148 +509,797 @@ QR *create_QR(double *A, int rows, int columns) {
         return NULL;
     }
 
-    memcpy(QR_decomposition->A, A, rows * columns * sizeof(double));
+    memcpy(QR_decomposition->A, A, rows * columns * sizeof(REAL));
     
     return QR_decomposition;
 
 }
 
+/*
+ * Shared body of QR_decomposition and QR_decomposition_parallel: factors a copy of A, copies
+ * R out of it and forms Q. The signs are chosen so that R has a nonnegative diagonal, the
+ * factorization Gram-Schmidt computes when the columns are independent.
+ */
+
+static FN(QR) *QR_decomposition_blocked(REAL *A, index_t rows, index_t columns, int parallel, const char *name) {
+
+    if (rows < columns) {
+        fprintf(stderr, "Error: %s requires at least as many rows as columns (rows=%" PRId64 ", columns=%" PRId64 ").\n",
+		name, rows, columns);
+        return NULL;
+    }
+
+    FN(QR) *QR_decomposition = FN(create_QR)(A, rows, columns);
+
+    if (!QR_decomposition) {
+        fprintf(stderr, "Error: Failed to create QR decomposition structure in %s.\n", name);
+        return NULL;
+    }
+
+    REAL *factor = malloc((size_t) rows * columns * sizeof(REAL));
+    REAL *tau = malloc(columns * sizeof(REAL));
+
+    if (!factor || !tau) {
+        fprintf(stderr, "Error: Memory allocation failed for the Householder vectors in %s.\n", name);
+        free(factor);
+        free(tau);
+        FN(QR_free)(QR_decomposition);
+        return NULL;
+    }
+
+    memcpy(factor, A, (size_t) rows * columns * sizeof(REAL));
+
+    int status = FN(blocked_QR_factorization)(rows, columns, factor, columns, tau, parallel);
+
+    if (!status) {
+	for (index_t i = 0; i < columns; i++)
+	    memcpy(QR_decomposition->R + (size_t) i * columns + i, factor + (size_t) i * columns + i,
+		   (columns - i) * sizeof(REAL));
+
+	status = FN(blocked_QR_form_Q)(rows, columns, factor, columns, tau, QR_decomposition->Q, columns, parallel);
+    }
+
+    free(factor);
+    free(tau);
+
+    if (status) {
+        FN(QR_free)(QR_decomposition);
+        return NULL;
+    }
+
+    for (index_t k = 0; k < columns; k++) {
+	if (QR_decomposition->R[k * columns + k] >= 0.0) continue;
+	for (index_t j = k; j < columns; j++)
+	    QR_decomposition->R[k * columns + j] = -QR_decomposition->R[k * columns + j];
+	for (index_t i = 0; i < rows; i++)
+	    QR_decomposition->Q[i * columns + k] = -QR_decomposition->Q[i * columns + k];
+    }
+
+    return QR_decomposition;
+
+}
+
 /**
- * @brief Performs QR decomposition on a given matrix using the Modified Gram-Schmidt method.
+ * @brief Performs QR decomposition on a given matrix using a blocked Householder QR.
  *
- * This function decomposes a matrix A into an orthogonal matrix Q
- * and an upper triangular matrix R such that A = Q * R.
+ * This function decomposes a matrix A into a matrix Q with orthonormal columns
+ * and an upper triangular matrix R with a nonnegative diagonal such that A = Q * R.
+ * Householder reflectors keep Q orthogonal to working precision; dependent columns
+ * give zeros on the diagonal of R instead of an error.
  *
  * @param A Pointer to the input matrix (size: rows x columns).
  * @param rows Number of rows in the matrix (must be positive).
- * @param columns Number of columns in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive and at most rows).
  *
  * @return Pointer to the QR structure containing Q and R matrices on success,
- *         or NULL on failure due to invalid dimensions, singular columns, or memory allocation errors.
+ *         or NULL on failure due to invalid dimensions or memory allocation errors.
  */
 
-QR *QR_decomposition(double *A, int rows, int columns) {
-    
-    QR *QR_decomposition = create_QR(A, rows, columns);
+FN(QR) *FN(QR_decomposition)(REAL *A, index_t rows, index_t columns) {
 
-    if (!QR_decomposition) {
-        fprintf(stderr, "Error: Failed to create QR decomposition structure.\n");
+    return QR_decomposition_blocked(A, rows, columns, 0, "QR_decomposition");
+
+}
+
+/**
+ * @brief Performs parallelized QR decomposition on a given matrix using OpenMP.
+ *
+ * This function decomposes a matrix A into a matrix Q with orthonormal columns
+ * and an upper triangular matrix R with a nonnegative diagonal such that A = Q * R.
+ * Each block reflector is applied to tiles of columns by all the threads of a single
+ * parallel region.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive and at most rows).
+ *
+ * @return Pointer to the QR structure containing Q and R matrices on success,
+ *         or NULL on failure due to invalid dimensions or memory allocation errors.
+ */
+
+FN(QR) *FN(QR_decomposition_parallel)(REAL *A, index_t rows, index_t columns) {
+
+    return QR_decomposition_blocked(A, rows, columns, 1, "QR_decomposition_parallel");
+
+}
+
+/*
+ * Shared body of QR_factorization_into and QR_factorization_parallel_into.
+ */
+
+static int QR_factorization_compact(REAL *A, index_t rows, index_t columns, REAL *QR, REAL *tau, int parallel,
+				    const char *name) {
+
+    if (rows <= 0 || columns <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions for QR factorization (rows=%" PRId64 ", columns=%" PRId64 "). Both must be strictly positive.\n", rows, columns);
+        return -1;
+    }
+
+    if (!A || !QR || !tau) {
+        fprintf(stderr, "Error: Null pointer detected in %s.\n", name);
+        return -1;
+    }
+
+    if (QR != A && ranges_overlap(QR, (size_t) rows * columns, A, (size_t) rows * columns)) {
+        fprintf(stderr, "Error: Output matrix partially overlaps the input matrix in %s.\n", name);
+        return -1;
+    }
+
+    if (QR != A)
+        memcpy(QR, A, (size_t) rows * columns * sizeof(REAL));
+
+    return FN(blocked_QR_factorization)(rows, columns, QR, columns, tau, parallel);
+
+}
+
+/**
+ * @brief Performs QR decomposition into a single caller-provided matrix, with Q kept implicit.
+ *
+ * This function computes A = Q R with the blocked Householder QR of QR_decomposition, in the
+ * compact storage of LAPACK: R is stored on and above the diagonal of QR and the Householder
+ * vectors v_j below it, with v_j[j] = 1 implied, so that Q = H_0 ... H_{s-1} with
+ * H_j = I - tau[j] v_j v_j^T and s = min(rows, columns). Q is never formed: QR_factored_apply_Q
+ * multiplies by Q or Q^T and QR_factored_form_Q forms it on request. QR may be A, which is
+ * then factored in place. The diagonal of R is not made nonnegative.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive).
+ * @param QR Pointer to the output factors (size: rows x columns), may be A.
+ * @param tau Pointer to the scalars of the reflectors (size: min(rows, columns)).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         partially overlapping output or memory allocation errors.
+ */
+
+int FN(QR_factorization_into)(REAL *A, index_t rows, index_t columns, REAL *QR, REAL *tau) {
+
+    return QR_factorization_compact(A, rows, columns, QR, tau, 0, "QR_factorization_into");
+
+}
+
+/**
+ * @brief Performs parallelized QR decomposition into a single caller-provided matrix using OpenMP.
+ *
+ * Same as QR_factorization_into, with the block reflectors applied by all the threads
+ * as in QR_decomposition_parallel.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive).
+ * @param QR Pointer to the output factors (size: rows x columns), may be A.
+ * @param tau Pointer to the scalars of the reflectors (size: min(rows, columns)).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         partially overlapping output or memory allocation errors.
+ */
+
+int FN(QR_factorization_parallel_into)(REAL *A, index_t rows, index_t columns, REAL *QR, REAL *tau) {
+
+    return QR_factorization_compact(A, rows, columns, QR, tau, 1, "QR_factorization_parallel_into");
+
+}
+
+/**
+ * @brief Multiplies a block by Q or Q^T from the compact QR factors of A.
+ *
+ * @param QR Pointer to the factors returned by QR_factorization_into (size: rows x columns).
+ * @param tau Pointer to the scalars returned by QR_factorization_into (size: min(rows, columns)).
+ * @param rows Number of rows of A (must be positive).
+ * @param columns Number of columns of A (must be positive).
+ * @param transpose OP_NO_TRANSPOSE for Q B, OP_TRANSPOSE for Q^T B.
+ * @param B Pointer to the block (size: rows x k), a vector when k is 1.
+ * @param k Number of columns of B (must be positive).
+ *
+ * @return Pointer to the product (size: rows x k) on success, or NULL on failure due to
+ *         invalid arguments or memory allocation errors.
+ */
+
+REAL *FN(QR_factored_apply_Q)(const REAL *QR, const REAL *tau, index_t rows, index_t columns, int transpose,
+			      REAL *B, index_t k) {
+
+    if (rows <= 0 || k <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions for QR_factored_apply_Q (rows=%" PRId64 ", k=%" PRId64 "). Both must be strictly positive.\n", rows, k);
         return NULL;
     }
 
-    double val;
-    double epsilon = 1e-10;
-    
-    for (int k = 0; k < columns; k++) {
-
-	double s = 0.0;
-
-	for (int j = 0; j < rows; j++) {
-	    val = QR_decomposition->A[j * columns + k];
-	    s += val * val;
-	}
-	
-	if (s < epsilon) { 
-            fprintf(stderr, "Error: Column %d is singular or zero during QR decomposition and s = %lf.\n", k, s);
-            QR_free(QR_decomposition);
-            return NULL;
-        }
-	
-	QR_decomposition->R[k * columns + k] = sqrt(s);
-	
-	for (int j = 0; j < rows; j++) {
-	    QR_decomposition->Q[j * columns + k] = QR_decomposition->A[j * columns + k] / QR_decomposition->R[k * columns + k];
-	}
-	
-	for (int i = k + 1; i < columns; i++) {
-	    s = 0.0;
-	    for (int j = 0; j < rows; j++) {
-		s += QR_decomposition->A[j * columns + i] * QR_decomposition->Q[j * columns + k];
-	    }
-	    QR_decomposition->R[k * columns + i] = s;
-	    for (int j = 0; j < rows; j++) {
-		QR_decomposition->A[j * columns + i] = QR_decomposition->A[j * columns + i] - QR_decomposition->R[k * columns + i] * QR_decomposition->Q[j * columns + k];
-	    }
+    REAL *C = malloc((size_t) rows * k * sizeof(REAL));
+
+    if (!C) {
+        fprintf(stderr, "Error: Memory allocation failed for the product in QR_factored_apply_Q.\n");
+        return NULL;
+    }
+
+    if (FN(QR_factored_apply_Q_into)(QR, tau, rows, columns, transpose, B, k, C)) {
+        free(C);
+        return NULL;
+    }
+
+    return C;
+
+}
+
+/**
+ * @brief Multiplies a block by Q or Q^T from the compact QR factors of A into a caller-provided block.
+ *
+ * Q is the full rows x rows orthogonal matrix H_0 ... H_{s-1}: Q^T b gives the coordinates
+ * of b on the columns of A in its first min(rows, columns) elements and the rest of b in
+ * the others (the least-squares residual), and Q x with x zero after its first columns
+ * elements gives the product by the thin Q. Q is never formed: a vector costs 4 rows columns
+ * FLOPs instead of the 2 rows columns^2 of forming Q. Blocks of many columns are multiplied
+ * by block reflectors, tiles of columns on all the threads. C may be B (in place).
+ *
+ * @param QR Pointer to the factors returned by QR_factorization_into (size: rows x columns).
+ * @param tau Pointer to the scalars returned by QR_factorization_into (size: min(rows, columns)).
+ * @param rows Number of rows of A (must be positive).
+ * @param columns Number of columns of A (must be positive).
+ * @param transpose OP_NO_TRANSPOSE for Q B, OP_TRANSPOSE for Q^T B.
+ * @param B Pointer to the block (size: rows x k), a vector when k is 1.
+ * @param k Number of columns of B (must be positive).
+ * @param C Pointer to the product (size: rows x k), may be B.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         an unknown operation, partially overlapping output or memory allocation errors.
+ */
+
+int FN(QR_factored_apply_Q_into)(const REAL *QR, const REAL *tau, index_t rows, index_t columns, int transpose,
+				 REAL *B, index_t k, REAL *C) {
+
+    if (rows <= 0 || columns <= 0 || k <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions for QR_factored_apply_Q_into (rows=%" PRId64 ", columns=%" PRId64 ", k=%" PRId64 "). All must be strictly positive.\n",
+		rows, columns, k);
+        return -1;
+    }
+
+    if (!QR || !tau || !B || !C) {
+        fprintf(stderr, "Error: Null pointer detected in QR_factored_apply_Q_into.\n");
+        return -1;
+    }
+
+    if (transpose != OP_NO_TRANSPOSE && transpose != OP_TRANSPOSE) {
+        fprintf(stderr, "Error: Unknown operation (%d) in QR_factored_apply_Q_into.\n", transpose);
+        return -1;
+    }
+
+    size_t size = (size_t) rows * k;
+
+    if (C != B && ranges_overlap(C, size, B, size)) {
+        fprintf(stderr, "Error: Output block partially overlaps the input block in QR_factored_apply_Q_into.\n");
+        return -1;
+    }
+
+    if (ranges_overlap(C, size, QR, (size_t) rows * columns)) {
+        fprintf(stderr, "Error: Output block overlaps the factors in QR_factored_apply_Q_into.\n");
+        return -1;
+    }
+
+    if (C != B)
+        memcpy(C, B, size * sizeof(REAL));
+
+    index_t steps = rows < columns ? rows : columns;
+
+    if (apply_reflectors(transpose, rows, k, steps, QR, columns, tau, C, k, 0, k > QR_TILE_COLUMNS)) {
+        fprintf(stderr, "Error: Memory allocation failed for the workspace of QR_factored_apply_Q_into.\n");
+        return -1;
+    }
+
+    return 0;
+
+}
+
+/**
+ * @brief Forms the thin Q explicitly from the compact QR factors of A.
+ *
+ * @param QR Pointer to the factors returned by QR_factorization_into (size: rows x columns).
+ * @param tau Pointer to the scalars returned by QR_factorization_into (size: min(rows, columns)).
+ * @param rows Number of rows of A (must be positive).
+ * @param columns Number of columns of A (must be positive).
+ *
+ * @return Pointer to Q (size: rows x min(rows, columns)) on success, or NULL on failure due to
+ *         invalid arguments or memory allocation errors.
+ */
+
+REAL *FN(QR_factored_form_Q)(const REAL *QR, const REAL *tau, index_t rows, index_t columns) {
+
+    if (rows <= 0 || columns <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions for QR_factored_form_Q (rows=%" PRId64 ", columns=%" PRId64 "). Both must be strictly positive.\n", rows, columns);
+        return NULL;
+    }
+
+    index_t steps = rows < columns ? rows : columns;
+    REAL *Q = malloc((size_t) rows * steps * sizeof(REAL));
+
+    if (!Q) {
+        fprintf(stderr, "Error: Memory allocation failed for Q in QR_factored_form_Q.\n");
+        return NULL;
+    }
+
+    if (FN(QR_factored_form_Q_into)(QR, tau, rows, columns, Q)) {
+        free(Q);
+        return NULL;
+    }
+
+    return Q;
+
+}
+
+/**
+ * @brief Forms the thin Q explicitly from the compact QR factors of A into a caller-provided matrix.
+ *
+ * Q = H_0 ... H_{s-1} [I; 0] with s = min(rows, columns), built by block reflectors on all the
+ * threads (2 rows s^2 - 2 s^3 / 3 FLOPs). Only needed when Q itself is wanted:
+ * QR_factored_apply_Q multiplies by Q without it.
+ *
+ * @param QR Pointer to the factors returned by QR_factorization_into (size: rows x columns).
+ * @param tau Pointer to the scalars returned by QR_factorization_into (size: min(rows, columns)).
+ * @param rows Number of rows of A (must be positive).
+ * @param columns Number of columns of A (must be positive).
+ * @param Q Pointer to the output matrix (size: rows x min(rows, columns)), must not overlap QR.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         overlapping output or memory allocation errors.
+ */
+
+int FN(QR_factored_form_Q_into)(const REAL *QR, const REAL *tau, index_t rows, index_t columns, REAL *Q) {
+
+    if (rows <= 0 || columns <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions for QR_factored_form_Q_into (rows=%" PRId64 ", columns=%" PRId64 "). Both must be strictly positive.\n", rows, columns);
+        return -1;
+    }
+
+    if (!QR || !tau || !Q) {
+        fprintf(stderr, "Error: Null pointer detected in QR_factored_form_Q_into.\n");
+        return -1;
+    }
+
+    index_t steps = rows < columns ? rows : columns;
+
+    if (ranges_overlap(Q, (size_t) rows * steps, QR, (size_t) rows * columns)) {
+        fprintf(stderr, "Error: Output matrix overlaps the factors in QR_factored_form_Q_into.\n");
+        return -1;
+    }
+
+    return FN(blocked_QR_form_Q)(rows, steps, QR, columns, tau, Q, steps, 1);
+
+}
+
+/*
+ * TSQR (tall-skinny QR) reads A once. Its rows are cut in chunks of about
+ * TSQR_CHUNK_VALUES values, which stay in cache while they are factored, and
+ * each thread takes a contiguous range of chunks:
+ * 1. the first chunk of a thread gets a Householder QR, the next ones are
+ *    stacked under the R of the thread, [R; A_c] = Q_c R', a QR that keeps the
+ *    structure of R (its reflectors are e_j over a column of the chunk). These
+ *    chunks are transposed first, so that their columns are contiguous, and
+ *    factored recursively with most of the work in the GEMM engine,
+ * 2. the R of the threads are then reduced pairwise along a binary tree, with
+ *    the same stacked QR.
+ * The root holds R. The reflectors, left in the chunks and in the R of the
+ * tree, are Q in implicit form: the explicit Q is formed on request by applying
+ * them back from the root to the leaves, each chunk once more.
+ */
+
+/**
+ * @brief Values of A per chunk of rows factored in cache by TSQR.
+ */
+
+#define TSQR_CHUNK_VALUES 65536
+
+/**
+ * @brief Columns under which the stacked QR of TSQR runs column by column.
+ */
+
+#define TSQR_BASE 32
+
+/*
+ * Householder QR of [R; B], R n x n upper triangular and B m x n given by its transpose B^T,
+ * column by column (see factor_stacked): each column of B is a contiguous row of B^T.
+ */
+
+static void factor_stacked_columns(index_t m, index_t n, REAL *R, index_t ldr, REAL *B_t, index_t ldb, REAL *tau,
+				   const simd_kernels *kernels) {
+
+    for (index_t j = 0; j < n; j++) {
+	REAL *R_j = R + (size_t) j * ldr + j, *v = B_t + (size_t) j * ldb;
+	REAL norm = kernels->dot(v, v, m);
+
+	tau[j] = 0.0;
+
+	if (norm == 0.0) continue;
+
+	REAL alpha = R_j[0];
+	REAL beta = -copysign(sqrt(alpha * alpha + norm), alpha);
+	REAL inverse = 1.0 / (alpha - beta);
+
+	for (index_t i = 0; i < m; i++)
+	    v[i] *= inverse;
+
+	R_j[0] = beta;
+	tau[j] = (beta - alpha) / beta;
+
+	for (index_t c = 1; c < n - j; c++) {
+	    REAL *column = v + (size_t) c * ldb;
+	    REAL w = tau[j] * (R_j[c] + kernels->dot(v, column, m));
+	    R_j[c] -= w;
+	    kernels->axpy(-w, v, column, m);
+	}
+    }
+
+}
+
+/*
+ * Householder QR of [R; B], R n x n upper triangular and B m x n given by its transpose B^T
+ * (n x m), so that the columns of B are contiguous: R receives the new R and B^T the lower parts
+ * of the reflectors, whose upper parts are the columns of the identity. The columns are split in
+ * two halves: once the left one is factored, its reflectors [I; V] reach the right one in compact
+ * WY form, C - [I; V] T^T [I; V]^T C, through the GEMM engine. T and W hold n x n values.
+ */
+
+static void factor_stacked(index_t m, index_t n, REAL *R, index_t ldr, REAL *B_t, index_t ldb, REAL *tau, REAL *T,
+			   REAL *W, REAL *P_packed, REAL *Q_packed, const simd_kernels *kernels) {
+
+    if (n <= TSQR_BASE) {
+	factor_stacked_columns(m, n, R, ldr, B_t, ldb, tau, kernels);
+	return;
+    }
+
+    index_t n1 = n / 2, n2 = n - n1;
+    REAL *R12 = R + n1, *B2_t = B_t + (size_t) n1 * ldb;
+
+    factor_stacked(m, n1, R, ldr, B_t, ldb, tau, T, W, P_packed, Q_packed, kernels);
+
+    FN(blocked_general_product_packed)(OP_NO_TRANSPOSE, OP_TRANSPOSE, n1, n1, m, 1.0, B_t, ldb, B_t, ldb, 0.0, T, n1,
+				       P_packed, Q_packed);
+
+    triangular_factor(n1, tau, T);
+
+    // W = R12 + V^T B2, then W = T^T W (rows in decreasing order)
+    for (index_t i = 0; i < n1; i++)
+	memcpy(W + i * n2, R12 + (size_t) i * ldr, n2 * sizeof(REAL));
+
+    FN(blocked_general_product_packed)(OP_NO_TRANSPOSE, OP_TRANSPOSE, n1, n2, m, 1.0, B_t, ldb, B2_t, ldb, 1.0, W, n2,
+				       P_packed, Q_packed);
+
+    for (index_t i = n1 - 1; i >= 0; i--) {
+	REAL *W_i = W + i * n2;
+	for (index_t j = 0; j < n2; j++)
+	    W_i[j] *= T[i * n1 + i];
+	for (index_t p = 0; p < i; p++)
+	    kernels->axpy(T[p * n1 + i], W + p * n2, W_i, n2);
+    }
+
+    // R12 -= W and B2^T -= W^T V^T
+    for (index_t i = 0; i < n1; i++)
+	kernels->axpy(-1.0, W + i * n2, R12 + (size_t) i * ldr, n2);
+
+    FN(blocked_general_product_packed)(OP_TRANSPOSE, OP_NO_TRANSPOSE, n2, m, n1, -1.0, W, n2, B_t, ldb, 1.0, B2_t, ldb,
+				       P_packed, Q_packed);
+
+    factor_stacked(m, n2, R + (size_t) n1 * ldr + n1, ldr, B2_t, ldb, tau + n1, T, W, P_packed, Q_packed, kernels);
+
+}
+
+/*
+ * [X; Y] = H_0 ... H_{n-1} [X; 0] for the reflectors of factor_stacked, whose lower parts are
+ * in V^T (n x m): X (n x n) is updated in place and Y (m x n, distinct from V^T) is written.
+ * The reflectors are [I; V] in compact WY form, I - [I; V] T [I; V]^T, so with W = T X the
+ * result is [X - W; -V W], two products by the GEMM engine. T and W hold n x n values.
+ */
+
+static void apply_stacked(index_t m, index_t n, const REAL *V_t, index_t ldv, const REAL *tau, REAL *X, index_t ldx,
+			  REAL *Y, index_t ldy, REAL *T, REAL *W, REAL *P_packed, REAL *Q_packed) {
+
+    // The identity on top of V does not change G above the diagonal, the only part read
+    FN(blocked_general_product_packed)(OP_NO_TRANSPOSE, OP_TRANSPOSE, n, n, m, 1.0, V_t, ldv, V_t, ldv, 0.0, T, n,
+				       P_packed, Q_packed);
+
+    triangular_factor(n, tau, T);
+
+    FN(blocked_general_product_packed)(OP_NO_TRANSPOSE, OP_NO_TRANSPOSE, n, n, n, 1.0, T, n, X, ldx, 0.0, W, n,
+				       P_packed, Q_packed);
+
+    for (index_t i = 0; i < n; i++)
+	for (index_t c = 0; c < n; c++)
+	    X[(size_t) i * ldx + c] -= W[i * n + c];
+
+    FN(blocked_general_product_packed)(OP_TRANSPOSE, OP_NO_TRANSPOSE, m, n, n, -1.0, V_t, ldv, W, n, 0.0, Y, ldy,
+				       P_packed, Q_packed);
+
+}
+
+/*
+ * C = H_0 ... H_{n-1} [X; 0] (m x n) for the reflectors of factor_panel, stored below the
+ * diagonal of V (m x n, distinct from C).
+ */
+
+static void apply_panel(index_t m, index_t n, const REAL *V, index_t ldv, const REAL *tau, const REAL *X, index_t ldx,
+			REAL *C, index_t ldc, REAL *w) {
+
+    for (index_t i = 0; i < m; i++)
+	for (index_t c = 0; c < n; c++)
+	    C[(size_t) i * ldc + c] = i < n ? X[(size_t) i * ldx + c] : 0.0;
+
+    for (index_t j = n - 1; j >= 0; j--) {
+	if (tau[j] == 0.0) continue;
+
+	REAL *C_j = C + (size_t) j * ldc;
+
+	for (index_t c = 0; c < n; c++)
+	    w[c] = C_j[c];
+	for (index_t i = j + 1; i < m; i++) {
+	    REAL v = V[(size_t) i * ldv + j];
+	    const REAL *row = C + (size_t) i * ldc;
+	    for (index_t c = 0; c < n; c++)
+		w[c] += v * row[c];
+	}
+
+	for (index_t c = 0; c < n; c++)
+	    C_j[c] -= tau[j] * w[c];
+	for (index_t i = j + 1; i < m; i++) {
+	    REAL scale = tau[j] * V[(size_t) i * ldv + j];
+	    REAL *row = C + (size_t) i * ldc;
+	    for (index_t c = 0; c < n; c++)
+		row[c] -= scale * w[c];
 	}
-	
     }
 
-    return QR_decomposition;
-    
 }
 
 /**
- * @brief Performs parallelized QR decomposition on a given matrix using OpenMP.
+ * @brief Performs the QR decomposition of a tall and skinny matrix with TSQR.
  *
- * This function decomposes a matrix A into an orthogonal matrix Q
- * and an upper triangular matrix R such that A = Q * R. The computation is
- * parallelized using OpenMP for improved performance on large matrices.
+ * This function decomposes a matrix A into a matrix Q with orthonormal columns
+ * and an upper triangular matrix R with a nonnegative diagonal such that A = Q * R,
+ * with the communication-avoiding TSQR: the threads factor chunks of rows in cache,
+ * then reduce their R factors along a binary tree. Meant for rows >> columns.
  *
  * @param A Pointer to the input matrix (size: rows x columns).
  * @param rows Number of rows in the matrix (must be positive).
- * @param columns Number of columns in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive and at most rows).
  *
  * @return Pointer to the QR structure containing Q and R matrices on success,
- *         or NULL on failure due to invalid dimensions, singular columns, or memory allocation errors.
+ *         or NULL on failure due to invalid dimensions or memory allocation errors.
  */
 
-QR *QR_decomposition_parallel(double *A, int rows, int columns) {
-    
-    QR *QR_decomposition = create_QR(A, rows, columns);
+FN(QR) *FN(TSQR_decomposition)(REAL *A, index_t rows, index_t columns) {
+
+    if (rows < columns) {
+        fprintf(stderr, "Error: TSQR_decomposition requires at least as many rows as columns (rows=%" PRId64 ", columns=%" PRId64 ").\n",
+		rows, columns);
+        return NULL;
+    }
+
+    FN(QR) *QR_decomposition = FN(create_QR)(A, rows, columns);
 
     if (!QR_decomposition) {
-        fprintf(stderr, "Error: Failed to create parallelized QR decomposition structure.\n");
+        fprintf(stderr, "Error: Failed to create QR decomposition structure in TSQR_decomposition.\n");
         return NULL;
     }
-    
-    double epsilon = 1e-10; 
-
-    for (int k = 0; k < columns; k++) {
-
-	double s = 0.0;
-
-#pragma omp parallel for reduction(+:s) schedule(static)
-        for (int j = 0; j < rows; j++) {
-	    double val = QR_decomposition->A[j * columns + k];
-            s += val * val;
-        }
-	
-	if (s < epsilon) {
-            fprintf(stderr, "Error: Singular column detected at column %d during QR decomposition.\n", k);
-            QR_free(QR_decomposition);
-            return NULL;
-        }
-	
-        QR_decomposition->R[k * columns + k] = sqrt(s);
-
-#pragma omp parallel for schedule(static)
-        for (int j = 0; j < rows; j++) {
-
-	    if (QR_decomposition->R[k * columns + k] > epsilon) {
-                QR_decomposition->Q[j * columns + k] = QR_decomposition->A[j * columns + k] / QR_decomposition->R[k * columns + k];
-            }
-	    else {
-                QR_decomposition->Q[j * columns + k] = 0.0;
-            }
-
-	}
-	
-        for (int i = k + 1; i < columns; i++) {
-	    s = 0.0;
-#pragma omp parallel for reduction(+:s) schedule(static)
-            for (int j = 0; j < rows; j++) {
-                s += QR_decomposition->A[j * columns + i] * QR_decomposition->Q[j * columns + k];
-            }
-	    QR_decomposition->R[k * columns + i] = s;
-#pragma omp parallel for schedule(static)
-	    for (int j = 0; j < rows; j++) {
-                QR_decomposition->A[j * columns + i] -= QR_decomposition->R[k * columns + i] * QR_decomposition->Q[j * columns + k];
-            }
-        }
-	
+
+    if (FN(TSQR_decomposition_into)(A, rows, columns, QR_decomposition->Q, QR_decomposition->R)) {
+        FN(QR_free)(QR_decomposition);
+        return NULL;
     }
 
     return QR_decomposition;
+
+}
+
+/**
+ * @brief Performs the QR decomposition of a tall and skinny matrix with TSQR, into caller-provided storage.
+ *
+ * A is read once, chunk by chunk, by all the OpenMP threads. Q is formed by a second
+ * pass over its rows only when it is requested: Q may be NULL to compute R alone, which
+ * leaves A untouched and needs no memory proportional to rows. Q may be A (A is then
+ * overwritten by Q), which factors matrices too large to be held twice.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive and at most rows).
+ * @param Q Pointer to the matrix with orthonormal columns (size: rows x columns), or NULL.
+ * @param R Pointer to the upper triangular matrix (size: columns x columns).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         overlapping outputs or memory allocation errors.
+ */
+
+int FN(TSQR_decomposition_into)(REAL *A, index_t rows, index_t columns, REAL *Q, REAL *R) {
+
+    if (!A || !R) {
+        fprintf(stderr, "Error: Null pointer detected in TSQR_decomposition_into.\n");
+        return -1;
+    }
+
+    if (columns <= 0 || rows < columns) {
+        fprintf(stderr, "Error: Invalid dimensions for TSQR_decomposition_into (rows=%" PRId64 ", columns=%" PRId64 "). Need rows >= columns > 0.\n",
+		rows, columns);
+        return -1;
+    }
+
+    index_t n = columns;
+    size_t size = (size_t) rows * n;
+
+    if (ranges_overlap(R, (size_t) n * n, A, size) || (Q && Q != A && ranges_overlap(Q, size, A, size)) ||
+	(Q && ranges_overlap(R, (size_t) n * n, Q, size))) {
+        fprintf(stderr, "Error: Overlapping outputs in TSQR_decomposition_into.\n");
+        return -1;
+    }
+
+    // Chunks of at least n rows (the last one takes the remainder), at least one per thread
+    index_t chunk_rows = TSQR_CHUNK_VALUES / n > n ? TSQR_CHUNK_VALUES / n : n;
+    index_t chunks = rows / chunk_rows > 1 ? rows / chunk_rows : 1;
+    index_t largest = rows - (chunks - 1) * chunk_rows;
+    int threads = omp_get_max_threads() < chunks ? omp_get_max_threads() : (int) chunks;
+    const simd_kernels *kernels = FN(active_kernels);
+
+    // Per thread: R, a chunk, w, the n x n T, W and (for Q) X, and the packing buffers
+    REAL *tau = malloc((size_t) (chunks + threads) * n * sizeof(REAL));
+    REAL *R_thread = malloc((size_t) threads * n * n * sizeof(REAL));
+    REAL *V = malloc((size_t) threads * largest * n * sizeof(REAL));
+    REAL *w = malloc((size_t) threads * n * sizeof(REAL));
+    REAL *X = malloc((size_t) (Q ? 3 : 2) * threads * n * n * sizeof(REAL));
+    REAL **P_packed = calloc(threads, sizeof(REAL *));
+    REAL **Q_packed = calloc(threads, sizeof(REAL *));
+    int failed = !tau || !R_thread || !V || !w || !X || !P_packed || !Q_packed;
+
+    for (int t = 0; t < threads && !failed; t++) {
+	P_packed[t] = aligned_buffer(sizeof(REAL) * GEMM_P_BUFFER_SIZE(largest, largest));
+	Q_packed[t] = aligned_buffer(sizeof(REAL) * GEMM_Q_BUFFER_SIZE(largest, largest));
+	failed = !P_packed[t] || !Q_packed[t];
+    }
+
+    if (failed) {
+        fprintf(stderr, "Error: Memory allocation failed for the workspace of TSQR_decomposition_into.\n");
+	for (int t = 0; P_packed && Q_packed && t < threads; t++) {
+	    free(P_packed[t]);
+	    free(Q_packed[t]);
+	}
+        free(P_packed);
+        free(Q_packed);
+        free(tau);
+        free(R_thread);
+        free(X);
+        free(V);
+        free(w);
+        return -1;
+    }
+
+    REAL *tree_tau = tau + (size_t) chunks * n;
+
+#pragma omp parallel num_threads(threads)
+    {
+	// The team may be smaller than requested (nested regions, dynamic adjustment): the chunks and
+	// the tree follow its real size, the workspace being sized for the request
+	int t = omp_get_thread_num(), team = omp_get_num_threads();
+	index_t first = t * chunks / team, last = (t + 1) * chunks / team;
+	REAL *R_t = R_thread + (size_t) t * n * n, *V_t = V + (size_t) t * largest * n, *w_t = w + (size_t) t * n;
+	REAL *T_t = X + (size_t) t * n * n, *W_t = X + (size_t) (threads + t) * n * n;
+
+	// Leaves: the first chunk of the thread is factored in Q (or in V_t when Q is not wanted) and
+	// the next ones in V_t, transposed, then stored in Q in this layout
+	for (index_t c = first; c < last; c++) {
+	    index_t start = c * chunk_rows, m = (c == chunks - 1 ? rows : start + chunk_rows) - start;
+	    const REAL *A_c = A + (size_t) start * n;
+
+	    if (c > first) {
+		for (index_t i = 0; i < m; i++)
+		    for (index_t j = 0; j < n; j++)
+			V_t[(size_t) j * m + i] = A_c[(size_t) i * n + j];
+
+		factor_stacked(m, n, R_t, n, V_t, m, tau + (size_t) c * n, T_t, W_t, P_packed[t], Q_packed[t], kernels);
+
+		if (Q) memcpy(Q + (size_t) start * n, V_t, (size_t) m * n * sizeof(REAL));
+		continue;
+	    }
+
+	    REAL *chunk = Q ? Q + (size_t) start * n : V_t;
+
+	    if (chunk != A_c)
+		memcpy(chunk, A_c, (size_t) m * n * sizeof(REAL));
+
+	    factor_panel(m, n, chunk, n, tau + (size_t) c * n, w_t);
+	    for (index_t i = 0; i < n; i++)
+		for (index_t j = 0; j < n; j++)
+		    R_t[i * n + j] = j >= i ? chunk[(size_t) i * n + j] : 0.0;
+	}
+
+	// Reduction tree: thread t takes the R of thread t + s, which keeps the reflectors of the node
+	for (int s = 1; s < team; s *= 2) {
+#pragma omp barrier
+	    if (t % (2 * s) == 0 && t + s < team) {
+		REAL *R_s = R_thread + (size_t) (t + s) * n * n;
+
+		for (index_t i = 0; i < n; i++)
+		    for (index_t j = i + 1; j < n; j++) {
+			REAL swap = R_s[i * n + j];
+			R_s[i * n + j] = R_s[j * n + i];
+			R_s[j * n + i] = swap;
+		    }
+
+		factor_stacked(n, n, R_t, n, R_s, n, tree_tau + (size_t) (t + s) * n, T_t, W_t, P_packed[t], Q_packed[t],
+			       kernels);
+	    }
+	}
+
+#pragma omp barrier
+
+	if (Q) {
+	    REAL *X_t = X + (size_t) (2 * threads + t) * n * n;
+
+	    // Q = Q_implicit D with D = diag(sign(R_kk)) gives R a nonnegative diagonal
+	    if (t == 0)
+		for (index_t i = 0; i < n; i++)
+		    for (index_t j = 0; j < n; j++)
+			X_t[i * n + j] = i == j ? (R_thread[i * n + i] < 0.0 ? -1.0 : 1.0) : 0.0;
+
+	    int top = 1;
+	    while (2 * top < team) top *= 2;
+
+	    for (int s = top; s >= 1 && team > 1; s /= 2) {
+#pragma omp barrier
+		if (t % (2 * s) == 0 && t + s < team)
+		    apply_stacked(n, n, R_thread + (size_t) (t + s) * n * n, n, tree_tau + (size_t) (t + s) * n, X_t, n,
+				  X + (size_t) (2 * threads + t + s) * n * n, n, T_t, W_t, P_packed[t], Q_packed[t]);
+	    }
+
+#pragma omp barrier
+
+	    // Leaves, from the last chunk of the thread to the first
+	    for (index_t c = last - 1; c >= first; c--) {
+		index_t start = c * chunk_rows, m = (c == chunks - 1 ? rows : start + chunk_rows) - start;
+		REAL *chunk = Q + (size_t) start * n;
+
+		memcpy(V_t, chunk, (size_t) m * n * sizeof(REAL));
+
+		if (c > first)
+		    apply_stacked(m, n, V_t, m, tau + (size_t) c * n, X_t, n, chunk, n, T_t, W_t, P_packed[t], Q_packed[t]);
+		else
+		    apply_panel(m, n, V_t, n, tau + (size_t) c * n, X_t, n, chunk, n, w_t);
+	    }
+	}
+    }
+
+    for (index_t i = 0; i < n; i++) {
+	REAL sign = R_thread[i * n + i] < 0.0 ? -1.0 : 1.0;
+	for (index_t j = 0; j < n; j++)
+	    R[i * n + j] = j >= i ? sign * R_thread[i * n + j] : 0.0;
+    }
+
+    for (int t = 0; t < threads; t++) {
+	free(P_packed[t]);
+	free(Q_packed[t]);
+    }
+
+    free(P_packed);
+    free(Q_packed);
+    free(tau);
+    free(R_thread);
+    free(X);
+    free(V);
+    free(w);
+
+    return 0;
+
 }
 
 /**
@@ -203,7 +1311,7 @@ QR *QR_decomposition_parallel(double *A, int rows, int columns) {
  * @param QR_decomposition Pointer to the QR structure to free.
  */
 
-void QR_free(QR *QR_decomposition) {
+void FN(QR_free)(FN(QR) *QR_decomposition) {
 
     if (!QR_decomposition) return;
 
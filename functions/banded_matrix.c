@@ -0,0 +1,470 @@
+#include "kernels.h"
+#include <string.h>
+
+/*
+ * Row i of a banded matrix stores the columns i - lower to i + upper, so that element
+ * (i, j) of the band is data[i * width + j - i + lower] with width = lower + upper + 1.
+ * The few slots of the first and last rows that fall outside the matrix hold zeros.
+ *
+ * The banded LU factorisation pivots on rows, which lets U grow up to lower + upper
+ * diagonals above the diagonal (the fill of LAPACK's gbtrf), so its rows hold the
+ * columns i - lower to i + lower + upper.
+ */
+
+#define BAND(M, width, offset, i, j) ((M)[(size_t) (i) * (width) + (j) - (i) + (offset)])
+
+/**
+ * @brief Allocates a zero banded matrix.
+ *
+ * @param size Dimension of the square matrix (must be positive).
+ * @param lower Number of diagonals below the main diagonal (must be in [0, size)).
+ * @param upper Number of diagonals above the main diagonal (must be in [0, size)).
+ *
+ * @return Pointer to the banded matrix on success, or NULL on failure due to invalid
+ *         dimensions or memory allocation errors.
+ */
+
+FN(banded_matrix) *FN(create_banded_matrix)(index_t size, index_t lower, index_t upper) {
+
+    if (size <= 0 || lower < 0 || upper < 0 || lower >= size || upper >= size) {
+        fprintf(stderr, "Error: Invalid dimensions for banded matrix (size=%" PRId64 ", lower=%" PRId64 ", upper=%" PRId64 ").\n",
+                size, lower, upper);
+        return NULL;
+    }
+
+    FN(banded_matrix) *A = malloc(sizeof(FN(banded_matrix)));
+
+    if (!A) {
+        fprintf(stderr, "Error: Memory allocation failed for banded matrix structure.\n");
+        return NULL;
+    }
+
+    A->size = size;
+    A->lower = lower;
+    A->upper = upper;
+    A->data = calloc((size_t) size * (lower + upper + 1), sizeof(REAL));
+
+    if (!A->data) {
+        fprintf(stderr, "Error: Memory allocation failed for banded matrix of size %" PRId64 " with %" PRId64 " diagonals.\n",
+                size, lower + upper + 1);
+        free(A);
+        return NULL;
+    }
+
+    return A;
+
+}
+
+/**
+ * @brief Extracts the band of a dense square matrix.
+ *
+ * Elements of A outside the band are ignored.
+ *
+ * @param A Pointer to the dense matrix (size: size x size).
+ * @param size Dimension of the square matrix (must be positive).
+ * @param lower Number of diagonals below the main diagonal kept (must be in [0, size)).
+ * @param upper Number of diagonals above the main diagonal kept (must be in [0, size)).
+ *
+ * @return Pointer to the banded matrix on success, or NULL on failure due to invalid
+ *         dimensions, null pointers or memory allocation errors.
+ */
+
+FN(banded_matrix) *FN(banded_from_dense)(REAL *A, index_t size, index_t lower, index_t upper) {
+
+    if (!A) {
+        fprintf(stderr, "Error: Null pointer detected in banded_from_dense.\n");
+        return NULL;
+    }
+
+    FN(banded_matrix) *B = FN(create_banded_matrix)(size, lower, upper);
+
+    if (!B) return NULL;
+
+    index_t width = lower + upper + 1;
+
+    for (index_t i = 0; i < size; i++) {
+	index_t first = i - lower > 0 ? i - lower : 0, last = i + upper < size ? i + upper : size - 1;
+	for (index_t j = first; j <= last; j++)
+	    BAND(B->data, width, lower, i, j) = A[(size_t) i * size + j];
+    }
+
+    return B;
+
+}
+
+/**
+ * @brief Expands a banded matrix to a dense square matrix.
+ *
+ * @param A Pointer to the banded matrix.
+ *
+ * @return Pointer to the dense matrix (size: size x size) on success,
+ *         or NULL on failure due to a null pointer or memory allocation errors.
+ */
+
+REAL *FN(banded_to_dense)(const FN(banded_matrix) *A) {
+
+    if (!A) {
+        fprintf(stderr, "Error: Null pointer detected in banded_to_dense.\n");
+        return NULL;
+    }
+
+    index_t size = A->size, width = A->lower + A->upper + 1;
+    REAL *D = calloc((size_t) size * size, sizeof(REAL));
+
+    if (!D) {
+        fprintf(stderr, "Error: Memory allocation failed for dense matrix of size %" PRId64 " x %" PRId64 ".\n", size, size);
+        return NULL;
+    }
+
+    for (index_t i = 0; i < size; i++) {
+	index_t first = i - A->lower > 0 ? i - A->lower : 0, last = i + A->upper < size ? i + A->upper : size - 1;
+	for (index_t j = first; j <= last; j++)
+	    D[(size_t) i * size + j] = BAND(A->data, width, A->lower, i, j);
+    }
+
+    return D;
+
+}
+
+/**
+ * @brief Frees all memory associated with a banded matrix.
+ *
+ * @param A Pointer to the banded matrix to free (may be NULL).
+ */
+
+void FN(banded_free)(FN(banded_matrix) *A) {
+
+    if (!A) return;
+
+    free(A->data);
+    free(A);
+
+}
+
+/**
+ * @brief Performs the LU decomposition with partial pivoting of a banded matrix.
+ *
+ * This function computes P A = L U in O(size * lower * (lower + upper)) time and
+ * O(size * (2 * lower + upper)) memory: L has lower diagonals below its unit
+ * diagonal, and U has at most lower + upper diagonals above its diagonal.
+ *
+ * @param A Pointer to the banded matrix to decompose.
+ *
+ * @return Pointer to the banded_LU structure on success, or NULL on failure due to
+ *         null pointers, singular matrix detection or memory allocation errors.
+ */
+
+FN(banded_LU) *FN(banded_LU_decomposition)(const FN(banded_matrix) *A) {
+
+    if (!A || !A->data) {
+        fprintf(stderr, "Error: Null pointer detected in banded_LU_decomposition.\n");
+        return NULL;
+    }
+
+    index_t n = A->size, kl = A->lower, ku = A->upper;
+    index_t width = 2 * kl + ku + 1, band_width = kl + ku + 1;
+
+    FN(banded_LU) *F = malloc(sizeof(FN(banded_LU)));
+
+    if (!F) {
+        fprintf(stderr, "Error: Memory allocation failed for banded LU structure.\n");
+        return NULL;
+    }
+
+    F->size = n;
+    F->lower = kl;
+    F->upper = ku;
+    F->LU = calloc((size_t) n * width, sizeof(REAL));
+    F->pivots = malloc(n * sizeof(index_t));
+
+    if (!F->LU || !F->pivots) {
+        fprintf(stderr, "Error: Memory allocation failed for factors in banded_LU_decomposition.\n");
+        FN(banded_LU_free)(F);
+        return NULL;
+    }
+
+    REAL *LU = F->LU;
+
+    for (index_t i = 0; i < n; i++) {
+	index_t first = i - kl > 0 ? i - kl : 0, last = i + ku < n ? i + ku : n - 1;
+	for (index_t j = first; j <= last; j++)
+	    BAND(LU, width, kl, i, j) = BAND(A->data, band_width, kl, i, j);
+    }
+
+    for (index_t k = 0; k < n; k++) {
+
+	index_t last_row = k + kl < n ? k + kl : n - 1;
+	index_t last_column = k + kl + ku < n ? k + kl + ku : n - 1;
+
+	// Largest element of column k on or below the diagonal
+	index_t pivot = k;
+	for (index_t i = k + 1; i <= last_row; i++)
+	    if (fabs(BAND(LU, width, kl, i, k)) > fabs(BAND(LU, width, kl, pivot, k)))
+		pivot = i;
+
+	if (BAND(LU, width, kl, pivot, k) == 0.0) {
+	    fprintf(stderr, "Error: Matrix is singular at column %" PRId64 " in banded_LU_decomposition.\n", k);
+	    FN(banded_LU_free)(F);
+	    return NULL;
+	}
+
+	F->pivots[k] = pivot;
+
+	// Rows k and pivot both hold the columns k to last_column
+	if (pivot != k)
+	    for (index_t j = k; j <= last_column; j++) {
+		REAL swap = BAND(LU, width, kl, k, j);
+		BAND(LU, width, kl, k, j) = BAND(LU, width, kl, pivot, j);
+		BAND(LU, width, kl, pivot, j) = swap;
+	    }
+
+	REAL diagonal = BAND(LU, width, kl, k, k);
+
+	for (index_t i = k + 1; i <= last_row; i++) {
+	    REAL l = BAND(LU, width, kl, i, k) / diagonal;
+	    BAND(LU, width, kl, i, k) = l;
+	    if (l != 0.0)
+		for (index_t j = k + 1; j <= last_column; j++)
+		    BAND(LU, width, kl, i, j) -= l * BAND(LU, width, kl, k, j);
+	}
+
+    }
+
+    return F;
+
+}
+
+/**
+ * @brief Solves a linear system Ax = b from the banded LU decomposition of A.
+ *
+ * @param F Pointer to the banded LU decomposition of A.
+ * @param b Pointer to the right-hand side vector b (size: size).
+ *
+ * @return Pointer to the solution vector x on success, or NULL on failure due to
+ *         null pointers or memory allocation errors.
+ */
+
+REAL *FN(solve_banded_LU_system)(const FN(banded_LU) *F, REAL *b) {
+
+    if (!F || !b) {
+        fprintf(stderr, "Error: Null pointer detected in solve_banded_LU_system.\n");
+        return NULL;
+    }
+
+    REAL *x = malloc(F->size * sizeof(REAL));
+
+    if (!x) {
+        fprintf(stderr, "Error: Memory allocation failed for solution vector in solve_banded_LU_system.\n");
+        return NULL;
+    }
+
+    FN(solve_banded_LU_system_into)(F, b, x);
+
+    return x;
+
+}
+
+/**
+ * @brief Solves a linear system Ax = b from the banded LU decomposition of A.
+ *
+ * x may be b (the right-hand side is overwritten by the solution).
+ *
+ * @param F Pointer to the banded LU decomposition of A.
+ * @param b Pointer to the right-hand side vector b (size: size).
+ * @param x Pointer to the solution vector x (size: size).
+ *
+ * @return 0 on success, or -1 on failure due to null pointers.
+ */
+
+int FN(solve_banded_LU_system_into)(const FN(banded_LU) *F, REAL *b, REAL *x) {
+
+    if (!F || !b || !x) {
+        fprintf(stderr, "Error: Null pointer detected in solve_banded_LU_system_into.\n");
+        return -1;
+    }
+
+    index_t n = F->size, kl = F->lower, ku = F->upper, width = 2 * kl + ku + 1;
+    const REAL *LU = F->LU;
+
+    if (x != b)
+	memcpy(x, b, n * sizeof(REAL));
+
+    // L y = P b, applying the interchanges in the order of the elimination
+    for (index_t k = 0; k < n; k++) {
+	index_t pivot = F->pivots[k];
+	if (pivot != k) {
+	    REAL swap = x[k];
+	    x[k] = x[pivot];
+	    x[pivot] = swap;
+	}
+	index_t last_row = k + kl < n ? k + kl : n - 1;
+	for (index_t i = k + 1; i <= last_row; i++)
+	    x[i] -= BAND(LU, width, kl, i, k) * x[k];
+    }
+
+    // U x = y
+    for (index_t i = n - 1; i >= 0; i--) {
+	index_t last_column = i + kl + ku < n ? i + kl + ku : n - 1;
+	REAL sum = x[i];
+	for (index_t j = i + 1; j <= last_column; j++)
+	    sum -= BAND(LU, width, kl, i, j) * x[j];
+	x[i] = sum / BAND(LU, width, kl, i, i);
+    }
+
+    return 0;
+
+}
+
+/**
+ * @brief Frees all memory associated with a banded LU decomposition.
+ *
+ * @param F Pointer to the banded LU structure to free (may be NULL).
+ */
+
+void FN(banded_LU_free)(FN(banded_LU) *F) {
+
+    if (!F) return;
+
+    free(F->LU);
+    free(F->pivots);
+    free(F);
+
+}
+
+/**
+ * @brief Performs the Cholesky decomposition A = L L^T of a symmetric positive definite banded matrix.
+ *
+ * Only the diagonal and the lower diagonals of A are read. L has the same lower
+ * bandwidth as A, so the decomposition takes O(size * lower^2) time and
+ * O(size * lower) memory.
+ *
+ * @param A Pointer to the symmetric banded matrix (lower must equal upper).
+ *
+ * @return Pointer to the banded lower triangular factor L (upper = 0) on success, or NULL
+ *         on failure due to null pointers, a non-symmetric band, a matrix that is not
+ *         positive definite or memory allocation errors.
+ */
+
+FN(banded_matrix) *FN(banded_Cholesky_decomposition)(const FN(banded_matrix) *A) {
+
+    if (!A || !A->data) {
+        fprintf(stderr, "Error: Null pointer detected in banded_Cholesky_decomposition.\n");
+        return NULL;
+    }
+
+    if (A->lower != A->upper) {
+        fprintf(stderr, "Error: A symmetric band needs as many lower (%" PRId64 ") as upper (%" PRId64 ") diagonals.\n",
+                A->lower, A->upper);
+        return NULL;
+    }
+
+    index_t n = A->size, k = A->lower, width = 2 * k + 1;
+
+    FN(banded_matrix) *L = FN(create_banded_matrix)(n, k, 0);
+
+    if (!L) return NULL;
+
+    for (index_t i = 0; i < n; i++) {
+	index_t first = i - k > 0 ? i - k : 0;
+
+	for (index_t j = first; j <= i; j++) {
+	    REAL sum = BAND(A->data, width, k, i, j);
+
+	    // L(i, m) and L(j, m) are both in the band for m in [i - k, j)
+	    for (index_t m = first; m < j; m++)
+		sum -= BAND(L->data, k + 1, k, i, m) * BAND(L->data, k + 1, k, j, m);
+
+	    if (j < i) {
+		BAND(L->data, k + 1, k, i, j) = sum / BAND(L->data, k + 1, k, j, j);
+	    } else if (sum <= 0.0) {
+		fprintf(stderr, "Error: Matrix is not positive definite at row %" PRId64 " in banded_Cholesky_decomposition.\n", i);
+		FN(banded_free)(L);
+		return NULL;
+	    } else {
+		BAND(L->data, k + 1, k, i, i) = sqrt(sum);
+	    }
+	}
+    }
+
+    return L;
+
+}
+
+/**
+ * @brief Solves a linear system Ax = b from the banded Cholesky factor L of A.
+ *
+ * @param L Pointer to the banded lower triangular factor returned by banded_Cholesky_decomposition.
+ * @param b Pointer to the right-hand side vector b (size: size).
+ *
+ * @return Pointer to the solution vector x on success, or NULL on failure due to
+ *         null pointers, a factor that is not lower triangular or memory allocation errors.
+ */
+
+REAL *FN(solve_banded_Cholesky_system)(const FN(banded_matrix) *L, REAL *b) {
+
+    if (!L || !b) {
+        fprintf(stderr, "Error: Null pointer detected in solve_banded_Cholesky_system.\n");
+        return NULL;
+    }
+
+    REAL *x = malloc(L->size * sizeof(REAL));
+
+    if (!x) {
+        fprintf(stderr, "Error: Memory allocation failed for solution vector in solve_banded_Cholesky_system.\n");
+        return NULL;
+    }
+
+    if (FN(solve_banded_Cholesky_system_into)(L, b, x)) {
+        free(x);
+        return NULL;
+    }
+
+    return x;
+
+}
+
+/**
+ * @brief Solves a linear system Ax = b from the banded Cholesky factor L of A.
+ *
+ * Solves L y = b then L^T x = y. x may be b (the right-hand side is overwritten by the solution).
+ *
+ * @param L Pointer to the banded lower triangular factor returned by banded_Cholesky_decomposition.
+ * @param b Pointer to the right-hand side vector b (size: size).
+ * @param x Pointer to the solution vector x (size: size).
+ *
+ * @return 0 on success, or -1 on failure due to null pointers or a factor that is not lower triangular.
+ */
+
+int FN(solve_banded_Cholesky_system_into)(const FN(banded_matrix) *L, REAL *b, REAL *x) {
+
+    if (!L || !b || !x) {
+        fprintf(stderr, "Error: Null pointer detected in solve_banded_Cholesky_system_into.\n");
+        return -1;
+    }
+
+    if (L->upper != 0) {
+        fprintf(stderr, "Error: The Cholesky factor must be lower triangular (upper=%" PRId64 ").\n", L->upper);
+        return -1;
+    }
+
+    index_t n = L->size, k = L->lower, width = k + 1;
+
+    for (index_t i = 0; i < n; i++) {
+	index_t first = i - k > 0 ? i - k : 0;
+	REAL sum = b[i];
+	for (index_t m = first; m < i; m++)
+	    sum -= BAND(L->data, width, k, i, m) * x[m];
+	x[i] = sum / BAND(L->data, width, k, i, i);
+    }
+
+    for (index_t i = n - 1; i >= 0; i--) {
+	index_t last = i + k < n ? i + k : n - 1;
+	REAL sum = x[i];
+	for (index_t m = i + 1; m <= last; m++)
+	    sum -= BAND(L->data, width, k, m, i) * x[m];
+	x[i] = sum / BAND(L->data, width, k, i, i);
+    }
+
+    return 0;
+
+}
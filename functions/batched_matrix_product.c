@@ -0,0 +1,360 @@
+#include "kernels.h"
+#include <string.h>
+#include <omp.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86
+#endif
+
+/**
+ * @brief Largest dimension handled by the unpacked small-matrix kernels.
+ *
+ * Above it, every product of the batch goes through the blocked engine with
+ * packing buffers owned by each thread.
+ */
+
+#define BATCHED_SMALL_MAX 32
+
+/**
+ * @brief Minimal number of multiply-adds of a batch before it is spread across threads.
+ */
+
+#define BATCHED_PARALLEL_WORK 65536
+
+/**
+ * @brief Rows of C accumulated together by the square kernels.
+ *
+ * BATCHED_ROWS x 32 doubles fill half of the AVX-512 register file, so the
+ * accumulators of every fixed size stay in registers while each row of Q
+ * loaded from L1 is reused BATCHED_ROWS times.
+ */
+
+#define BATCHED_ROWS 4
+
+/**
+ * @brief Square product C = P * Q of compile-time size SIZE.
+ *
+ * With SIZE known, the j loop becomes a fixed number of vector registers of
+ * the target instruction set. The k loop is kept rolled: unrolling it lets the
+ * compiler vectorize across rows instead, with permutations that are several
+ * times slower.
+ */
+
+#define DEFINE_FIXED_PRODUCT(SIZE, SUFFIX, TARGET)			\
+    TARGET static void fixed_product_##SIZE##_##SUFFIX(const REAL *restrict P, const REAL *restrict Q, \
+						     REAL *restrict C) { \
+	for (index_t i = 0; i < SIZE; i += BATCHED_ROWS) {			\
+	    REAL rows[BATCHED_ROWS][SIZE];				\
+	    for (index_t r = 0; r < BATCHED_ROWS; r++)			\
+		for (index_t j = 0; j < SIZE; j++)				\
+		    rows[r][j] = 0.0;					\
+	    _Pragma("GCC unroll 1")					\
+	    for (index_t k = 0; k < SIZE; k++) {				\
+		for (index_t r = 0; r < BATCHED_ROWS; r++) {		\
+		    REAL p = P[(i + r) * SIZE + k];			\
+		    _Pragma("omp simd")					\
+		    for (index_t j = 0; j < SIZE; j++)			\
+			rows[r][j] += p * Q[k * SIZE + j];		\
+		}							\
+	    }								\
+	    for (index_t r = 0; r < BATCHED_ROWS; r++)			\
+		for (index_t j = 0; j < SIZE; j++)				\
+		    C[(i + r) * SIZE + j] = rows[r][j];			\
+	}								\
+    }
+
+/**
+ * @brief Product C = P * Q of any size up to BATCHED_SMALL_MAX, without packing.
+ */
+
+#define DEFINE_SMALL_PRODUCT(SUFFIX, TARGET)				\
+    TARGET static void small_product_##SUFFIX(index_t M, index_t N, index_t K, const REAL *restrict P, \
+					      const REAL *restrict Q, REAL *restrict C) { \
+	for (index_t i = 0; i < M; i++) {					\
+	    REAL row[BATCHED_SMALL_MAX] = {0.0};			\
+	    for (index_t k = 0; k < K; k++) {				\
+		REAL p = P[i * K + k];				\
+		for (index_t j = 0; j < N; j++)				\
+		    row[j] += p * Q[k * N + j];				\
+	    }								\
+	    for (index_t j = 0; j < N; j++)					\
+		C[i * N + j] = row[j];					\
+	}								\
+    }
+
+#define DEFINE_BATCHED_KERNELS(SUFFIX, TARGET)	\
+    DEFINE_FIXED_PRODUCT(4, SUFFIX, TARGET)	\
+    DEFINE_FIXED_PRODUCT(8, SUFFIX, TARGET)	\
+    DEFINE_FIXED_PRODUCT(16, SUFFIX, TARGET)	\
+    DEFINE_FIXED_PRODUCT(32, SUFFIX, TARGET)	\
+    DEFINE_SMALL_PRODUCT(SUFFIX, TARGET)
+
+/**
+ * @brief Small-matrix kernels compiled for one instruction set.
+ *
+ * @struct batched_kernels
+ * @var batched_kernels::name
+ * Name of the instruction set, matching simd_kernels::name.
+ * @var batched_kernels::fixed
+ * Square kernels of size 4, 8, 16 and 32.
+ * @var batched_kernels::small
+ * Kernel of any size up to BATCHED_SMALL_MAX.
+ */
+
+typedef struct batched_kernels {
+
+    const char *name;
+
+    void (*fixed[4])(const REAL *P, const REAL *Q, REAL *C);
+    void (*small)(index_t M, index_t N, index_t K, const REAL *P, const REAL *Q, REAL *C);
+
+} batched_kernels;
+
+#define BATCHED_KERNELS_TABLE(NAME, SUFFIX)				\
+    { NAME, { fixed_product_4_##SUFFIX, fixed_product_8_##SUFFIX,	\
+	      fixed_product_16_##SUFFIX, fixed_product_32_##SUFFIX },	\
+      small_product_##SUFFIX }
+
+DEFINE_BATCHED_KERNELS(generic, )
+
+#ifdef SIMD_X86
+DEFINE_BATCHED_KERNELS(sse2, __attribute__((target("sse2"))))
+DEFINE_BATCHED_KERNELS(avx2, __attribute__((target("avx2,fma"))))
+DEFINE_BATCHED_KERNELS(avx512, __attribute__((target("avx512f"))))
+#endif
+
+static const batched_kernels batched_kernels_tables[] = {
+    BATCHED_KERNELS_TABLE("generic", generic),
+#ifdef SIMD_X86
+    BATCHED_KERNELS_TABLE("sse2", sse2),
+    BATCHED_KERNELS_TABLE("avx2", avx2),
+    BATCHED_KERNELS_TABLE("avx512", avx512),
+#endif
+};
+
+/**
+ * @brief Returns the small-matrix kernels of the instruction set selected in simd_kernels.c.
+ */
+
+static const batched_kernels *active_batched_kernels(void) {
+
+    const char *name = FN(active_kernels)->name;
+
+    for (size_t i = 0; i < sizeof(batched_kernels_tables) / sizeof(batched_kernels_tables[0]); i++)
+	if (!strcmp(batched_kernels_tables[i].name, name))
+	    return &batched_kernels_tables[i];
+
+    return &batched_kernels_tables[0];
+
+}
+
+/**
+ * @brief Index of the square kernel of a given size in batched_kernels::fixed, or -1.
+ */
+
+static int fixed_index(index_t size) {
+
+    switch (size) {
+    case 4: return 0;
+    case 8: return 1;
+    case 16: return 2;
+    case 32: return 3;
+    default: return -1;
+    }
+
+}
+
+/**
+ * @brief Runs the products of a batch, whose operands come either from pointer
+ *        arrays (P_array, Q_array, C_array) or from base pointers and strides.
+ *
+ * The kernel is chosen once for the whole batch, and the batch is split in
+ * contiguous chunks across the OpenMP threads when it holds enough work.
+ *
+ * @return 0 on success, or -1 on failure due to memory allocation errors.
+ */
+
+static int batched_product(index_t M, index_t N, index_t K,
+			   REAL **P_array, REAL **Q_array, REAL **C_array,
+			   const REAL *P, size_t P_stride, const REAL *Q, size_t Q_stride,
+			   REAL *C, size_t C_stride, index_t batch) {
+
+    const batched_kernels *kernels = active_batched_kernels();
+    int parallel = (size_t) batch * M * N * K >= BATCHED_PARALLEL_WORK && omp_get_max_threads() > 1;
+
+    int fixed = (M == N && N == K) ? fixed_index(M) : -1;
+    int small = M <= BATCHED_SMALL_MAX && N <= BATCHED_SMALL_MAX && K <= BATCHED_SMALL_MAX;
+
+    if (fixed >= 0 || small) {
+
+#pragma omp parallel for schedule(static) if(parallel)
+	for (index_t b = 0; b < batch; b++) {
+	    const REAL *P_b = P_array ? P_array[b] : P + b * P_stride;
+	    const REAL *Q_b = Q_array ? Q_array[b] : Q + b * Q_stride;
+	    REAL *C_b = C_array ? C_array[b] : C + b * C_stride;
+	    if (fixed >= 0)
+		kernels->fixed[fixed](P_b, Q_b, C_b);
+	    else
+		kernels->small(M, N, K, P_b, Q_b, C_b);
+	}
+
+	return 0;
+
+    }
+
+    int failed = 0;
+
+#pragma omp parallel if(parallel)
+    {
+	REAL *P_packed = aligned_buffer(sizeof(REAL) * GEMM_P_BUFFER_SIZE(M, K));
+	REAL *Q_packed = aligned_buffer(sizeof(REAL) * GEMM_Q_BUFFER_SIZE(N, K));
+
+	if (!P_packed || !Q_packed) {
+#pragma omp atomic write
+	    failed = 1;
+	}
+
+#pragma omp barrier
+
+	if (!failed) {
+#pragma omp for schedule(static)
+	    for (index_t b = 0; b < batch; b++) {
+		const REAL *P_b = P_array ? P_array[b] : P + b * P_stride;
+		const REAL *Q_b = Q_array ? Q_array[b] : Q + b * Q_stride;
+		REAL *C_b = C_array ? C_array[b] : C + b * C_stride;
+		FN(blocked_matrix_product_packed)(M, N, K, 1.0, P_b, K, Q_b, N, 0.0, C_b, N, P_packed, Q_packed);
+	    }
+	}
+
+	free(P_packed);
+	free(Q_packed);
+    }
+
+    if (failed) {
+        fprintf(stderr, "Error: Memory allocation failed for packing buffers in batched matrix product.\n");
+        return -1;
+    }
+
+    return 0;
+
+}
+
+/**
+ * @brief Computes a batch of matrix products C[b] = P[b] * Q[b] given as arrays of pointers.
+ *
+ * All the products of the batch share the same dimensions, which are validated
+ * once for the whole batch. Square products of size 4, 8, 16 and 32 run
+ * size-specialized kernels, other products up to 32 x 32 an unpacked kernel,
+ * and bigger ones the blocked engine. The batch is spread across OpenMP threads.
+ * A C[b] overlapping P[b] or Q[b] is rejected. Overlaps between C[b] and the
+ * operands of the other products of the batch are not checked and are undefined behaviour.
+ *
+ * @param P Array of batch pointers to the first matrices (size: P_rows x P_columns each).
+ * @param P_rows Number of rows of the matrices P[b] (must be positive).
+ * @param P_columns Number of columns of the matrices P[b] (must equal Q_rows).
+ * @param Q Array of batch pointers to the second matrices (size: Q_rows x Q_columns each).
+ * @param Q_rows Number of rows of the matrices Q[b] (must equal P_columns).
+ * @param Q_columns Number of columns of the matrices Q[b] (must be positive).
+ * @param C Array of batch pointers to the output matrices (size: P_rows x Q_columns each).
+ * @param batch Number of products (must be non-negative).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         aliased outputs, or memory allocation errors.
+ */
+
+int FN(batched_matrix_product)(REAL **P, index_t P_rows, index_t P_columns, REAL **Q, index_t Q_rows, index_t Q_columns, REAL **C, index_t batch) {
+
+    if (P_rows <= 0 || P_columns <= 0 || Q_rows <= 0 || Q_columns <= 0 || batch < 0) {
+        fprintf(stderr, "Error: Invalid dimensions for batched matrix product (P_rows=%" PRId64 ", P_columns=%" PRId64 ", Q_rows=%" PRId64 ", Q_columns=%" PRId64 ", batch=%" PRId64 ").\n",
+                P_rows, P_columns, Q_rows, Q_columns, batch);
+        return -1;
+    }
+
+    if (P_columns != Q_rows) {
+        fprintf(stderr, "Error: Dimension mismatch. Columns of first matrices (%" PRId64 ") must equal rows of second matrices (%" PRId64 ").\n",
+                P_columns, Q_rows);
+        return -1;
+    }
+
+    if (!P || !Q || !C) {
+        fprintf(stderr, "Error: Null pointer detected in batched_matrix_product.\n");
+        return -1;
+    }
+
+    int missing = 0, aliased = 0;
+    size_t P_size = (size_t) P_rows * P_columns, Q_size = (size_t) Q_rows * Q_columns, C_size = (size_t) P_rows * Q_columns;
+
+    for (index_t b = 0; b < batch; b++) {
+	missing |= !P[b] | !Q[b] | !C[b];
+	aliased |= ranges_overlap(C[b], C_size, P[b], P_size) || ranges_overlap(C[b], C_size, Q[b], Q_size);
+    }
+
+    if (missing) {
+        fprintf(stderr, "Error: Null matrix pointer detected in batched_matrix_product.\n");
+        return -1;
+    }
+
+    if (aliased) {
+        fprintf(stderr, "Error: Output matrix overlaps its operands in batched_matrix_product.\n");
+        return -1;
+    }
+
+    return batched_product(P_rows, Q_columns, P_columns, P, Q, C, NULL, 0, NULL, 0, NULL, 0, batch);
+
+}
+
+/**
+ * @brief Computes a batch of matrix products C[b] = P[b] * Q[b] stored at constant strides.
+ *
+ * Matrix b of each operand starts b * stride elements after its base pointer.
+ * A stride of 0 for P or Q reuses the same matrix for the whole batch. Kernels
+ * and parallelisation are the same as batched_matrix_product.
+ *
+ * @param P Pointer to the first matrix of the batch (size: P_rows x P_columns each).
+ * @param P_rows Number of rows of the matrices P[b] (must be positive).
+ * @param P_columns Number of columns of the matrices P[b] (must equal Q_rows).
+ * @param P_stride Distance in elements between two consecutive matrices P[b].
+ * @param Q Pointer to the second matrix of the batch (size: Q_rows x Q_columns each).
+ * @param Q_rows Number of rows of the matrices Q[b] (must equal P_columns).
+ * @param Q_columns Number of columns of the matrices Q[b] (must be positive).
+ * @param Q_stride Distance in elements between two consecutive matrices Q[b].
+ * @param C Pointer to the first output matrix (size: P_rows x Q_columns each).
+ * @param C_stride Distance in elements between two consecutive matrices C[b]
+ *        (must be at least P_rows x Q_columns).
+ * @param batch Number of products (must be non-negative).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions or strides, null pointers,
+ *         or memory allocation errors.
+ */
+
+int FN(strided_batched_matrix_product)(REAL *P, index_t P_rows, index_t P_columns, size_t P_stride,
+				   REAL *Q, index_t Q_rows, index_t Q_columns, size_t Q_stride,
+				   REAL *C, size_t C_stride, index_t batch) {
+
+    if (P_rows <= 0 || P_columns <= 0 || Q_rows <= 0 || Q_columns <= 0 || batch < 0) {
+        fprintf(stderr, "Error: Invalid dimensions for batched matrix product (P_rows=%" PRId64 ", P_columns=%" PRId64 ", Q_rows=%" PRId64 ", Q_columns=%" PRId64 ", batch=%" PRId64 ").\n",
+                P_rows, P_columns, Q_rows, Q_columns, batch);
+        return -1;
+    }
+
+    if (P_columns != Q_rows) {
+        fprintf(stderr, "Error: Dimension mismatch. Columns of first matrices (%" PRId64 ") must equal rows of second matrices (%" PRId64 ").\n",
+                P_columns, Q_rows);
+        return -1;
+    }
+
+    if (batch > 1 && C_stride < (size_t) P_rows * Q_columns) {
+        fprintf(stderr, "Error: Output stride (%zu) smaller than an output matrix (%" PRId64 " x %" PRId64 ") in strided_batched_matrix_product.\n",
+                C_stride, P_rows, Q_columns);
+        return -1;
+    }
+
+    if (!P || !Q || !C) {
+        fprintf(stderr, "Error: Null pointer detected in strided_batched_matrix_product.\n");
+        return -1;
+    }
+
+    return batched_product(P_rows, Q_columns, P_columns, NULL, NULL, NULL,
+			   P, P_stride, Q, Q_stride, C, C_stride, batch);
+
+}
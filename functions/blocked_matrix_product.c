@@ -0,0 +1,221 @@
+#include "kernels.h"
+
+#ifndef SINGLE_PRECISION
+
+/**
+ * @brief Allocates a buffer aligned on GEMM_ALIGNMENT bytes.
+ *
+ * @param bytes Size of the buffer in bytes.
+ *
+ * @return Pointer to the buffer (to release with free) on success, or NULL on failure.
+ */
+
+void *aligned_buffer(size_t bytes) {
+
+    // aligned_alloc requires a size multiple of the alignment
+    size_t rounded = (bytes + GEMM_ALIGNMENT - 1) / GEMM_ALIGNMENT * GEMM_ALIGNMENT;
+
+    if (rounded == 0) rounded = GEMM_ALIGNMENT;
+
+    return aligned_alloc(GEMM_ALIGNMENT, rounded);
+
+}
+
+#endif
+
+/**
+ * @brief Packs an mc x kc block of op(P) into row panels of mr rows.
+ *
+ * Inside a panel the elements are stored column after column (mr
+ * consecutive values per k), which is the order the microkernel reads them.
+ * Rows beyond mc are padded with zeros. When transpose is set, element (i, k)
+ * of the block is read at P[k * ldp + i], so P^T is never formed.
+ */
+
+static void pack_P(index_t mc, int kc, const REAL *P, index_t ldp, int transpose, REAL *buffer, int mr_kernel) {
+
+    for (index_t ir = 0; ir < mc; ir += mr_kernel) {
+	int mr = (mc - ir < mr_kernel) ? mc - ir : mr_kernel;
+	for (index_t k = 0; k < kc; k++) {
+	    if (transpose) {
+		const REAL *column = P + (size_t) k * ldp + ir;
+		for (index_t i = 0; i < mr; i++)
+		    buffer[i] = column[i];
+	    } else {
+		for (index_t i = 0; i < mr; i++)
+		    buffer[i] = P[(size_t) (ir + i) * ldp + k];
+	    }
+	    for (index_t i = mr; i < mr_kernel; i++)
+		buffer[i] = 0.0;
+	    buffer += mr_kernel;
+	}
+    }
+
+}
+
+/**
+ * @brief Packs a kc x nc block of op(Q) into column panels of nr columns.
+ *
+ * Inside a panel the elements are stored row after row (nr consecutive
+ * values per k). Columns beyond nc are padded with zeros. When transpose is
+ * set, element (k, j) of the block is read at Q[j * ldq + k].
+ */
+
+static void pack_Q(int kc, index_t nc, const REAL *Q, index_t ldq, int transpose, REAL *buffer, int nr_kernel) {
+
+    for (index_t jr = 0; jr < nc; jr += nr_kernel) {
+	int nr = (nc - jr < nr_kernel) ? nc - jr : nr_kernel;
+	for (index_t k = 0; k < kc; k++) {
+	    if (transpose) {
+		for (index_t j = 0; j < nr; j++)
+		    buffer[j] = Q[(size_t) (jr + j) * ldq + k];
+	    } else {
+		const REAL *row = Q + (size_t) k * ldq + jr;
+		for (index_t j = 0; j < nr; j++)
+		    buffer[j] = row[j];
+	    }
+	    for (index_t j = nr; j < nr_kernel; j++)
+		buffer[j] = 0.0;
+	    buffer += nr_kernel;
+	}
+    }
+
+}
+
+/**
+ * @brief Computes C = alpha * op(P) * op(Q) + beta * C with caller-provided packing buffers.
+ *
+ * The loops follow the classical five-level blocking: a kc x nc panel of op(Q) is
+ * packed once for the L3 cache, an mc x kc block of op(P) is packed for the L2
+ * cache, and the microkernel of the selected instruction set walks mr x nr
+ * tiles of C whose operands stream from L1. Transposition only changes the
+ * order in which the packing routines read the operands.
+ *
+ * @param P_packed Packing buffer of P (GEMM_P_BUFFER_SIZE(M, K) values, aligned).
+ * @param Q_packed Packing buffer of Q (GEMM_Q_BUFFER_SIZE(N, K) values, aligned).
+ */
+
+void FN(blocked_general_product_packed)(int transpose_P, int transpose_Q, index_t M, index_t N, index_t K,
+				    REAL alpha, const REAL *P, index_t ldp, const REAL *Q, index_t ldq,
+				    REAL beta, REAL *C, index_t ldc, REAL *P_packed, REAL *Q_packed) {
+
+    if (M <= 0 || N <= 0) return;
+
+    if (K <= 0 || alpha == 0.0) {
+	for (index_t i = 0; i < M; i++)
+	    for (index_t j = 0; j < N; j++)
+		C[(size_t) i * ldc + j] = (beta == 0.0) ? 0.0 : beta * C[(size_t) i * ldc + j];
+	return;
+    }
+
+    const simd_kernels *kernels = FN(active_kernels);
+    int MR = kernels->mr, NR = kernels->nr;
+
+    for (index_t jc = 0; jc < N; jc += GEMM_NC) {
+	index_t nc = (N - jc < GEMM_NC) ? N - jc : GEMM_NC;
+
+	for (index_t pc = 0; pc < K; pc += GEMM_KC) {
+	    int kc = (K - pc < GEMM_KC) ? K - pc : GEMM_KC;
+	    REAL beta_block = (pc == 0) ? beta : 1.0;
+
+	    const REAL *Q_block = transpose_Q ? Q + (size_t) jc * ldq + pc : Q + (size_t) pc * ldq + jc;
+	    pack_Q(kc, nc, Q_block, ldq, transpose_Q, Q_packed, NR);
+
+	    for (index_t ic = 0; ic < M; ic += GEMM_MC) {
+		index_t mc = (M - ic < GEMM_MC) ? M - ic : GEMM_MC;
+
+		const REAL *P_block = transpose_P ? P + (size_t) pc * ldp + ic : P + (size_t) ic * ldp + pc;
+		pack_P(mc, kc, P_block, ldp, transpose_P, P_packed, MR);
+
+		for (index_t jr = 0; jr < nc; jr += NR) {
+		    int nr = (nc - jr < NR) ? nc - jr : NR;
+		    for (index_t ir = 0; ir < mc; ir += MR) {
+			int mr = (mc - ir < MR) ? mc - ir : MR;
+			kernels->microkernel(kc, P_packed + (size_t) ir * kc, Q_packed + (size_t) jr * kc,
+					     C + (size_t) (ic + ir) * ldc + jc + jr, ldc,
+					     alpha, beta_block, mr, nr);
+		    }
+		}
+	    }
+	}
+    }
+
+}
+
+/**
+ * @brief Computes C = alpha * op(P) * op(Q) + beta * C, allocating the packing buffers.
+ *
+ * @return 0 on success, or -1 on failure due to memory allocation errors.
+ */
+
+int FN(blocked_general_product)(int transpose_P, int transpose_Q, index_t M, index_t N, index_t K,
+			    REAL alpha, const REAL *P, index_t ldp, const REAL *Q, index_t ldq,
+			    REAL beta, REAL *C, index_t ldc) {
+
+    if (M <= 0 || N <= 0 || K <= 0 || alpha == 0.0) {
+	FN(blocked_general_product_packed)(transpose_P, transpose_Q, M, N, K, alpha, P, ldp, Q, ldq,
+				       beta, C, ldc, NULL, NULL);
+	return 0;
+    }
+
+    REAL *P_packed = aligned_buffer(sizeof(REAL) * GEMM_P_BUFFER_SIZE(M, K));
+    REAL *Q_packed = aligned_buffer(sizeof(REAL) * GEMM_Q_BUFFER_SIZE(N, K));
+
+    if (!P_packed || !Q_packed) {
+	fprintf(stderr, "Error: Memory allocation failed for packing buffers in blocked_general_product.\n");
+	free(P_packed);
+	free(Q_packed);
+	return -1;
+    }
+
+    FN(blocked_general_product_packed)(transpose_P, transpose_Q, M, N, K, alpha, P, ldp, Q, ldq,
+				   beta, C, ldc, P_packed, Q_packed);
+
+    free(P_packed);
+    free(Q_packed);
+
+    return 0;
+
+}
+
+/**
+ * @brief Computes C = alpha * P * Q + beta * C with caller-provided packing buffers.
+ *
+ * @param P_packed Packing buffer of P (GEMM_P_BUFFER_SIZE(M, K) values, aligned).
+ * @param Q_packed Packing buffer of Q (GEMM_Q_BUFFER_SIZE(N, K) values, aligned).
+ */
+
+void FN(blocked_matrix_product_packed)(index_t M, index_t N, index_t K, REAL alpha, const REAL *P, index_t ldp,
+				   const REAL *Q, index_t ldq, REAL beta, REAL *C, index_t ldc,
+				   REAL *P_packed, REAL *Q_packed) {
+
+    FN(blocked_general_product_packed)(0, 0, M, N, K, alpha, P, ldp, Q, ldq, beta, C, ldc, P_packed, Q_packed);
+
+}
+
+/**
+ * @brief Computes C = alpha * P * Q + beta * C with a cache-blocked, packed GEMM engine.
+ *
+ * Allocates the packing buffers and runs blocked_matrix_product_packed.
+ *
+ * @param M Number of rows of P and C.
+ * @param N Number of columns of Q and C.
+ * @param K Number of columns of P and rows of Q.
+ * @param alpha Scalar applied to the product.
+ * @param P Pointer to the first matrix (size: M x K, leading dimension ldp).
+ * @param ldp Leading dimension of P (must be >= K).
+ * @param Q Pointer to the second matrix (size: K x N, leading dimension ldq).
+ * @param ldq Leading dimension of Q (must be >= N).
+ * @param beta Scalar applied to C before accumulation.
+ * @param C Pointer to the output matrix (size: M x N, leading dimension ldc).
+ * @param ldc Leading dimension of C (must be >= N).
+ *
+ * @return 0 on success, or -1 on failure due to memory allocation errors.
+ */
+
+int FN(blocked_matrix_product)(index_t M, index_t N, index_t K, REAL alpha, const REAL *P, index_t ldp,
+			   const REAL *Q, index_t ldq, REAL beta, REAL *C, index_t ldc) {
+
+    return FN(blocked_general_product)(0, 0, M, N, K, alpha, P, ldp, Q, ldq, beta, C, ldc);
+
+}
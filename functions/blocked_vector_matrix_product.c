@@ -0,0 +1,252 @@
+#include "kernels.h"
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86
+#endif
+
+/*
+ * A matrix-vector product performs one multiply-add per element of A, so it is
+ * bound by the bandwidth at which A is streamed. The kernels below read each
+ * element of A once and keep everything else in registers or L1:
+ * - GEMV_ROWS rows of A are walked together, so every value of X loaded is
+ *   used GEMV_ROWS times and each row has its own vector accumulators;
+ * - when several vectors are applied, the columns are cut in chunks of
+ *   GEMV_KC, and every chunk of the GEMV_ROWS rows is reused from L1 by all
+ *   vectors before moving on, so A still crosses the memory bus only once.
+ */
+
+/**
+ * @brief Vectors accumulated together by the multi-vector kernel.
+ */
+
+#define GEMV_VECTORS 2
+
+/**
+ * @brief Columns of A per chunk: GEMV_ROWS x GEMV_KC values (32 KB in double) stay in L1.
+ */
+
+#define GEMV_KC 1024
+
+/**
+ * @brief Columns of the transposed product per chunk: the GEMV_T_KC results (16 KB in double) stay in L1.
+ */
+
+#define GEMV_T_KC 2048
+
+/**
+ * @brief Y[r] += A_r . X for the GEMV_ROWS rows of A starting at A.
+ *
+ * The reductions give each row its own vector accumulator, which the compiler
+ * maps onto the registers of the target instruction set.
+ */
+
+#define DEFINE_GEMV_ROWS(SUFFIX, TARGET)				\
+    TARGET static void gemv_rows_##SUFFIX(index_t n, const REAL *restrict A, index_t lda, \
+					  const REAL *restrict X, REAL *restrict Y) { \
+	const REAL *A0 = A, *A1 = A + lda, *A2 = A + 2 * lda, *A3 = A + 3 * lda; \
+	REAL s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;			\
+	_Pragma("omp simd reduction(+:s0, s1, s2, s3)")			\
+	for (index_t j = 0; j < n; j++) {				\
+	    REAL x = X[j];						\
+	    s0 += A0[j] * x;						\
+	    s1 += A1[j] * x;						\
+	    s2 += A2[j] * x;						\
+	    s3 += A3[j] * x;						\
+	}								\
+	Y[0] += s0;							\
+	Y[1] += s1;							\
+	Y[2] += s2;							\
+	Y[3] += s3;							\
+    }
+
+/**
+ * @brief Y_v[r] += A_r . X_v for GEMV_ROWS rows of A and GEMV_VECTORS vectors.
+ *
+ * Vector v starts at X + v * ldx and its result at Y + v * ldy.
+ */
+
+#define DEFINE_GEMV_BLOCK(SUFFIX, TARGET)				\
+    TARGET static void gemv_block_##SUFFIX(index_t n, const REAL *restrict A, index_t lda, \
+					   const REAL *restrict X, index_t ldx, \
+					   REAL *restrict Y, index_t ldy) {	\
+	const REAL *A0 = A, *A1 = A + lda, *A2 = A + 2 * lda, *A3 = A + 3 * lda; \
+	const REAL *X0 = X, *X1 = X + ldx;				\
+	REAL s00 = 0.0, s10 = 0.0, s20 = 0.0, s30 = 0.0;		\
+	REAL s01 = 0.0, s11 = 0.0, s21 = 0.0, s31 = 0.0;		\
+	_Pragma("omp simd reduction(+:s00, s10, s20, s30, s01, s11, s21, s31)") \
+	for (index_t j = 0; j < n; j++) {				\
+	    REAL x0 = X0[j], x1 = X1[j];				\
+	    REAL a0 = A0[j], a1 = A1[j], a2 = A2[j], a3 = A3[j];	\
+	    s00 += a0 * x0; s10 += a1 * x0; s20 += a2 * x0; s30 += a3 * x0; \
+	    s01 += a0 * x1; s11 += a1 * x1; s21 += a2 * x1; s31 += a3 * x1; \
+	}								\
+	Y[0] += s00; Y[1] += s10; Y[2] += s20; Y[3] += s30;		\
+	Y[ldy] += s01; Y[ldy + 1] += s11; Y[ldy + 2] += s21; Y[ldy + 3] += s31; \
+    }
+
+/**
+ * @brief Y += X[0] A_0 + ... + X[3] A_3 for the GEMV_ROWS rows of A starting at A.
+ *
+ * Each result is loaded and stored once for GEMV_ROWS rows instead of once per row.
+ */
+
+#define DEFINE_GEMV_T_ROWS(SUFFIX, TARGET)				\
+    TARGET static void gemv_t_rows_##SUFFIX(index_t n, const REAL *restrict A, index_t lda, \
+					    const REAL *restrict X, REAL *restrict Y) { \
+	const REAL *A0 = A, *A1 = A + lda, *A2 = A + 2 * lda, *A3 = A + 3 * lda; \
+	REAL x0 = X[0], x1 = X[1], x2 = X[2], x3 = X[3];		\
+	_Pragma("omp simd")						\
+	for (index_t j = 0; j < n; j++)					\
+	    Y[j] += x0 * A0[j] + x1 * A1[j] + x2 * A2[j] + x3 * A3[j];	\
+    }
+
+#define DEFINE_GEMV_KERNELS(SUFFIX, TARGET)	\
+    DEFINE_GEMV_ROWS(SUFFIX, TARGET)		\
+    DEFINE_GEMV_BLOCK(SUFFIX, TARGET)		\
+    DEFINE_GEMV_T_ROWS(SUFFIX, TARGET)
+
+/**
+ * @brief Matrix-vector kernels compiled for one instruction set.
+ *
+ * @struct gemv_kernels
+ * @var gemv_kernels::name
+ * Name of the instruction set, matching simd_kernels::name.
+ * @var gemv_kernels::rows
+ * GEMV_ROWS rows against one vector.
+ * @var gemv_kernels::block
+ * GEMV_ROWS rows against GEMV_VECTORS vectors.
+ * @var gemv_kernels::transposed_rows
+ * GEMV_ROWS rows accumulated into the transposed product.
+ */
+
+typedef struct gemv_kernels {
+
+    const char *name;
+
+    void (*rows)(index_t n, const REAL *A, index_t lda, const REAL *X, REAL *Y);
+    void (*block)(index_t n, const REAL *A, index_t lda, const REAL *X, index_t ldx, REAL *Y, index_t ldy);
+    void (*transposed_rows)(index_t n, const REAL *A, index_t lda, const REAL *X, REAL *Y);
+
+} gemv_kernels;
+
+#define GEMV_KERNELS_TABLE(NAME, SUFFIX) { NAME, gemv_rows_##SUFFIX, gemv_block_##SUFFIX, gemv_t_rows_##SUFFIX }
+
+DEFINE_GEMV_KERNELS(generic, )
+
+#ifdef SIMD_X86
+DEFINE_GEMV_KERNELS(sse2, __attribute__((target("sse2"))))
+DEFINE_GEMV_KERNELS(avx2, __attribute__((target("avx2,fma"))))
+DEFINE_GEMV_KERNELS(avx512, __attribute__((target("avx512f"))))
+#endif
+
+static const gemv_kernels gemv_kernels_tables[] = {
+    GEMV_KERNELS_TABLE("generic", generic),
+#ifdef SIMD_X86
+    GEMV_KERNELS_TABLE("sse2", sse2),
+    GEMV_KERNELS_TABLE("avx2", avx2),
+    GEMV_KERNELS_TABLE("avx512", avx512),
+#endif
+};
+
+/**
+ * @brief Returns the matrix-vector kernels of the instruction set selected in simd_kernels.c.
+ */
+
+static const gemv_kernels *active_gemv_kernels(void) {
+
+    const char *name = FN(active_kernels)->name;
+
+    for (size_t i = 0; i < sizeof(gemv_kernels_tables) / sizeof(gemv_kernels_tables[0]); i++)
+	if (!strcmp(gemv_kernels_tables[i].name, name))
+	    return &gemv_kernels_tables[i];
+
+    return &gemv_kernels_tables[0];
+
+}
+
+/**
+ * @brief Computes Y_v = A * X_v for several vectors, streaming A once.
+ *
+ * Rows are taken GEMV_ROWS at a time; the few rows left at the bottom use the
+ * dot product of the selected instruction set.
+ *
+ * @param rows Number of rows of A.
+ * @param columns Number of columns of A.
+ * @param A Pointer to the matrix (size: rows x columns, leading dimension lda).
+ * @param lda Leading dimension of A (must be >= columns).
+ * @param X Pointer to the first vector; vector v starts at X + v * ldx.
+ * @param ldx Distance between two vectors of X (must be >= columns).
+ * @param vectors Number of vectors.
+ * @param Y Pointer to the first result; result v starts at Y + v * ldy.
+ * @param ldy Distance between two results (must be >= rows).
+ */
+
+void FN(blocked_vector_matrix_product)(index_t rows, index_t columns, const REAL *A, index_t lda,
+				       const REAL *X, index_t ldx, index_t vectors, REAL *Y, index_t ldy) {
+
+    const simd_kernels *kernels = FN(active_kernels);
+    const gemv_kernels *gemv = active_gemv_kernels();
+
+    for (index_t v = 0; v < vectors; v++)
+	for (index_t i = 0; i < rows; i++)
+	    Y[v * ldy + i] = 0.0;
+
+    index_t full_rows = rows - rows % GEMV_ROWS;
+
+    for (index_t i = 0; i < full_rows; i += GEMV_ROWS) {
+	for (index_t jc = 0; jc < columns; jc += GEMV_KC) {
+	    index_t kc = (columns - jc < GEMV_KC) ? columns - jc : GEMV_KC;
+	    const REAL *A_block = A + i * lda + jc;
+
+	    index_t v = 0;
+
+	    for (; v + GEMV_VECTORS <= vectors; v += GEMV_VECTORS)
+		gemv->block(kc, A_block, lda, X + v * ldx + jc, ldx, Y + v * ldy + i, ldy);
+	    for (; v < vectors; v++)
+		gemv->rows(kc, A_block, lda, X + v * ldx + jc, Y + v * ldy + i);
+	}
+    }
+
+    for (index_t i = full_rows; i < rows; i++)
+	for (index_t v = 0; v < vectors; v++)
+	    Y[v * ldy + i] = kernels->dot(A + i * lda, X + v * ldx, columns);
+
+}
+
+/**
+ * @brief Computes Y = A^T * X by accumulating the rows of A, without forming the transpose.
+ *
+ * A is read row after row, GEMV_ROWS rows at a time, and the columns are cut in
+ * chunks of GEMV_T_KC so that the part of Y being accumulated stays in L1.
+ *
+ * @param rows Number of rows of A (and size of X).
+ * @param columns Number of columns of A (and size of Y).
+ * @param A Pointer to the matrix (size: rows x columns, leading dimension lda).
+ * @param lda Leading dimension of A (must be >= columns).
+ * @param X Pointer to the vector (size: rows).
+ * @param Y Pointer to the result (size: columns), overwritten.
+ */
+
+void FN(blocked_transposed_vector_matrix_product)(index_t rows, index_t columns, const REAL *A, index_t lda,
+						  const REAL *X, REAL *Y) {
+
+    const simd_kernels *kernels = FN(active_kernels);
+    const gemv_kernels *gemv = active_gemv_kernels();
+
+    for (index_t j = 0; j < columns; j++)
+	Y[j] = 0.0;
+
+    index_t full_rows = rows - rows % GEMV_ROWS;
+
+    for (index_t jc = 0; jc < columns; jc += GEMV_T_KC) {
+	index_t kc = (columns - jc < GEMV_T_KC) ? columns - jc : GEMV_T_KC;
+
+	for (index_t i = 0; i < full_rows; i += GEMV_ROWS)
+	    gemv->transposed_rows(kc, A + i * lda + jc, lda, X + i, Y + jc);
+
+	for (index_t i = full_rows; i < rows; i++)
+	    kernels->axpy(X[i], A + i * lda + jc, Y + jc, kc);
+    }
+
+}
@@ -0,0 +1,183 @@
+#include "kernels.h"
+#include <omp.h>
+
+/**
+ * @brief Checks the arguments of C = alpha * op(A) * op(B) + beta * C.
+ *
+ * @return 0 if the arguments are valid, or -1 after printing the reason.
+ */
+
+static int check_general_product(const char *name, int transpose_A, int transpose_B, index_t M, index_t N, index_t K,
+				 const REAL *A, index_t lda, const REAL *B, index_t ldb, const REAL *C, index_t ldc) {
+
+    if (M < 0 || N < 0 || K < 0) {
+        fprintf(stderr, "Error: Invalid dimensions for %s (M=%" PRId64 ", N=%" PRId64 ", K=%" PRId64 "). All dimensions must be non-negative.\n",
+                name, M, N, K);
+        return -1;
+    }
+
+    index_t A_rows = transpose_A ? K : M, A_columns = transpose_A ? M : K;
+    index_t B_rows = transpose_B ? N : K, B_columns = transpose_B ? K : N;
+
+    if (lda < (A_columns > 1 ? A_columns : 1) || ldb < (B_columns > 1 ? B_columns : 1) || ldc < (N > 1 ? N : 1)) {
+        fprintf(stderr, "Error: Leading dimensions too small in %s (lda=%" PRId64 ", ldb=%" PRId64 ", ldc=%" PRId64 " for %" PRId64 ", %" PRId64 " and %" PRId64 " columns).\n",
+                name, lda, ldb, ldc, A_columns, B_columns, N);
+        return -1;
+    }
+
+    if (M == 0 || N == 0) return 0;
+
+    if (!C || (K > 0 && (!A || !B))) {
+        fprintf(stderr, "Error: Null pointer detected in %s.\n", name);
+        return -1;
+    }
+
+    size_t C_extent = (size_t) (M - 1) * ldc + N;
+
+    if (K > 0 && (ranges_overlap(C, C_extent, A, (size_t) (A_rows - 1) * lda + A_columns) ||
+		  ranges_overlap(C, C_extent, B, (size_t) (B_rows - 1) * ldb + B_columns))) {
+        fprintf(stderr, "Error: Output matrix overlaps an input matrix in %s.\n", name);
+        return -1;
+    }
+
+    return 0;
+
+}
+
+/**
+ * @brief Chooses the width of the tiles of C handed to the threads.
+ *
+ * Tiles are GEMM_MC rows high; their width starts at a quarter of the L3 panel
+ * and is halved (down to 128 columns) until every thread gets about four tiles,
+ * so the dynamic schedule can balance the load.
+ */
+
+static index_t tile_columns(index_t rows, index_t columns, int threads) {
+
+    index_t width = GEMM_NC / 2;
+    index_t row_tiles = (rows + GEMM_MC - 1) / GEMM_MC;
+
+    while (width > 128 && row_tiles * ((columns + width - 1) / width) < 4 * threads)
+	width /= 2;
+
+    return width;
+
+}
+
+/**
+ * @brief Computes the general matrix product C = alpha * op(A) * op(B) + beta * C sequentially.
+ *
+ * op(X) is X when the flag is OP_NO_TRANSPOSE and X^T when it is OP_TRANSPOSE.
+ * Transposed operands are read in place by the packing stage of the blocked
+ * engine: no transposed copy, temporary product or separate addition is made.
+ * Matrices are row-major and addressed through their leading dimensions, so any
+ * sub-block of a bigger matrix can be used. When beta is 0, C is only written.
+ *
+ * @param transpose_A OP_NO_TRANSPOSE or OP_TRANSPOSE.
+ * @param transpose_B OP_NO_TRANSPOSE or OP_TRANSPOSE.
+ * @param M Number of rows of op(A) and C (must be non-negative).
+ * @param N Number of columns of op(B) and C (must be non-negative).
+ * @param K Number of columns of op(A) and rows of op(B) (must be non-negative).
+ * @param alpha Scalar applied to the product.
+ * @param A Pointer to A (size: M x K, or K x M when transposed).
+ * @param lda Leading dimension of A (at least its number of columns).
+ * @param B Pointer to B (size: K x N, or N x K when transposed).
+ * @param ldb Leading dimension of B (at least its number of columns).
+ * @param beta Scalar applied to C before accumulation.
+ * @param C Pointer to the output matrix (size: M x N), must not overlap A or B.
+ * @param ldc Leading dimension of C (at least N).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         aliased output, or memory allocation errors.
+ */
+
+int FN(general_matrix_product)(int transpose_A, int transpose_B, index_t M, index_t N, index_t K, REAL alpha,
+			   REAL *A, index_t lda, REAL *B, index_t ldb, REAL beta, REAL *C, index_t ldc) {
+
+    if (check_general_product("general_matrix_product", transpose_A, transpose_B, M, N, K, A, lda, B, ldb, C, ldc))
+	return -1;
+
+    return FN(blocked_general_product)(transpose_A, transpose_B, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+
+}
+
+/**
+ * @brief Computes the general matrix product C = alpha * op(A) * op(B) + beta * C in parallel using OpenMP.
+ *
+ * Same as general_matrix_product. C is split into 2D tiles of cache-sized
+ * blocks that a single team of threads shares out dynamically; each thread runs
+ * the packed engine on its tiles with its own packing buffers.
+ *
+ * @param transpose_A OP_NO_TRANSPOSE or OP_TRANSPOSE.
+ * @param transpose_B OP_NO_TRANSPOSE or OP_TRANSPOSE.
+ * @param M Number of rows of op(A) and C (must be non-negative).
+ * @param N Number of columns of op(B) and C (must be non-negative).
+ * @param K Number of columns of op(A) and rows of op(B) (must be non-negative).
+ * @param alpha Scalar applied to the product.
+ * @param A Pointer to A (size: M x K, or K x M when transposed).
+ * @param lda Leading dimension of A (at least its number of columns).
+ * @param B Pointer to B (size: K x N, or N x K when transposed).
+ * @param ldb Leading dimension of B (at least its number of columns).
+ * @param beta Scalar applied to C before accumulation.
+ * @param C Pointer to the output matrix (size: M x N), must not overlap A or B.
+ * @param ldc Leading dimension of C (at least N).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         aliased output, or memory allocation errors.
+ */
+
+int FN(parallel_general_matrix_product)(int transpose_A, int transpose_B, index_t M, index_t N, index_t K, REAL alpha,
+				    REAL *A, index_t lda, REAL *B, index_t ldb, REAL beta, REAL *C, index_t ldc) {
+
+    if (check_general_product("parallel_general_matrix_product", transpose_A, transpose_B, M, N, K, A, lda, B, ldb, C, ldc))
+	return -1;
+
+    if (M == 0 || N == 0) return 0;
+
+    index_t tile_width = tile_columns(M, N, omp_get_max_threads());
+    index_t row_tiles = (M + GEMM_MC - 1) / GEMM_MC;
+    index_t column_tiles = (N + tile_width - 1) / tile_width;
+    int failed = 0;
+
+#pragma omp parallel shared(failed)
+    {
+	// One pair of packing buffers per thread, reused for all its tiles
+	REAL *A_packed = aligned_buffer(sizeof(REAL) * GEMM_P_BUFFER_SIZE(GEMM_MC, K));
+	REAL *B_packed = aligned_buffer(sizeof(REAL) * GEMM_Q_BUFFER_SIZE(tile_width, K));
+
+	if (!A_packed || !B_packed) {
+#pragma omp atomic write
+	    failed = 1;
+	}
+
+#pragma omp barrier
+
+	if (!failed) {
+#pragma omp for collapse(2) schedule(dynamic)
+	    for (index_t ti = 0; ti < row_tiles; ti++) {
+		for (index_t tj = 0; tj < column_tiles; tj++) {
+		    index_t i = ti * GEMM_MC;
+		    index_t j = tj * tile_width;
+		    index_t m = (M - i < GEMM_MC) ? M - i : GEMM_MC;
+		    index_t n = (N - j < tile_width) ? N - j : tile_width;
+		    const REAL *A_tile = transpose_A ? A + i : A + (size_t) i * lda;
+		    const REAL *B_tile = transpose_B ? B + (size_t) j * ldb : B + j;
+		    FN(blocked_general_product_packed)(transpose_A, transpose_B, m, n, K, alpha, A_tile, lda,
+						   B_tile, ldb, beta, C + (size_t) i * ldc + j, ldc,
+						   A_packed, B_packed);
+		}
+	    }
+	}
+
+	free(A_packed);
+	free(B_packed);
+    }
+
+    if (failed) {
+        fprintf(stderr, "Error: Memory allocation failed for packing buffers in parallel_general_matrix_product.\n");
+        return -1;
+    }
+
+    return 0;
+
+}
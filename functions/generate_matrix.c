@@ -1,4 +1,4 @@
-#include "LinearAlgebraBasics.h"
+#include "precision.h"
 #define DOUBLE 100.0
 
 /**
@@ -15,25 +15,25 @@
  *
  */
 
-double *generate_matrix_double (int rows, int columns) {
+REAL *TYPED(generate_matrix) (index_t rows, index_t columns) {
 
     if (rows <= 0 || columns <= 0) {
-        fprintf(stderr, "Error: invalid dimensions (rows=%d, columns=%d). Both must be positive..\n", rows, columns);
+        fprintf(stderr, "Error: invalid dimensions (rows=%" PRId64 ", columns=%" PRId64 "). Both must be positive..\n", rows, columns);
         return NULL;
     }
 
-    double *matrix = malloc((rows * columns) * sizeof(double));
+    REAL *matrix = malloc((rows * columns) * sizeof(REAL));
 
     if (!matrix) {
-        fprintf(stderr, "Error: memory allocation failed for a matrix of size %dx%d.\n", rows, columns);
+        fprintf(stderr, "Error: memory allocation failed for a matrix of size %" PRId64 "x%" PRId64 ".\n", rows, columns);
         return NULL;
     }
     
     srand(time(NULL));
 
-    for (int i = 0; i < rows; i++) 
-	for (int j = 0; j < columns; j++) 
-	    matrix[i * columns + j] = (double) (rand()) / RAND_MAX * DOUBLE;    
+    for (index_t i = 0; i < rows; i++) 
+	for (index_t j = 0; j < columns; j++) 
+	    matrix[i * columns + j] = (REAL) (rand()) / RAND_MAX * DOUBLE;    
 
      return matrix;
 
@@ -51,22 +51,22 @@ double *generate_matrix_double (int rows, int columns) {
  *         or memory allocation errors.
  */
 
-double *generate_identity_matrix (int dimension) {
+REAL *FN(generate_identity_matrix) (index_t dimension) {
 
     if (dimension <= 0) {
-        fprintf(stderr, "Error: Invalid dimension (%d). Must be strictly positive.\n", dimension);
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", dimension);
         return NULL;
     }
 
-    double *matrix = malloc((dimension * dimension) * sizeof(double));
+    REAL *matrix = malloc((dimension * dimension) * sizeof(REAL));
 
     if (!matrix) {
-        fprintf(stderr, "Error: Memory allocation failed for identity matrix of size %dx%d.\n", dimension, dimension);
+        fprintf(stderr, "Error: Memory allocation failed for identity matrix of size %" PRId64 "x%" PRId64 ".\n", dimension, dimension);
         return NULL;
     }
 
-    for (int i = 0; i < dimension; i++) {
-	for (int j = 0; j < dimension; j++) {
+    for (index_t i = 0; i < dimension; i++) {
+	for (index_t j = 0; j < dimension; j++) {
 	    if (i == j) matrix[i * dimension + j] = 1.0;
 	    else matrix[i * dimension + j] = 0.0;
 	}
@@ -1,4 +1,4 @@
-#include "LinearAlgebraBasics.h"
+#include "kernels.h"
 #include <string.h>
 
 // ASSERTION : THE USER WILL ALWAYS GIVE MATRICES OF THE RIGHT SIZE AS INPUT
@@ -18,10 +18,10 @@
  *         null pointers, or memory allocation errors.
  */
 
-double *matrices_addition(double *A, double *B, int rows, int columns) {
+REAL *FN(matrices_addition)(REAL *A, REAL *B, index_t rows, index_t columns) {
 
     if (rows <= 0 || columns <= 0) {
-        fprintf(stderr, "Error: Invalid dimensions for matrix addition (rows=%d, columns=%d). Both must be strictly positive.\n", rows, columns);
+        fprintf(stderr, "Error: Invalid dimensions for matrix addition (rows=%" PRId64 ", columns=%" PRId64 "). Both must be strictly positive.\n", rows, columns);
         return NULL;
     }
 
@@ -30,21 +30,55 @@ double *matrices_addition(double *A, double *B, int rows, int columns) {
         return NULL;
     }
 
-    double *matrix = malloc(rows * columns * sizeof(double));
+    REAL *matrix = malloc(rows * columns * sizeof(REAL));
 
     if (!matrix) {
         fprintf(stderr, "Error: Memory allocation failed for result matrix in matrices_addition.\n");
         return NULL;
     }
 
-    for (int i = 0; i < rows; i++)
-	for (int j = 0; j < columns; j++)
-	    matrix[i * columns + j] = A[i * columns + j] + B[i * columns + j];
+    FN(matrices_addition_into)(A, B, rows, columns, matrix);
 
     return matrix;
 
 }
 
+/**
+ * @brief Adds two matrices A and B of the same size into a caller-provided matrix.
+ *
+ * Same as matrices_addition, without allocating the result. C may be A or B
+ * (in-place addition).
+ *
+ * @param A Pointer to the first input matrix (size: rows x columns).
+ * @param B Pointer to the second input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrices (must be positive).
+ * @param columns Number of columns in the matrices (must be positive).
+ * @param C Pointer to the output matrix (size: rows x columns).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions or null pointers.
+ */
+
+int FN(matrices_addition_into)(REAL *A, REAL *B, index_t rows, index_t columns, REAL *C) {
+
+    if (rows <= 0 || columns <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions for matrix addition (rows=%" PRId64 ", columns=%" PRId64 "). Both must be strictly positive.\n", rows, columns);
+        return -1;
+    }
+
+    if (!A || !B || !C) {
+        fprintf(stderr, "Error: Null pointer detected in matrices_addition_into.\n");
+        return -1;
+    }
+
+    size_t size = (size_t) rows * columns;
+
+    for (size_t i = 0; i < size; i++)
+	C[i] = A[i] + B[i];
+
+    return 0;
+
+}
+
 /**
  * @brief Multiplies a matrix A by a scalar value.
  *
@@ -60,14 +94,14 @@ double *matrices_addition(double *A, double *B, int rows, int columns) {
  *         null pointers, or memory allocation errors.
  */
 
-double *matrix_scalar_multiplication(double *A, int rows, int columns, int scalar) {
+REAL *FN(matrix_scalar_multiplication)(REAL *A, index_t rows, index_t columns, int scalar) {
 
     if (rows <= 0 || columns <= 0) {
-        fprintf(stderr, "Error: Invalid dimensions for scalar multiplication (rows=%d, columns=%d). Both must be strictly positive.\n", rows, columns);
+        fprintf(stderr, "Error: Invalid dimensions for scalar multiplication (rows=%" PRId64 ", columns=%" PRId64 "). Both must be strictly positive.\n", rows, columns);
         return NULL;
     }
 
-    double *matrix = malloc(rows * columns * sizeof(double));
+    REAL *matrix = malloc(rows * columns * sizeof(REAL));
 
     if (!A) {
         fprintf(stderr, "Error: Null pointer detected for input matrix in matrix_scalar_multiplication.\n");
@@ -79,14 +113,48 @@ double *matrix_scalar_multiplication(double *A, int rows, int columns, int scala
         return NULL;
     }
     
-    for (int i = 0; i < rows; i++)
-	for (int j = 0; j < columns; j++)
-	    matrix[i * columns + j] = scalar * A[i * columns + j];
+    FN(matrix_scalar_multiplication_into)(A, rows, columns, scalar, matrix);
 
     return matrix;
 	       
 }
 
+/**
+ * @brief Multiplies a matrix A by a scalar value into a caller-provided matrix.
+ *
+ * Same as matrix_scalar_multiplication, without allocating the result. C may
+ * be A (in-place scaling).
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive).
+ * @param scalar Scalar value to multiply each element by.
+ * @param C Pointer to the output matrix (size: rows x columns).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions or null pointers.
+ */
+
+int FN(matrix_scalar_multiplication_into)(REAL *A, index_t rows, index_t columns, int scalar, REAL *C) {
+
+    if (rows <= 0 || columns <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions for scalar multiplication (rows=%" PRId64 ", columns=%" PRId64 "). Both must be strictly positive.\n", rows, columns);
+        return -1;
+    }
+
+    if (!A || !C) {
+        fprintf(stderr, "Error: Null pointer detected in matrix_scalar_multiplication_into.\n");
+        return -1;
+    }
+
+    size_t size = (size_t) rows * columns;
+
+    for (size_t i = 0; i < size; i++)
+	C[i] = scalar * A[i];
+
+    return 0;
+
+}
+
 /**
  * @brief Computes the transpose of a given matrix A.
  *
@@ -100,10 +168,10 @@ double *matrix_scalar_multiplication(double *A, int rows, int columns, int scala
  *         null pointers, or memory allocation errors.
  */
 
-double *matrix_transpose(double *A, int rows, int columns) {
+REAL *FN(matrix_transpose)(REAL *A, index_t rows, index_t columns) {
 
     if (rows <= 0 || columns <= 0) {
-        fprintf(stderr, "Error: Invalid dimensions for transpose (rows=%d, columns=%d). Both must be strictly positive.\n", rows, columns);
+        fprintf(stderr, "Error: Invalid dimensions for transpose (rows=%" PRId64 ", columns=%" PRId64 "). Both must be strictly positive.\n", rows, columns);
         return NULL;
     }
 
@@ -112,21 +180,68 @@ double *matrix_transpose(double *A, int rows, int columns) {
         return NULL;
     }
 
-    double *matrix = malloc(rows * columns * sizeof(double));
+    REAL *matrix = malloc(rows * columns * sizeof(REAL));
 
     if (!matrix) {
         fprintf(stderr, "Error: Memory allocation failed for transposed matrix.\n");
         return NULL;
     }
     
-    for (int i = 0; i < columns; i++)
-	for (int j = 0; j < rows; j++)
-	    matrix[i * rows + j] = A[j * columns + i];
+    FN(matrix_transpose_into)(A, rows, columns, matrix);
 
     return matrix;
 
 }
 
+/**
+ * @brief Computes the transpose of a given matrix A into a caller-provided matrix.
+ *
+ * Same as matrix_transpose, without allocating the result. C may be A only when
+ * the matrix is square (in-place transpose); otherwise C must not overlap A.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the input matrix (must be positive).
+ * @param columns Number of columns in the input matrix (must be positive).
+ * @param C Pointer to the output matrix (size: columns x rows).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers or aliased output.
+ */
+
+int FN(matrix_transpose_into)(REAL *A, index_t rows, index_t columns, REAL *C) {
+
+    if (rows <= 0 || columns <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions for transpose (rows=%" PRId64 ", columns=%" PRId64 "). Both must be strictly positive.\n", rows, columns);
+        return -1;
+    }
+
+    if (!A || !C) {
+        fprintf(stderr, "Error: Null pointer detected in matrix_transpose_into.\n");
+        return -1;
+    }
+
+    if (C == A && rows == columns) {
+	for (index_t i = 0; i < rows; i++)
+	    for (index_t j = i + 1; j < columns; j++) {
+		REAL tmp = A[i * columns + j];
+		A[i * columns + j] = A[j * columns + i];
+		A[j * columns + i] = tmp;
+	    }
+	return 0;
+    }
+
+    if (ranges_overlap(C, (size_t) rows * columns, A, (size_t) rows * columns)) {
+        fprintf(stderr, "Error: Output matrix overlaps the input matrix in matrix_transpose_into (in-place transpose requires a square matrix).\n");
+        return -1;
+    }
+
+    for (index_t i = 0; i < columns; i++)
+	for (index_t j = 0; j < rows; j++)
+	    C[i * rows + j] = A[j * columns + i];
+
+    return 0;
+
+}
+
 /**
  * @brief Computes the trace of a square matrix A.
  *
@@ -139,10 +254,10 @@ double *matrix_transpose(double *A, int rows, int columns) {
  *         or null pointers.
  */
 
-double matrix_trace(double *A, int dimension) {
+REAL FN(matrix_trace)(REAL *A, index_t dimension) {
 
     if (dimension <= 0) {
-        fprintf(stderr, "Error: Invalid dimension (%d). Must be strictly positive.\n", dimension);
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", dimension);
         return -1.0;
     }
 
@@ -151,9 +266,9 @@ double matrix_trace(double *A, int dimension) {
         return -1.0;
     }
 
-    double trace = 0.0;
+    REAL trace = 0.0;
 
-    for (int i = 0; i < dimension; i++) 
+    for (index_t i = 0; i < dimension; i++) 
         trace += A[i * dimension + i];
 	
     return trace;
@@ -173,12 +288,12 @@ double matrix_trace(double *A, int dimension) {
  *         null pointers, or memory allocation errors during transposition.
  */
 
-double matrix_norm(double *A, int rows, int columns) {
+REAL FN(matrix_norm)(REAL *A, index_t rows, index_t columns) {
 
     // 1-NORM
 
     if (rows <= 0 || columns <= 0) {
-        fprintf(stderr, "Error: Invalid dimensions for matrix norm computation (rows=%d, columns=%d). Both must be strictly positive.\n", rows, columns);
+        fprintf(stderr, "Error: Invalid dimensions for matrix norm computation (rows=%" PRId64 ", columns=%" PRId64 "). Both must be strictly positive.\n", rows, columns);
         return -1.0; 
     }
 
@@ -187,18 +302,18 @@ double matrix_norm(double *A, int rows, int columns) {
         return -1.0;
     }
 
-    double max = -INFINITY;
-    double sum = 0.0;
+    REAL max = -INFINITY;
+    REAL sum = 0.0;
 
-    double *TMP = matrix_transpose(A, rows, columns);
+    REAL *TMP = FN(matrix_transpose)(A, rows, columns);
 
     if (!TMP) {
         fprintf(stderr, "Error: Failed to transpose matrix in matrix_norm.\n");
         return -1.0;
     }
     
-    for (int i = 0; i < columns; i++) {
-	for (int j = 0; j < rows; j++) {
+    for (index_t i = 0; i < columns; i++) {
+	for (index_t j = 0; j < rows; j++) {
 	    sum += TMP[i * rows + j];
 	}
 	if (max < sum) max = sum;
@@ -225,10 +340,10 @@ double matrix_norm(double *A, int rows, int columns) {
  *         or null pointers.
  */
 
-double frobenius_norm(double *A, int rows, int columns) {
+REAL FN(frobenius_norm)(REAL *A, index_t rows, index_t columns) {
 
     if (rows <= 0 || columns <= 0) {
-        fprintf(stderr, "Error: Invalid dimensions for Frobenius norm computation (rows=%d, columns=%d). Both must be strictly positive.\n", rows, columns);
+        fprintf(stderr, "Error: Invalid dimensions for Frobenius norm computation (rows=%" PRId64 ", columns=%" PRId64 "). Both must be strictly positive.\n", rows, columns);
         return -1.0;
     }
 
@@ -237,10 +352,10 @@ double frobenius_norm(double *A, int rows, int columns) {
         return -1.0; 
     }
 
-    double frobenius = 0.0;
+    REAL frobenius = 0.0;
 
-    for (int i = 0; i < rows; i++)
-	for (int j = 0; j < columns; j++)
+    for (index_t i = 0; i < rows; i++)
+	for (index_t j = 0; j < columns; j++)
 	    frobenius += pow(A[i * columns + j], 2.0);
     
     return sqrt(frobenius);
@@ -250,8 +365,9 @@ double frobenius_norm(double *A, int rows, int columns) {
 /**
  * @brief Computes the determinant of a square matrix A using LU decomposition.
  *
- * This function calculates the determinant by performing LU decomposition
- * and multiplying diagonal elements from L and U matrices. It checks for singularity during computation.
+ * This function calculates the determinant by performing LU decomposition with partial
+ * pivoting into a single compact L\U matrix and multiplying the diagonal elements of U,
+ * with one sign change per row interchange. It checks for singularity during computation.
  *
  * @param A Pointer to the input square matrix (size: rows x rows).
  * @param rows Number of rows in the square matrix (must equal columns and be positive).
@@ -261,10 +377,10 @@ double frobenius_norm(double *A, int rows, int columns) {
  *         null pointers, singularity detection, or LU decomposition failure.
  */
 
-double matrix_determinant(double *A, int rows, int columns) {
+REAL FN(matrix_determinant)(REAL *A, index_t rows, index_t columns) {
 
     if (rows <= 0 || columns <= 0 || rows != columns) {
-        fprintf(stderr, "Error: Invalid dimensions for determinant computation (rows=%d, columns=%d). Must be a square matrix.\n", rows, columns);
+        fprintf(stderr, "Error: Invalid dimensions for determinant computation (rows=%" PRId64 ", columns=%" PRId64 "). Must be a square matrix.\n", rows, columns);
         return -1.0; 
     }
 
@@ -273,30 +389,34 @@ double matrix_determinant(double *A, int rows, int columns) {
         return -1.0; 
     }
     
-    LU *LU_matrices = LU_decomposition(A, rows, columns);
+    // Compact factors L\U in a single matrix, with the row interchanges
+    REAL *LU = malloc((size_t) rows * columns * sizeof(REAL));
+    index_t *pivots = malloc(rows * sizeof(index_t));
 
-    if (!LU_matrices) {
+    if (!LU || !pivots || FN(LU_factorization_into)(A, rows, columns, LU, pivots)) {
         fprintf(stderr, "Error: LU decomposition failed during determinant computation.\n");
+        free(LU);
+        free(pivots);
         return -1.0; 
     }
 
-    double determinant = 1.0;
-    double epsilon = 1e-10;
+    REAL epsilon = 1e-10;
     
-    for (int i = 0; i < rows; i++) {
+    for (index_t i = 0; i < rows; i++) {
 	
-        determinant *= LU_matrices->L[i * columns + i];
-        determinant *= LU_matrices->U[i * columns + i];
-	
-        if (fabs(LU_matrices->L[i * columns + i]) < epsilon || fabs(LU_matrices->U[i * columns + i]) < epsilon) {
+        if (fabs(LU[i * columns + i]) < epsilon) {
             fprintf(stderr, "Error: Singular matrix detected during determinant computation.\n");
-            LU_free(LU_matrices);
+            free(LU);
+            free(pivots);
             return -1.0;
         }
 	
     }
+
+    REAL determinant = FN(LU_factored_determinant)(LU, pivots, rows);
     
-    LU_free(LU_matrices);
+    free(LU);
+    free(pivots);
     
     return determinant;
 
@@ -316,10 +436,10 @@ double matrix_determinant(double *A, int rows, int columns) {
  *         null pointers, or invalid tolerance values.
  */
 
-int has_converged(double *H, int n, double tol) {
+int FN(has_converged)(REAL *H, index_t n, REAL tol) {
 
     if (n <= 0) {
-        fprintf(stderr, "Error: Invalid dimension (%d). Must be strictly positive.\n", n);
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", n);
         return -1; 
     }
 
@@ -335,8 +455,8 @@ int has_converged(double *H, int n, double tol) {
 
     // Suppose that we only use square matrix
 
-    for (int i = 1; i < n; i++) {
-        for (int j = 0; j < i; j++) {
+    for (index_t i = 1; i < n; i++) {
+        for (index_t j = 0; j < i; j++) {
             if (fabs(H[i * n + j]) > tol) {
                 return 0;
             }
@@ -347,110 +467,533 @@ int has_converged(double *H, int n, double tol) {
 		 
 }
 
+/*
+ * Eigenvalues of a general matrix. A is reduced once to upper Hessenberg form
+ * H = Q^T A Q, then Francis double-shift QR steps run on the active window of H:
+ * each step chases a 3 x 3 bulge down the subdiagonal in O(n^2) operations,
+ * with the two eigenvalues of the trailing 2 x 2 block as shifts so that complex
+ * shifts stay in real arithmetic. Negligible subdiagonal elements split the window,
+ * and the 1 x 1 and 2 x 2 blocks left at its bottom give the real eigenvalues
+ * and the complex-conjugate pairs. Only the eigenvalues are wanted, so a step
+ * updates the window and not the rows and columns of H outside of it.
+ */
+
+/**
+ * @brief Columns reduced together by the Hessenberg reduction (width of a panel and of its block reflector).
+ */
+
+#define HESSENBERG_BLOCK 32
+
 /**
- * @brief Computes eigenvalues of a square matrix using QR decomposition with iterative refinement.
+ * @brief Rows updated together by the deferred right updates of a QR sweep.
+ */
+
+#define FRANCIS_ROWS 4
+
+/*
+ * Blocked Householder reduction of the square matrix H (n x n) to upper Hessenberg form, in place:
+ * H <- Q^T H Q with Q = H_0 ... H_{n-3}, the reflector H_k acting on rows and columns k + 1 .. n - 1.
+ * For a panel of nb columns starting at column p, the block reflector I - V T V^T and Y = H V T
+ * (n x nb) are accumulated column by column: a column is brought up to date from Y, V and T,
+ * reduced, and its reflector v adds tau (H v - Y V^T v) to Y, the only pass over the matrix per
+ * column. The columns right of the panel are then updated once, by GEMM: H -= Y V^T, then the
+ * block reflector from the left. Returns -1 on memory allocation errors.
+ */
+
+static int hessenberg_reduction(index_t n, REAL *H) {
+
+    if (n < 3) return 0;
+
+    const simd_kernels *kernels = FN(active_kernels);
+    index_t block = n - 2 < HESSENBERG_BLOCK ? n - 2 : HESSENBERG_BLOCK;
+
+    REAL *V = malloc(((size_t) 3 * n * block + block * block + 2 * n + block) * sizeof(REAL));
+    REAL *P_packed = aligned_buffer(sizeof(REAL) * GEMM_P_BUFFER_SIZE(n, n));
+    REAL *Q_packed = aligned_buffer(sizeof(REAL) * GEMM_Q_BUFFER_SIZE(n, n));
+
+    if (!V || !P_packed || !Q_packed) {
+	free(V);
+	free(P_packed);
+	free(Q_packed);
+	return -1;
+    }
+
+    REAL *Y = V + (size_t) n * block, *W = Y + (size_t) n * block, *T = W + (size_t) n * block;
+    REAL *b = T + block * block, *v = b + n, *u = v + n;
+
+    for (index_t p = 0; p + 2 < n; p += block) {
+
+	index_t nb = n - 2 - p < block ? n - 2 - p : block, m = n - p - 1;
+
+	for (index_t i = 0; i < nb; i++) {
+
+	    index_t j = p + i, length = n - j - 1;
+
+	    for (index_t r = 0; r < n; r++)
+		b[r] = H[r * n + j];
+
+	    if (i > 0) {
+		// Right update b -= Y V[j, :]^T, then left update b -= V T^T V^T b on rows p + 1 .. n - 1
+		for (index_t r = 0; r < n; r++)
+		    b[r] -= kernels->dot(Y + r * nb, V + (j - p - 1) * nb, i);
+
+		memset(u, 0, i * sizeof(REAL));
+
+		for (index_t r = p + 1; r < n; r++)
+		    kernels->axpy(b[r], V + (r - p - 1) * nb, u, i);
+
+		for (index_t q = i - 1; q >= 0; q--) {
+		    REAL sum = 0.0;
+		    for (index_t s = 0; s <= q; s++)
+			sum += T[s * nb + q] * u[s];
+		    u[q] = sum;
+		}
+
+		for (index_t r = p + 1; r < n; r++)
+		    b[r] -= kernels->dot(V + (r - p - 1) * nb, u, i);
+	    }
+
+	    // Reflector of b[j + 1 .. n - 1]
+	    REAL alpha = b[j + 1], norm = 0.0, tau = 0.0;
+
+	    for (index_t r = j + 2; r < n; r++)
+		norm += b[r] * b[r];
+
+	    v[0] = 1.0;
+
+	    if (norm == 0.0) {
+		for (index_t r = 1; r < length; r++)
+		    v[r] = 0.0;
+	    } else {
+		REAL beta = -copysign(sqrt(alpha * alpha + norm), alpha);
+		REAL scale = 1.0 / (alpha - beta);
+		tau = (beta - alpha) / beta;
+		for (index_t r = 1; r < length; r++) {
+		    v[r] = b[j + 1 + r] * scale;
+		    b[j + 1 + r] = 0.0;
+		}
+		b[j + 1] = beta;
+	    }
+
+	    for (index_t r = 0; r < n; r++)
+		H[r * n + j] = b[r];
+
+	    for (index_t r = p + 1; r < n; r++)
+		V[(r - p - 1) * nb + i] = r > j ? v[r - j - 1] : 0.0;
+
+	    // u = V^T v over the previous reflectors, Y[:, i] = tau (H v - Y u), T[:, i] = -tau T u
+	    memset(u, 0, i * sizeof(REAL));
+
+	    for (index_t r = j + 1; r < n; r++)
+		kernels->axpy(v[r - j - 1], V + (r - p - 1) * nb, u, i);
+
+	    for (index_t r = 0; r < n; r++)
+		Y[r * nb + i] = tau * (kernels->dot(H + r * n + j + 1, v, length) - kernels->dot(Y + r * nb, u, i));
+
+	    for (index_t q = 0; q < i; q++) {
+		REAL sum = 0.0;
+		for (index_t s = q; s < i; s++)
+		    sum += T[q * nb + s] * u[s];
+		T[q * nb + i] = -tau * sum;
+	    }
+
+	    T[i * nb + i] = tau;
+
+	    for (index_t q = i + 1; q < nb; q++)
+		T[q * nb + i] = 0.0;
+
+	}
+
+	index_t first = p + nb, columns = n - first;
+
+	if (columns == 0) continue;
+
+	// H <- H - Y V^T, then H <- (I - V T^T V^T) H, right of the panel
+	FN(blocked_general_product_packed)(OP_NO_TRANSPOSE, OP_TRANSPOSE, n, columns, nb, -1.0, Y, nb,
+					   V + (first - p - 1) * nb, nb, 1.0, H + first, n, P_packed, Q_packed);
+
+	FN(apply_block_reflector)(OP_TRANSPOSE, m, columns, nb, V, T, H + (p + 1) * n + first, n, W,
+				  P_packed, Q_packed, kernels);
+
+    }
+
+    free(V);
+    free(P_packed);
+    free(Q_packed);
+
+    return 0;
+
+}
+
+/*
+ * Reflector I - tau v v^T with v = (1, v[1], v[2]) mapping (x, y, z) to a multiple of
+ * the first unit vector, of order 2 when z is 0. tau is 0 when (y, z) is already 0.
+ */
+
+static REAL bulge_reflector(REAL x, REAL y, REAL z, REAL *v) {
+
+    REAL norm = y * y + z * z;
+
+    if (norm == 0.0) return 0.0;
+
+    REAL beta = -copysign(sqrt(x * x + norm), x);
+
+    v[1] = y / (x - beta);
+    v[2] = z / (x - beta);
+
+    return (beta - x) / beta;
+
+}
+
+/*
+ * Applies the reflector (tau, v[1], v[2]) of order 2 or 3 on rows k .. k + order - 1 of H,
+ * columns first .. last (left), or on the elements k .. k + order - 1 of one row (right).
+ */
+
+static void reflect_rows(index_t n, REAL *H, index_t k, int order, const REAL *reflector, index_t first, index_t last) {
+
+    REAL tau = reflector[0], v1 = reflector[1], v2 = reflector[2];
+    REAL *restrict r0 = H + k * n, *restrict r1 = r0 + n;
+
+    if (order == 2) {
+	for (index_t j = first; j <= last; j++) {
+	    REAL s = tau * (r0[j] + v1 * r1[j]);
+	    r0[j] -= s;
+	    r1[j] -= s * v1;
+	}
+	return;
+    }
+
+    REAL *restrict r2 = r1 + n;
+
+    for (index_t j = first; j <= last; j++) {
+	REAL s = tau * (r0[j] + v1 * r1[j] + v2 * r2[j]);
+	r0[j] -= s;
+	r1[j] -= s * v1;
+	r2[j] -= s * v2;
+    }
+
+}
+
+static inline void reflect_row(REAL *c, int order, const REAL *reflector) {
+
+    REAL tau = reflector[0], v1 = reflector[1], v2 = reflector[2];
+    REAL s = c[0] + v1 * c[1] + (order == 3 ? v2 * c[2] : 0.0);
+
+    s *= tau;
+    c[0] -= s;
+    c[1] -= s * v1;
+    if (order == 3) c[2] -= s * v2;
+
+}
+
+/*
+ * Right updates of a sweep ending at row high deferred on the rows top .. top + FRANCIS_ROWS - 1,
+ * all above high: row i receives the reflectors i .. high - 1 in order. Consecutive reflectors
+ * share two elements of a row, carried in registers, and the rows of the block are updated
+ * together so that their dependency chains overlap.
+ */
+
+static void deferred_right_updates(index_t n, REAL *H, index_t top, index_t high, const REAL *reflectors) {
+
+    index_t start = top + FRANCIS_ROWS - 1;
+    REAL *row[FRANCIS_ROWS], c0[FRANCIS_ROWS], c1[FRANCIS_ROWS];
+
+    for (index_t i = top; i < start; i++)
+	for (index_t k = i; k < start; k++)
+	    reflect_row(H + i * n + k, 3, reflectors + 3 * k);
+
+    for (int r = 0; r < FRANCIS_ROWS; r++) {
+	row[r] = H + (top + r) * n;
+	c0[r] = row[r][start];
+	c1[r] = row[r][start + 1];
+    }
+
+    for (index_t k = start; k + 1 < high; k++) {
+	REAL tau = reflectors[3 * k], v1 = reflectors[3 * k + 1], v2 = reflectors[3 * k + 2];
+	for (int r = 0; r < FRANCIS_ROWS; r++) {
+	    REAL c2 = row[r][k + 2];
+	    REAL s = tau * (c0[r] + v1 * c1[r] + v2 * c2);
+	    row[r][k] = c0[r] - s;
+	    c0[r] = c1[r] - s * v1;
+	    c1[r] = c2 - s * v2;
+	}
+    }
+
+    REAL tau = reflectors[3 * (high - 1)], v1 = reflectors[3 * (high - 1) + 1];
+
+    for (int r = 0; r < FRANCIS_ROWS; r++) {
+	REAL s = tau * (c0[r] + v1 * c1[r]);
+	row[r][high - 1] = c0[r] - s;
+	row[r][high] = c1[r] - s * v1;
+    }
+
+}
+
+/*
+ * Eigenvalues of the 2 x 2 block [a b; c d]: a real pair, or a complex-conjugate pair
+ * with the positive imaginary part first.
+ */
+
+static void block_eigenvalues(REAL a, REAL b, REAL c, REAL d, REAL *real, REAL *imaginary) {
+
+    REAL p = 0.5 * (a - d), discriminant = p * p + b * c;
+
+    if (discriminant >= 0.0) {
+	REAL z = p + copysign(sqrt(discriminant), p);
+	real[0] = d + z;
+	real[1] = z != 0.0 ? d - b * c / z : d;
+	imaginary[0] = imaginary[1] = 0.0;
+    } else {
+	real[0] = real[1] = d + p;
+	imaginary[0] = sqrt(-discriminant);
+	imaginary[1] = -imaginary[0];
+    }
+
+}
+
+/*
+ * Francis double-shift QR on the upper Hessenberg matrix H (n x n), destroyed on return.
+ * reflectors holds 3 n values. Returns -1 when a window needs more than max_iter steps to split.
+ */
+
+static int hessenberg_eigenvalues(index_t n, REAL *H, int max_iter, REAL tol, REAL *reflectors, REAL *real, REAL *imaginary) {
+
+    REAL tolerance = fmax(tol, REAL_EPSILON), norm = 0.0;
+
+    for (index_t i = 0; i < n; i++)
+	for (index_t j = i > 0 ? i - 1 : 0; j < n; j++)
+	    norm += fabs(H[i * n + j]);
+
+    index_t high = n - 1;
+    int iterations = 0;
+
+    while (high >= 0) {
+
+	// Bottom of the window: the last negligible subdiagonal element above row high
+	index_t low = high;
+
+	for (; low > 0; low--) {
+	    REAL scale = fabs(H[(low - 1) * n + low - 1]) + fabs(H[low * n + low]);
+	    if (scale == 0.0) scale = norm;
+	    if (fabs(H[low * n + low - 1]) <= tolerance * scale) {
+		H[low * n + low - 1] = 0.0;
+		break;
+	    }
+	}
+
+	if (low == high) {
+	    real[high] = H[high * n + high];
+	    imaginary[high] = 0.0;
+	    high--;
+	    iterations = 0;
+	    continue;
+	}
+
+	if (low == high - 1) {
+	    block_eigenvalues(H[low * n + low], H[low * n + high], H[high * n + low], H[high * n + high],
+			      real + low, imaginary + low);
+	    high -= 2;
+	    iterations = 0;
+	    continue;
+	}
+
+	if (iterations == max_iter) return -1;
+
+	iterations++;
+
+	// Shifts: eigenvalues of the trailing 2 x 2 block, or an exceptional pair every 10 steps
+	REAL a = H[(high - 1) * n + high - 1], b = H[(high - 1) * n + high];
+	REAL c = H[high * n + high - 1], d = H[high * n + high];
+
+	if (iterations % 10 == 0) {
+	    REAL s = fabs(c) + fabs(H[(high - 1) * n + high - 2]);
+	    a = d = 0.75 * s + d;
+	    b = -0.4375 * s;
+	    c = s;
+	}
+
+	REAL trace = a + d, determinant = a * d - b * c;
+
+	// First column of (H - s1 I)(H - s2 I) restricted to the window
+	REAL h00 = H[low * n + low], h01 = H[low * n + low + 1];
+	REAL h10 = H[(low + 1) * n + low], h11 = H[(low + 1) * n + low + 1], h21 = H[(low + 2) * n + low + 1];
+
+	REAL x = h00 * h00 + h01 * h10 - trace * h00 + determinant;
+	REAL y = h10 * (h00 + h11 - trace);
+	REAL z = h10 * h21;
+	REAL scale = fabs(x) + fabs(y) + fabs(z);
+
+	if (scale != 0.0) {
+	    x /= scale;
+	    y /= scale;
+	    z /= scale;
+	}
+
+	// Bulge chase: the reflector of step k acts on rows and columns k .. k + 2. Its right
+	// update is applied at once to rows k + 1 .. k + 3 only, which later steps read again;
+	// rows low .. k are not read by the rest of the sweep, so they receive their right
+	// updates afterwards, by blocks of FRANCIS_ROWS rows.
+	for (index_t k = low; k < high; k++) {
+
+	    int order = k + 1 < high ? 3 : 2;
+	    REAL *reflector = reflectors + 3 * k;
+
+	    reflector[1] = reflector[2] = 0.0;
+	    reflector[0] = bulge_reflector(x, y, order == 3 ? z : 0.0, reflector);
+
+	    if (reflector[0] != 0.0) {
+		reflect_rows(n, H, k, order, reflector, k > low ? k - 1 : low, high);
+
+		for (index_t i = k + 1; i <= k + 3 && i <= high; i++)
+		    reflect_row(H + i * n + k, order, reflector);
+
+		if (k > low) {
+		    H[(k + 1) * n + k - 1] = 0.0;
+		    if (order == 3) H[(k + 2) * n + k - 1] = 0.0;
+		}
+	    }
+
+	    if (k + 1 < high) {
+		x = H[(k + 1) * n + k];
+		y = H[(k + 2) * n + k];
+		if (k + 3 <= high) z = H[(k + 3) * n + k];
+	    }
+
+	}
+
+	index_t top = low;
+
+	for (; top + FRANCIS_ROWS <= high; top += FRANCIS_ROWS)
+	    deferred_right_updates(n, H, top, high, reflectors);
+
+	for (; top < high; top++)
+	    for (index_t k = top; k < high; k++)
+		reflect_row(H + top * n + k, k + 1 < high ? 3 : 2, reflectors + 3 * k);
+
+    }
+
+    return 0;
+
+}
+
+/**
+ * @brief Computes the eigenvalues of a square matrix.
  *
- * This function uses QR decomposition iteratively until convergence is achieved within
- * a specified tolerance or until reaching a maximum number of iterations. Eigenvalues are extracted from
- * diagonal elements after convergence.
+ * This function reduces a copy of A to upper Hessenberg form once, then runs Francis
+ * double-shift QR steps in O(n^2) each, splitting the active window of the iteration
+ * wherever a subdiagonal element becomes negligible. Complex-conjugate pairs are
+ * represented here by their common real part; matrix_eigenvalues_into also returns
+ * the imaginary parts.
  *
  * @param A Pointer to the input square matrix (size: rows x columns).
  * @param rows Number of rows in the input matrix (must be positive).
  * @param columns Number of columns in the input matrix (must be positive).
- * @param max_iter Maximum number of iterations for convergence.
- * @param tol Tolerance for convergence check (must be positive).
+ * @param max_iter Maximum number of QR steps spent on one eigenvalue or pair (must be positive).
+ * @param tol Relative tolerance under which a subdiagonal element is negligible (must be positive,
+ *            machine epsilon is used when smaller).
  *
- * @return Pointer to an array containing eigenvalues on success, or NULL on failure due to invalid dimensions,
-           null pointers, memory allocation errors, or lack of convergence within max_iter iterations.
+ * @return Pointer to an array containing the real parts of the eigenvalues on success, or NULL on failure
+ *         due to invalid dimensions, null pointers, memory allocation errors, or lack of convergence
+ *         within max_iter steps.
  */
 
-double *matrix_eigenvalues(double *A, int rows, int columns, int max_iter, double tol) {
-
-    // A (rows * columns) ||| Q (rows * rows) ||| R (rows * columns)
-    // A (m * n) ||| Q (m * m) ||| R (m * n)
-    // m > n with rank(A) = n
+REAL *FN(matrix_eigenvalues)(REAL *A, index_t rows, index_t columns, int max_iter, REAL tol) {
 
     if (rows <= 0 || columns <= 0) {
-        fprintf(stderr, "Error: Invalid dimensions for eigenvalue computation (rows=%d, columns=%d). Both must be strictly positive.\n", rows, columns);
+        fprintf(stderr, "Error: Invalid dimensions for eigenvalue computation (rows=%" PRId64 ", columns=%" PRId64 "). Both must be strictly positive.\n", rows, columns);
         return NULL;
     }
 
+    REAL *eigenvalues = malloc(rows * sizeof(REAL));
+
+    if (!eigenvalues) {
+	fprintf(stderr, "Error: Memory allocation failed for eigenvalues.\n");
+	return NULL;
+    }
+
+    if (FN(matrix_eigenvalues_into)(A, rows, columns, max_iter, tol, eigenvalues, NULL)) {
+	free(eigenvalues);
+	return NULL;
+    }
+
+    return eigenvalues;
+
+}
+
+/**
+ * @brief Computes the eigenvalues of a square matrix into caller-provided vectors.
+ *
+ * Eigenvalue k is real[k] + i imaginary[k]. A complex-conjugate pair occupies two
+ * consecutive entries, the one with the positive imaginary part first. The eigenvalues
+ * come in the order of the diagonal of the real Schur form of A. A is not modified.
+ *
+ * @param A Pointer to the input square matrix (size: rows x columns).
+ * @param rows Number of rows in the input matrix (must be positive).
+ * @param columns Number of columns in the input matrix (must be positive).
+ * @param max_iter Maximum number of QR steps spent on one eigenvalue or pair (must be positive).
+ * @param tol Relative tolerance under which a subdiagonal element is negligible (must be positive,
+ *            machine epsilon is used when smaller).
+ * @param real Pointer to the real parts of the eigenvalues (size: rows).
+ * @param imaginary Pointer to the imaginary parts of the eigenvalues (size: rows), or NULL.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers, memory allocation
+ *         errors, or lack of convergence within max_iter steps.
+ */
+
+int FN(matrix_eigenvalues_into)(REAL *A, index_t rows, index_t columns, int max_iter, REAL tol, REAL *real, REAL *imaginary) {
+
+    if (rows <= 0 || columns <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions for eigenvalue computation (rows=%" PRId64 ", columns=%" PRId64 "). Both must be strictly positive.\n", rows, columns);
+        return -1;
+    }
+
     if (tol <= 0) {
         fprintf(stderr, "Error: Invalid tolerance (%f). Must be strictly positive.\n", tol);
-        return NULL;
+        return -1;
     }
 
-    if (!A) {
-        fprintf(stderr, "Error: Null pointer detected for input matrix in matrix_eigenvalues.\n");
-        return NULL;
+    if (max_iter <= 0) {
+        fprintf(stderr, "Error: Invalid maximum number of iterations (%d). Must be strictly positive.\n", max_iter);
+        return -1;
+    }
+
+    if (!A || !real) {
+        fprintf(stderr, "Error: Null pointer detected in matrix_eigenvalues_into.\n");
+        return -1;
     }
 
     if (rows != columns) {
         fprintf(stderr, "Error: Matrix must be square for eigenvalue computation.\n");
-        return NULL;
+        return -1;
     }
-    
-    double *H = malloc(rows * columns * sizeof(double));
 
-    if (!H) {
+    index_t n = rows;
+    REAL *H = malloc((size_t) n * n * sizeof(REAL));
+    REAL *work = malloc(4 * n * sizeof(REAL));
+    REAL *imaginary_parts = imaginary ? imaginary : work + 3 * n;
+
+    if (!H || !work) {
         fprintf(stderr, "Error: Memory allocation failed for intermediate matrix H.\n");
-        return NULL;
+        free(H);
+        free(work);
+        return -1;
     }
-    
-    memcpy(H, A, rows * columns * sizeof(double));
-
-    int iter = 0;
-    
-    while (iter < max_iter && !has_converged(H, rows, tol)) {
-
-	QR *QR_H = QR_decomposition(H, rows, columns);
 
-	if (!QR_H) {
-            fprintf(stderr, "Error: QR decomposition failed during eigenvalue computation.\n");
-            free(H);
-            return NULL;
-        }
+    memcpy(H, A, (size_t) n * n * sizeof(REAL));
 
-	for (int i = 0; i < rows; i++) {
-            for (int j = 0; j < columns; j++) {
-		double sum = 0.0;
-                for (int k = 0; k < columns; k++) {
-                    sum += QR_H->R[i * columns + k] * QR_H->Q[k * columns + j];
-                }
-	        H[i * columns + j] = sum;
-            }
-        }
+    int status = hessenberg_reduction(n, H);
 
-	QR_free(QR_H);
-	
-	iter++;
+    if (status)
+        fprintf(stderr, "Error: Memory allocation failed for the Hessenberg reduction in matrix_eigenvalues.\n");
+    else if ((status = hessenberg_eigenvalues(n, H, max_iter, tol, work, real, imaginary_parts)))
+        fprintf(stderr, "Error: QR iteration did not converge within %d steps in matrix_eigenvalues.\n", max_iter);
 
-	if (iter >= max_iter) {
-	    fprintf(stderr, "Maximum iteration reached without convergence.\n");
-	    free(H);
-	    return NULL;
-	}
-	
-    }
-    
-    double *eigenvalues = malloc(rows * sizeof(double));
+    free(H);
+    free(work);
 
-    if (!eigenvalues) {
-	fprintf(stderr, "Allocation failed for eigenvalues.\n");
-	free(H);
-	return NULL;
-    }
-    
-    for (int i = 0; i < rows; i++) {
-        eigenvalues[i] = H[i * rows + i];
-    }
-    
-    printf("Converged in %d iteration(s).\n", iter);
+    return status;
 
-    free(H);
-    
-    return eigenvalues;
-    
 }
 
 /**
@@ -466,10 +1009,10 @@ double *matrix_eigenvalues(double *A, int rows, int columns, int max_iter, doubl
  *         null pointers, singular matrix detection, or memory allocation errors.
  */
 
-double *forward_substitution(double *L, int d, double *b) {
+REAL *FN(forward_substitution)(REAL *L, index_t d, REAL *b) {
 
     if (d <= 0) {
-        fprintf(stderr, "Error: Invalid dimension (%d). Must be strictly positive.\n", d);
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", d);
         return NULL;
     }
 
@@ -478,32 +1021,65 @@ double *forward_substitution(double *L, int d, double *b) {
         return NULL;
     }
 
-    double *c = malloc(d * sizeof(double));
+    REAL *c = malloc(d * sizeof(REAL));
 
     if (!c) {
         fprintf(stderr, "Error: Memory allocation failed for solution vector in forward_substitution.\n");
         return NULL;
     }
 
-    double epsilon = 1e-10;
+    if (FN(forward_substitution_into)(L, d, b, c)) {
+        free(c);
+        return NULL;
+    }
+
+    return c;
+
+}
+
+/**
+ * @brief Solves a lower triangular system Lc = b using forward substitution into a caller-provided vector.
+ *
+ * Same as forward_substitution, without allocating the solution. c may be b
+ * (the right-hand side is overwritten by the solution).
+ *
+ * @param L Pointer to the lower triangular matrix (size: d x d).
+ * @param d Dimension of the square matrix L and vector b (must be positive).
+ * @param b Pointer to the right-hand side vector b (size: d).
+ * @param c Pointer to the solution vector c (size: d).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers
+ *         or singular matrix detection.
+ */
+
+int FN(forward_substitution_into)(REAL *L, index_t d, REAL *b, REAL *c) {
+
+    if (d <= 0) {
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", d);
+        return -1;
+    }
+
+    if (!L || !b || !c) {
+        fprintf(stderr, "Error: Null pointer detected in forward_substitution_into.\n");
+        return -1;
+    }
 
-    for (int i = 0; i < d; i++)
-	c[i] = 0.0;
+    REAL epsilon = 1e-10;
 
-    for (int i = 0; i < d; i++) {
+    // Row i only reads b[i] and c[0..i-1], so c can overwrite b
+    for (index_t i = 0; i < d; i++) {
 	if (fabs(L[i * d + i]) < epsilon) { 
-            fprintf(stderr, "Error: Singular matrix detected in forward_substitution at row %d.\n", i);
-            free(c);
-            return NULL;
+            fprintf(stderr, "Error: Singular matrix detected in forward_substitution at row %" PRId64 ".\n", i);
+            return -1;
         }
-	c[i] = b[i];
-	for (int j = 0; j < i; j++) {
-	    c[i] = c[i] - L[i * d + j] * c[j];
+	REAL sum = b[i];
+	for (index_t j = 0; j < i; j++) {
+	    sum = sum - L[i * d + j] * c[j];
 	}
-	c[i] = c[i] / L[i * d + i];
+	c[i] = sum / L[i * d + i];
     }
 
-    return c;
+    return 0;
 
 }
 
@@ -520,10 +1096,10 @@ double *forward_substitution(double *L, int d, double *b) {
  *         null pointers, singular matrix detection, or memory allocation errors.
  */
 
-double *backward_substitution(double *U, int d, double *c) {
+REAL *FN(backward_substitution)(REAL *U, index_t d, REAL *c) {
 
     if (d <= 0) {
-        fprintf(stderr, "Error: Invalid dimension (%d). Must be strictly positive.\n", d);
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", d);
         return NULL;
     }
 
@@ -532,38 +1108,71 @@ double *backward_substitution(double *U, int d, double *c) {
         return NULL;
     }
 
-    double *x = malloc(d * sizeof(double));
+    REAL *x = malloc(d * sizeof(REAL));
 
     if (!x) {
         fprintf(stderr, "Error: Memory allocation failed for solution vector in backward_substitution.\n");
         return NULL;
     }
 
-    for (int i = 0; i < d; i++)
-	x[i] = 0.0;
+    if (FN(backward_substitution_into)(U, d, c, x)) {
+        free(x);
+        return NULL;
+    }
+
+    return x;
+
+}
 
-    for (int i = d - 1; i >= 0; i--) {
+/**
+ * @brief Solves an upper triangular system Ux = c using backward substitution into a caller-provided vector.
+ *
+ * Same as backward_substitution, without allocating the solution. x may be c
+ * (the right-hand side is overwritten by the solution).
+ *
+ * @param U Pointer to the upper triangular matrix (size: d x d).
+ * @param d Dimension of the square matrix U and vector c (must be positive).
+ * @param c Pointer to the right-hand side vector c (size: d).
+ * @param x Pointer to the solution vector x (size: d).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers
+ *         or singular matrix detection.
+ */
+
+int FN(backward_substitution_into)(REAL *U, index_t d, REAL *c, REAL *x) {
+
+    if (d <= 0) {
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", d);
+        return -1;
+    }
+
+    if (!U || !c || !x) {
+        fprintf(stderr, "Error: Null pointer detected in backward_substitution_into.\n");
+        return -1;
+    }
+
+    // Row i only reads c[i] and x[i+1..d-1], so x can overwrite c
+    for (index_t i = d - 1; i >= 0; i--) {
 	if (fabs(U[i * d + i]) < 1e-10) { 
-            fprintf(stderr, "Error: Singular matrix detected in backward_substitution at row %d.\n", i);
-            free(x);
-            return NULL;
+            fprintf(stderr, "Error: Singular matrix detected in backward_substitution at row %" PRId64 ".\n", i);
+            return -1;
         }
-	x[i] = c[i];
-	for (int j = i + 1; j < d; j++) {
-	    x[i] = x[i] - U[i * d + j] * x[j];
+	REAL sum = c[i];
+	for (index_t j = i + 1; j < d; j++) {
+	    sum = sum - U[i * d + j] * x[j];
 	}
-	x[i] = x[i] / U[i * d + i];
+	x[i] = sum / U[i * d + i];
     }
 
-    return x;
-    
+    return 0;
+
 }
 
 /**
  * @brief Solves a linear system Ax = b using LU decomposition.
  *
  * This function computes the solution vector x for a square matrix A and right-hand side vector b
- * by performing LU decomposition and solving Ly = b followed by Ux = y.
+ * by performing LU decomposition with partial pivoting (P A = L U) and solving Ly = Pb followed by Ux = y.
  *
  * @param A Pointer to the square matrix A (size: d x d).
  * @param b Pointer to the right-hand side vector b (size: d).
@@ -573,10 +1182,10 @@ double *backward_substitution(double *U, int d, double *c) {
  *         null pointers, LU decomposition failure, or memory allocation errors.
  */
 
-double *solve_LU_system(double *A, double *b, int d) {
+REAL *FN(solve_LU_system)(REAL *A, REAL *b, index_t d) {
 
     if (d <= 0) {
-        fprintf(stderr, "Error: Invalid dimension (%d). Must be strictly positive.\n", d);
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", d);
         return NULL;
     }
 
@@ -585,38 +1194,73 @@ double *solve_LU_system(double *A, double *b, int d) {
         return NULL;
     }
 
-    LU *LU_matrix = LU_decomposition(A, d, d);
+    REAL *x = malloc(d * sizeof(REAL));
 
-    if (!LU_matrix) {
-        fprintf(stderr, "Error: LU decomposition failed in solve_LU_system.\n");
+    if (!x) {
+        fprintf(stderr, "Error: Memory allocation failed for solution vector in solve_LU_system.\n");
         return NULL;
     }
-    
-    // Ly = b
-    double *y = forward_substitution(LU_matrix->L, d, b);
 
-    if (!y) {
-        fprintf(stderr, "Error: Forward substitution failed in solve_LU_system.\n");
-        LU_free(LU_matrix);
+    if (FN(solve_LU_system_into)(A, b, d, x)) {
+        free(x);
         return NULL;
     }
     
-    // Ux = y
-    double *x = backward_substitution(LU_matrix->U, d, y);
+    return x;
 
-    if (!x) {
-        fprintf(stderr, "Error: Backward substitution failed in solve_LU_system.\n");
-        free(y);
-        LU_free(LU_matrix);
-        return NULL;
+}
+
+/**
+ * @brief Solves a linear system Ax = b using LU decomposition into a caller-provided vector.
+ *
+ * Same as solve_LU_system, without allocating the solution: A is factored into a
+ * single compact L\U matrix (see LU_factorization_into) and both triangular solves
+ * run in x. x may be b (the right-hand side is overwritten by the solution).
+ *
+ * @param A Pointer to the square matrix A (size: d x d).
+ * @param b Pointer to the right-hand side vector b (size: d).
+ * @param d Dimension of the square matrix A and vector b (must be positive).
+ * @param x Pointer to the solution vector x (size: d).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         aliased output or LU decomposition failure.
+ */
+
+int FN(solve_LU_system_into)(REAL *A, REAL *b, index_t d, REAL *x) {
+
+    if (d <= 0) {
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", d);
+        return -1;
     }
 
-    LU_free(LU_matrix);
-    
-    free(y);
-    
-    return x;
+    if (!A || !b || !x) {
+        fprintf(stderr, "Error: Null pointer detected in solve_LU_system_into.\n");
+        return -1;
+    }
+
+    if (ranges_overlap(x, d, A, (size_t) d * d)) {
+        fprintf(stderr, "Error: Solution vector overlaps the matrix in solve_LU_system_into.\n");
+        return -1;
+    }
+
+    REAL *LU = malloc((size_t) d * d * sizeof(REAL));
+    index_t *pivots = malloc(d * sizeof(index_t));
+
+    if (!LU || !pivots || FN(LU_factorization_into)(A, d, d, LU, pivots)) {
+        fprintf(stderr, "Error: LU decomposition failed in solve_LU_system.\n");
+        free(LU);
+        free(pivots);
+        return -1;
+    }
+
+    // Ly = Pb, then Ux = y, all in x
+    int status = FN(solve_LU_factored_system_into)(LU, pivots, d, b, x);
+
+    free(LU);
+    free(pivots);
     
+    return status;
+
 }
 
 /**
@@ -632,10 +1276,10 @@ double *solve_LU_system(double *A, double *b, int d) {
  *         null pointers, LU decomposition failure, or memory allocation errors.
  */
 
-double *matrix_inverse(double *A, int d) {
+REAL *FN(matrix_inverse)(REAL *A, index_t d) {
 
     if (d <= 0) {
-        fprintf(stderr, "Error: Invalid dimension (%d). Must be strictly positive.\n", d);
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", d);
         return NULL;
     }
 
@@ -644,97 +1288,70 @@ double *matrix_inverse(double *A, int d) {
         return NULL;
     }
 
-    double *I = generate_identity_matrix(d);
-
-    if (!I) {
-        fprintf(stderr, "Error: Failed to generate identity matrix in matrix_inverse.\n");
-        return NULL;
-    }
-
-    LU *LU_matrix = LU_decomposition(A, d, d);
+    REAL *inverse = malloc((size_t) d * d * sizeof(REAL));
 
-    if (!LU_matrix) {
-        fprintf(stderr, "Error: LU decomposition failed in matrix_inverse.\n");
-        free(I);
+    if (!inverse) {
+        fprintf(stderr, "Error: Memory allocation failed for matrices in matrix_inverse.\n");
         return NULL;
     }
 
-    double *C = malloc(d * d * sizeof(double));
-    double *inverse = malloc(d * d * sizeof(double));
-    double *b_i = malloc(d * sizeof(double));
-
-    if (!C || !inverse || !b_i) {
-        fprintf(stderr, "Error: Memory allocation failed for matrices in matrix_inverse.\n");
-        free(I);
-        free(C);
+    if (FN(matrix_inverse_into)(A, d, inverse)) {
         free(inverse);
-        free(b_i);
-        LU_free(LU_matrix);
         return NULL;
     }
 
-    double *c_i;
-    double *x_i;
-    
-    for (int i = 0; i < d; i++) {
-
-	for (int j = 0; j < d; j++) {
-	    b_i[j] = I[j * d + i];
-	}
-	
-	c_i = forward_substitution(LU_matrix->L, d, b_i);
-
-	if (!c_i) {
-            fprintf(stderr, "Error: Forward substitution failed in matrix_inverse.\n");
-            free(I);
-            free(C);
-            free(inverse);
-            free(b_i);
-            LU_free(LU_matrix);
-            return NULL;
-
-	}
-	
-	for (int j = 0; j < d; j++) {
-	    C[j * d + i] = c_i[j];
-	}
-	
-	free(c_i);
-	
-    }
+    return inverse;
 
-    for (int i = 0; i < d; i++) {
+}
 
-	for (int j = 0; j < d; j++) {
-	    b_i[j] = C[j * d + i];
+/**
+ * @brief Computes the inverse of a square matrix A using LU decomposition into a caller-provided matrix.
+ *
+ * Same as matrix_inverse, without allocating the result: A is factored into a
+ * single compact L\U matrix (see LU_factorization_into), from which all the columns
+ * of the inverse are solved at once. inverse may be A (in-place inversion), since A
+ * is no longer read once factored.
+ *
+ * @param A Pointer to the square matrix A (size: d x d).
+ * @param d Dimension of the square matrix A (must be positive).
+ * @param inverse Pointer to the output matrix (size: d x d).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         LU decomposition failure or memory allocation errors.
+ */
 
-	}
+int FN(matrix_inverse_into)(REAL *A, index_t d, REAL *inverse) {
 
-	x_i = backward_substitution(LU_matrix->U, d, b_i);
+    if (d <= 0) {
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", d);
+        return -1;
+    }
 
-	if (!x_i) {
-	    fprintf(stderr,"Backward substitution failed\n");
-	    free(I);
-	    free(C);
-	    free(b_i);
-	    LU_free(LU_matrix);
-	    return NULL;
+    if (!A || !inverse) {
+        fprintf(stderr, "Error: Null pointer detected in matrix_inverse_into.\n");
+        return -1;
+    }
 
-	}
-	for (int j = 0; j < d; j++) {
-	    inverse[j * d + i] = x_i[j];
-	}
+    if (inverse != A && ranges_overlap(inverse, (size_t) d * d, A, (size_t) d * d)) {
+        fprintf(stderr, "Error: Output matrix partially overlaps the input matrix in matrix_inverse_into.\n");
+        return -1;
+    }
 
-	free(x_i);
+    REAL *LU = malloc((size_t) d * d * sizeof(REAL));
+    index_t *pivots = malloc(d * sizeof(index_t));
 
+    if (!LU || !pivots || FN(LU_factorization_into)(A, d, d, LU, pivots)) {
+        fprintf(stderr, "Error: LU decomposition failed in matrix_inverse.\n");
+        free(LU);
+        free(pivots);
+        return -1;
     }
 
-    free(I);
-    free(C);
-    free(b_i);
+    int status = FN(LU_factored_inverse_into)(LU, pivots, d, inverse);
 
-    LU_free(LU_matrix);
-    
-    return inverse;
+    free(LU);
+    free(pivots);
     
+    return status;
+
 }
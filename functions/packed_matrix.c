@@ -0,0 +1,278 @@
+#include "kernels.h"
+#include <string.h>
+
+/*
+ * A packed matrix stores one triangle, row after row, in n * (n + 1) / 2 values
+ * (see packed_index in kernels.h). In the lower triangle each row starts at
+ * column 0, so the rows of a lower packed Cholesky factor are contiguous and
+ * the factorisation and the forward substitution run on dot products of rows.
+ */
+
+/**
+ * @brief Allocates a zero packed matrix.
+ *
+ * @param size Dimension of the square matrix (must be positive).
+ * @param triangle TRIANGLE_LOWER or TRIANGLE_UPPER, the stored triangle.
+ *
+ * @return Pointer to the packed matrix on success, or NULL on failure due to invalid
+ *         dimensions, an unknown triangle or memory allocation errors.
+ */
+
+FN(packed_matrix) *FN(create_packed_matrix)(index_t size, int triangle) {
+
+    if (size <= 0) {
+        fprintf(stderr, "Error: Invalid size (%" PRId64 ") for packed matrix. Must be strictly positive.\n", size);
+        return NULL;
+    }
+
+    if (triangle != TRIANGLE_LOWER && triangle != TRIANGLE_UPPER) {
+        fprintf(stderr, "Error: Unknown triangle (%d) for packed matrix.\n", triangle);
+        return NULL;
+    }
+
+    FN(packed_matrix) *A = malloc(sizeof(FN(packed_matrix)));
+
+    if (!A) {
+        fprintf(stderr, "Error: Memory allocation failed for packed matrix structure.\n");
+        return NULL;
+    }
+
+    A->size = size;
+    A->triangle = triangle;
+    A->data = calloc((size_t) size * (size + 1) / 2, sizeof(REAL));
+
+    if (!A->data) {
+        fprintf(stderr, "Error: Memory allocation failed for packed matrix of size %" PRId64 ".\n", size);
+        free(A);
+        return NULL;
+    }
+
+    return A;
+
+}
+
+/**
+ * @brief Packs one triangle of a dense square matrix.
+ *
+ * The elements of A in the other triangle are ignored, so a symmetric matrix
+ * is packed from either of its triangles.
+ *
+ * @param A Pointer to the dense matrix (size: size x size).
+ * @param size Dimension of the square matrix (must be positive).
+ * @param triangle TRIANGLE_LOWER or TRIANGLE_UPPER, the triangle kept.
+ *
+ * @return Pointer to the packed matrix on success, or NULL on failure due to invalid
+ *         dimensions, null pointers or memory allocation errors.
+ */
+
+FN(packed_matrix) *FN(packed_from_dense)(REAL *A, index_t size, int triangle) {
+
+    if (!A) {
+        fprintf(stderr, "Error: Null pointer detected in packed_from_dense.\n");
+        return NULL;
+    }
+
+    FN(packed_matrix) *P = FN(create_packed_matrix)(size, triangle);
+
+    if (!P) return NULL;
+
+    for (index_t i = 0; i < size; i++) {
+	index_t first = triangle == TRIANGLE_LOWER ? 0 : i, last = triangle == TRIANGLE_LOWER ? i : size - 1;
+	memcpy(P->data + packed_index(size, triangle, i, first), A + (size_t) i * size + first,
+	       (last - first + 1) * sizeof(REAL));
+    }
+
+    return P;
+
+}
+
+/**
+ * @brief Expands a packed matrix to a dense square matrix.
+ *
+ * @param A Pointer to the packed matrix.
+ * @param mirror 1 to copy the stored triangle into the other one (symmetric matrix),
+ *               0 to fill the other triangle with zeros (triangular matrix).
+ *
+ * @return Pointer to the dense matrix (size: size x size) on success,
+ *         or NULL on failure due to a null pointer or memory allocation errors.
+ */
+
+REAL *FN(packed_to_dense)(const FN(packed_matrix) *A, int mirror) {
+
+    if (!A || !A->data) {
+        fprintf(stderr, "Error: Null pointer detected in packed_to_dense.\n");
+        return NULL;
+    }
+
+    index_t size = A->size;
+    int lower = A->triangle == TRIANGLE_LOWER;
+    REAL *D = calloc((size_t) size * size, sizeof(REAL));
+
+    if (!D) {
+        fprintf(stderr, "Error: Memory allocation failed for dense matrix of size %" PRId64 " x %" PRId64 ".\n", size, size);
+        return NULL;
+    }
+
+    for (index_t i = 0; i < size; i++) {
+	index_t first = lower ? 0 : i, last = lower ? i : size - 1;
+	const REAL *row = A->data + packed_index(size, A->triangle, i, first);
+	for (index_t j = first; j <= last; j++) {
+	    D[(size_t) i * size + j] = row[j - first];
+	    if (mirror) D[(size_t) j * size + i] = row[j - first];
+	}
+    }
+
+    return D;
+
+}
+
+/**
+ * @brief Frees all memory associated with a packed matrix.
+ *
+ * @param A Pointer to the packed matrix to free (may be NULL).
+ */
+
+void FN(packed_free)(FN(packed_matrix) *A) {
+
+    if (!A) return;
+
+    free(A->data);
+    free(A);
+
+}
+
+/**
+ * @brief Performs the Cholesky decomposition of a symmetric positive-definite packed matrix.
+ *
+ * This function computes A = L L^T where A is given by either of its triangles,
+ * and returns L in lower packed storage: the factorisation never holds more than
+ * one triangle, half the memory of Cholesky_decomposition.
+ *
+ * @param A Pointer to the packed symmetric matrix to decompose.
+ *
+ * @return Pointer to the lower triangular factor L on success, or NULL on failure due to
+ *         null pointers, non-positive definite matrix or memory allocation errors.
+ */
+
+FN(packed_matrix) *FN(packed_Cholesky_decomposition)(const FN(packed_matrix) *A) {
+
+    if (!A || !A->data) {
+        fprintf(stderr, "Error: Null pointer detected in packed_Cholesky_decomposition.\n");
+        return NULL;
+    }
+
+    index_t n = A->size;
+
+    FN(packed_matrix) *L = FN(create_packed_matrix)(n, TRIANGLE_LOWER);
+
+    if (!L) return NULL;
+
+    // Lower triangle of A, read from the upper one (its transpose) when needed
+    if (A->triangle == TRIANGLE_LOWER)
+	memcpy(L->data, A->data, (size_t) n * (n + 1) / 2 * sizeof(REAL));
+    else
+	for (index_t i = 0; i < n; i++)
+	    for (index_t j = i; j < n; j++)
+		L->data[packed_index(n, TRIANGLE_LOWER, j, i)] = A->data[packed_index(n, TRIANGLE_UPPER, i, j)];
+
+    const simd_kernels *kernels = FN(active_kernels);
+
+    for (index_t i = 0; i < n; i++) {
+	REAL *L_i = L->data + packed_index(n, TRIANGLE_LOWER, i, 0);
+
+	for (index_t j = 0; j < i; j++) {
+	    const REAL *L_j = L->data + packed_index(n, TRIANGLE_LOWER, j, 0);
+	    L_i[j] = (L_i[j] - kernels->dot(L_i, L_j, j)) / L_j[j];
+	}
+
+	REAL diagonal = L_i[i] - kernels->dot(L_i, L_i, i);
+
+	if (diagonal <= 0.0) {
+	    fprintf(stderr, "Error: Matrix is not positive definite at row %" PRId64 " in packed_Cholesky_decomposition.\n", i);
+	    FN(packed_free)(L);
+	    return NULL;
+	}
+
+	L_i[i] = sqrt(diagonal);
+    }
+
+    return L;
+
+}
+
+/**
+ * @brief Solves a linear system Ax = b from the packed Cholesky factor L of A.
+ *
+ * @param L Pointer to the lower packed factor returned by packed_Cholesky_decomposition.
+ * @param b Pointer to the right-hand side vector b (size: size).
+ *
+ * @return Pointer to the solution vector x on success, or NULL on failure due to
+ *         null pointers, a factor that is not lower triangular or memory allocation errors.
+ */
+
+REAL *FN(solve_packed_Cholesky_system)(const FN(packed_matrix) *L, REAL *b) {
+
+    if (!L || !b) {
+        fprintf(stderr, "Error: Null pointer detected in solve_packed_Cholesky_system.\n");
+        return NULL;
+    }
+
+    REAL *x = malloc(L->size * sizeof(REAL));
+
+    if (!x) {
+        fprintf(stderr, "Error: Memory allocation failed for solution vector in solve_packed_Cholesky_system.\n");
+        return NULL;
+    }
+
+    if (FN(solve_packed_Cholesky_system_into)(L, b, x)) {
+        free(x);
+        return NULL;
+    }
+
+    return x;
+
+}
+
+/**
+ * @brief Solves a linear system Ax = b from the packed Cholesky factor L of A.
+ *
+ * Solves L y = b with dot products of the rows of L, then L^T x = y by subtracting
+ * each solved unknown times its row, so L is read row after row in both passes.
+ * x may be b (the right-hand side is overwritten by the solution).
+ *
+ * @param L Pointer to the lower packed factor returned by packed_Cholesky_decomposition.
+ * @param b Pointer to the right-hand side vector b (size: size).
+ * @param x Pointer to the solution vector x (size: size).
+ *
+ * @return 0 on success, or -1 on failure due to null pointers or a factor that is not lower triangular.
+ */
+
+int FN(solve_packed_Cholesky_system_into)(const FN(packed_matrix) *L, REAL *b, REAL *x) {
+
+    if (!L || !L->data || !b || !x) {
+        fprintf(stderr, "Error: Null pointer detected in solve_packed_Cholesky_system_into.\n");
+        return -1;
+    }
+
+    if (L->triangle != TRIANGLE_LOWER) {
+        fprintf(stderr, "Error: The Cholesky factor must be stored as a lower triangle.\n");
+        return -1;
+    }
+
+    index_t n = L->size;
+    const simd_kernels *kernels = FN(active_kernels);
+
+    for (index_t i = 0; i < n; i++) {
+	const REAL *L_i = L->data + packed_index(n, TRIANGLE_LOWER, i, 0);
+	x[i] = (b[i] - kernels->dot(L_i, x, i)) / L_i[i];
+    }
+
+    for (index_t i = n - 1; i >= 0; i--) {
+	const REAL *L_i = L->data + packed_index(n, TRIANGLE_LOWER, i, 0);
+	x[i] /= L_i[i];
+	kernels->axpy(-x[i], L_i, x, i);
+    }
+
+    return 0;
+
+}
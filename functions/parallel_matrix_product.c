@@ -1,11 +1,14 @@
-#include "LinearAlgebraBasics.h"
+#include "kernels.h"
 
 /**
  * @brief Computes the product of two matrices P and Q in parallel using OpenMP.
  *
  * This function calculates the matrix product C = P * Q using parallelization
- * to improve performance. Each element of the resulting matrix is computed
- * by summing the products of corresponding elements from rows of P and columns of Q.
+ * to improve performance. The resulting matrix is split into 2D tiles of cache-sized
+ * blocks that a single team of threads shares out dynamically (see
+ * parallel_general_matrix_product); each thread runs the packed GEMM engine on its
+ * tiles with its own packing buffers, so there is no nested parallel region and no
+ * shared accumulator.
  *
  * @param P Pointer to the first input matrix (size: P_rows x P_columns).
  * @param P_rows Number of rows in matrix P (must be positive).
@@ -18,16 +21,16 @@
  *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
  */
 
-double *parallel_matrix_product(double *P, int P_rows, int P_columns, double *Q, int Q_rows, int Q_columns) {
+REAL *FN(parallel_matrix_product)(REAL *P, index_t P_rows, index_t P_columns, REAL *Q, index_t Q_rows, index_t Q_columns) {
 
     if (P_rows <= 0 || P_columns <= 0 || Q_rows <= 0 || Q_columns <= 0) {
-        fprintf(stderr, "Error: Invalid dimensions for parallel matrix product (P_rows=%d, P_columns=%d, Q_rows=%d, Q_columns=%d). All dimensions must be strictly positive.\n",
+        fprintf(stderr, "Error: Invalid dimensions for parallel matrix product (P_rows=%" PRId64 ", P_columns=%" PRId64 ", Q_rows=%" PRId64 ", Q_columns=%" PRId64 "). All dimensions must be strictly positive.\n",
                 P_rows, P_columns, Q_rows, Q_columns);
         return NULL;
     }
 
     if (P_columns != Q_rows) {
-        fprintf(stderr, "Error: Dimension mismatch. Columns of first matrix (%d) must equal rows of second matrix (%d).\n",
+        fprintf(stderr, "Error: Dimension mismatch. Columns of first matrix (%" PRId64 ") must equal rows of second matrix (%" PRId64 ").\n",
                 P_columns, Q_rows);
         return NULL;
     }
@@ -37,26 +40,66 @@ double *parallel_matrix_product(double *P, int P_rows, int P_columns, double *Q,
         return NULL;
     }
 
-    double *matrix = malloc(sizeof(double) * (P_rows * Q_columns));
+    REAL *matrix = malloc(sizeof(REAL) * (P_rows * Q_columns));
 
     if (!matrix) {
         fprintf(stderr, "Error: Memory allocation failed for result matrix in parallel_matrix_product.\n");
         return NULL;
     }
 
-    double value;
-#pragma omp parallel for
-    for (int i = 0; i < P_rows; i++) {
-	for (int j = 0; j < Q_columns; j++) {
-	    value = 0;
-#pragma omp parallel for reduction(+:value)
-	    for (int k = 0; k < P_columns; k++) {
-		value += P[i * P_columns + k] * Q[k * Q_columns + j];
-	    }
-	    matrix[i * Q_columns + j] = value;
-	}
+    if (FN(parallel_matrix_product_into)(P, P_rows, P_columns, Q, Q_rows, Q_columns, matrix)) {
+        fprintf(stderr, "Error: Tiled product failed in parallel_matrix_product.\n");
+        free(matrix);
+        return NULL;
     }
 
     return matrix;
 
 }
+
+/**
+ * @brief Computes the product of two matrices P and Q in parallel into a caller-provided matrix.
+ *
+ * Same as parallel_matrix_product, without allocating the result. C must not
+ * overlap P or Q.
+ *
+ * @param P Pointer to the first input matrix (size: P_rows x P_columns).
+ * @param P_rows Number of rows in matrix P (must be positive).
+ * @param P_columns Number of columns in matrix P (must equal Q_rows).
+ * @param Q Pointer to the second input matrix (size: Q_rows x Q_columns).
+ * @param Q_rows Number of rows in matrix Q (must equal P_columns).
+ * @param Q_columns Number of columns in matrix Q (must be positive).
+ * @param C Pointer to the output matrix (size: P_rows x Q_columns).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         aliased output, or memory allocation errors.
+ */
+
+int FN(parallel_matrix_product_into)(REAL *P, index_t P_rows, index_t P_columns, REAL *Q, index_t Q_rows, index_t Q_columns, REAL *C) {
+
+    if (P_rows <= 0 || P_columns <= 0 || Q_rows <= 0 || Q_columns <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions for parallel matrix product (P_rows=%" PRId64 ", P_columns=%" PRId64 ", Q_rows=%" PRId64 ", Q_columns=%" PRId64 "). All dimensions must be strictly positive.\n",
+                P_rows, P_columns, Q_rows, Q_columns);
+        return -1;
+    }
+
+    if (P_columns != Q_rows) {
+        fprintf(stderr, "Error: Dimension mismatch. Columns of first matrix (%" PRId64 ") must equal rows of second matrix (%" PRId64 ").\n",
+                P_columns, Q_rows);
+        return -1;
+    }
+
+    if (!P || !Q || !C) {
+        fprintf(stderr, "Error: Null pointer detected in parallel_matrix_product_into.\n");
+        return -1;
+    }
+
+    if (ranges_overlap(C, (size_t) P_rows * Q_columns, P, (size_t) P_rows * P_columns) || ranges_overlap(C, (size_t) P_rows * Q_columns, Q, (size_t) Q_rows * Q_columns)) {
+        fprintf(stderr, "Error: Output matrix overlaps an input matrix in parallel_matrix_product_into.\n");
+        return -1;
+    }
+
+    return FN(parallel_general_matrix_product)(OP_NO_TRANSPOSE, OP_NO_TRANSPOSE, P_rows, Q_columns, P_columns,
+					   1.0, P, P_columns, Q, Q_columns, 0.0, C, Q_columns);
+
+}
@@ -1,4 +1,31 @@
-#include "LinearAlgebraBasics.h"
+#include "kernels.h"
+#include <omp.h>
+
+/*
+ * Splits the rows of A in contiguous ranges, one per thread and in multiples of
+ * GEMV_ROWS, so that each thread streams its own part of A once for all the vectors
+ * and writes a disjoint part of each result.
+ */
+
+static void parallel_blocked_vector_matrix_product(index_t rows, index_t columns, const REAL *A,
+						   const REAL *X, index_t vectors, REAL *Y) {
+
+#pragma omp parallel
+    {
+	index_t threads = omp_get_num_threads(), thread = omp_get_thread_num();
+	index_t chunk = (rows + threads - 1) / threads;
+
+	chunk = (chunk + GEMV_ROWS - 1) / GEMV_ROWS * GEMV_ROWS;
+
+	index_t first = thread * chunk < rows ? thread * chunk : rows;
+	index_t last = first + chunk < rows ? first + chunk : rows;
+
+	if (first < last)
+	    FN(blocked_vector_matrix_product)(last - first, columns, A + first * columns, columns,
+					      X, columns, vectors, Y + first, rows);
+    }
+
+}
 
 /**
  * @brief Computes the product of a matrix A and a vector X in parallel using OpenMP.
@@ -16,16 +43,16 @@
  *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
  */
 
-double *parallel_vector_matrix_product(double *A, int A_rows, int A_columns, double *X, int dimension) {
+REAL *FN(parallel_vector_matrix_product)(REAL *A, index_t A_rows, index_t A_columns, REAL *X, index_t dimension) {
 
     if (A_rows <= 0 || A_columns <= 0 || dimension <= 0) {
-        fprintf(stderr, "Error: Invalid dimensions for parallel vector-matrix product (A_rows=%d, A_columns=%d, dimension=%d). All dimensions must be strictly positive.\n",
+        fprintf(stderr, "Error: Invalid dimensions for parallel vector-matrix product (A_rows=%" PRId64 ", A_columns=%" PRId64 ", dimension=%" PRId64 "). All dimensions must be strictly positive.\n",
                 A_rows, A_columns, dimension);
         return NULL;
     }
 
     if (A_columns != dimension) {
-        fprintf(stderr, "Error: Dimension mismatch. Columns of matrix (%d) must equal size of vector (%d).\n",
+        fprintf(stderr, "Error: Dimension mismatch. Columns of matrix (%" PRId64 ") must equal size of vector (%" PRId64 ").\n",
                 A_columns, dimension);
         return NULL;
     }
@@ -35,24 +62,259 @@ double *parallel_vector_matrix_product(double *A, int A_rows, int A_columns, dou
         return NULL;
     }
     
-    double *vector = malloc(A_rows * sizeof(double));
+    REAL *vector = malloc(A_rows * sizeof(REAL));
 
     if (!vector) {
         fprintf(stderr, "Error: Memory allocation failed for result vector in parallel_vector_matrix_product.\n");
         return NULL;
     }
 
-    double value = 0.0;
-#pragma omp parallel for
-    for (int i = 0; i < A_rows; i++) {
-	value = 0.0;
-#pragma omp parallel for reduction(+:value)
-	for (int j = 0; j < A_columns; j++) {
-	    value += A[i * A_columns + j] * X[j];
-	}
-	vector[i] = value;
+    FN(parallel_vector_matrix_product_into)(A, A_rows, A_columns, X, dimension, vector);
+
+    return vector;
+
+}
+
+/**
+ * @brief Computes the product of a matrix A and a vector X in parallel using OpenMP into a caller-provided vector.
+ *
+ * Same as parallel_vector_matrix_product, without allocating the result. Y must not overlap A or X.
+ *
+ * @param A Pointer to the input matrix (size: A_rows x A_columns).
+ * @param A_rows Number of rows in the matrix A (must be positive).
+ * @param A_columns Number of columns in the matrix A (must equal dimension).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal A_columns).
+ * @param Y Pointer to the output vector (size: A_rows).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers or aliased output.
+ */
+
+int FN(parallel_vector_matrix_product_into)(REAL *A, index_t A_rows, index_t A_columns, REAL *X, index_t dimension, REAL *Y) {
+
+    if (A_rows <= 0 || A_columns <= 0 || dimension <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions provided. All dimensions must be strictly positive. (A_rows=%" PRId64 ", A_columns=%" PRId64 ", dimension=%" PRId64 ")\n", 
+                A_rows, A_columns, dimension);
+        return -1;
+    }
+
+    if (A_columns != dimension) {
+        fprintf(stderr, "Error: Dimension mismatch. Matrix columns (%" PRId64 ") must equal vector size (%" PRId64 ").\n", 
+                A_columns, dimension);
+        return -1;
+    }
+
+    if (!A || !X || !Y) {
+        fprintf(stderr, "Error: Null pointer detected in parallel_vector_matrix_product_into.\n");
+        return -1;
+    }
+
+    if (ranges_overlap(Y, A_rows, A, (size_t) A_rows * A_columns) || ranges_overlap(Y, A_rows, X, dimension)) {
+        fprintf(stderr, "Error: Output vector overlaps an input in parallel_vector_matrix_product_into.\n");
+        return -1;
+    }
+
+    parallel_blocked_vector_matrix_product(A_rows, A_columns, A, X, 1, Y);
+
+    return 0;
+
+}
+
+/**
+ * @brief Computes the products of a matrix A with several vectors in parallel, reading A once.
+ *
+ * This function calculates Y_v = A * X_v for v = 0, ..., vectors - 1.
+ * The rows of A are split in contiguous ranges between the threads, and each
+ * thread applies its range to all the vectors while it is streamed once.
+ *
+ * @param A Pointer to the input matrix (size: A_rows x A_columns).
+ * @param A_rows Number of rows in the matrix A (must be positive).
+ * @param A_columns Number of columns in the matrix A (must equal dimension).
+ * @param X Pointer to the input vectors, stored one after the other (size: vectors x dimension).
+ * @param dimension Dimension of each vector X_v (must equal A_columns).
+ * @param vectors Number of vectors (must be positive).
+ * @param Y Pointer to the output vectors, stored one after the other (size: vectors x A_rows).
+ *         Y must not overlap A or X.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers or aliased output.
+ */
+
+int FN(parallel_multi_vector_matrix_product)(REAL *A, index_t A_rows, index_t A_columns, REAL *X, index_t dimension,
+                                            index_t vectors, REAL *Y) {
+
+    if (A_rows <= 0 || A_columns <= 0 || dimension <= 0 || vectors <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions provided. All dimensions must be strictly positive. (A_rows=%" PRId64 ", A_columns=%" PRId64 ", dimension=%" PRId64 ", vectors=%" PRId64 ")\n",
+                A_rows, A_columns, dimension, vectors);
+        return -1;
+    }
+
+    if (A_columns != dimension) {
+        fprintf(stderr, "Error: Dimension mismatch. Matrix columns (%" PRId64 ") must equal vector size (%" PRId64 ").\n",
+                A_columns, dimension);
+        return -1;
+    }
+
+    if (!A || !X || !Y) {
+        fprintf(stderr, "Error: Null pointer detected in parallel_multi_vector_matrix_product.\n");
+        return -1;
+    }
+
+    if (ranges_overlap(Y, (size_t) vectors * A_rows, A, (size_t) A_rows * A_columns) ||
+        ranges_overlap(Y, (size_t) vectors * A_rows, X, (size_t) vectors * dimension)) {
+        fprintf(stderr, "Error: Output vectors overlap an input in parallel_multi_vector_matrix_product.\n");
+        return -1;
+    }
+
+    parallel_blocked_vector_matrix_product(A_rows, A_columns, A, X, vectors, Y);
+
+    return 0;
+
+}
+
+/**
+ * @brief Computes the product of the transpose of a matrix A and a vector X in parallel using OpenMP.
+ *
+ * This function calculates the vector result = A^T * X (equivalently X^T * A) without
+ * forming the transpose: the rows of A are accumulated in the order they are stored.
+ * Each thread accumulates a contiguous range of rows into its own partial vector,
+ * and the partial vectors are summed at the end.
+ *
+ * @param A Pointer to the input matrix (size: A_rows x A_columns).
+ * @param A_rows Number of rows in the matrix A (must equal dimension).
+ * @param A_columns Number of columns in the matrix A (must be positive).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal A_rows).
+ *
+ * @return Pointer to the resulting vector (size: A_columns) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(parallel_transposed_vector_matrix_product)(REAL *A, index_t A_rows, index_t A_columns, REAL *X, index_t dimension) {
+
+    if (A_rows <= 0 || A_columns <= 0 || dimension <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions provided. All dimensions must be strictly positive. (A_rows=%" PRId64 ", A_columns=%" PRId64 ", dimension=%" PRId64 ")\n",
+                A_rows, A_columns, dimension);
+        return NULL;
+    }
+
+    if (A_rows != dimension) {
+        fprintf(stderr, "Error: Dimension mismatch. Matrix rows (%" PRId64 ") must equal vector size (%" PRId64 ").\n",
+                A_rows, dimension);
+        return NULL;
+    }
+
+    if (!A || !X) {
+        fprintf(stderr, "Error: Null pointer detected in parallel_transposed_vector_matrix_product.\n");
+        return NULL;
+    }
+
+    REAL *vector = malloc(A_columns * sizeof(REAL));
+
+    if (!vector) {
+        fprintf(stderr, "Error: Memory allocation failed for result vector of size %" PRId64 ".\n", A_columns);
+        return NULL;
+    }
+
+    if (FN(parallel_transposed_vector_matrix_product_into)(A, A_rows, A_columns, X, dimension, vector) != 0) {
+        free(vector);
+        return NULL;
     }
 
     return vector;
 
 }
+
+/**
+ * @brief Computes the product of the transpose of a matrix A and a vector X in parallel using OpenMP into a caller-provided vector.
+ *
+ * Same as parallel_transposed_vector_matrix_product, without allocating the result. Y must not overlap A or X.
+ *
+ * @param A Pointer to the input matrix (size: A_rows x A_columns).
+ * @param A_rows Number of rows in the matrix A (must equal dimension).
+ * @param A_columns Number of columns in the matrix A (must be positive).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal A_rows).
+ * @param Y Pointer to the output vector (size: A_columns).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers, aliased output, or memory allocation errors.
+ */
+
+int FN(parallel_transposed_vector_matrix_product_into)(REAL *A, index_t A_rows, index_t A_columns, REAL *X, index_t dimension, REAL *Y) {
+
+    if (A_rows <= 0 || A_columns <= 0 || dimension <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions provided. All dimensions must be strictly positive. (A_rows=%" PRId64 ", A_columns=%" PRId64 ", dimension=%" PRId64 ")\n",
+                A_rows, A_columns, dimension);
+        return -1;
+    }
+
+    if (A_rows != dimension) {
+        fprintf(stderr, "Error: Dimension mismatch. Matrix rows (%" PRId64 ") must equal vector size (%" PRId64 ").\n",
+                A_rows, dimension);
+        return -1;
+    }
+
+    if (!A || !X || !Y) {
+        fprintf(stderr, "Error: Null pointer detected in parallel_transposed_vector_matrix_product_into.\n");
+        return -1;
+    }
+
+    if (ranges_overlap(Y, A_columns, A, (size_t) A_rows * A_columns) || ranges_overlap(Y, A_columns, X, dimension)) {
+        fprintf(stderr, "Error: Output vector overlaps an input in parallel_transposed_vector_matrix_product_into.\n");
+        return -1;
+    }
+
+    int threads = omp_get_max_threads(), failed = 0;
+    REAL **partials = calloc(threads, sizeof(REAL *));
+
+    if (!partials) {
+        fprintf(stderr, "Error: Memory allocation failed for partial vectors in parallel_transposed_vector_matrix_product_into.\n");
+        return -1;
+    }
+
+#pragma omp parallel shared(failed)
+    {
+	int thread = omp_get_thread_num(), team = omp_get_num_threads();
+
+	// The first thread accumulates directly into Y, the others into their own partial vector
+	partials[thread] = thread == 0 ? Y : aligned_buffer(sizeof(REAL) * A_columns);
+
+	if (!partials[thread]) {
+#pragma omp atomic write
+	    failed = 1;
+	}
+
+#pragma omp barrier
+
+	if (!failed) {
+	    index_t chunk = (A_rows + team - 1) / team;
+
+	    chunk = (chunk + GEMV_ROWS - 1) / GEMV_ROWS * GEMV_ROWS;
+
+	    index_t first = thread * chunk < A_rows ? thread * chunk : A_rows;
+	    index_t last = first + chunk < A_rows ? first + chunk : A_rows;
+
+	    FN(blocked_transposed_vector_matrix_product)(last - first, A_columns, A + first * A_columns, A_columns,
+							 X + first, partials[thread]);
+
+#pragma omp barrier
+
+	    // Reduction of the partial vectors, split by columns
+#pragma omp for schedule(static)
+	    for (index_t j = 0; j < A_columns; j++)
+		for (int t = 1; t < team; t++)
+		    Y[j] += partials[t][j];
+	}
+    }
+
+    for (int t = 1; t < threads; t++)
+	free(partials[t]);
+    free(partials);
+
+    if (failed) {
+        fprintf(stderr, "Error: Memory allocation failed for partial vectors in parallel_transposed_vector_matrix_product_into.\n");
+        return -1;
+    }
+
+    return 0;
+
+}
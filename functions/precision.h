@@ -0,0 +1,28 @@
+#ifndef __LinearAlgebraPrecision_
+#define __LinearAlgebraPrecision_
+
+#include "LinearAlgebraBasics.h"
+#include <float.h>
+
+/*
+ * Scalar type of the translation unit being compiled.
+ *
+ * Every source of functions/ is written with REAL, FN and TYPED (see
+ * LinearAlgebraReal.h) and compiled twice: as is for double precision, and
+ * with -DSINGLE_PRECISION for the "_float" functions. REAL_EPSILON is the
+ * machine epsilon of REAL, the floor of the convergence tolerances.
+ */
+
+#ifdef SINGLE_PRECISION
+#define REAL float
+#define FN(name) name##_float
+#define TYPED(name) name##_float
+#define REAL_EPSILON FLT_EPSILON
+#else
+#define REAL double
+#define FN(name) name
+#define TYPED(name) name##_double
+#define REAL_EPSILON DBL_EPSILON
+#endif
+
+#endif
@@ -1,4 +1,4 @@
-#include "LinearAlgebraBasics.h"
+#include "kernels.h"
 
 /**
  * @brief Computes the product of a matrix A and a vector X sequentially.
@@ -16,16 +16,16 @@
  *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
  */
 
-double *sequential_vector_matrix_product(double *A, int A_rows, int A_columns, double *X, int dimension) {
+REAL *FN(sequential_vector_matrix_product)(REAL *A, index_t A_rows, index_t A_columns, REAL *X, index_t dimension) {
 
     if (A_rows <= 0 || A_columns <= 0 || dimension <= 0) {
-        fprintf(stderr, "Error: Invalid dimensions provided. All dimensions must be strictly positive. (A_rows=%d, A_columns=%d, dimension=%d)\n", 
+        fprintf(stderr, "Error: Invalid dimensions provided. All dimensions must be strictly positive. (A_rows=%" PRId64 ", A_columns=%" PRId64 ", dimension=%" PRId64 ")\n", 
                 A_rows, A_columns, dimension);
         return NULL;
     }
 
     if (A_columns != dimension) {
-        fprintf(stderr, "Error: Dimension mismatch. Matrix columns (%d) must equal vector size (%d).\n", 
+        fprintf(stderr, "Error: Dimension mismatch. Matrix columns (%" PRId64 ") must equal vector size (%" PRId64 ").\n", 
                 A_columns, dimension);
         return NULL;
     }
@@ -35,23 +35,207 @@ double *sequential_vector_matrix_product(double *A, int A_rows, int A_columns, d
         return NULL;
     }
 
-    double *vector = malloc(A_rows * sizeof(double));
+    REAL *vector = malloc(A_rows * sizeof(REAL));
 
     if (!vector) {
-        fprintf(stderr, "Error: Memory allocation failed for result vector of size %d.\n", A_rows);
+        fprintf(stderr, "Error: Memory allocation failed for result vector of size %" PRId64 ".\n", A_rows);
         return NULL;
     }
 
-    double value = 0.0;
-    
-    for (int i = 0; i < A_rows; i++) {
-	value = 0.0;
-	for (int j = 0; j < A_columns; j++) {
-	    value += A[i * A_columns + j] * X[j];
-	}
-	vector[i] = value;
+    FN(sequential_vector_matrix_product_into)(A, A_rows, A_columns, X, dimension, vector);
+
+    return vector;
+
+}
+
+/**
+ * @brief Computes the product of a matrix A and a vector X sequentially into a caller-provided vector.
+ *
+ * Same as sequential_vector_matrix_product, without allocating the result. Y must not overlap A or X.
+ *
+ * @param A Pointer to the input matrix (size: A_rows x A_columns).
+ * @param A_rows Number of rows in the matrix A (must be positive).
+ * @param A_columns Number of columns in the matrix A (must equal dimension).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal A_columns).
+ * @param Y Pointer to the output vector (size: A_rows).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers or aliased output.
+ */
+
+int FN(sequential_vector_matrix_product_into)(REAL *A, index_t A_rows, index_t A_columns, REAL *X, index_t dimension, REAL *Y) {
+
+    if (A_rows <= 0 || A_columns <= 0 || dimension <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions provided. All dimensions must be strictly positive. (A_rows=%" PRId64 ", A_columns=%" PRId64 ", dimension=%" PRId64 ")\n", 
+                A_rows, A_columns, dimension);
+        return -1;
+    }
+
+    if (A_columns != dimension) {
+        fprintf(stderr, "Error: Dimension mismatch. Matrix columns (%" PRId64 ") must equal vector size (%" PRId64 ").\n", 
+                A_columns, dimension);
+        return -1;
+    }
+
+    if (!A || !X || !Y) {
+        fprintf(stderr, "Error: Null pointer detected in sequential_vector_matrix_product_into.\n");
+        return -1;
+    }
+
+    if (ranges_overlap(Y, A_rows, A, (size_t) A_rows * A_columns) || ranges_overlap(Y, A_rows, X, dimension)) {
+        fprintf(stderr, "Error: Output vector overlaps an input in sequential_vector_matrix_product_into.\n");
+        return -1;
+    }
+
+    FN(blocked_vector_matrix_product)(A_rows, A_columns, A, A_columns, X, dimension, 1, Y, A_rows);
+
+    return 0;
+
+}
+
+/**
+ * @brief Computes the products of a matrix A with several vectors sequentially, reading A once.
+ *
+ * This function calculates Y_v = A * X_v for v = 0, ..., vectors - 1.
+ * Applying A to all the vectors in one pass costs about the memory traffic of a
+ * single matrix-vector product, which is what bounds iterative methods on large matrices.
+ *
+ * @param A Pointer to the input matrix (size: A_rows x A_columns).
+ * @param A_rows Number of rows in the matrix A (must be positive).
+ * @param A_columns Number of columns in the matrix A (must equal dimension).
+ * @param X Pointer to the input vectors, stored one after the other (size: vectors x dimension).
+ * @param dimension Dimension of each vector X_v (must equal A_columns).
+ * @param vectors Number of vectors (must be positive).
+ * @param Y Pointer to the output vectors, stored one after the other (size: vectors x A_rows).
+ *         Y must not overlap A or X.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers or aliased output.
+ */
+
+int FN(sequential_multi_vector_matrix_product)(REAL *A, index_t A_rows, index_t A_columns, REAL *X, index_t dimension,
+                                              index_t vectors, REAL *Y) {
+
+    if (A_rows <= 0 || A_columns <= 0 || dimension <= 0 || vectors <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions provided. All dimensions must be strictly positive. (A_rows=%" PRId64 ", A_columns=%" PRId64 ", dimension=%" PRId64 ", vectors=%" PRId64 ")\n",
+                A_rows, A_columns, dimension, vectors);
+        return -1;
+    }
+
+    if (A_columns != dimension) {
+        fprintf(stderr, "Error: Dimension mismatch. Matrix columns (%" PRId64 ") must equal vector size (%" PRId64 ").\n",
+                A_columns, dimension);
+        return -1;
+    }
+
+    if (!A || !X || !Y) {
+        fprintf(stderr, "Error: Null pointer detected in sequential_multi_vector_matrix_product.\n");
+        return -1;
+    }
+
+    if (ranges_overlap(Y, (size_t) vectors * A_rows, A, (size_t) A_rows * A_columns) ||
+        ranges_overlap(Y, (size_t) vectors * A_rows, X, (size_t) vectors * dimension)) {
+        fprintf(stderr, "Error: Output vectors overlap an input in sequential_multi_vector_matrix_product.\n");
+        return -1;
+    }
+
+    FN(blocked_vector_matrix_product)(A_rows, A_columns, A, A_columns, X, dimension, vectors, Y, A_rows);
+
+    return 0;
+
+}
+
+/**
+ * @brief Computes the product of the transpose of a matrix A and a vector X sequentially.
+ *
+ * This function calculates the vector result = A^T * X (equivalently X^T * A) without
+ * forming the transpose: the rows of A are accumulated in the order they are stored.
+ *
+ * @param A Pointer to the input matrix (size: A_rows x A_columns).
+ * @param A_rows Number of rows in the matrix A (must equal dimension).
+ * @param A_columns Number of columns in the matrix A (must be positive).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal A_rows).
+ *
+ * @return Pointer to the resulting vector (size: A_columns) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(sequential_transposed_vector_matrix_product)(REAL *A, index_t A_rows, index_t A_columns, REAL *X, index_t dimension) {
+
+    if (A_rows <= 0 || A_columns <= 0 || dimension <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions provided. All dimensions must be strictly positive. (A_rows=%" PRId64 ", A_columns=%" PRId64 ", dimension=%" PRId64 ")\n",
+                A_rows, A_columns, dimension);
+        return NULL;
+    }
+
+    if (A_rows != dimension) {
+        fprintf(stderr, "Error: Dimension mismatch. Matrix rows (%" PRId64 ") must equal vector size (%" PRId64 ").\n",
+                A_rows, dimension);
+        return NULL;
+    }
+
+    if (!A || !X) {
+        fprintf(stderr, "Error: Null pointer detected in sequential_transposed_vector_matrix_product.\n");
+        return NULL;
+    }
+
+    REAL *vector = malloc(A_columns * sizeof(REAL));
+
+    if (!vector) {
+        fprintf(stderr, "Error: Memory allocation failed for result vector of size %" PRId64 ".\n", A_columns);
+        return NULL;
+    }
+
+    if (FN(sequential_transposed_vector_matrix_product_into)(A, A_rows, A_columns, X, dimension, vector) != 0) {
+        free(vector);
+        return NULL;
     }
 
     return vector;
 
 }
+
+/**
+ * @brief Computes the product of the transpose of a matrix A and a vector X sequentially into a caller-provided vector.
+ *
+ * Same as sequential_transposed_vector_matrix_product, without allocating the result. Y must not overlap A or X.
+ *
+ * @param A Pointer to the input matrix (size: A_rows x A_columns).
+ * @param A_rows Number of rows in the matrix A (must equal dimension).
+ * @param A_columns Number of columns in the matrix A (must be positive).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal A_rows).
+ * @param Y Pointer to the output vector (size: A_columns).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers, aliased output.
+ */
+
+int FN(sequential_transposed_vector_matrix_product_into)(REAL *A, index_t A_rows, index_t A_columns, REAL *X, index_t dimension, REAL *Y) {
+
+    if (A_rows <= 0 || A_columns <= 0 || dimension <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions provided. All dimensions must be strictly positive. (A_rows=%" PRId64 ", A_columns=%" PRId64 ", dimension=%" PRId64 ")\n",
+                A_rows, A_columns, dimension);
+        return -1;
+    }
+
+    if (A_rows != dimension) {
+        fprintf(stderr, "Error: Dimension mismatch. Matrix rows (%" PRId64 ") must equal vector size (%" PRId64 ").\n",
+                A_rows, dimension);
+        return -1;
+    }
+
+    if (!A || !X || !Y) {
+        fprintf(stderr, "Error: Null pointer detected in sequential_transposed_vector_matrix_product_into.\n");
+        return -1;
+    }
+
+    if (ranges_overlap(Y, A_columns, A, (size_t) A_rows * A_columns) || ranges_overlap(Y, A_columns, X, dimension)) {
+        fprintf(stderr, "Error: Output vector overlaps an input in sequential_transposed_vector_matrix_product_into.\n");
+        return -1;
+    }
+
+    FN(blocked_transposed_vector_matrix_product)(A_rows, A_columns, A, A_columns, X, Y);
+
+    return 0;
+
+}
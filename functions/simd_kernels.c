@@ -0,0 +1,718 @@
+#include "kernels.h"
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86
+#include <immintrin.h>
+#endif
+
+/*
+ * Every instruction set provides the same kernels. The x86 variants are
+ * compiled with per-function target attributes, so the library itself is
+ * built without any -march flag and runs on every x86-64 CPU; the best set
+ * supported by the CPU is selected once, when the library is loaded.
+ *
+ * The kernels are written once on the vector types below, which hold
+ * REALs, or floats when the file is compiled with SINGLE_PRECISION. A
+ * register holds twice as many floats as REALs, so the microkernels
+ * keep two registers per row of C and have a tile twice as wide in float.
+ */
+
+#ifdef SIMD_X86
+#ifdef SINGLE_PRECISION
+
+#define SSE2_LANES 4
+#define V128 __m128
+#define V128_ZERO _mm_setzero_ps
+#define V128_LOAD _mm_load_ps
+#define V128_LOADU _mm_loadu_ps
+#define V128_STOREU _mm_storeu_ps
+#define V128_SET1 _mm_set1_ps
+#define V128_ADD _mm_add_ps
+#define V128_MUL _mm_mul_ps
+
+#define AVX2_LANES 8
+#define V256 __m256
+#define V256_ZERO _mm256_setzero_ps
+#define V256_LOAD _mm256_load_ps
+#define V256_LOADU _mm256_loadu_ps
+#define V256_STOREU _mm256_storeu_ps
+#define V256_SET1 _mm256_set1_ps
+#define V256_BROADCAST _mm256_broadcast_ss
+#define V256_ADD _mm256_add_ps
+#define V256_MUL _mm256_mul_ps
+#define V256_FMADD _mm256_fmadd_ps
+
+#define AVX512_LANES 16
+#define V512 __m512
+#define V512_MASK __mmask16
+#define V512_ZERO _mm512_setzero_ps
+#define V512_LOAD _mm512_load_ps
+#define V512_LOADU _mm512_loadu_ps
+#define V512_MASKZ_LOADU _mm512_maskz_loadu_ps
+#define V512_STOREU _mm512_storeu_ps
+#define V512_MASK_STOREU _mm512_mask_storeu_ps
+#define V512_SET1 _mm512_set1_ps
+#define V512_ADD _mm512_add_ps
+#define V512_MUL _mm512_mul_ps
+#define V512_FMADD _mm512_fmadd_ps
+#define V512_REDUCE_ADD _mm512_reduce_add_ps
+
+#else
+
+#define SSE2_LANES 2
+#define V128 __m128d
+#define V128_ZERO _mm_setzero_pd
+#define V128_LOAD _mm_load_pd
+#define V128_LOADU _mm_loadu_pd
+#define V128_STOREU _mm_storeu_pd
+#define V128_SET1 _mm_set1_pd
+#define V128_ADD _mm_add_pd
+#define V128_MUL _mm_mul_pd
+
+#define AVX2_LANES 4
+#define V256 __m256d
+#define V256_ZERO _mm256_setzero_pd
+#define V256_LOAD _mm256_load_pd
+#define V256_LOADU _mm256_loadu_pd
+#define V256_STOREU _mm256_storeu_pd
+#define V256_SET1 _mm256_set1_pd
+#define V256_BROADCAST _mm256_broadcast_sd
+#define V256_ADD _mm256_add_pd
+#define V256_MUL _mm256_mul_pd
+#define V256_FMADD _mm256_fmadd_pd
+
+#define AVX512_LANES 8
+#define V512 __m512d
+#define V512_MASK __mmask8
+#define V512_ZERO _mm512_setzero_pd
+#define V512_LOAD _mm512_load_pd
+#define V512_LOADU _mm512_loadu_pd
+#define V512_MASKZ_LOADU _mm512_maskz_loadu_pd
+#define V512_STOREU _mm512_storeu_pd
+#define V512_MASK_STOREU _mm512_mask_storeu_pd
+#define V512_SET1 _mm512_set1_pd
+#define V512_ADD _mm512_add_pd
+#define V512_MUL _mm512_mul_pd
+#define V512_FMADD _mm512_fmadd_pd
+#define V512_REDUCE_ADD _mm512_reduce_add_pd
+
+#endif
+#endif
+
+/**
+ * @brief Writes an mr x nr accumulated tile into C as C = alpha * tile + beta * C.
+ *
+ * Shared by the microkernels for the edge tiles of C, where only a part of the
+ * register block is stored.
+ */
+
+static void store_tile(const REAL *tile, index_t ld_tile, REAL *C, index_t ldc,
+		       REAL alpha, REAL beta, int mr, int nr) {
+
+    for (index_t i = 0; i < mr; i++) {
+	REAL *row = C + (size_t) i * ldc;
+	if (beta == 0.0) {
+	    for (index_t j = 0; j < nr; j++)
+		row[j] = alpha * tile[i * ld_tile + j];
+	}
+	else {
+	    for (index_t j = 0; j < nr; j++)
+		row[j] = alpha * tile[i * ld_tile + j] + beta * row[j];
+	}
+    }
+
+}
+
+/* ----------------------------------------------------------------------------------------------- */
+/* Generic C kernels (any architecture)                                                            */
+/* ----------------------------------------------------------------------------------------------- */
+
+#define GENERIC_MR 4
+#define GENERIC_NR 8
+
+static void microkernel_generic(int kc, const REAL *a, const REAL *b, REAL *C, index_t ldc,
+				REAL alpha, REAL beta, int mr, int nr) {
+
+    REAL acc[GENERIC_MR * GENERIC_NR];
+
+    for (index_t i = 0; i < GENERIC_MR * GENERIC_NR; i++)
+	acc[i] = 0.0;
+
+    for (index_t k = 0; k < kc; k++) {
+	for (index_t i = 0; i < GENERIC_MR; i++) {
+	    REAL a_i = a[i];
+	    for (index_t j = 0; j < GENERIC_NR; j++)
+		acc[i * GENERIC_NR + j] += a_i * b[j];
+	}
+	a += GENERIC_MR;
+	b += GENERIC_NR;
+    }
+
+    store_tile(acc, GENERIC_NR, C, ldc, alpha, beta, mr, nr);
+
+}
+
+static REAL dot_generic(const REAL *X, const REAL *Y, index_t n) {
+
+    REAL s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    index_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+	s0 += X[i] * Y[i];
+	s1 += X[i + 1] * Y[i + 1];
+	s2 += X[i + 2] * Y[i + 2];
+	s3 += X[i + 3] * Y[i + 3];
+    }
+    for (; i < n; i++)
+	s0 += X[i] * Y[i];
+
+    return (s0 + s1) + (s2 + s3);
+
+}
+
+static void add_generic(const REAL *X, const REAL *Y, REAL *Z, index_t n) {
+
+    for (index_t i = 0; i < n; i++)
+	Z[i] = X[i] + Y[i];
+
+}
+
+static void multiply_generic(const REAL *X, const REAL *Y, REAL *Z, index_t n) {
+
+    for (index_t i = 0; i < n; i++)
+	Z[i] = X[i] * Y[i];
+
+}
+
+static void axpy_generic(REAL alpha, const REAL *X, REAL *Y, index_t n) {
+
+    for (index_t i = 0; i < n; i++)
+	Y[i] += alpha * X[i];
+
+}
+
+static const simd_kernels kernels_generic = {
+    "generic", GENERIC_MR, GENERIC_NR,
+    microkernel_generic, dot_generic, add_generic, multiply_generic, axpy_generic
+};
+
+#ifdef SIMD_X86
+
+/* ----------------------------------------------------------------------------------------------- */
+/* SSE2 kernels (2 doubles or 4 floats per register)                                               */
+/* ----------------------------------------------------------------------------------------------- */
+
+#define SSE2_MR 4
+#define SSE2_NR (2 * SSE2_LANES)
+
+__attribute__((target("sse2")))
+static void microkernel_sse2(int kc, const REAL *a, const REAL *b, REAL *C, index_t ldc,
+			     REAL alpha, REAL beta, int mr, int nr) {
+
+    V128 c[SSE2_MR][2];
+
+    for (index_t i = 0; i < SSE2_MR; i++)
+	c[i][0] = c[i][1] = V128_ZERO();
+
+    for (index_t k = 0; k < kc; k++) {
+	V128 b0 = V128_LOAD(b);
+	V128 b1 = V128_LOAD(b + SSE2_LANES);
+	for (index_t i = 0; i < SSE2_MR; i++) {
+	    V128 a_i = V128_SET1(a[i]);
+	    c[i][0] = V128_ADD(c[i][0], V128_MUL(a_i, b0));
+	    c[i][1] = V128_ADD(c[i][1], V128_MUL(a_i, b1));
+	}
+	a += SSE2_MR;
+	b += SSE2_NR;
+    }
+
+    V128 alpha_v = V128_SET1(alpha);
+
+    if (mr == SSE2_MR && nr == SSE2_NR) {
+	V128 beta_v = V128_SET1(beta);
+	for (index_t i = 0; i < SSE2_MR; i++) {
+	    REAL *row = C + (size_t) i * ldc;
+	    V128 r0 = V128_MUL(alpha_v, c[i][0]);
+	    V128 r1 = V128_MUL(alpha_v, c[i][1]);
+	    if (beta != 0.0) {
+		r0 = V128_ADD(r0, V128_MUL(beta_v, V128_LOADU(row)));
+		r1 = V128_ADD(r1, V128_MUL(beta_v, V128_LOADU(row + SSE2_LANES)));
+	    }
+	    V128_STOREU(row, r0);
+	    V128_STOREU(row + SSE2_LANES, r1);
+	}
+	return;
+    }
+
+    REAL tile[SSE2_MR * SSE2_NR];
+
+    for (index_t i = 0; i < SSE2_MR; i++) {
+	V128_STOREU(tile + i * SSE2_NR, c[i][0]);
+	V128_STOREU(tile + i * SSE2_NR + SSE2_LANES, c[i][1]);
+    }
+
+    store_tile(tile, SSE2_NR, C, ldc, alpha, beta, mr, nr);
+
+}
+
+__attribute__((target("sse2")))
+static REAL dot_sse2(const REAL *X, const REAL *Y, index_t n) {
+
+    V128 s0 = V128_ZERO(), s1 = V128_ZERO();
+    V128 s2 = V128_ZERO(), s3 = V128_ZERO();
+    index_t i = 0;
+
+    for (; i + 4 * SSE2_LANES <= n; i += 4 * SSE2_LANES) {
+	s0 = V128_ADD(s0, V128_MUL(V128_LOADU(X + i), V128_LOADU(Y + i)));
+	s1 = V128_ADD(s1, V128_MUL(V128_LOADU(X + i + SSE2_LANES), V128_LOADU(Y + i + SSE2_LANES)));
+	s2 = V128_ADD(s2, V128_MUL(V128_LOADU(X + i + 2 * SSE2_LANES), V128_LOADU(Y + i + 2 * SSE2_LANES)));
+	s3 = V128_ADD(s3, V128_MUL(V128_LOADU(X + i + 3 * SSE2_LANES), V128_LOADU(Y + i + 3 * SSE2_LANES)));
+    }
+
+    REAL lanes[SSE2_LANES];
+
+    V128_STOREU(lanes, V128_ADD(V128_ADD(s0, s1), V128_ADD(s2, s3)));
+
+    REAL sum = 0.0;
+
+    for (index_t l = 0; l < SSE2_LANES; l++)
+	sum += lanes[l];
+
+    for (; i < n; i++)
+	sum += X[i] * Y[i];
+
+    return sum;
+
+}
+
+__attribute__((target("sse2")))
+static void add_sse2(const REAL *X, const REAL *Y, REAL *Z, index_t n) {
+
+    index_t i = 0;
+
+    for (; i + SSE2_LANES <= n; i += SSE2_LANES)
+	V128_STOREU(Z + i, V128_ADD(V128_LOADU(X + i), V128_LOADU(Y + i)));
+    for (; i < n; i++)
+	Z[i] = X[i] + Y[i];
+
+}
+
+__attribute__((target("sse2")))
+static void multiply_sse2(const REAL *X, const REAL *Y, REAL *Z, index_t n) {
+
+    index_t i = 0;
+
+    for (; i + SSE2_LANES <= n; i += SSE2_LANES)
+	V128_STOREU(Z + i, V128_MUL(V128_LOADU(X + i), V128_LOADU(Y + i)));
+    for (; i < n; i++)
+	Z[i] = X[i] * Y[i];
+
+}
+
+__attribute__((target("sse2")))
+static void axpy_sse2(REAL alpha, const REAL *X, REAL *Y, index_t n) {
+
+    V128 alpha_v = V128_SET1(alpha);
+    index_t i = 0;
+
+    for (; i + SSE2_LANES <= n; i += SSE2_LANES)
+	V128_STOREU(Y + i, V128_ADD(V128_LOADU(Y + i), V128_MUL(alpha_v, V128_LOADU(X + i))));
+    for (; i < n; i++)
+	Y[i] += alpha * X[i];
+
+}
+
+static const simd_kernels kernels_sse2 = {
+    "sse2", SSE2_MR, SSE2_NR,
+    microkernel_sse2, dot_sse2, add_sse2, multiply_sse2, axpy_sse2
+};
+
+/* ----------------------------------------------------------------------------------------------- */
+/* AVX2 + FMA kernels (4 doubles or 8 floats per register)                                         */
+/* ----------------------------------------------------------------------------------------------- */
+
+#define AVX2_MR 6
+#define AVX2_NR (2 * AVX2_LANES)
+
+__attribute__((target("avx2,fma")))
+static void microkernel_avx2(int kc, const REAL *a, const REAL *b, REAL *C, index_t ldc,
+			     REAL alpha, REAL beta, int mr, int nr) {
+
+    V256 c[AVX2_MR][2];
+
+    for (index_t i = 0; i < AVX2_MR; i++)
+	c[i][0] = c[i][1] = V256_ZERO();
+
+    for (index_t k = 0; k < kc; k++) {
+	V256 b0 = V256_LOAD(b);
+	V256 b1 = V256_LOAD(b + AVX2_LANES);
+	for (index_t i = 0; i < AVX2_MR; i++) {
+	    V256 a_i = V256_BROADCAST(a + i);
+	    c[i][0] = V256_FMADD(a_i, b0, c[i][0]);
+	    c[i][1] = V256_FMADD(a_i, b1, c[i][1]);
+	}
+	a += AVX2_MR;
+	b += AVX2_NR;
+    }
+
+    V256 alpha_v = V256_SET1(alpha);
+
+    if (mr == AVX2_MR && nr == AVX2_NR) {
+	V256 beta_v = V256_SET1(beta);
+	for (index_t i = 0; i < AVX2_MR; i++) {
+	    REAL *row = C + (size_t) i * ldc;
+	    V256 r0 = V256_MUL(alpha_v, c[i][0]);
+	    V256 r1 = V256_MUL(alpha_v, c[i][1]);
+	    if (beta != 0.0) {
+		r0 = V256_FMADD(beta_v, V256_LOADU(row), r0);
+		r1 = V256_FMADD(beta_v, V256_LOADU(row + AVX2_LANES), r1);
+	    }
+	    V256_STOREU(row, r0);
+	    V256_STOREU(row + AVX2_LANES, r1);
+	}
+	return;
+    }
+
+    REAL tile[AVX2_MR * AVX2_NR];
+
+    for (index_t i = 0; i < AVX2_MR; i++) {
+	V256_STOREU(tile + i * AVX2_NR, c[i][0]);
+	V256_STOREU(tile + i * AVX2_NR + AVX2_LANES, c[i][1]);
+    }
+
+    store_tile(tile, AVX2_NR, C, ldc, alpha, beta, mr, nr);
+
+}
+
+__attribute__((target("avx2,fma")))
+static REAL dot_avx2(const REAL *X, const REAL *Y, index_t n) {
+
+    V256 s0 = V256_ZERO(), s1 = V256_ZERO();
+    V256 s2 = V256_ZERO(), s3 = V256_ZERO();
+    index_t i = 0;
+
+    for (; i + 4 * AVX2_LANES <= n; i += 4 * AVX2_LANES) {
+	s0 = V256_FMADD(V256_LOADU(X + i), V256_LOADU(Y + i), s0);
+	s1 = V256_FMADD(V256_LOADU(X + i + AVX2_LANES), V256_LOADU(Y + i + AVX2_LANES), s1);
+	s2 = V256_FMADD(V256_LOADU(X + i + 2 * AVX2_LANES), V256_LOADU(Y + i + 2 * AVX2_LANES), s2);
+	s3 = V256_FMADD(V256_LOADU(X + i + 3 * AVX2_LANES), V256_LOADU(Y + i + 3 * AVX2_LANES), s3);
+    }
+    for (; i + AVX2_LANES <= n; i += AVX2_LANES)
+	s0 = V256_FMADD(V256_LOADU(X + i), V256_LOADU(Y + i), s0);
+
+    REAL lanes[AVX2_LANES];
+
+    V256_STOREU(lanes, V256_ADD(V256_ADD(s0, s1), V256_ADD(s2, s3)));
+
+    REAL sum = 0.0;
+
+    for (index_t l = 0; l < AVX2_LANES; l++)
+	sum += lanes[l];
+
+    for (; i < n; i++)
+	sum += X[i] * Y[i];
+
+    return sum;
+
+}
+
+__attribute__((target("avx2,fma")))
+static void add_avx2(const REAL *X, const REAL *Y, REAL *Z, index_t n) {
+
+    index_t i = 0;
+
+    for (; i + AVX2_LANES <= n; i += AVX2_LANES)
+	V256_STOREU(Z + i, V256_ADD(V256_LOADU(X + i), V256_LOADU(Y + i)));
+    for (; i < n; i++)
+	Z[i] = X[i] + Y[i];
+
+}
+
+__attribute__((target("avx2,fma")))
+static void multiply_avx2(const REAL *X, const REAL *Y, REAL *Z, index_t n) {
+
+    index_t i = 0;
+
+    for (; i + AVX2_LANES <= n; i += AVX2_LANES)
+	V256_STOREU(Z + i, V256_MUL(V256_LOADU(X + i), V256_LOADU(Y + i)));
+    for (; i < n; i++)
+	Z[i] = X[i] * Y[i];
+
+}
+
+__attribute__((target("avx2,fma")))
+static void axpy_avx2(REAL alpha, const REAL *X, REAL *Y, index_t n) {
+
+    V256 alpha_v = V256_SET1(alpha);
+    index_t i = 0;
+
+    for (; i + AVX2_LANES <= n; i += AVX2_LANES)
+	V256_STOREU(Y + i, V256_FMADD(alpha_v, V256_LOADU(X + i), V256_LOADU(Y + i)));
+    for (; i < n; i++)
+	Y[i] += alpha * X[i];
+
+}
+
+static const simd_kernels kernels_avx2 = {
+    "avx2", AVX2_MR, AVX2_NR,
+    microkernel_avx2, dot_avx2, add_avx2, multiply_avx2, axpy_avx2
+};
+
+/* ----------------------------------------------------------------------------------------------- */
+/* AVX-512 kernels (8 doubles or 16 floats per register)                                           */
+/* ----------------------------------------------------------------------------------------------- */
+
+#define AVX512_MR 8
+#define AVX512_NR (2 * AVX512_LANES)
+
+__attribute__((target("avx512f")))
+static void microkernel_avx512(int kc, const REAL *a, const REAL *b, REAL *C, index_t ldc,
+			       REAL alpha, REAL beta, int mr, int nr) {
+
+    V512 c[AVX512_MR][2];
+
+    for (index_t i = 0; i < AVX512_MR; i++)
+	c[i][0] = c[i][1] = V512_ZERO();
+
+    for (index_t k = 0; k < kc; k++) {
+	V512 b0 = V512_LOAD(b);
+	V512 b1 = V512_LOAD(b + AVX512_LANES);
+	for (index_t i = 0; i < AVX512_MR; i++) {
+	    V512 a_i = V512_SET1(a[i]);
+	    c[i][0] = V512_FMADD(a_i, b0, c[i][0]);
+	    c[i][1] = V512_FMADD(a_i, b1, c[i][1]);
+	}
+	a += AVX512_MR;
+	b += AVX512_NR;
+    }
+
+    V512 alpha_v = V512_SET1(alpha);
+
+    if (mr == AVX512_MR && nr == AVX512_NR) {
+	V512 beta_v = V512_SET1(beta);
+	for (index_t i = 0; i < AVX512_MR; i++) {
+	    REAL *row = C + (size_t) i * ldc;
+	    V512 r0 = V512_MUL(alpha_v, c[i][0]);
+	    V512 r1 = V512_MUL(alpha_v, c[i][1]);
+	    if (beta != 0.0) {
+		r0 = V512_FMADD(beta_v, V512_LOADU(row), r0);
+		r1 = V512_FMADD(beta_v, V512_LOADU(row + AVX512_LANES), r1);
+	    }
+	    V512_STOREU(row, r0);
+	    V512_STOREU(row + AVX512_LANES, r1);
+	}
+	return;
+    }
+
+    REAL tile[AVX512_MR * AVX512_NR];
+
+    for (index_t i = 0; i < AVX512_MR; i++) {
+	V512_STOREU(tile + i * AVX512_NR, c[i][0]);
+	V512_STOREU(tile + i * AVX512_NR + AVX512_LANES, c[i][1]);
+    }
+
+    store_tile(tile, AVX512_NR, C, ldc, alpha, beta, mr, nr);
+
+}
+
+__attribute__((target("avx512f")))
+static REAL dot_avx512(const REAL *X, const REAL *Y, index_t n) {
+
+    V512 s0 = V512_ZERO(), s1 = V512_ZERO();
+    V512 s2 = V512_ZERO(), s3 = V512_ZERO();
+    index_t i = 0;
+
+    for (; i + 4 * AVX512_LANES <= n; i += 4 * AVX512_LANES) {
+	s0 = V512_FMADD(V512_LOADU(X + i), V512_LOADU(Y + i), s0);
+	s1 = V512_FMADD(V512_LOADU(X + i + AVX512_LANES), V512_LOADU(Y + i + AVX512_LANES), s1);
+	s2 = V512_FMADD(V512_LOADU(X + i + 2 * AVX512_LANES), V512_LOADU(Y + i + 2 * AVX512_LANES), s2);
+	s3 = V512_FMADD(V512_LOADU(X + i + 3 * AVX512_LANES), V512_LOADU(Y + i + 3 * AVX512_LANES), s3);
+    }
+    for (; i + AVX512_LANES <= n; i += AVX512_LANES)
+	s0 = V512_FMADD(V512_LOADU(X + i), V512_LOADU(Y + i), s0);
+
+    if (i < n) {
+	V512_MASK mask = (V512_MASK) ((1u << (n - i)) - 1);
+	s1 = V512_FMADD(V512_MASKZ_LOADU(mask, X + i), V512_MASKZ_LOADU(mask, Y + i), s1);
+    }
+
+    return V512_REDUCE_ADD(V512_ADD(V512_ADD(s0, s1), V512_ADD(s2, s3)));
+
+}
+
+__attribute__((target("avx512f")))
+static void add_avx512(const REAL *X, const REAL *Y, REAL *Z, index_t n) {
+
+    index_t i = 0;
+
+    for (; i + AVX512_LANES <= n; i += AVX512_LANES)
+	V512_STOREU(Z + i, V512_ADD(V512_LOADU(X + i), V512_LOADU(Y + i)));
+
+    if (i < n) {
+	V512_MASK mask = (V512_MASK) ((1u << (n - i)) - 1);
+	V512_MASK_STOREU(Z + i, mask, V512_ADD(V512_MASKZ_LOADU(mask, X + i),
+							  V512_MASKZ_LOADU(mask, Y + i)));
+    }
+
+}
+
+__attribute__((target("avx512f")))
+static void multiply_avx512(const REAL *X, const REAL *Y, REAL *Z, index_t n) {
+
+    index_t i = 0;
+
+    for (; i + AVX512_LANES <= n; i += AVX512_LANES)
+	V512_STOREU(Z + i, V512_MUL(V512_LOADU(X + i), V512_LOADU(Y + i)));
+
+    if (i < n) {
+	V512_MASK mask = (V512_MASK) ((1u << (n - i)) - 1);
+	V512_MASK_STOREU(Z + i, mask, V512_MUL(V512_MASKZ_LOADU(mask, X + i),
+							  V512_MASKZ_LOADU(mask, Y + i)));
+    }
+
+}
+
+__attribute__((target("avx512f")))
+static void axpy_avx512(REAL alpha, const REAL *X, REAL *Y, index_t n) {
+
+    V512 alpha_v = V512_SET1(alpha);
+    index_t i = 0;
+
+    for (; i + AVX512_LANES <= n; i += AVX512_LANES)
+	V512_STOREU(Y + i, V512_FMADD(alpha_v, V512_LOADU(X + i), V512_LOADU(Y + i)));
+
+    if (i < n) {
+	V512_MASK mask = (V512_MASK) ((1u << (n - i)) - 1);
+	V512_MASK_STOREU(Y + i, mask, V512_FMADD(alpha_v, V512_MASKZ_LOADU(mask, X + i),
+							    V512_MASKZ_LOADU(mask, Y + i)));
+    }
+
+}
+
+static const simd_kernels kernels_avx512 = {
+    "avx512", AVX512_MR, AVX512_NR,
+    microkernel_avx512, dot_avx512, add_avx512, multiply_avx512, axpy_avx512
+};
+
+#endif
+
+/* ----------------------------------------------------------------------------------------------- */
+/* Runtime dispatch                                                                                */
+/* ----------------------------------------------------------------------------------------------- */
+
+const simd_kernels *FN(active_kernels) = &kernels_generic;
+
+/**
+ * @brief Returns the kernel set of a given instruction set if the CPU supports it.
+ */
+
+static const simd_kernels *supported_kernels(const char *name) {
+
+    if (!strcmp(name, "generic")) return &kernels_generic;
+
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+
+    if (!strcmp(name, "sse2") && __builtin_cpu_supports("sse2")) return &kernels_sse2;
+    if (!strcmp(name, "avx2") && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return &kernels_avx2;
+    if (!strcmp(name, "avx512") && __builtin_cpu_supports("avx512f")) return &kernels_avx512;
+#endif
+
+    return NULL;
+
+}
+
+/**
+ * @brief Selects the kernels of one precision for a given instruction set.
+ *
+ * @return 0 on success, or -1 when the name is unknown or the CPU does not support it.
+ */
+
+int FN(select_kernels)(const char *name) {
+
+    const simd_kernels *candidate = supported_kernels(name);
+
+    if (!candidate) return -1;
+
+    FN(active_kernels) = candidate;
+
+    return 0;
+
+}
+
+/*
+ * The public selection functions are compiled once, with the double-precision
+ * kernels, and switch both precisions together.
+ */
+
+#ifndef SINGLE_PRECISION
+
+/**
+ * @brief Selects the widest instruction set supported by the CPU when the library is loaded.
+ *
+ * The LINEAR_ALGEBRA_BASICS_ISA environment variable (generic, sse2, avx2 or avx512)
+ * can request another supported instruction set, e.g. to compare the code paths.
+ */
+
+__attribute__((constructor))
+static void select_default_kernels(void) {
+
+    static const char *preferred[] = {"avx512", "avx2", "sse2"};
+
+    const char *requested = getenv("LINEAR_ALGEBRA_BASICS_ISA");
+
+    if (requested && simd_select_instruction_set(requested) == 0) return;
+
+    for (size_t i = 0; i < sizeof(preferred) / sizeof(preferred[0]); i++) {
+	if (select_kernels(preferred[i]) == 0) {
+	    select_kernels_float(preferred[i]);
+	    return;
+	}
+    }
+
+}
+
+/**
+ * @brief Returns the name of the instruction set used by the kernels.
+ *
+ * @return "generic", "sse2", "avx2" or "avx512".
+ */
+
+const char *simd_instruction_set(void) {
+
+    return active_kernels->name;
+
+}
+
+/**
+ * @brief Selects the instruction set used by the kernels.
+ *
+ * The selection applies to every subsequent call of the library, in both precisions.
+ * It should not be changed while another thread is running a kernel.
+ *
+ * @param name Name of the instruction set ("generic", "sse2", "avx2" or "avx512").
+ *
+ * @return 0 on success, or -1 on failure when the name is unknown or the CPU does not
+ *         support the instruction set.
+ */
+
+int simd_select_instruction_set(const char *name) {
+
+    if (!name) {
+        fprintf(stderr, "Error: Null pointer detected in simd_select_instruction_set.\n");
+        return -1;
+    }
+
+    if (select_kernels(name) != 0) {
+        fprintf(stderr, "Error: Instruction set %s is unknown or not supported by this CPU.\n", name);
+        return -1;
+    }
+
+    select_kernels_float(name);
+
+    return 0;
+
+}
+
+#endif
@@ -0,0 +1,296 @@
+#include "kernels.h"
+#include <string.h>
+
+/*
+ * A compressed matrix stores its nonzeros slice after slice, a slice being a row
+ * (CSR) or a column (CSC). In the functions below the "major" dimension counts the
+ * slices and the "minor" dimension indexes the elements inside a slice.
+ */
+
+/**
+ * @brief Allocates a compressed matrix with room for nnz nonzeros.
+ *
+ * @param rows Number of rows.
+ * @param columns Number of columns.
+ * @param nnz Number of nonzeros to allocate (may be 0).
+ * @param format SPARSE_CSR or SPARSE_CSC.
+ *
+ * @return Pointer to the matrix with its pointers, indices and values allocated,
+ *         or NULL on memory allocation failure.
+ */
+
+FN(sparse_matrix) *FN(create_sparse_matrix)(index_t rows, index_t columns, index_t nnz, int format) {
+
+    FN(sparse_matrix) *S = malloc(sizeof(FN(sparse_matrix)));
+
+    if (!S) {
+        fprintf(stderr, "Error: Memory allocation failed for sparse matrix structure.\n");
+        return NULL;
+    }
+
+    index_t majors = (format == SPARSE_CSR) ? rows : columns;
+
+    S->rows = rows;
+    S->columns = columns;
+    S->nnz = nnz;
+    S->format = format;
+
+    S->pointers = calloc(majors + 1, sizeof(index_t));
+    S->indices = malloc((nnz > 0 ? nnz : 1) * sizeof(index_t));
+    S->values = malloc((nnz > 0 ? nnz : 1) * sizeof(REAL));
+
+    if (!S->pointers || !S->indices || !S->values) {
+        fprintf(stderr, "Error: Memory allocation failed for arrays of a sparse matrix with %" PRId64 " nonzeros.\n", nnz);
+        FN(sparse_free)(S);
+        return NULL;
+    }
+
+    return S;
+
+}
+
+/**
+ * @brief Builds a compressed sparse matrix from coordinate (COO) triplets.
+ *
+ * Entry k has value values[k] at (row_indices[k], column_indices[k]). The triplets
+ * may come in any order; duplicated coordinates are summed. Inside each row (CSR)
+ * or column (CSC) the indices of the result are sorted in increasing order.
+ * The construction takes O(nnz + rows + columns) time with two counting sorts.
+ *
+ * @param rows Number of rows of the matrix (must be positive).
+ * @param columns Number of columns of the matrix (must be positive).
+ * @param nnz Number of triplets (must be non-negative).
+ * @param row_indices Row of each triplet, in [0, rows) (size: nnz).
+ * @param column_indices Column of each triplet, in [0, columns) (size: nnz).
+ * @param values Value of each triplet (size: nnz).
+ * @param format SPARSE_CSR or SPARSE_CSC.
+ *
+ * @return Pointer to the sparse matrix on success, or NULL on failure due to invalid
+ *         dimensions or format, out of bounds indices, null pointers or memory allocation errors.
+ */
+
+FN(sparse_matrix) *FN(sparse_from_coo)(index_t rows, index_t columns, index_t nnz, const index_t *row_indices,
+				       const index_t *column_indices, const REAL *values, int format) {
+
+    if (rows <= 0 || columns <= 0 || nnz < 0) {
+        fprintf(stderr, "Error: Invalid dimensions provided. (rows=%" PRId64 ", columns=%" PRId64 ", nnz=%" PRId64 ")\n",
+                rows, columns, nnz);
+        return NULL;
+    }
+
+    if (format != SPARSE_CSR && format != SPARSE_CSC) {
+        fprintf(stderr, "Error: Invalid format %d in sparse_from_coo. Expected SPARSE_CSR or SPARSE_CSC.\n", format);
+        return NULL;
+    }
+
+    if (nnz > 0 && (!row_indices || !column_indices || !values)) {
+        fprintf(stderr, "Error: Null pointer detected in sparse_from_coo.\n");
+        return NULL;
+    }
+
+    for (index_t k = 0; k < nnz; k++)
+	if (row_indices[k] < 0 || row_indices[k] >= rows || column_indices[k] < 0 || column_indices[k] >= columns) {
+	    fprintf(stderr, "Error: Triplet %" PRId64 " at (%" PRId64 ", %" PRId64 ") is out of bounds of a %" PRId64 " x %" PRId64 " matrix.\n",
+		    k, row_indices[k], column_indices[k], rows, columns);
+	    return NULL;
+	}
+
+    const index_t *major = (format == SPARSE_CSR) ? row_indices : column_indices;
+    const index_t *minor = (format == SPARSE_CSR) ? column_indices : row_indices;
+    index_t majors = (format == SPARSE_CSR) ? rows : columns;
+    index_t minors = (format == SPARSE_CSR) ? columns : rows;
+
+    FN(sparse_matrix) *S = FN(create_sparse_matrix)(rows, columns, nnz, format);
+    index_t *minor_pointers = calloc(minors + 1, sizeof(index_t));
+    index_t *order = malloc((nnz > 0 ? nnz : 1) * sizeof(index_t));
+
+    if (!S || !minor_pointers || !order) {
+        fprintf(stderr, "Error: Memory allocation failed in sparse_from_coo.\n");
+        FN(sparse_free)(S);
+        free(minor_pointers);
+        free(order);
+        return NULL;
+    }
+
+    // Counting sort of the triplets by minor index
+    for (index_t k = 0; k < nnz; k++)
+	minor_pointers[minor[k] + 1]++;
+    for (index_t m = 0; m < minors; m++)
+	minor_pointers[m + 1] += minor_pointers[m];
+    for (index_t k = 0; k < nnz; k++)
+	order[minor_pointers[minor[k]]++] = k;
+
+    free(minor_pointers);
+
+    // Stable counting sort by major index: each slice comes out sorted by minor index
+    index_t *pointers = S->pointers;
+
+    for (index_t k = 0; k < nnz; k++)
+	pointers[major[k] + 1]++;
+    for (index_t m = 0; m < majors; m++)
+	pointers[m + 1] += pointers[m];
+
+    // Next free position of each slice
+    index_t *next = malloc(majors * sizeof(index_t));
+
+    if (!next) {
+        fprintf(stderr, "Error: Memory allocation failed in sparse_from_coo.\n");
+        FN(sparse_free)(S);
+        free(order);
+        return NULL;
+    }
+
+    memcpy(next, pointers, majors * sizeof(index_t));
+
+    for (index_t o = 0; o < nnz; o++) {
+	index_t k = order[o];
+	index_t position = next[major[k]]++;
+	S->indices[position] = minor[k];
+	S->values[position] = values[k];
+    }
+
+    free(next);
+    free(order);
+
+    // Duplicates are now adjacent: sum them while compacting the slices
+    index_t count = 0;
+
+    for (index_t m = 0; m < majors; m++) {
+	index_t start = pointers[m], end = pointers[m + 1];
+	pointers[m] = count;
+	for (index_t p = start; p < end; p++) {
+	    if (count > pointers[m] && S->indices[count - 1] == S->indices[p]) {
+		S->values[count - 1] += S->values[p];
+	    } else {
+		S->indices[count] = S->indices[p];
+		S->values[count] = S->values[p];
+		count++;
+	    }
+	}
+    }
+
+    pointers[majors] = count;
+    S->nnz = count;
+
+    return S;
+
+}
+
+/**
+ * @brief Converts a dense row-major matrix to a compressed sparse matrix.
+ *
+ * Elements equal to zero are not stored.
+ *
+ * @param A Pointer to the dense matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive).
+ * @param format SPARSE_CSR or SPARSE_CSC.
+ *
+ * @return Pointer to the sparse matrix on success, or NULL on failure due to invalid
+ *         dimensions or format, null pointers or memory allocation errors.
+ */
+
+FN(sparse_matrix) *FN(sparse_from_dense)(REAL *A, index_t rows, index_t columns, int format) {
+
+    if (rows <= 0 || columns <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions provided. Both must be strictly positive. (rows=%" PRId64 ", columns=%" PRId64 ")\n",
+                rows, columns);
+        return NULL;
+    }
+
+    if (format != SPARSE_CSR && format != SPARSE_CSC) {
+        fprintf(stderr, "Error: Invalid format %d in sparse_from_dense. Expected SPARSE_CSR or SPARSE_CSC.\n", format);
+        return NULL;
+    }
+
+    if (!A) {
+        fprintf(stderr, "Error: Null pointer detected in sparse_from_dense.\n");
+        return NULL;
+    }
+
+    index_t nnz = 0;
+
+    for (size_t k = 0; k < (size_t) rows * columns; k++)
+	if (A[k] != 0.0) nnz++;
+
+    FN(sparse_matrix) *S = FN(create_sparse_matrix)(rows, columns, nnz, format);
+
+    if (!S) return NULL;
+
+    index_t majors = (format == SPARSE_CSR) ? rows : columns;
+    index_t minors = (format == SPARSE_CSR) ? columns : rows;
+    size_t major_stride = (format == SPARSE_CSR) ? (size_t) columns : 1;
+    size_t minor_stride = (format == SPARSE_CSR) ? 1 : (size_t) columns;
+    index_t count = 0;
+
+    for (index_t m = 0; m < majors; m++) {
+	S->pointers[m] = count;
+	for (index_t n = 0; n < minors; n++) {
+	    REAL value = A[m * major_stride + n * minor_stride];
+	    if (value != 0.0) {
+		S->indices[count] = n;
+		S->values[count] = value;
+		count++;
+	    }
+	}
+    }
+
+    S->pointers[majors] = count;
+
+    return S;
+
+}
+
+/**
+ * @brief Converts a compressed sparse matrix to a dense row-major matrix.
+ *
+ * @param S Pointer to the sparse matrix.
+ *
+ * @return Pointer to the dense matrix (size: rows x columns) on success,
+ *         or NULL on failure due to a null pointer or memory allocation errors.
+ */
+
+REAL *FN(sparse_to_dense)(const FN(sparse_matrix) *S) {
+
+    if (!S) {
+        fprintf(stderr, "Error: Null pointer detected in sparse_to_dense.\n");
+        return NULL;
+    }
+
+    REAL *A = calloc((size_t) S->rows * S->columns, sizeof(REAL));
+
+    if (!A) {
+        fprintf(stderr, "Error: Memory allocation failed for dense matrix of size %" PRId64 " x %" PRId64 ".\n",
+                S->rows, S->columns);
+        return NULL;
+    }
+
+    index_t majors = (S->format == SPARSE_CSR) ? S->rows : S->columns;
+
+    for (index_t m = 0; m < majors; m++)
+	for (index_t p = S->pointers[m]; p < S->pointers[m + 1]; p++) {
+	    size_t position = (S->format == SPARSE_CSR) ? (size_t) m * S->columns + S->indices[p]
+		: (size_t) S->indices[p] * S->columns + m;
+	    A[position] += S->values[p];
+	}
+
+    return A;
+
+}
+
+/**
+ * @brief Frees all memory associated with a compressed sparse matrix.
+ *
+ * @param S Pointer to the sparse matrix to free (may be NULL).
+ */
+
+void FN(sparse_free)(FN(sparse_matrix) *S) {
+
+    if (!S) return;
+
+    free(S->pointers);
+    free(S->indices);
+    free(S->values);
+    free(S);
+
+}
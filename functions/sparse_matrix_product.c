@@ -0,0 +1,398 @@
+#include "kernels.h"
+#include <omp.h>
+#include <string.h>
+
+/*
+ * Row i of C = P * Q is the sum of the rows k of Q weighted by P[i, k] (Gustavson's
+ * algorithm), gathered by each thread in its own accumulator:
+ * - a hash table sized after the row when at most a few thousand products make the
+ *   row, so that it stays in L1 however many columns Q has;
+ * - otherwise a dense array over the columns of Q, where marker[j] holds the last
+ *   row in which column j appeared so that it is never cleared.
+ * The product is computed in two phases:
+ * - the symbolic phase counts the nonzeros of each row of C, which gives the row
+ *   pointers and the exact size of C;
+ * - the numeric phase writes the columns and values of each row directly at their
+ *   final place, so the threads never synchronise while computing rows.
+ */
+
+/**
+ * @brief Rows of C handed out at a time to the threads.
+ *
+ * The cost of a row depends on the rows of Q it touches, so rows are shared dynamically.
+ */
+
+#define SPGEMM_CHUNK 256
+
+/**
+ * @brief Largest hash table of a row, in entries; longer rows use the dense accumulator.
+ */
+
+#define SPGEMM_HASH_MAX 4096
+
+/*
+ * Accumulators of one thread. The dense one is only allocated when a row needs it.
+ */
+
+typedef struct spgemm_accumulator {
+
+    index_t *keys;
+    REAL *values;
+
+    index_t *marker;
+    REAL *dense;
+
+} spgemm_accumulator;
+
+static int compare_indices(const void *a, const void *b) {
+
+    index_t x = *(const index_t *) a, y = *(const index_t *) b;
+
+    return (x > y) - (x < y);
+
+}
+
+/*
+ * Sorts the columns of a row of C: insertion sort for short rows, qsort otherwise.
+ */
+
+static void sort_indices(index_t *indices, index_t n) {
+
+    if (n > 64) {
+	qsort(indices, n, sizeof(index_t), compare_indices);
+	return;
+    }
+
+    for (index_t i = 1; i < n; i++) {
+	index_t value = indices[i], j = i;
+	while (j > 0 && indices[j - 1] > value) {
+	    indices[j] = indices[j - 1];
+	    j--;
+	}
+	indices[j] = value;
+    }
+
+}
+
+/*
+ * Hash table size for row i of C: a power of two at least twice the number of products,
+ * or 0 when the row goes to the dense accumulator.
+ */
+
+static index_t hash_size(const FN(sparse_matrix) *P, const FN(sparse_matrix) *Q, index_t i) {
+
+    index_t products = 0;
+
+    for (index_t p = P->pointers[i]; p < P->pointers[i + 1]; p++) {
+	index_t k = P->indices[p];
+	products += Q->pointers[k + 1] - Q->pointers[k];
+	if (2 * products > SPGEMM_HASH_MAX) return 0;
+    }
+
+    index_t size = 16;
+
+    while (size < 2 * products) size *= 2;
+
+    return size;
+
+}
+
+/*
+ * Slot of column j in a hash table of the given size (linear probing).
+ */
+
+static inline index_t hash_slot(const index_t *keys, index_t size, index_t j) {
+
+    index_t slot = (index_t) (((uint64_t) j * 0x9E3779B97F4A7C15ull) >> 40) & (size - 1);
+
+    while (keys[slot] != -1 && keys[slot] != j)
+	slot = (slot + 1) & (size - 1);
+
+    return slot;
+
+}
+
+/*
+ * Makes sure the dense accumulator of a thread exists. Returns -1 on allocation failure.
+ */
+
+static int dense_accumulator(spgemm_accumulator *accumulator, index_t columns) {
+
+    if (accumulator->marker) return 0;
+
+    accumulator->marker = malloc(columns * sizeof(index_t));
+    accumulator->dense = malloc(columns * sizeof(REAL));
+
+    if (!accumulator->marker || !accumulator->dense) return -1;
+
+    for (index_t j = 0; j < columns; j++)
+	accumulator->marker[j] = -1;
+
+    return 0;
+
+}
+
+/*
+ * Symbolic phase for row i: number of distinct columns. Returns -1 on allocation failure.
+ */
+
+static index_t count_row(const FN(sparse_matrix) *P, const FN(sparse_matrix) *Q, index_t i,
+			 spgemm_accumulator *accumulator) {
+
+    index_t size = hash_size(P, Q, i), count = 0;
+
+    if (size > 0) {
+	index_t *keys = accumulator->keys;
+
+	for (index_t s = 0; s < size; s++)
+	    keys[s] = -1;
+
+	for (index_t p = P->pointers[i]; p < P->pointers[i + 1]; p++) {
+	    index_t k = P->indices[p];
+	    for (index_t q = Q->pointers[k]; q < Q->pointers[k + 1]; q++) {
+		index_t slot = hash_slot(keys, size, Q->indices[q]);
+		if (keys[slot] == -1) {
+		    keys[slot] = Q->indices[q];
+		    count++;
+		}
+	    }
+	}
+
+	return count;
+    }
+
+    if (dense_accumulator(accumulator, Q->columns)) return -1;
+
+    index_t *marker = accumulator->marker;
+
+    for (index_t p = P->pointers[i]; p < P->pointers[i + 1]; p++) {
+	index_t k = P->indices[p];
+	for (index_t q = Q->pointers[k]; q < Q->pointers[k + 1]; q++) {
+	    index_t j = Q->indices[q];
+	    if (marker[j] != i) {
+		marker[j] = i;
+		count++;
+	    }
+	}
+    }
+
+    return count;
+
+}
+
+/*
+ * Numeric phase for row i: sorted columns and values written to indices and values.
+ * Returns -1 on allocation failure.
+ */
+
+static int compute_row(const FN(sparse_matrix) *P, const FN(sparse_matrix) *Q, index_t i,
+			spgemm_accumulator *accumulator, index_t *indices, REAL *values) {
+
+    index_t size = hash_size(P, Q, i), count = 0;
+
+    if (size > 0) {
+	index_t *keys = accumulator->keys;
+	REAL *sums = accumulator->values;
+
+	for (index_t s = 0; s < size; s++)
+	    keys[s] = -1;
+
+	for (index_t p = P->pointers[i]; p < P->pointers[i + 1]; p++) {
+	    index_t k = P->indices[p];
+	    REAL a = P->values[p];
+	    for (index_t q = Q->pointers[k]; q < Q->pointers[k + 1]; q++) {
+		index_t slot = hash_slot(keys, size, Q->indices[q]);
+		if (keys[slot] == -1) {
+		    keys[slot] = Q->indices[q];
+		    sums[slot] = a * Q->values[q];
+		    indices[count++] = Q->indices[q];
+		} else {
+		    sums[slot] += a * Q->values[q];
+		}
+	    }
+	}
+
+	sort_indices(indices, count);
+
+	for (index_t c = 0; c < count; c++)
+	    values[c] = sums[hash_slot(keys, size, indices[c])];
+
+	return 0;
+    }
+
+    if (dense_accumulator(accumulator, Q->columns)) return -1;
+
+    index_t *marker = accumulator->marker;
+    REAL *dense = accumulator->dense;
+
+    // Marks -i - 2 cannot collide with the row numbers left by the symbolic phase
+    for (index_t p = P->pointers[i]; p < P->pointers[i + 1]; p++) {
+	index_t k = P->indices[p];
+	for (index_t q = Q->pointers[k]; q < Q->pointers[k + 1]; q++) {
+	    index_t j = Q->indices[q];
+	    if (marker[j] != -i - 2) {
+		marker[j] = -i - 2;
+		dense[j] = 0.0;
+		indices[count++] = j;
+	    }
+	}
+    }
+
+    for (index_t p = P->pointers[i]; p < P->pointers[i + 1]; p++) {
+	index_t k = P->indices[p];
+	REAL a = P->values[p];
+	for (index_t q = Q->pointers[k]; q < Q->pointers[k + 1]; q++)
+	    dense[Q->indices[q]] += a * Q->values[q];
+    }
+
+    sort_indices(indices, count);
+
+    for (index_t c = 0; c < count; c++)
+	values[c] = dense[indices[c]];
+
+    return 0;
+
+}
+
+/*
+ * Two-phase product of two CSR matrices, on one thread or on the whole team.
+ */
+
+static FN(sparse_matrix) *sparse_product(const FN(sparse_matrix) *P, const FN(sparse_matrix) *Q, int parallel,
+					 const char *name) {
+
+    if (!P || !Q) {
+        fprintf(stderr, "Error: Null pointer detected in %s.\n", name);
+        return NULL;
+    }
+
+    if (P->format != SPARSE_CSR || Q->format != SPARSE_CSR) {
+        fprintf(stderr, "Error: Both matrices must be in SPARSE_CSR format in %s.\n", name);
+        return NULL;
+    }
+
+    if (P->columns != Q->rows) {
+        fprintf(stderr, "Error: Dimension mismatch. P columns (%" PRId64 ") must equal Q rows (%" PRId64 ").\n",
+                P->columns, Q->rows);
+        return NULL;
+    }
+
+    index_t rows = P->rows;
+    index_t *row_nnz = calloc(rows + 1, sizeof(index_t));
+
+    if (!row_nnz) {
+        fprintf(stderr, "Error: Memory allocation failed for row counts in %s.\n", name);
+        return NULL;
+    }
+
+    FN(sparse_matrix) *C = NULL;
+    int failed = 0;
+
+#pragma omp parallel if(parallel) shared(C, failed)
+    {
+	spgemm_accumulator accumulator = {malloc(SPGEMM_HASH_MAX * sizeof(index_t)),
+					  malloc(SPGEMM_HASH_MAX * sizeof(REAL)), NULL, NULL};
+
+	if (!accumulator.keys || !accumulator.values) {
+#pragma omp atomic write
+	    failed = 1;
+	}
+
+#pragma omp barrier
+
+	if (!failed) {
+
+	    // Symbolic phase: number of distinct columns of each row of C
+#pragma omp for schedule(dynamic, SPGEMM_CHUNK)
+	    for (index_t i = 0; i < rows; i++) {
+		index_t count = count_row(P, Q, i, &accumulator);
+		if (count < 0) {
+#pragma omp atomic write
+		    failed = 1;
+		    count = 0;
+		}
+		row_nnz[i + 1] = count;
+	    }
+
+#pragma omp single
+	    if (!failed) {
+		for (index_t i = 0; i < rows; i++)
+		    row_nnz[i + 1] += row_nnz[i];
+
+		C = FN(create_sparse_matrix)(rows, Q->columns, row_nnz[rows], SPARSE_CSR);
+
+		if (C)
+		    memcpy(C->pointers, row_nnz, (rows + 1) * sizeof(index_t));
+		else
+		    failed = 1;
+	    }
+
+	    // Numeric phase: columns and values of each row, at their final place
+	    if (!failed) {
+#pragma omp for schedule(dynamic, SPGEMM_CHUNK)
+		for (index_t i = 0; i < rows; i++)
+		    if (compute_row(P, Q, i, &accumulator, C->indices + C->pointers[i], C->values + C->pointers[i])) {
+#pragma omp atomic write
+			failed = 1;
+		    }
+	    }
+	}
+
+	free(accumulator.keys);
+	free(accumulator.values);
+	free(accumulator.marker);
+	free(accumulator.dense);
+    }
+
+    free(row_nnz);
+
+    if (failed) {
+        fprintf(stderr, "Error: Memory allocation failed in %s.\n", name);
+        FN(sparse_free)(C);
+        return NULL;
+    }
+
+    return C;
+
+}
+
+/**
+ * @brief Computes the product of two sparse matrices P and Q sequentially.
+ *
+ * This function calculates the sparse matrix C = P * Q without forming any dense
+ * matrix: the time and memory are proportional to the number of multiplications
+ * P[i, k] * Q[k, j] and to the nonzeros of C, plus a dense accumulator over the
+ * columns of Q. The columns of each row of C are sorted; products that cancel
+ * exactly are kept as stored zeros.
+ *
+ * @param P Pointer to the first sparse matrix, in SPARSE_CSR format.
+ * @param Q Pointer to the second sparse matrix, in SPARSE_CSR format (rows must equal the columns of P).
+ *
+ * @return Pointer to the resulting sparse matrix in SPARSE_CSR format (size: P rows x Q columns) on success,
+ *         or NULL on failure due to invalid dimensions or formats, null pointers, or memory allocation errors.
+ */
+
+FN(sparse_matrix) *FN(sequential_sparse_matrix_product)(const FN(sparse_matrix) *P, const FN(sparse_matrix) *Q) {
+
+    return sparse_product(P, Q, 0, "sequential_sparse_matrix_product");
+
+}
+
+/**
+ * @brief Computes the product of two sparse matrices P and Q in parallel using OpenMP.
+ *
+ * Same as sequential_sparse_matrix_product, with the rows of C shared dynamically
+ * between the threads. Each thread has its own dense accumulator over the columns of Q.
+ *
+ * @param P Pointer to the first sparse matrix, in SPARSE_CSR format.
+ * @param Q Pointer to the second sparse matrix, in SPARSE_CSR format (rows must equal the columns of P).
+ *
+ * @return Pointer to the resulting sparse matrix in SPARSE_CSR format (size: P rows x Q columns) on success,
+ *         or NULL on failure due to invalid dimensions or formats, null pointers, or memory allocation errors.
+ */
+
+FN(sparse_matrix) *FN(parallel_sparse_matrix_product)(const FN(sparse_matrix) *P, const FN(sparse_matrix) *Q) {
+
+    return sparse_product(P, Q, 1, "parallel_sparse_matrix_product");
+
+}
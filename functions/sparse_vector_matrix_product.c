@@ -0,0 +1,274 @@
+#include "kernels.h"
+#include <omp.h>
+
+/*
+ * Row i of a CSR matrix times X. The column indices gather X, so the loop is only
+ * bound by the bandwidth at which the values and indices are streamed.
+ */
+
+static inline REAL sparse_row_product(const FN(sparse_matrix) *A, index_t i, const REAL *X) {
+
+    REAL sum = 0.0;
+
+#pragma omp simd reduction(+:sum)
+    for (index_t p = A->pointers[i]; p < A->pointers[i + 1]; p++)
+	sum += A->values[p] * X[A->indices[p]];
+
+    return sum;
+
+}
+
+/*
+ * Y += A_{:, first..last-1} * X_{first..last-1} for a CSC matrix: columns are scattered into Y.
+ */
+
+static void sparse_scatter_columns(const FN(sparse_matrix) *A, index_t first, index_t last, const REAL *X, REAL *Y) {
+
+    for (index_t j = first; j < last; j++) {
+	REAL x = X[j];
+	for (index_t p = A->pointers[j]; p < A->pointers[j + 1]; p++)
+	    Y[A->indices[p]] += A->values[p] * x;
+    }
+
+}
+
+/*
+ * First slice m in [0, slices] whose nonzeros start at or after target: splitting the
+ * slices at these points gives every thread about the same number of nonzeros,
+ * whatever the distribution of the nonzeros between rows or columns.
+ */
+
+static index_t nnz_partition_point(const index_t *pointers, index_t slices, index_t target) {
+
+    index_t low = 0, high = slices;
+
+    while (low < high) {
+	index_t middle = low + (high - low) / 2;
+	if (pointers[middle] < target)
+	    low = middle + 1;
+	else
+	    high = middle;
+    }
+
+    return low;
+
+}
+
+/*
+ * Checks shared by the sparse matrix-vector products. Returns 0 when the arguments are valid.
+ */
+
+static int check_sparse_vector_matrix_product(const FN(sparse_matrix) *A, REAL *X, index_t dimension, REAL *Y,
+					      int check_output, const char *name) {
+
+    if (!A || !X || (check_output && !Y)) {
+        fprintf(stderr, "Error: Null pointer detected in %s.\n", name);
+        return -1;
+    }
+
+    if (dimension <= 0 || A->columns != dimension) {
+        fprintf(stderr, "Error: Dimension mismatch. Matrix columns (%" PRId64 ") must equal vector size (%" PRId64 ").\n",
+                A->columns, dimension);
+        return -1;
+    }
+
+    if (check_output && (ranges_overlap(Y, A->rows, A->values, A->nnz) || ranges_overlap(Y, A->rows, X, dimension))) {
+        fprintf(stderr, "Error: Output vector overlaps an input in %s.\n", name);
+        return -1;
+    }
+
+    return 0;
+
+}
+
+/**
+ * @brief Computes the product of a sparse matrix A and a vector X sequentially.
+ *
+ * This function calculates the vector result = A * X, where A is stored in CSR or
+ * CSC format. Only the nonzeros of A are read.
+ *
+ * @param A Pointer to the sparse matrix (size: rows x columns).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal the columns of A).
+ *
+ * @return Pointer to the resulting vector (size: rows of A) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(sequential_sparse_vector_matrix_product)(const FN(sparse_matrix) *A, REAL *X, index_t dimension) {
+
+    if (check_sparse_vector_matrix_product(A, X, dimension, NULL, 0, "sequential_sparse_vector_matrix_product"))
+	return NULL;
+
+    REAL *vector = malloc(A->rows * sizeof(REAL));
+
+    if (!vector) {
+        fprintf(stderr, "Error: Memory allocation failed for result vector of size %" PRId64 ".\n", A->rows);
+        return NULL;
+    }
+
+    FN(sequential_sparse_vector_matrix_product_into)(A, X, dimension, vector);
+
+    return vector;
+
+}
+
+/**
+ * @brief Computes the product of a sparse matrix A and a vector X sequentially into a caller-provided vector.
+ *
+ * Same as sequential_sparse_vector_matrix_product, without allocating the result. Y must not overlap A or X.
+ *
+ * @param A Pointer to the sparse matrix (size: rows x columns).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal the columns of A).
+ * @param Y Pointer to the output vector (size: rows of A).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers or aliased output.
+ */
+
+int FN(sequential_sparse_vector_matrix_product_into)(const FN(sparse_matrix) *A, REAL *X, index_t dimension, REAL *Y) {
+
+    if (check_sparse_vector_matrix_product(A, X, dimension, Y, 1, "sequential_sparse_vector_matrix_product_into"))
+	return -1;
+
+    if (A->format == SPARSE_CSR) {
+	for (index_t i = 0; i < A->rows; i++)
+	    Y[i] = sparse_row_product(A, i, X);
+    } else {
+	for (index_t i = 0; i < A->rows; i++)
+	    Y[i] = 0.0;
+	sparse_scatter_columns(A, 0, A->columns, X, Y);
+    }
+
+    return 0;
+
+}
+
+/**
+ * @brief Computes the product of a sparse matrix A and a vector X in parallel using OpenMP.
+ *
+ * This function calculates the vector result = A * X, where A is stored in CSR or
+ * CSC format. The rows (CSR) or columns (CSC) are split between the threads so that
+ * each thread gets about the same number of nonzeros, which keeps the threads busy
+ * when a few rows hold most of the nonzeros. In CSC format each thread scatters its
+ * columns into its own partial vector, and the partial vectors are summed at the end.
+ *
+ * @param A Pointer to the sparse matrix (size: rows x columns).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal the columns of A).
+ *
+ * @return Pointer to the resulting vector (size: rows of A) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(parallel_sparse_vector_matrix_product)(const FN(sparse_matrix) *A, REAL *X, index_t dimension) {
+
+    if (check_sparse_vector_matrix_product(A, X, dimension, NULL, 0, "parallel_sparse_vector_matrix_product"))
+	return NULL;
+
+    REAL *vector = malloc(A->rows * sizeof(REAL));
+
+    if (!vector) {
+        fprintf(stderr, "Error: Memory allocation failed for result vector of size %" PRId64 ".\n", A->rows);
+        return NULL;
+    }
+
+    if (FN(parallel_sparse_vector_matrix_product_into)(A, X, dimension, vector) != 0) {
+	free(vector);
+	return NULL;
+    }
+
+    return vector;
+
+}
+
+/**
+ * @brief Computes the product of a sparse matrix A and a vector X in parallel using OpenMP into a caller-provided vector.
+ *
+ * Same as parallel_sparse_vector_matrix_product, without allocating the result. Y must not overlap A or X.
+ *
+ * @param A Pointer to the sparse matrix (size: rows x columns).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal the columns of A).
+ * @param Y Pointer to the output vector (size: rows of A).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers, aliased output,
+ *         or memory allocation errors.
+ */
+
+int FN(parallel_sparse_vector_matrix_product_into)(const FN(sparse_matrix) *A, REAL *X, index_t dimension, REAL *Y) {
+
+    if (check_sparse_vector_matrix_product(A, X, dimension, Y, 1, "parallel_sparse_vector_matrix_product_into"))
+	return -1;
+
+    if (A->format == SPARSE_CSR) {
+
+#pragma omp parallel
+	{
+	    index_t team = omp_get_num_threads(), thread = omp_get_thread_num();
+	    index_t first = nnz_partition_point(A->pointers, A->rows, thread * A->nnz / team);
+	    index_t last = (thread == team - 1) ? A->rows
+		: nnz_partition_point(A->pointers, A->rows, (thread + 1) * A->nnz / team);
+
+	    for (index_t i = first; i < last; i++)
+		Y[i] = sparse_row_product(A, i, X);
+	}
+
+	return 0;
+
+    }
+
+    int threads = omp_get_max_threads(), failed = 0;
+    REAL **partials = calloc(threads, sizeof(REAL *));
+
+    if (!partials) {
+        fprintf(stderr, "Error: Memory allocation failed for partial vectors in parallel_sparse_vector_matrix_product_into.\n");
+        return -1;
+    }
+
+#pragma omp parallel shared(failed)
+    {
+	int thread = omp_get_thread_num(), team = omp_get_num_threads();
+
+	// The first thread scatters directly into Y, the others into their own partial vector
+	partials[thread] = thread == 0 ? Y : aligned_buffer(sizeof(REAL) * A->rows);
+
+	if (!partials[thread]) {
+#pragma omp atomic write
+	    failed = 1;
+	}
+
+#pragma omp barrier
+
+	if (!failed) {
+	    index_t first = nnz_partition_point(A->pointers, A->columns, (index_t) thread * A->nnz / team);
+	    index_t last = (thread == team - 1) ? A->columns
+		: nnz_partition_point(A->pointers, A->columns, (index_t) (thread + 1) * A->nnz / team);
+
+	    for (index_t i = 0; i < A->rows; i++)
+		partials[thread][i] = 0.0;
+
+	    sparse_scatter_columns(A, first, last, X, partials[thread]);
+
+#pragma omp barrier
+
+	    // Reduction of the partial vectors, split by rows
+#pragma omp for schedule(static)
+	    for (index_t i = 0; i < A->rows; i++)
+		for (int t = 1; t < team; t++)
+		    Y[i] += partials[t][i];
+	}
+    }
+
+    for (int t = 1; t < threads; t++)
+	free(partials[t]);
+    free(partials);
+
+    if (failed) {
+        fprintf(stderr, "Error: Memory allocation failed for partial vectors in parallel_sparse_vector_matrix_product_into.\n");
+        return -1;
+    }
+
+    return 0;
+
+}
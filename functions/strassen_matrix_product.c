@@ -0,0 +1,268 @@
+#include "kernels.h"
+
+/**
+ * @brief Recursion depth under which the seven subproducts are spawned as OpenMP tasks.
+ *
+ * Three levels give up to 343 tasks, enough to feed a many-core node; deeper
+ * levels run inside their task.
+ */
+
+#define STRASSEN_TASK_DEPTH 3
+
+/**
+ * @brief Computes C = A + sign * B on m x n blocks addressed through leading dimensions.
+ */
+
+static void add_blocks(index_t m, index_t n, const REAL *A, index_t lda, const REAL *B, index_t ldb,
+		       REAL sign, REAL *C, index_t ldc) {
+
+    for (index_t i = 0; i < m; i++) {
+	const REAL *a = A + (size_t) i * lda;
+	const REAL *b = B + (size_t) i * ldb;
+	REAL *c = C + (size_t) i * ldc;
+	for (index_t j = 0; j < n; j++)
+	    c[j] = a[j] + sign * b[j];
+    }
+
+}
+
+/**
+ * @brief Computes C = A * B with the Strassen-Winograd recursion, peeling odd dimensions.
+ *
+ * The even part of every dimension is split in halves; the last row of A, the last
+ * column of B or the last column of A / row of B are handled afterwards by thin
+ * products of the blocked engine (dynamic peeling).
+ *
+ * @return 0 on success, or -1 on failure due to memory allocation errors.
+ */
+
+static int strassen_recursive(index_t m, index_t k, index_t n, const REAL *A, index_t lda, const REAL *B, index_t ldb,
+			      REAL *C, index_t ldc, index_t cutoff, int depth) {
+
+    if (m <= cutoff || k <= cutoff || n <= cutoff)
+	return FN(blocked_matrix_product)(m, n, k, 1.0, A, lda, B, ldb, 0.0, C, ldc);
+
+    index_t hm = m / 2, hk = k / 2, hn = n / 2;
+
+    const REAL *A11 = A, *A12 = A + hk;
+    const REAL *A21 = A + (size_t) hm * lda, *A22 = A21 + hk;
+    const REAL *B11 = B, *B12 = B + hn;
+    const REAL *B21 = B + (size_t) hk * ldb, *B22 = B21 + hn;
+    REAL *C11 = C, *C12 = C + hn;
+    REAL *C21 = C + (size_t) hm * ldc, *C22 = C21 + hn;
+
+    size_t size_S = (size_t) hm * hk, size_T = (size_t) hk * hn, size_M = (size_t) hm * hn;
+
+    REAL *workspace = malloc(sizeof(REAL) * (4 * size_S + 4 * size_T + 3 * size_M));
+
+    if (!workspace) {
+	fprintf(stderr, "Error: Memory allocation failed for workspace in strassen_matrix_product.\n");
+	return -1;
+    }
+
+    REAL *S1 = workspace, *S2 = S1 + size_S, *S3 = S2 + size_S, *S4 = S3 + size_S;
+    REAL *T1 = S4 + size_S, *T2 = T1 + size_T, *T3 = T2 + size_T, *T4 = T3 + size_T;
+    REAL *M2 = T4 + size_T, *M6 = M2 + size_M, *M7 = M6 + size_M;
+
+    add_blocks(hm, hk, A21, lda, A22, lda, 1.0, S1, hk);
+    add_blocks(hm, hk, S1, hk, A11, lda, -1.0, S2, hk);
+    add_blocks(hm, hk, A11, lda, A21, lda, -1.0, S3, hk);
+    add_blocks(hm, hk, A12, lda, S2, hk, -1.0, S4, hk);
+
+    add_blocks(hk, hn, B12, ldb, B11, ldb, -1.0, T1, hn);
+    add_blocks(hk, hn, B22, ldb, T1, hn, -1.0, T2, hn);
+    add_blocks(hk, hn, B22, ldb, B12, ldb, -1.0, T3, hn);
+    add_blocks(hk, hn, T2, hn, B21, ldb, -1.0, T4, hn);
+
+    // M1, M3, M4 and M5 are written straight into the quadrants of C that need them last
+    int status[7];
+    int spawn = depth < STRASSEN_TASK_DEPTH;
+
+#pragma omp task shared(status) if(spawn)
+    status[0] = strassen_recursive(hm, hk, hn, A11, lda, B11, ldb, C11, ldc, cutoff, depth + 1);
+#pragma omp task shared(status) if(spawn)
+    status[1] = strassen_recursive(hm, hk, hn, A12, lda, B21, ldb, M2, hn, cutoff, depth + 1);
+#pragma omp task shared(status) if(spawn)
+    status[2] = strassen_recursive(hm, hk, hn, S4, hk, B22, ldb, C12, ldc, cutoff, depth + 1);
+#pragma omp task shared(status) if(spawn)
+    status[3] = strassen_recursive(hm, hk, hn, A22, lda, T4, hn, C21, ldc, cutoff, depth + 1);
+#pragma omp task shared(status) if(spawn)
+    status[4] = strassen_recursive(hm, hk, hn, S1, hk, T1, hn, C22, ldc, cutoff, depth + 1);
+#pragma omp task shared(status) if(spawn)
+    status[5] = strassen_recursive(hm, hk, hn, S2, hk, T2, hn, M6, hn, cutoff, depth + 1);
+#pragma omp task shared(status) if(spawn)
+    status[6] = strassen_recursive(hm, hk, hn, S3, hk, T3, hn, M7, hn, cutoff, depth + 1);
+#pragma omp taskwait
+
+    for (index_t i = 0; i < 7; i++) {
+	if (status[i]) {
+	    free(workspace);
+	    return -1;
+	}
+    }
+
+    // U2 = M1 + M6, C11 = M1 + M2, U3 = U2 + M7, U4 = U2 + M5
+    add_blocks(hm, hn, C11, ldc, M6, hn, 1.0, M6, hn);
+    add_blocks(hm, hn, C11, ldc, M2, hn, 1.0, C11, ldc);
+    add_blocks(hm, hn, M6, hn, M7, hn, 1.0, M7, hn);
+    add_blocks(hm, hn, M6, hn, C22, ldc, 1.0, M6, hn);
+
+    // C12 = U4 + M3, C21 = U3 - M4, C22 = U3 + M5
+    add_blocks(hm, hn, M6, hn, C12, ldc, 1.0, C12, ldc);
+    add_blocks(hm, hn, M7, hn, C21, ldc, -1.0, C21, ldc);
+    add_blocks(hm, hn, M7, hn, C22, ldc, 1.0, C22, ldc);
+
+    free(workspace);
+
+    index_t m2 = 2 * hm, k2 = 2 * hk, n2 = 2 * hn;
+
+    // Odd inner dimension: rank-1 update with the last column of A and the last row of B
+    if (k2 < k && FN(blocked_matrix_product)(m2, n2, 1, 1.0, A + k2, lda, B + (size_t) k2 * ldb, ldb, 1.0, C, ldc))
+	return -1;
+
+    // Odd number of columns: last column of C
+    if (n2 < n && FN(blocked_matrix_product)(m, 1, k, 1.0, A, lda, B + n2, ldb, 0.0, C + n2, ldc))
+	return -1;
+
+    // Odd number of rows: last row of C (its last element is already computed)
+    if (m2 < m && FN(blocked_matrix_product)(1, n2, k, 1.0, A + (size_t) m2 * lda, lda, B, ldb, 0.0, C + (size_t) m2 * ldc, ldc))
+	return -1;
+
+    return 0;
+
+}
+
+/**
+ * @brief Computes the product of two matrices P and Q with the Strassen-Winograd algorithm.
+ *
+ * This function calculates the matrix product C = P * Q with the Winograd variant of
+ * Strassen's algorithm (7 recursive products and 15 additions per level). The seven
+ * subproducts of the first levels run as OpenMP tasks. Below the cutoff the blocked
+ * GEMM engine takes over. Odd and non-power-of-two dimensions are handled by peeling
+ * the last row or column at each level instead of padding.
+ *
+ * The error is bounded normwise rather than componentwise: for n x n matrices and a
+ * cutoff n0, the computed product satisfies (Higham, Accuracy and Stability of
+ * Numerical Algorithms, §23.2.2)
+ *   max|C - Ĉ| <= [ (n / n0)^log2(18) (n0² + 6 n0) - 6 n ] u max|P| max|Q| + O(u²),
+ * where u is the unit roundoff, i.e. about (n / n0)^4.17 n0² u instead of n u for the
+ * conventional product. Small elements of C may therefore lose relative accuracy;
+ * a larger cutoff tightens the bound.
+ *
+ * @param P Pointer to the first input matrix (size: P_rows x P_columns).
+ * @param P_rows Number of rows in matrix P (must be positive).
+ * @param P_columns Number of columns in matrix P (must equal Q_rows).
+ * @param Q Pointer to the second input matrix (size: Q_rows x Q_columns).
+ * @param Q_rows Number of rows in matrix Q (must equal P_columns).
+ * @param Q_columns Number of columns in matrix Q (must be positive).
+ * @param cutoff Dimension under which the recursion stops and the blocked engine is used
+ *        (0 selects STRASSEN_DEFAULT_CUTOFF, otherwise must be at least 2).
+ *
+ * @return Pointer to the resulting matrix (size: P_rows x Q_columns) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(strassen_matrix_product)(REAL *P, index_t P_rows, index_t P_columns, REAL *Q, index_t Q_rows, index_t Q_columns, index_t cutoff) {
+
+    if (P_rows <= 0 || P_columns <= 0 || Q_rows <= 0 || Q_columns <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions for Strassen matrix product (P_rows=%" PRId64 ", P_columns=%" PRId64 ", Q_rows=%" PRId64 ", Q_columns=%" PRId64 "). All dimensions must be strictly positive.\n",
+                P_rows, P_columns, Q_rows, Q_columns);
+        return NULL;
+    }
+
+    if (P_columns != Q_rows) {
+        fprintf(stderr, "Error: Dimension mismatch. Columns of first matrix (%" PRId64 ") must equal rows of second matrix (%" PRId64 ").\n",
+                P_columns, Q_rows);
+        return NULL;
+    }
+
+    if (cutoff == 0) cutoff = STRASSEN_DEFAULT_CUTOFF;
+
+    if (cutoff < 2) {
+        fprintf(stderr, "Error: Invalid cutoff (%" PRId64 ") for Strassen matrix product. Must be at least 2.\n", cutoff);
+        return NULL;
+    }
+
+    if (!P || !Q) {
+        fprintf(stderr, "Error: Null pointer detected for input matrices in strassen_matrix_product.\n");
+        return NULL;
+    }
+
+    REAL *matrix = malloc(sizeof(REAL) * (P_rows * Q_columns));
+
+    if (!matrix) {
+        fprintf(stderr, "Error: Memory allocation failed for result matrix in strassen_matrix_product.\n");
+        return NULL;
+    }
+
+    if (FN(strassen_matrix_product_into)(P, P_rows, P_columns, Q, Q_rows, Q_columns, cutoff, matrix)) {
+        fprintf(stderr, "Error: Strassen recursion failed in strassen_matrix_product.\n");
+        free(matrix);
+        return NULL;
+    }
+
+    return matrix;
+
+}
+
+/**
+ * @brief Computes the product of two matrices P and Q with Strassen-Winograd into a caller-provided matrix.
+ *
+ * Same as strassen_matrix_product, without allocating the result (the recursion
+ * still allocates its temporaries). C must not overlap P or Q.
+ *
+ * @param P Pointer to the first input matrix (size: P_rows x P_columns).
+ * @param P_rows Number of rows in matrix P (must be positive).
+ * @param P_columns Number of columns in matrix P (must equal Q_rows).
+ * @param Q Pointer to the second input matrix (size: Q_rows x Q_columns).
+ * @param Q_rows Number of rows in matrix Q (must equal P_columns).
+ * @param Q_columns Number of columns in matrix Q (must be positive).
+ * @param cutoff Dimension under which the recursion stops and the blocked engine is used
+ *        (0 selects STRASSEN_DEFAULT_CUTOFF, otherwise must be at least 2).
+ * @param C Pointer to the output matrix (size: P_rows x Q_columns).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         aliased output, or memory allocation errors.
+ */
+
+int FN(strassen_matrix_product_into)(REAL *P, index_t P_rows, index_t P_columns, REAL *Q, index_t Q_rows, index_t Q_columns, index_t cutoff, REAL *C) {
+
+    if (P_rows <= 0 || P_columns <= 0 || Q_rows <= 0 || Q_columns <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions for Strassen matrix product (P_rows=%" PRId64 ", P_columns=%" PRId64 ", Q_rows=%" PRId64 ", Q_columns=%" PRId64 "). All dimensions must be strictly positive.\n",
+                P_rows, P_columns, Q_rows, Q_columns);
+        return -1;
+    }
+
+    if (P_columns != Q_rows) {
+        fprintf(stderr, "Error: Dimension mismatch. Columns of first matrix (%" PRId64 ") must equal rows of second matrix (%" PRId64 ").\n",
+                P_columns, Q_rows);
+        return -1;
+    }
+
+    if (cutoff == 0) cutoff = STRASSEN_DEFAULT_CUTOFF;
+
+    if (cutoff < 2) {
+        fprintf(stderr, "Error: Invalid cutoff (%" PRId64 ") for Strassen matrix product. Must be at least 2.\n", cutoff);
+        return -1;
+    }
+
+    if (!P || !Q || !C) {
+        fprintf(stderr, "Error: Null pointer detected in strassen_matrix_product_into.\n");
+        return -1;
+    }
+
+    if (ranges_overlap(C, (size_t) P_rows * Q_columns, P, (size_t) P_rows * P_columns) || ranges_overlap(C, (size_t) P_rows * Q_columns, Q, (size_t) Q_rows * Q_columns)) {
+        fprintf(stderr, "Error: Output matrix overlaps an input matrix in strassen_matrix_product_into.\n");
+        return -1;
+    }
+
+    int failed = 0;
+
+#pragma omp parallel
+#pragma omp single
+    failed = strassen_recursive(P_rows, P_columns, Q_columns, P, P_columns, Q, Q_columns,
+				C, Q_columns, cutoff, 0);
+
+    return failed ? -1 : 0;
+
+}
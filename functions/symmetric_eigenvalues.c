@@ -0,0 +1,803 @@
+#include "kernels.h"
+#include <omp.h>
+#include <string.h>
+
+/**
+ * @brief Columns reduced together by the tridiagonalization (width of a panel).
+ */
+
+#define TRIDIAGONAL_BLOCK 32
+
+/**
+ * @brief Columns of the trailing lower triangle per tile of the update that ends a panel.
+ */
+
+#define TRIDIAGONAL_TILE_COLUMNS 128
+
+/**
+ * @brief Size under which a tridiagonal eigenproblem is solved by implicit QL rather than split.
+ */
+
+#define DIVIDE_AND_CONQUER_BASE 32
+
+/**
+ * @brief Rows of the eigenvector product per task when two halves are merged.
+ */
+
+#define MERGE_TILE_ROWS 128
+
+/**
+ * @brief Maximum number of QL steps spent on one eigenvalue, and of iterations on one secular root.
+ */
+
+#define QL_ITERATIONS 60
+#define SECULAR_ITERATIONS 100
+
+/*
+ * Symmetric eigenproblem A = Z diag(lambda) Z^T in three steps:
+ *
+ * - A is reduced to a symmetric tridiagonal T = Q^T A Q by Householder reflectors,
+ *   reading and updating the lower triangle only;
+ * - the eigenvalues of T come from implicit QL in O(n^2), or, when the eigenvectors
+ *   are wanted, from Cuppen's divide and conquer: T is split into two halves plus a
+ *   rank-one correction, the halves are solved (as independent OpenMP tasks) and
+ *   merged by the roots of a secular equation, with the eigenvectors of Gu and
+ *   Eisenstat so that they stay orthogonal; the product by the eigenvectors of the
+ *   halves, the O(n^3) part, runs on the GEMM engine;
+ * - the eigenvectors of T are multiplied by Q with the block reflectors of the QR.
+ */
+
+/*
+ * Blocked Householder tridiagonalization of the symmetric matrix A (n x n, lower triangle), in place:
+ * T = Q^T A Q with Q = H_0 ... H_{n-3} and H_j = I - tau[j] v_j v_j^T acting on rows and columns
+ * j + 1 .. n - 1. On return d and e hold the diagonal and the subdiagonal of T and v_j is stored
+ * below the subdiagonal of column j, v_j[j + 1] = 1 being implied.
+ * For a panel of nb columns starting at column p, V and W (rows p + 1 .. n - 1) hold the
+ * reduction so far as A - V W^T - W V^T: a column is brought up to date from them and reduced,
+ * and w = tau (A - V W^T - W V^T) v - (tau / 2) (w^T v) v. The product A v, the only pass over the
+ * trailing matrix per column, reads each value of the lower triangle once and uses it twice; its
+ * rows are shared by the threads, each one accumulating its own copy of A v. The lower triangle
+ * right of the panel is then updated by tiles of GEMMs. Returns -1 on memory allocation errors.
+ */
+
+static int tridiagonal_reduction(index_t n, REAL *A, REAL *d, REAL *e, REAL *tau, int parallel) {
+
+    if (n < 3) {
+	d[0] = A[0];
+	if (n == 2) {
+	    e[0] = A[2];
+	    d[1] = A[3];
+	}
+	return 0;
+    }
+
+    const simd_kernels *kernels = FN(active_kernels);
+    int threads = parallel ? omp_get_max_threads() : 1;
+    index_t block = n - 2 < TRIDIAGONAL_BLOCK ? n - 2 : TRIDIAGONAL_BLOCK;
+
+    REAL *V = malloc(((size_t) 2 * n * block + n + 2 * block) * sizeof(REAL));
+    REAL *Y = calloc((size_t) threads * n, sizeof(REAL));
+    REAL **P_packed = calloc(threads, sizeof(REAL *)), **Q_packed = calloc(threads, sizeof(REAL *));
+
+    int failed = !V || !Y || !P_packed || !Q_packed;
+
+    for (int t = 0; t < threads && !failed; t++) {
+	P_packed[t] = aligned_buffer(sizeof(REAL) * GEMM_P_BUFFER_SIZE(n, block));
+	Q_packed[t] = aligned_buffer(sizeof(REAL) * GEMM_Q_BUFFER_SIZE(TRIDIAGONAL_TILE_COLUMNS, block));
+	failed = !P_packed[t] || !Q_packed[t];
+    }
+
+    if (!failed) {
+
+	REAL *W = V + (size_t) n * block, *v = W + (size_t) n * block, *u = v + n, *x = u + block;
+
+#pragma omp parallel num_threads(threads)
+	for (index_t p = 0; p + 2 < n; p += block) {
+
+	    index_t nb = n - 2 - p < block ? n - 2 - p : block;
+
+	    for (index_t i = 0; i < nb; i++) {
+
+		index_t j = p + i, length = n - j - 1;
+
+#pragma omp single
+		{
+		    // Column j brought up to date: A[j:, j] -= V W[j, :]^T + W V[j, :]^T
+		    if (i > 0)
+			for (index_t r = j; r < n; r++) {
+			    const REAL *V_r = V + (r - p - 1) * nb, *W_r = W + (r - p - 1) * nb;
+			    A[r * n + j] -= kernels->dot(V_r, W + (j - p - 1) * nb, i) + kernels->dot(W_r, V + (j - p - 1) * nb, i);
+			}
+
+		    REAL alpha = A[(j + 1) * n + j], norm = 0.0;
+
+		    for (index_t r = j + 2; r < n; r++)
+			norm += A[r * n + j] * A[r * n + j];
+
+		    d[j] = A[j * n + j];
+		    v[0] = 1.0;
+		    tau[j] = 0.0;
+		    e[j] = alpha;
+
+		    if (norm != 0.0) {
+			REAL beta = -copysign(sqrt(alpha * alpha + norm), alpha);
+			REAL scale = 1.0 / (alpha - beta);
+			tau[j] = (beta - alpha) / beta;
+			e[j] = beta;
+			for (index_t r = j + 2; r < n; r++)
+			    v[r - j - 1] = A[r * n + j] *= scale;
+		    } else {
+			for (index_t r = 1; r < length; r++)
+			    v[r] = 0.0;
+		    }
+
+		    for (index_t r = p + 1; r < n; r++)
+			V[(r - p - 1) * nb + i] = r > j ? v[r - j - 1] : 0.0;
+		}
+
+		// Y_t = A[j + 1:, j + 1:] v over the rows of the thread
+		int t = omp_get_thread_num();
+		REAL *Y_t = Y + (size_t) t * n + j + 1;
+
+		memset(Y_t, 0, length * sizeof(REAL));
+
+#pragma omp for schedule(static, 16)
+		for (index_t r = 0; r < length; r++) {
+		    const REAL *row = A + (j + 1 + r) * n + j + 1;
+		    Y_t[r] += kernels->dot(row, v, r) + row[r] * v[r];
+		    kernels->axpy(v[r], row, Y_t, r);
+		}
+
+#pragma omp single
+		{
+		    REAL *y = Y + j + 1;
+
+		    for (int s = 1; s < threads; s++)
+			kernels->axpy(1.0, Y + (size_t) s * n + j + 1, y, length);
+
+		    // u = W^T v and x = V^T v over the previous columns, y -= V u + W x
+		    memset(u, 0, 2 * block * sizeof(REAL));
+
+		    for (index_t r = j + 1; r < n && i > 0; r++) {
+			kernels->axpy(v[r - j - 1], W + (r - p - 1) * nb, u, i);
+			kernels->axpy(v[r - j - 1], V + (r - p - 1) * nb, x, i);
+		    }
+
+		    REAL product = 0.0;
+
+		    for (index_t r = 0; r < length; r++) {
+			const REAL *V_r = V + (j + r - p) * nb, *W_r = W + (j + r - p) * nb;
+			y[r] = tau[j] * (y[r] - kernels->dot(V_r, u, i) - kernels->dot(W_r, x, i));
+			product += y[r] * v[r];
+		    }
+
+		    kernels->axpy(-0.5 * tau[j] * product, v, y, length);
+
+		    for (index_t r = p + 1; r < n; r++)
+			W[(r - p - 1) * nb + i] = r > j ? y[r - j - 1] : 0.0;
+		}
+
+	    }
+
+	    // A[first:, first:] -= V W^T + W V^T, lower triangle, by tiles of columns
+	    index_t first = p + nb;
+
+#pragma omp for schedule(dynamic)
+	    for (index_t c = first; c < n; c += TRIDIAGONAL_TILE_COLUMNS) {
+		int t = omp_get_thread_num();
+		index_t columns = n - c < TRIDIAGONAL_TILE_COLUMNS ? n - c : TRIDIAGONAL_TILE_COLUMNS;
+		const REAL *V_c = V + (c - p - 1) * nb, *W_c = W + (c - p - 1) * nb;
+
+		FN(blocked_general_product_packed)(OP_NO_TRANSPOSE, OP_TRANSPOSE, n - c, columns, nb, -1.0, V_c, nb, W_c, nb,
+						   1.0, A + c * n + c, n, P_packed[t], Q_packed[t]);
+		FN(blocked_general_product_packed)(OP_NO_TRANSPOSE, OP_TRANSPOSE, n - c, columns, nb, -1.0, W_c, nb, V_c, nb,
+						   1.0, A + c * n + c, n, P_packed[t], Q_packed[t]);
+	    }
+
+	}
+
+	d[n - 2] = A[(n - 2) * n + n - 2];
+	e[n - 2] = A[(n - 1) * n + n - 2];
+	d[n - 1] = A[(n - 1) * n + n - 1];
+
+    }
+
+    for (int t = 0; P_packed && Q_packed && t < threads; t++) {
+	free(P_packed[t]);
+	free(Q_packed[t]);
+    }
+
+    free(P_packed);
+    free(Q_packed);
+    free(Y);
+    free(V);
+
+    return failed ? -1 : 0;
+
+}
+
+/*
+ * Eigenvalues of the symmetric tridiagonal matrix (d, e) of size n by implicit QL with Wilkinson
+ * shifts, e[i] coupling rows i and i + 1 (e holds n values, the last one is workspace). With Z
+ * (leading dimension ldz), the rotations are accumulated in its columns. The eigenvalues are left
+ * unsorted in d. As in EISPACK tql1, an off-diagonal element is negligible relative to the norm of
+ * the matrix (the largest |d[i]| + |e[i]|) rather than to its two diagonal neighbours, which vanish
+ * along with it for rank-deficient matrices. Returns -1 when an eigenvalue needs more than
+ * QL_ITERATIONS steps.
+ */
+
+static int tridiagonal_QL(index_t n, REAL *d, REAL *e, REAL *Z, index_t ldz) {
+
+    REAL norm = 0.0;
+
+    e[n - 1] = 0.0;
+
+    for (index_t i = 0; i < n; i++)
+	norm = fmax(norm, fabs(d[i]) + fabs(e[i]));
+
+    for (index_t l = 0; l < n; l++) {
+
+	int iterations = 0;
+	index_t m;
+
+	do {
+	    for (m = l; m < n - 1; m++)
+		if (fabs(e[m]) <= REAL_EPSILON * norm) break;
+
+	    if (m == l) break;
+
+	    if (iterations++ == QL_ITERATIONS) return -1;
+
+	    REAL g = (d[l + 1] - d[l]) / (2.0 * e[l]);
+	    REAL r = hypot(g, 1.0);
+	    REAL s = 1.0, c = 1.0, p = 0.0;
+	    index_t i;
+
+	    g = d[m] - d[l] + e[l] / (g + copysign(r, g));
+
+	    for (i = m - 1; i >= l; i--) {
+		REAL f = s * e[i], b = c * e[i];
+
+		e[i + 1] = r = hypot(f, g);
+
+		if (r == 0.0) {
+		    d[i + 1] -= p;
+		    e[m] = 0.0;
+		    break;
+		}
+
+		s = f / r;
+		c = g / r;
+		g = d[i + 1] - p;
+		r = (d[i] - g) * s + 2.0 * c * b;
+		p = s * r;
+		d[i + 1] = g + p;
+		g = c * r - b;
+
+		for (index_t k = 0; Z && k < n; k++) {
+		    REAL *z = Z + k * ldz + i;
+		    f = z[1];
+		    z[1] = s * z[0] + c * f;
+		    z[0] = c * z[0] - s * f;
+		}
+	    }
+
+	    if (r == 0.0 && i >= l) continue;
+
+	    d[l] -= p;
+	    e[l] = g;
+	    e[m] = 0.0;
+	} while (m != l);
+
+    }
+
+    return 0;
+
+}
+
+/*
+ * Sorts the n eigenvalues d in increasing order, with the columns of Z (n rows, leading dimension
+ * ldz) when Z is not NULL. Insertion sort: the lists met here are small or nearly sorted.
+ */
+
+static void sort_eigenvalues(index_t n, REAL *d, REAL *Z, index_t ldz) {
+
+    for (index_t i = 1; i < n; i++)
+	for (index_t j = i; j > 0 && d[j - 1] > d[j]; j--) {
+	    REAL swap = d[j];
+	    d[j] = d[j - 1];
+	    d[j - 1] = swap;
+	    for (index_t k = 0; Z && k < n; k++) {
+		swap = Z[k * ldz + j];
+		Z[k * ldz + j] = Z[k * ldz + j - 1];
+		Z[k * ldz + j - 1] = swap;
+	    }
+	}
+
+}
+
+/*
+ * Secular function f(tau) = 1 + rho sum z_j^2 / (delta_j - delta_o - tau) around the pole o,
+ * its derivative, and the sum of the magnitudes of its terms (scale of its rounding errors).
+ */
+
+static REAL secular_function(index_t k, const REAL *delta, const REAL *z, REAL rho, index_t o, REAL tau,
+			     REAL *derivative, REAL *magnitude) {
+
+    REAL f = 1.0, slope = 0.0, sum = 1.0;
+
+    for (index_t j = 0; j < k; j++) {
+	REAL q = z[j] / ((delta[j] - delta[o]) - tau);
+	f += rho * z[j] * q;
+	slope += rho * q * q;
+	sum += fabs(rho * z[j] * q);
+    }
+
+    *derivative = slope;
+    *magnitude = sum;
+
+    return f;
+
+}
+
+/*
+ * Root i of the secular equation of D + rho z z^T (delta increasing, z without zero, rho > 0),
+ * in (delta_i, delta_{i + 1}) or above delta_{k - 1} for the last one. It is returned as
+ * delta[origin] + tau with origin the closer end of the interval, so that the differences
+ * lambda_i - delta_j are computed without cancellation. Newton steps are kept inside a bracket
+ * of the root, bisecting it when they leave it.
+ */
+
+static void secular_root(index_t k, const REAL *delta, const REAL *z, REAL rho, index_t i, index_t *origin, REAL *tau) {
+
+    REAL lower = 0.0, upper, derivative, magnitude;
+    index_t o = i;
+
+    if (i == k - 1) {
+	REAL norm = 0.0;
+	for (index_t j = 0; j < k; j++)
+	    norm += z[j] * z[j];
+	upper = rho * norm;
+    } else {
+	REAL gap = delta[i + 1] - delta[i];
+	upper = 0.5 * gap;
+	if (secular_function(k, delta, z, rho, i, upper, &derivative, &magnitude) < 0.0) {
+	    o = i + 1;
+	    lower = upper - gap;
+	    upper = 0.0;
+	}
+    }
+
+    REAL t = 0.5 * (lower + upper);
+
+    for (int iteration = 0; iteration < SECULAR_ITERATIONS; iteration++) {
+
+	REAL f = secular_function(k, delta, z, rho, o, t, &derivative, &magnitude);
+
+	if (fabs(f) <= REAL_EPSILON * magnitude) break;
+
+	if (f > 0.0)
+	    upper = t;
+	else
+	    lower = t;
+
+	if (upper - lower <= 2.0 * REAL_EPSILON * fmax(fabs(lower), fabs(upper))) break;
+
+	REAL next = t - f / derivative;
+	t = next > lower && next < upper ? next : 0.5 * (lower + upper);
+
+    }
+
+    *origin = o;
+    *tau = t;
+
+}
+
+/*
+ * Merges the two halves of a split tridiagonal matrix: d[0:m] and d[m:n] are their eigenvalues in
+ * increasing order, with their eigenvectors in the diagonal blocks of Q (leading dimension ldq,
+ * zeros elsewhere), and the coupling is rho u u^T with u = e_{m - 1} + sign e_m. On return d holds
+ * the n eigenvalues in increasing order and Q their eigenvectors. Returns -1 on memory allocation
+ * errors.
+ */
+
+static int merge_halves(index_t n, index_t m, REAL *d, REAL *Q, index_t ldq, REAL rho, REAL sign) {
+
+    REAL *z = malloc(5 * n * sizeof(REAL));
+    index_t *order = malloc(4 * n * sizeof(index_t));
+    REAL *Q_gathered = malloc((size_t) n * n * sizeof(REAL));
+
+    if (!z || !order || !Q_gathered) {
+	free(z);
+	free(order);
+	free(Q_gathered);
+	return -1;
+    }
+
+    REAL *delta = z + n, *z_kept = delta + n, *tau = z_kept + n, *values = tau + n;
+    index_t *kept = order + n, *deflated = kept + n, *origin = deflated + n;
+
+    // z = Q^T u / sqrt(2) has unit norm, rho u u^T = (2 rho) z z^T
+    for (index_t i = 0; i < n; i++)
+	z[i] = (i < m ? Q[(m - 1) * ldq + i] : sign * Q[m * ldq + i]) / sqrt(2.0);
+
+    rho *= 2.0;
+
+    // Both halves are sorted: merging them sorts d
+    for (index_t a = 0, b = m, s = 0; s < n; s++)
+	order[s] = b == n || (a < m && d[a] <= d[b]) ? a++ : b++;
+
+    // Deflation: a negligible component of z leaves its eigenpair unchanged, and a rotation zeroes
+    // the component of the first of two eigenvalues too close to be told apart
+    REAL largest_d = 0.0, largest_z = 0.0;
+
+    for (index_t i = 0; i < n; i++) {
+	largest_d = fmax(largest_d, fabs(d[i]));
+	largest_z = fmax(largest_z, fabs(z[i]));
+    }
+
+    REAL tolerance = 8.0 * REAL_EPSILON * fmax(largest_d, largest_z);
+    index_t k = 0, count = 0, previous = -1;
+
+    for (index_t s = 0; s < n; s++) {
+	index_t j = order[s];
+
+	if (rho * fabs(z[j]) <= tolerance) {
+	    deflated[count++] = j;
+	    continue;
+	}
+
+	if (previous >= 0) {
+	    REAL norm = hypot(z[previous], z[j]);
+	    REAL c = z[j] / norm, s_ = -z[previous] / norm;
+
+	    if (fabs((d[j] - d[previous]) * c * s_) <= tolerance) {
+		z[j] = norm;
+		z[previous] = 0.0;
+
+		for (index_t r = 0; r < n; r++) {
+		    REAL *row = Q + r * ldq, x = row[previous], y = row[j];
+		    row[previous] = c * x + s_ * y;
+		    row[j] = c * y - s_ * x;
+		}
+
+		REAL first = d[previous] * c * c + d[j] * s_ * s_;
+		d[j] = d[previous] * s_ * s_ + d[j] * c * c;
+		d[previous] = first;
+		deflated[count++] = previous;
+	    } else {
+		kept[k++] = previous;
+	    }
+	}
+
+	previous = j;
+    }
+
+    if (previous >= 0) kept[k++] = previous;
+
+    for (index_t c = 0; c < k; c++) {
+	delta[c] = d[kept[c]];
+	z_kept[c] = z[kept[c]];
+    }
+
+    for (index_t c = 0; c < count; c++)
+	values[k + c] = d[deflated[c]];
+
+    // Roots of the secular equation, then the z of which they are the exact eigenvalues
+    // (Gu and Eisenstat) and the eigenvectors of D + rho z z^T, in U (k x k)
+    REAL *U = k > 0 ? malloc((size_t) k * k * sizeof(REAL)) : NULL;
+    REAL *X = k > 0 ? malloc((size_t) n * k * sizeof(REAL)) : NULL;
+    int status = 0;
+
+    if (k > 0 && (!U || !X)) status = -1;
+
+    if (k > 0 && !status) {
+
+#pragma omp taskloop grainsize(16)
+	for (index_t i = 0; i < k; i++)
+	    secular_root(k, delta, z_kept, rho, i, origin + i, tau + i);
+
+#pragma omp taskloop grainsize(16)
+	for (index_t j = 0; j < k; j++) {
+	    REAL product = ((delta[origin[k - 1]] - delta[j]) + tau[k - 1]) / rho;
+	    for (index_t i = 0; i < k - 1; i++) {
+		REAL difference = (delta[origin[i]] - delta[j]) + tau[i];
+		product *= difference / (i < j ? delta[i] - delta[j] : delta[i + 1] - delta[j]);
+	    }
+	    z[j] = copysign(sqrt(fabs(product)), z_kept[j]);
+	}
+
+#pragma omp taskloop grainsize(16)
+	for (index_t i = 0; i < k; i++) {
+	    REAL norm = 0.0;
+	    for (index_t j = 0; j < k; j++) {
+		REAL u = z[j] / -((delta[origin[i]] - delta[j]) + tau[i]);
+		U[j * k + i] = u;
+		norm += u * u;
+	    }
+	    norm = 1.0 / sqrt(norm);
+	    for (index_t j = 0; j < k; j++)
+		U[j * k + i] *= norm;
+	    values[i] = delta[origin[i]] + tau[i];
+	}
+
+	// X = Q[:, kept] U, by tiles of rows
+	for (index_t r = 0; r < n; r++)
+	    for (index_t c = 0; c < k; c++)
+		Q_gathered[r * n + c] = Q[r * ldq + kept[c]];
+
+#pragma omp taskloop grainsize(1) shared(status)
+	for (index_t r = 0; r < n; r += MERGE_TILE_ROWS) {
+	    index_t rows = n - r < MERGE_TILE_ROWS ? n - r : MERGE_TILE_ROWS;
+	    if (FN(blocked_matrix_product)(rows, k, k, 1.0, Q_gathered + r * n, n, U, k, 0.0, X + r * k, k)) {
+#pragma omp atomic write
+		status = -1;
+	    }
+	}
+
+    }
+
+    if (!status) {
+
+	for (index_t r = 0; r < n; r++)
+	    for (index_t c = 0; c < count; c++)
+		Q_gathered[r * n + k + c] = Q[r * ldq + deflated[c]];
+
+	// The roots are increasing, the deflated eigenvalues nearly so: sort the latter, then merge
+	for (index_t c = 0; c < count; c++)
+	    order[c] = k + c;
+
+	for (index_t c = 1; c < count; c++)
+	    for (index_t s = c; s > 0 && values[order[s - 1]] > values[order[s]]; s--) {
+		index_t swap = order[s];
+		order[s] = order[s - 1];
+		order[s - 1] = swap;
+	    }
+
+	index_t *source = kept;
+
+	for (index_t a = 0, b = 0, s = 0; s < n; s++)
+	    source[s] = b == count || (a < k && values[a] <= values[order[b]]) ? a++ : order[b++];
+
+	for (index_t s = 0; s < n; s++)
+	    d[s] = values[source[s]];
+
+	for (index_t r = 0; r < n; r++)
+	    for (index_t s = 0; s < n; s++)
+		Q[r * ldq + s] = source[s] < k ? X[r * k + source[s]] : Q_gathered[r * n + source[s]];
+
+    }
+
+    free(U);
+    free(X);
+    free(z);
+    free(order);
+    free(Q_gathered);
+
+    return status;
+
+}
+
+/*
+ * Eigenvalues (in increasing order, in d) and eigenvectors (columns of Q, leading dimension ldq,
+ * zero outside of the n x n block on entry) of the symmetric tridiagonal matrix (d, e) of size n.
+ * The two halves are solved as OpenMP tasks. Sets status to -1 on failure.
+ */
+
+static void divide_and_conquer(index_t n, REAL *d, REAL *e, REAL *Q, index_t ldq, int *status) {
+
+    if (n <= DIVIDE_AND_CONQUER_BASE) {
+	for (index_t i = 0; i < n; i++)
+	    Q[i * ldq + i] = 1.0;
+
+	if (tridiagonal_QL(n, d, e, Q, ldq)) {
+#pragma omp atomic write
+	    *status = -1;
+	}
+
+	sort_eigenvalues(n, d, Q, ldq);
+	return;
+    }
+
+    // T = diag(T_1, T_2) + |beta| u u^T with u = e_{m - 1} + sign(beta) e_m
+    index_t m = n / 2;
+    REAL beta = e[m - 1], rho = fabs(beta);
+
+    d[m - 1] -= rho;
+    d[m] -= rho;
+
+#pragma omp task if (n > 4 * DIVIDE_AND_CONQUER_BASE)
+    divide_and_conquer(m, d, e, Q, ldq, status);
+
+    divide_and_conquer(n - m, d + m, e + m, Q + m * ldq + m, ldq, status);
+
+#pragma omp taskwait
+
+    int failed;
+
+#pragma omp atomic read
+    failed = *status;
+
+    if (!failed && merge_halves(n, m, d, Q, ldq, rho, beta < 0.0 ? -1.0 : 1.0)) {
+#pragma omp atomic write
+	*status = -1;
+    }
+
+}
+
+/*
+ * Shared body of the symmetric eigensolvers: eigenvalues of A (lower triangle) in increasing
+ * order, and its eigenvectors as the columns of eigenvectors when it is not NULL.
+ */
+
+static int symmetric_eigen(REAL *A, index_t size, REAL *eigenvalues, REAL *eigenvectors, int parallel, const char *name) {
+
+    if (size <= 0) {
+        fprintf(stderr, "Error: Invalid size (%" PRId64 ") in %s. Must be strictly positive.\n", size, name);
+        return -1;
+    }
+
+    if (!A || !eigenvalues) {
+        fprintf(stderr, "Error: Null pointer detected in %s.\n", name);
+        return -1;
+    }
+
+    if (eigenvectors && eigenvectors != A && ranges_overlap(eigenvectors, (size_t) size * size, A, (size_t) size * size)) {
+        fprintf(stderr, "Error: Eigenvectors partially overlap the input matrix in %s.\n", name);
+        return -1;
+    }
+
+    if (ranges_overlap(eigenvalues, size, A, (size_t) size * size) ||
+	(eigenvectors && ranges_overlap(eigenvalues, size, eigenvectors, (size_t) size * size))) {
+        fprintf(stderr, "Error: Eigenvalues overlap a matrix in %s.\n", name);
+        return -1;
+    }
+
+    index_t n = size;
+    REAL *T = malloc((size_t) n * n * sizeof(REAL));
+    REAL *e = malloc(2 * n * sizeof(REAL));
+
+    if (!T || !e) {
+        fprintf(stderr, "Error: Memory allocation failed in %s.\n", name);
+        free(T);
+        free(e);
+        return -1;
+    }
+
+    REAL *tau = e + n, *d = eigenvalues;
+
+    memcpy(T, A, (size_t) n * n * sizeof(REAL));
+
+    if (tridiagonal_reduction(n, T, d, e, tau, parallel)) {
+        fprintf(stderr, "Error: Memory allocation failed for the tridiagonalization in %s.\n", name);
+        free(T);
+        free(e);
+        return -1;
+    }
+
+    e[n - 1] = 0.0;
+
+    int status = 0;
+
+    if (!eigenvectors) {
+	status = tridiagonal_QL(n, d, e, NULL, 0);
+	sort_eigenvalues(n, d, NULL, 0);
+    } else {
+	// Scaled to the largest element so that the secular equations neither overflow nor underflow
+	REAL scale = 0.0;
+
+	for (index_t i = 0; i < n; i++)
+	    scale = fmax(scale, fmax(fabs(d[i]), i + 1 < n ? fabs(e[i]) : 0.0));
+
+	if (scale == 0.0) scale = 1.0;
+
+	for (index_t i = 0; i < n; i++) {
+	    d[i] /= scale;
+	    e[i] /= scale;
+	}
+
+	memset(eigenvectors, 0, (size_t) n * n * sizeof(REAL));
+
+#pragma omp parallel if (parallel)
+#pragma omp single
+	divide_and_conquer(n, d, e, eigenvectors, n, &status);
+
+	for (index_t i = 0; i < n; i++)
+	    d[i] *= scale;
+
+	if (!status && n > 2)
+	    status = FN(blocked_QR_apply_Q)(OP_NO_TRANSPOSE, n - 1, n, n - 2, T + n, n, tau, eigenvectors + n, n, parallel);
+    }
+
+    if (status)
+        fprintf(stderr, "Error: The tridiagonal eigensolver failed in %s.\n", name);
+
+    free(T);
+    free(e);
+
+    return status;
+
+}
+
+/**
+ * @brief Computes the eigenvalues of a symmetric matrix.
+ *
+ * A is reduced to tridiagonal form by blocked Householder reflectors, whose eigenvalues come
+ * from implicit QL iterations. Only the lower triangle of A is read.
+ *
+ * @param A Pointer to the symmetric matrix (size: size x size).
+ * @param size Dimension of the matrix (must be positive).
+ *
+ * @return Pointer to the eigenvalues in increasing order on success, or NULL on failure due to invalid
+ *         dimensions, null pointers, memory allocation errors or lack of convergence.
+ */
+
+REAL *FN(symmetric_eigenvalues)(REAL *A, index_t size) {
+
+    if (size <= 0) {
+        fprintf(stderr, "Error: Invalid size (%" PRId64 ") in symmetric_eigenvalues. Must be strictly positive.\n", size);
+        return NULL;
+    }
+
+    REAL *eigenvalues = malloc(size * sizeof(REAL));
+
+    if (!eigenvalues) {
+        fprintf(stderr, "Error: Memory allocation failed for eigenvalues in symmetric_eigenvalues.\n");
+        return NULL;
+    }
+
+    if (symmetric_eigen(A, size, eigenvalues, NULL, 0, "symmetric_eigenvalues")) {
+        free(eigenvalues);
+        return NULL;
+    }
+
+    return eigenvalues;
+
+}
+
+/**
+ * @brief Computes the eigenvalues and, optionally, the eigenvectors of a symmetric matrix.
+ *
+ * A = Z diag(eigenvalues) Z^T with Z orthogonal. A is reduced to tridiagonal form T by blocked
+ * Householder reflectors. Without eigenvectors, the eigenvalues of T come from implicit QL
+ * iterations in O(size^2). With them, T is solved by divide and conquer and its eigenvectors are
+ * multiplied by the reflectors. Only the lower triangle of A is read.
+ *
+ * @param A Pointer to the symmetric matrix (size: size x size).
+ * @param size Dimension of the matrix (must be positive).
+ * @param eigenvalues Pointer to the eigenvalues in increasing order (size: size).
+ * @param eigenvectors Pointer to Z (size: size x size), column i being the eigenvector of eigenvalue i,
+ *                     or NULL for the eigenvalues only. May be A.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers, overlapping outputs,
+ *         memory allocation errors or lack of convergence.
+ */
+
+int FN(symmetric_eigen_decomposition_into)(REAL *A, index_t size, REAL *eigenvalues, REAL *eigenvectors) {
+
+    return symmetric_eigen(A, size, eigenvalues, eigenvectors, 0, "symmetric_eigen_decomposition_into");
+
+}
+
+/**
+ * @brief Computes the eigenvalues and, optionally, the eigenvectors of a symmetric matrix in parallel.
+ *
+ * Same as symmetric_eigen_decomposition_into on all the OpenMP threads: the products of the
+ * tridiagonalization are shared by rows and tiles, the halves of the divide and conquer are solved
+ * as tasks and the reflectors are applied to tiles of columns of the eigenvectors.
+ *
+ * @param A Pointer to the symmetric matrix (size: size x size).
+ * @param size Dimension of the matrix (must be positive).
+ * @param eigenvalues Pointer to the eigenvalues in increasing order (size: size).
+ * @param eigenvectors Pointer to Z (size: size x size), column i being the eigenvector of eigenvalue i,
+ *                     or NULL for the eigenvalues only. May be A.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers, overlapping outputs,
+ *         memory allocation errors or lack of convergence.
+ */
+
+int FN(symmetric_eigen_decomposition_parallel_into)(REAL *A, index_t size, REAL *eigenvalues, REAL *eigenvectors) {
+
+    return symmetric_eigen(A, size, eigenvalues, eigenvectors, 1, "symmetric_eigen_decomposition_parallel_into");
+
+}
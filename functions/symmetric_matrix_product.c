@@ -0,0 +1,632 @@
+#include "kernels.h"
+#include <omp.h>
+#include <string.h>
+
+/**
+ * @brief Size of the square tiles of a packed matrix unpacked for the GEMM engine.
+ */
+
+#define SYMM_TILE GEMM_KC
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86
+#endif
+
+/*
+ * A symmetric matrix-vector product is bound by the bandwidth at which the stored
+ * triangle is streamed. Element (i, j) of the stored triangle adds a_ij * x_j to y_i
+ * and, off the diagonal, a_ij * x_i to y_j, so every stored value is loaded once and
+ * used twice. Rows are walked two at a time, so each value of X and Y loaded over
+ * their common columns serves both rows.
+ */
+
+/**
+ * @brief Y += x0 A_0 + x1 A_1 over n columns, and T[r] = A_r . X.
+ */
+
+#define DEFINE_SYMV_PAIR(SUFFIX, TARGET)				\
+    TARGET static void symv_pair_##SUFFIX(index_t n, const REAL *restrict A0, const REAL *restrict A1, \
+					  const REAL *restrict X, REAL x0, REAL x1, \
+					  REAL *restrict Y, REAL *restrict T) { \
+	REAL t0 = 0.0, t1 = 0.0;					\
+	_Pragma("omp simd reduction(+:t0, t1)")				\
+	for (index_t j = 0; j < n; j++) {				\
+	    REAL a0 = A0[j], a1 = A1[j];				\
+	    t0 += a0 * X[j];						\
+	    t1 += a1 * X[j];						\
+	    Y[j] += a0 * x0 + a1 * x1;					\
+	}								\
+	T[0] = t0;							\
+	T[1] = t1;							\
+    }
+
+/**
+ * @brief Y += x0 A_0 over n columns, and returns A_0 . X.
+ */
+
+#define DEFINE_SYMV_ROW(SUFFIX, TARGET)					\
+    TARGET static REAL symv_row_##SUFFIX(index_t n, const REAL *restrict A0, const REAL *restrict X, \
+					 REAL x0, REAL *restrict Y) {	\
+	REAL t0 = 0.0;							\
+	_Pragma("omp simd reduction(+:t0)")				\
+	for (index_t j = 0; j < n; j++) {				\
+	    t0 += A0[j] * X[j];						\
+	    Y[j] += A0[j] * x0;						\
+	}								\
+	return t0;							\
+    }
+
+#define DEFINE_SYMV_KERNELS(SUFFIX, TARGET)	\
+    DEFINE_SYMV_PAIR(SUFFIX, TARGET)		\
+    DEFINE_SYMV_ROW(SUFFIX, TARGET)
+
+/**
+ * @brief Symmetric matrix-vector kernels compiled for one instruction set.
+ *
+ * @struct symv_kernels
+ * @var symv_kernels::name
+ * Name of the instruction set, matching simd_kernels::name.
+ * @var symv_kernels::pair
+ * Two stored rows over their common columns.
+ * @var symv_kernels::row
+ * One stored row.
+ */
+
+typedef struct symv_kernels {
+
+    const char *name;
+
+    void (*pair)(index_t n, const REAL *A0, const REAL *A1, const REAL *X, REAL x0, REAL x1, REAL *Y, REAL *T);
+    REAL (*row)(index_t n, const REAL *A0, const REAL *X, REAL x0, REAL *Y);
+
+} symv_kernels;
+
+#define SYMV_KERNELS_TABLE(NAME, SUFFIX) { NAME, symv_pair_##SUFFIX, symv_row_##SUFFIX }
+
+DEFINE_SYMV_KERNELS(generic, )
+
+#ifdef SIMD_X86
+DEFINE_SYMV_KERNELS(sse2, __attribute__((target("sse2"))))
+DEFINE_SYMV_KERNELS(avx2, __attribute__((target("avx2,fma"))))
+DEFINE_SYMV_KERNELS(avx512, __attribute__((target("avx512f"))))
+#endif
+
+static const symv_kernels symv_kernels_tables[] = {
+    SYMV_KERNELS_TABLE("generic", generic),
+#ifdef SIMD_X86
+    SYMV_KERNELS_TABLE("sse2", sse2),
+    SYMV_KERNELS_TABLE("avx2", avx2),
+    SYMV_KERNELS_TABLE("avx512", avx512),
+#endif
+};
+
+/**
+ * @brief Returns the symmetric matrix-vector kernels of the instruction set selected in simd_kernels.c.
+ */
+
+static const symv_kernels *active_symv_kernels(void) {
+
+    const char *name = FN(active_kernels)->name;
+
+    for (size_t i = 0; i < sizeof(symv_kernels_tables) / sizeof(symv_kernels_tables[0]); i++)
+	if (!strcmp(symv_kernels_tables[i].name, name))
+	    return &symv_kernels_tables[i];
+
+    return &symv_kernels_tables[0];
+
+}
+
+/*
+ * Y += contribution of the stored rows first to last - 1 of a packed symmetric matrix
+ * to A * X. Y must not overlap the matrix or X.
+ */
+
+static void symmetric_rows(const FN(packed_matrix) *A, index_t first, index_t last, const REAL *X, REAL *Y) {
+
+    const symv_kernels *symv = active_symv_kernels();
+    index_t n = A->size;
+    int lower = A->triangle == TRIANGLE_LOWER;
+    index_t i = first;
+    REAL T[2];
+
+    for (; i + 1 < last; i += 2) {
+	const REAL *r0 = A->data + packed_index(n, A->triangle, i, lower ? 0 : i);
+	const REAL *r1 = A->data + packed_index(n, A->triangle, i + 1, lower ? 0 : i + 1);
+	REAL x0 = X[i], x1 = X[i + 1];
+
+	if (lower) {
+	    // Columns 0 to i - 1 are shared by both rows
+	    symv->pair(i, r0, r1, X, x0, x1, Y, T);
+	    Y[i] += T[0] + r0[i] * x0 + r1[i] * x1;
+	    Y[i + 1] += T[1] + r1[i] * x0 + r1[i + 1] * x1;
+	} else {
+	    // Columns i + 2 to n - 1 are shared by both rows
+	    symv->pair(n - i - 2, r0 + 2, r1 + 1, X + i + 2, x0, x1, Y + i + 2, T);
+	    Y[i] += T[0] + r0[0] * x0 + r0[1] * x1;
+	    Y[i + 1] += T[1] + r0[1] * x0 + r1[0] * x1;
+	}
+    }
+
+    for (; i < last; i++) {
+	const REAL *r = A->data + packed_index(n, A->triangle, i, lower ? 0 : i);
+	REAL x = X[i];
+
+	if (lower)
+	    Y[i] += symv->row(i, r, X, x, Y) + r[i] * x;
+	else
+	    Y[i] += symv->row(n - i - 1, r + 1, X + i + 1, x, Y + i + 1) + r[0] * x;
+    }
+
+}
+
+/*
+ * First row r in [0, n] such that the stored rows 0 to r - 1 hold at least target values.
+ * Splitting the rows at these points gives every thread about the same share of the triangle.
+ */
+
+static index_t packed_partition_point(index_t n, int triangle, size_t target) {
+
+    index_t low = 0, high = n;
+
+    while (low < high) {
+	index_t middle = low + (high - low) / 2;
+	if (packed_index(n, triangle, middle, triangle == TRIANGLE_LOWER ? 0 : middle) < target)
+	    low = middle + 1;
+	else
+	    high = middle;
+    }
+
+    return low;
+
+}
+
+/*
+ * Copies the block of rows i..i+m-1 and columns j..j+n-1 of the symmetric matrix to tile
+ * (leading dimension n) when it lies in the stored triangle, whose rows it reads as
+ * contiguous runs. Blocks of the other triangle are not formed: the stored block (j, i) is
+ * copied instead (leading dimension m) and OP_TRANSPOSE is returned. A diagonal block
+ * (i == j, m == n) is expanded to a full symmetric tile.
+ */
+
+static int unpack_tile(const FN(packed_matrix) *A, index_t i, index_t m, index_t j, index_t n, REAL *tile) {
+
+    index_t size = A->size;
+    int lower = A->triangle == TRIANGLE_LOWER;
+
+    if (i == j) {
+	for (index_t r = 0; r < m; r++)
+	    for (index_t c = lower ? 0 : r; c <= (lower ? r : m - 1); c++) {
+		REAL value = A->data[packed_index(size, A->triangle, i + r, i + c)];
+		tile[r * m + c] = value;
+		tile[c * m + r] = value;
+	    }
+	return OP_NO_TRANSPOSE;
+    }
+
+    if (lower == (i > j)) {
+	for (index_t r = 0; r < m; r++)
+	    memcpy(tile + r * n, A->data + packed_index(size, A->triangle, i + r, j), n * sizeof(REAL));
+	return OP_NO_TRANSPOSE;
+    }
+
+    for (index_t r = 0; r < n; r++)
+	memcpy(tile + r * m, A->data + packed_index(size, A->triangle, j + r, i), m * sizeof(REAL));
+
+    return OP_TRANSPOSE;
+
+}
+
+/*
+ * Checks shared by the symmetric products. Returns 0 when the arguments are valid.
+ */
+
+static int check_symmetric_product(const FN(packed_matrix) *A, REAL *B, index_t B_rows, index_t B_columns, REAL *C,
+				   int check_output, const char *name) {
+
+    if (!A || !A->data || !B || (check_output && !C)) {
+        fprintf(stderr, "Error: Null pointer detected in %s.\n", name);
+        return -1;
+    }
+
+    if (B_rows <= 0 || B_columns <= 0 || A->size != B_rows) {
+        fprintf(stderr, "Error: Dimension mismatch. Matrix size (%" PRId64 ") must equal the rows of the right operand (%" PRId64 ", %" PRId64 " columns).\n",
+                A->size, B_rows, B_columns);
+        return -1;
+    }
+
+    size_t packed_size = (size_t) A->size * (A->size + 1) / 2, size = (size_t) B_rows * B_columns;
+
+    if (check_output && (ranges_overlap(C, size, A->data, packed_size) || ranges_overlap(C, size, B, size))) {
+        fprintf(stderr, "Error: Output overlaps an input in %s.\n", name);
+        return -1;
+    }
+
+    return 0;
+
+}
+
+/**
+ * @brief Computes the product of a packed symmetric matrix A and a vector X sequentially.
+ *
+ * This function calculates the vector result = A * X, where A is given by one of its
+ * triangles in packed storage. Each stored element is read once and used for both of
+ * its positions in A, so the product streams half the memory of a dense one.
+ *
+ * @param A Pointer to the packed symmetric matrix (size: size x size).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal the size of A).
+ *
+ * @return Pointer to the resulting vector (size: dimension) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(sequential_symmetric_vector_matrix_product)(const FN(packed_matrix) *A, REAL *X, index_t dimension) {
+
+    if (check_symmetric_product(A, X, dimension, 1, NULL, 0, "sequential_symmetric_vector_matrix_product"))
+	return NULL;
+
+    REAL *vector = malloc(dimension * sizeof(REAL));
+
+    if (!vector) {
+        fprintf(stderr, "Error: Memory allocation failed for result vector of size %" PRId64 ".\n", dimension);
+        return NULL;
+    }
+
+    FN(sequential_symmetric_vector_matrix_product_into)(A, X, dimension, vector);
+
+    return vector;
+
+}
+
+/**
+ * @brief Computes the product of a packed symmetric matrix A and a vector X sequentially into a caller-provided vector.
+ *
+ * Same as sequential_symmetric_vector_matrix_product, without allocating the result. Y must not overlap A or X.
+ *
+ * @param A Pointer to the packed symmetric matrix (size: size x size).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal the size of A).
+ * @param Y Pointer to the output vector (size: dimension).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers or aliased output.
+ */
+
+int FN(sequential_symmetric_vector_matrix_product_into)(const FN(packed_matrix) *A, REAL *X, index_t dimension, REAL *Y) {
+
+    if (check_symmetric_product(A, X, dimension, 1, Y, 1, "sequential_symmetric_vector_matrix_product_into"))
+	return -1;
+
+    memset(Y, 0, dimension * sizeof(REAL));
+    symmetric_rows(A, 0, dimension, X, Y);
+
+    return 0;
+
+}
+
+/**
+ * @brief Computes the product of a packed symmetric matrix A and a vector X in parallel using OpenMP.
+ *
+ * This function calculates the vector result = A * X, where A is given by one of its
+ * triangles in packed storage. The stored rows are split between the threads so that
+ * each thread reads about the same share of the triangle, once. A stored element adds
+ * to two entries of the result, so each thread accumulates into its own partial vector
+ * and the partial vectors are summed at the end.
+ *
+ * @param A Pointer to the packed symmetric matrix (size: size x size).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal the size of A).
+ *
+ * @return Pointer to the resulting vector (size: dimension) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(parallel_symmetric_vector_matrix_product)(const FN(packed_matrix) *A, REAL *X, index_t dimension) {
+
+    if (check_symmetric_product(A, X, dimension, 1, NULL, 0, "parallel_symmetric_vector_matrix_product"))
+	return NULL;
+
+    REAL *vector = malloc(dimension * sizeof(REAL));
+
+    if (!vector) {
+        fprintf(stderr, "Error: Memory allocation failed for result vector of size %" PRId64 ".\n", dimension);
+        return NULL;
+    }
+
+    if (FN(parallel_symmetric_vector_matrix_product_into)(A, X, dimension, vector) != 0) {
+	free(vector);
+	return NULL;
+    }
+
+    return vector;
+
+}
+
+/**
+ * @brief Computes the product of a packed symmetric matrix A and a vector X in parallel using OpenMP into a caller-provided vector.
+ *
+ * Same as parallel_symmetric_vector_matrix_product, without allocating the result. Y must not overlap A or X.
+ *
+ * @param A Pointer to the packed symmetric matrix (size: size x size).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal the size of A).
+ * @param Y Pointer to the output vector (size: dimension).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers, aliased output,
+ *         or memory allocation errors.
+ */
+
+int FN(parallel_symmetric_vector_matrix_product_into)(const FN(packed_matrix) *A, REAL *X, index_t dimension, REAL *Y) {
+
+    if (check_symmetric_product(A, X, dimension, 1, Y, 1, "parallel_symmetric_vector_matrix_product_into"))
+	return -1;
+
+    int threads = omp_get_max_threads(), failed = 0;
+    REAL **partials = calloc(threads, sizeof(REAL *));
+
+    if (!partials) {
+        fprintf(stderr, "Error: Memory allocation failed for partial vectors in parallel_symmetric_vector_matrix_product_into.\n");
+        return -1;
+    }
+
+    size_t stored = (size_t) dimension * (dimension + 1) / 2;
+
+#pragma omp parallel shared(failed)
+    {
+	int thread = omp_get_thread_num(), team = omp_get_num_threads();
+
+	// The first thread accumulates directly into Y, the others into their own partial vector
+	partials[thread] = thread == 0 ? Y : aligned_buffer(sizeof(REAL) * dimension);
+
+	if (!partials[thread]) {
+#pragma omp atomic write
+	    failed = 1;
+	}
+
+#pragma omp barrier
+
+	if (!failed) {
+	    index_t first = packed_partition_point(dimension, A->triangle, stored * thread / team);
+	    index_t last = (thread == team - 1) ? dimension
+		: packed_partition_point(dimension, A->triangle, stored * (thread + 1) / team);
+
+	    memset(partials[thread], 0, dimension * sizeof(REAL));
+	    symmetric_rows(A, first, last, X, partials[thread]);
+
+#pragma omp barrier
+
+	    // Reduction of the partial vectors, split by rows
+#pragma omp for schedule(static)
+	    for (index_t i = 0; i < dimension; i++)
+		for (int t = 1; t < team; t++)
+		    Y[i] += partials[t][i];
+	}
+    }
+
+    for (int t = 1; t < threads; t++)
+	free(partials[t]);
+    free(partials);
+
+    if (failed) {
+        fprintf(stderr, "Error: Memory allocation failed for partial vectors in parallel_symmetric_vector_matrix_product_into.\n");
+        return -1;
+    }
+
+    return 0;
+
+}
+
+/**
+ * @brief Computes the product of a packed symmetric matrix A and a matrix B sequentially.
+ *
+ * This function calculates C = A * B, where A is given by one of its triangles in packed
+ * storage. The stored triangle is cut into tiles, each copied once from the packed rows
+ * into a small dense buffer and used twice by the packed GEMM engine: as A_IJ for the rows
+ * I of C and as its transpose for the rows J. Every stored element is therefore read
+ * once, and the full matrix is never formed.
+ *
+ * @param A Pointer to the packed symmetric matrix (size: size x size).
+ * @param B Pointer to the right operand (size: B_rows x B_columns).
+ * @param B_rows Number of rows in B (must equal the size of A).
+ * @param B_columns Number of columns in B (must be positive).
+ *
+ * @return Pointer to the resulting matrix (size: B_rows x B_columns) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(sequential_symmetric_matrix_product)(const FN(packed_matrix) *A, REAL *B, index_t B_rows, index_t B_columns) {
+
+    if (check_symmetric_product(A, B, B_rows, B_columns, NULL, 0, "sequential_symmetric_matrix_product"))
+	return NULL;
+
+    REAL *C = malloc((size_t) B_rows * B_columns * sizeof(REAL));
+
+    if (!C) {
+        fprintf(stderr, "Error: Memory allocation failed for result matrix of size %" PRId64 " x %" PRId64 ".\n",
+                B_rows, B_columns);
+        return NULL;
+    }
+
+    if (FN(sequential_symmetric_matrix_product_into)(A, B, B_rows, B_columns, C) != 0) {
+	free(C);
+	return NULL;
+    }
+
+    return C;
+
+}
+
+/**
+ * @brief Computes the product of a packed symmetric matrix A and a matrix B sequentially into a caller-provided matrix.
+ *
+ * Same as sequential_symmetric_matrix_product, without allocating the result. C must not overlap A or B.
+ *
+ * @param A Pointer to the packed symmetric matrix (size: size x size).
+ * @param B Pointer to the right operand (size: B_rows x B_columns).
+ * @param B_rows Number of rows in B (must equal the size of A).
+ * @param B_columns Number of columns in B (must be positive).
+ * @param C Pointer to the output matrix (size: B_rows x B_columns).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers, aliased output,
+ *         or memory allocation errors.
+ */
+
+int FN(sequential_symmetric_matrix_product_into)(const FN(packed_matrix) *A, REAL *B, index_t B_rows, index_t B_columns,
+						 REAL *C) {
+
+    if (check_symmetric_product(A, B, B_rows, B_columns, C, 1, "sequential_symmetric_matrix_product_into"))
+	return -1;
+
+    index_t n = A->size, k = B_columns;
+
+    REAL *tile = malloc(sizeof(REAL) * SYMM_TILE * SYMM_TILE);
+    REAL *P_packed = aligned_buffer(sizeof(REAL) * GEMM_P_BUFFER_SIZE(SYMM_TILE, SYMM_TILE));
+    REAL *Q_packed = aligned_buffer(sizeof(REAL) * GEMM_Q_BUFFER_SIZE(k, SYMM_TILE));
+
+    if (!tile || !P_packed || !Q_packed) {
+        fprintf(stderr, "Error: Memory allocation failed for buffers in sequential_symmetric_matrix_product_into.\n");
+	free(tile);
+	free(P_packed);
+	free(Q_packed);
+        return -1;
+    }
+
+    memset(C, 0, (size_t) n * k * sizeof(REAL));
+
+    for (index_t i = 0; i < n; i += SYMM_TILE) {
+	for (index_t j = 0; j <= i; j += SYMM_TILE) {
+
+	    index_t m = n - i < SYMM_TILE ? n - i : SYMM_TILE;
+	    index_t p = n - j < SYMM_TILE ? n - j : SYMM_TILE;
+
+	    // Block (i, j) of the lower triangle, or its transpose stored in the upper one
+	    int transpose = unpack_tile(A, i, m, j, p, tile);
+	    index_t ld = transpose ? m : p;
+
+	    FN(blocked_general_product_packed)(transpose, OP_NO_TRANSPOSE, m, k, p, 1.0, tile, ld,
+					       B + (size_t) j * k, k, 1.0, C + (size_t) i * k, k, P_packed, Q_packed);
+
+	    if (i != j)
+		FN(blocked_general_product_packed)(!transpose, OP_NO_TRANSPOSE, p, k, m, 1.0, tile, ld,
+						   B + (size_t) i * k, k, 1.0, C + (size_t) j * k, k, P_packed, Q_packed);
+
+	}
+    }
+
+    free(tile);
+    free(P_packed);
+    free(Q_packed);
+
+    return 0;
+
+}
+
+/**
+ * @brief Computes the product of a packed symmetric matrix A and a matrix B in parallel using OpenMP.
+ *
+ * This function calculates C = A * B, where A is given by one of its triangles in packed
+ * storage. Each thread owns blocks of rows of C: for a block I, it copies the tiles A_IJ
+ * of the whole block row from the packed triangle, reading the stored tile (J, I) when A_IJ
+ * lies in the other triangle, and multiplies them by B with the packed GEMM engine. The
+ * threads never write the same rows, and each stored element is read by at most two threads.
+ *
+ * @param A Pointer to the packed symmetric matrix (size: size x size).
+ * @param B Pointer to the right operand (size: B_rows x B_columns).
+ * @param B_rows Number of rows in B (must equal the size of A).
+ * @param B_columns Number of columns in B (must be positive).
+ *
+ * @return Pointer to the resulting matrix (size: B_rows x B_columns) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(parallel_symmetric_matrix_product)(const FN(packed_matrix) *A, REAL *B, index_t B_rows, index_t B_columns) {
+
+    if (check_symmetric_product(A, B, B_rows, B_columns, NULL, 0, "parallel_symmetric_matrix_product"))
+	return NULL;
+
+    REAL *C = malloc((size_t) B_rows * B_columns * sizeof(REAL));
+
+    if (!C) {
+        fprintf(stderr, "Error: Memory allocation failed for result matrix of size %" PRId64 " x %" PRId64 ".\n",
+                B_rows, B_columns);
+        return NULL;
+    }
+
+    if (FN(parallel_symmetric_matrix_product_into)(A, B, B_rows, B_columns, C) != 0) {
+	free(C);
+	return NULL;
+    }
+
+    return C;
+
+}
+
+/**
+ * @brief Computes the product of a packed symmetric matrix A and a matrix B in parallel using OpenMP into a caller-provided matrix.
+ *
+ * Same as parallel_symmetric_matrix_product, without allocating the result. C must not overlap A or B.
+ *
+ * @param A Pointer to the packed symmetric matrix (size: size x size).
+ * @param B Pointer to the right operand (size: B_rows x B_columns).
+ * @param B_rows Number of rows in B (must equal the size of A).
+ * @param B_columns Number of columns in B (must be positive).
+ * @param C Pointer to the output matrix (size: B_rows x B_columns).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers, aliased output,
+ *         or memory allocation errors.
+ */
+
+int FN(parallel_symmetric_matrix_product_into)(const FN(packed_matrix) *A, REAL *B, index_t B_rows, index_t B_columns,
+					       REAL *C) {
+
+    if (check_symmetric_product(A, B, B_rows, B_columns, C, 1, "parallel_symmetric_matrix_product_into"))
+	return -1;
+
+    index_t n = A->size, k = B_columns;
+    index_t blocks = (n + SYMM_TILE - 1) / SYMM_TILE;
+    int failed = 0;
+
+#pragma omp parallel if(blocks > 1) shared(failed)
+    {
+	// Tile and packing buffers, reused for all the tiles of the thread
+	REAL *tile = malloc(sizeof(REAL) * SYMM_TILE * SYMM_TILE);
+	REAL *P_packed = aligned_buffer(sizeof(REAL) * GEMM_P_BUFFER_SIZE(SYMM_TILE, SYMM_TILE));
+	REAL *Q_packed = aligned_buffer(sizeof(REAL) * GEMM_Q_BUFFER_SIZE(k, SYMM_TILE));
+
+	if (!tile || !P_packed || !Q_packed) {
+#pragma omp atomic write
+	    failed = 1;
+	}
+
+#pragma omp barrier
+
+	if (!failed) {
+#pragma omp for schedule(dynamic)
+	    for (index_t b = 0; b < blocks; b++) {
+
+		index_t i = b * SYMM_TILE, m = n - i < SYMM_TILE ? n - i : SYMM_TILE;
+
+		for (index_t j = 0; j < n; j += SYMM_TILE) {
+		    index_t p = n - j < SYMM_TILE ? n - j : SYMM_TILE;
+		    int transpose = unpack_tile(A, i, m, j, p, tile);
+
+		    FN(blocked_general_product_packed)(transpose, OP_NO_TRANSPOSE, m, k, p, 1.0, tile, transpose ? m : p,
+						       B + (size_t) j * k, k, j == 0 ? 0.0 : 1.0, C + (size_t) i * k, k,
+						       P_packed, Q_packed);
+		}
+
+	    }
+	}
+
+	free(tile);
+	free(P_packed);
+	free(Q_packed);
+    }
+
+    if (failed) {
+        fprintf(stderr, "Error: Memory allocation failed for buffers in parallel_symmetric_matrix_product_into.\n");
+        return -1;
+    }
+
+    return 0;
+
+}
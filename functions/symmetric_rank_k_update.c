@@ -0,0 +1,195 @@
+#include "kernels.h"
+#include <omp.h>
+
+/**
+ * @brief Size of the square tiles of C handed to the threads.
+ */
+
+#define SYRK_TILE GEMM_MC
+
+/**
+ * @brief Symmetric rank-k update of one triangle, C = alpha * op(A) * op(A)^T + beta * C,
+ *        computed blocked and in parallel using OpenMP.
+ *
+ * op(A) is A (N x K, C = alpha * A * A^T + beta * C) for OP_NO_TRANSPOSE and
+ * A^T (A is K x N, C = alpha * A^T * A + beta * C) for OP_TRANSPOSE. Only the
+ * tiles of C on the requested side of the diagonal are computed, each one by
+ * the packed GEMM engine reading A in place, so the update costs about half
+ * the FLOPs of a full product. Diagonal tiles are formed in a per-thread
+ * buffer and only their triangle is written back. The other triangle of C is
+ * left untouched, unless mirror is set: it then receives an exact copy of the
+ * computed one, and C can be given directly to Cholesky_decomposition or
+ * LDLT_decomposition, which require exact symmetry.
+ *
+ * @param triangle TRIANGLE_LOWER or TRIANGLE_UPPER, the triangle of C to compute.
+ * @param transpose OP_NO_TRANSPOSE or OP_TRANSPOSE.
+ * @param N Order of C (must be non-negative).
+ * @param K Rank of the update (must be non-negative).
+ * @param alpha Scalar applied to the product.
+ * @param A Pointer to A (size: N x K, or K x N when transposed).
+ * @param lda Leading dimension of A (at least its number of columns).
+ * @param beta Scalar applied to C before accumulation (C is not read when 0).
+ * @param C Pointer to the output matrix (size: N x N), must not overlap A.
+ * @param ldc Leading dimension of C (at least N).
+ * @param mirror 1 to copy the computed triangle into the other one, 0 otherwise.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         aliased output, or memory allocation errors.
+ */
+
+int FN(symmetric_rank_k_update)(int triangle, int transpose, index_t N, index_t K, REAL alpha, REAL *A, index_t lda,
+			    REAL beta, REAL *C, index_t ldc, int mirror) {
+
+    if (N < 0 || K < 0) {
+        fprintf(stderr, "Error: Invalid dimensions for symmetric_rank_k_update (N=%" PRId64 ", K=%" PRId64 "). Both must be non-negative.\n", N, K);
+        return -1;
+    }
+
+    index_t A_rows = transpose ? K : N, A_columns = transpose ? N : K;
+
+    if (lda < (A_columns > 1 ? A_columns : 1) || ldc < (N > 1 ? N : 1)) {
+        fprintf(stderr, "Error: Leading dimensions too small in symmetric_rank_k_update (lda=%" PRId64 ", ldc=%" PRId64 ").\n", lda, ldc);
+        return -1;
+    }
+
+    if (N == 0) return 0;
+
+    if (!C || (K > 0 && !A)) {
+        fprintf(stderr, "Error: Null pointer detected in symmetric_rank_k_update.\n");
+        return -1;
+    }
+
+    if (K > 0 && ranges_overlap(C, (size_t) (N - 1) * ldc + N, A, (size_t) (A_rows - 1) * lda + A_columns)) {
+        fprintf(stderr, "Error: Output matrix overlaps the input matrix in symmetric_rank_k_update.\n");
+        return -1;
+    }
+
+    int lower = (triangle == TRIANGLE_LOWER);
+    index_t tiles_per_side = (N + SYRK_TILE - 1) / SYRK_TILE;
+    index_t tiles = tiles_per_side * (tiles_per_side + 1) / 2;
+    int failed = 0;
+
+#pragma omp parallel if(tiles > 1) shared(failed)
+    {
+	// Packing buffers and diagonal tile buffer, reused for all the tiles of the thread
+	REAL *A_packed = aligned_buffer(sizeof(REAL) * GEMM_P_BUFFER_SIZE(SYRK_TILE, K));
+	REAL *B_packed = aligned_buffer(sizeof(REAL) * GEMM_Q_BUFFER_SIZE(SYRK_TILE, K));
+	REAL *diagonal = aligned_buffer(sizeof(REAL) * SYRK_TILE * SYRK_TILE);
+
+	if (!A_packed || !B_packed || !diagonal) {
+#pragma omp atomic write
+	    failed = 1;
+	}
+
+#pragma omp barrier
+
+	if (!failed) {
+#pragma omp for schedule(dynamic)
+	    for (index_t t = 0; t < tiles; t++) {
+
+		// Tile t of the lower triangle, row after row: (ti, tj) with tj <= ti
+		index_t ti = 0;
+		while ((ti + 1) * (ti + 2) / 2 <= t) ti++;
+		index_t tj = t - ti * (ti + 1) / 2;
+
+		if (!lower) {
+		    index_t swap = ti;
+		    ti = tj;
+		    tj = swap;
+		}
+
+		index_t i = ti * SYRK_TILE, j = tj * SYRK_TILE;
+		index_t m = (N - i < SYRK_TILE) ? N - i : SYRK_TILE;
+		index_t n = (N - j < SYRK_TILE) ? N - j : SYRK_TILE;
+
+		// Rows i.. of op(A) times the transpose of rows j.. of op(A)
+		const REAL *A_i = transpose ? A + i : A + (size_t) i * lda;
+		const REAL *A_j = transpose ? A + j : A + (size_t) j * lda;
+		REAL *C_ij = C + (size_t) i * ldc + j;
+
+		if (ti != tj) {
+		    FN(blocked_general_product_packed)(transpose, !transpose, m, n, K, alpha, A_i, lda, A_j, lda,
+						   beta, C_ij, ldc, A_packed, B_packed);
+		    continue;
+		}
+
+		FN(blocked_general_product_packed)(transpose, !transpose, m, m, K, alpha, A_i, lda, A_j, lda,
+					       0.0, diagonal, m, A_packed, B_packed);
+
+		for (index_t r = 0; r < m; r++) {
+		    index_t first = lower ? 0 : r, last = lower ? r : m - 1;
+		    for (index_t c = first; c <= last; c++)
+			C_ij[(size_t) r * ldc + c] = (beta == 0.0) ? diagonal[r * m + c]
+			    : diagonal[r * m + c] + beta * C_ij[(size_t) r * ldc + c];
+		}
+
+	    }
+
+	    if (mirror) {
+#pragma omp for schedule(static)
+		for (index_t r = 0; r < N; r++)
+		    for (index_t c = r + 1; c < N; c++) {
+			if (lower)
+			    C[(size_t) r * ldc + c] = C[(size_t) c * ldc + r];
+			else
+			    C[(size_t) c * ldc + r] = C[(size_t) r * ldc + c];
+		    }
+	    }
+	}
+
+	free(A_packed);
+	free(B_packed);
+	free(diagonal);
+    }
+
+    if (failed) {
+        fprintf(stderr, "Error: Memory allocation failed for buffers in symmetric_rank_k_update.\n");
+        return -1;
+    }
+
+    return 0;
+
+}
+
+/**
+ * @brief Computes the Gram matrix A^T * A of a matrix A.
+ *
+ * The lower triangle is formed by symmetric_rank_k_update and mirrored, so the
+ * result is exactly symmetric and can be passed to Cholesky_decomposition or
+ * LDLT_decomposition as is.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in matrix A (must be positive).
+ * @param columns Number of columns in matrix A (must be positive).
+ *
+ * @return Pointer to the resulting matrix (size: columns x columns) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(gram_matrix)(REAL *A, index_t rows, index_t columns) {
+
+    if (rows <= 0 || columns <= 0) {
+        fprintf(stderr, "Error: Invalid dimensions for Gram matrix (rows=%" PRId64 ", columns=%" PRId64 "). Both must be strictly positive.\n", rows, columns);
+        return NULL;
+    }
+
+    if (!A) {
+        fprintf(stderr, "Error: Null pointer detected for input matrix in gram_matrix.\n");
+        return NULL;
+    }
+
+    REAL *matrix = malloc((size_t) columns * columns * sizeof(REAL));
+
+    if (!matrix) {
+        fprintf(stderr, "Error: Memory allocation failed for result matrix in gram_matrix.\n");
+        return NULL;
+    }
+
+    if (FN(symmetric_rank_k_update)(TRIANGLE_LOWER, OP_TRANSPOSE, columns, rows, 1.0, A, columns, 0.0, matrix, columns, 1)) {
+        free(matrix);
+        return NULL;
+    }
+
+    return matrix;
+
+}
@@ -0,0 +1,193 @@
+#include "kernels.h"
+#include <omp.h>
+
+/*
+ * A tridiagonal system is given by three vectors of the same size n: lower[i],
+ * diagonal[i] and upper[i] are the elements (i, i - 1), (i, i) and (i, i + 1) of the
+ * matrix, so lower[0] and upper[n - 1] are not read. The batched solver takes the
+ * systems one after the other in each vector.
+ */
+
+/*
+ * Thomas algorithm: forward elimination into the scratch vector c and x, then back
+ * substitution. Returns the first row with a zero pivot, or -1 when the system is solved.
+ * x may be b.
+ */
+
+static index_t thomas(const REAL *lower, const REAL *diagonal, const REAL *upper, const REAL *b, index_t n,
+		      REAL *c, REAL *x) {
+
+    if (diagonal[0] == 0.0) return 0;
+
+    c[0] = n > 1 ? upper[0] / diagonal[0] : 0.0;
+    x[0] = b[0] / diagonal[0];
+
+    for (index_t i = 1; i < n; i++) {
+	REAL pivot = diagonal[i] - lower[i] * c[i - 1];
+	if (pivot == 0.0) return i;
+	c[i] = i < n - 1 ? upper[i] / pivot : 0.0;
+	x[i] = (b[i] - lower[i] * x[i - 1]) / pivot;
+    }
+
+    for (index_t i = n - 2; i >= 0; i--)
+	x[i] -= c[i] * x[i + 1];
+
+    return -1;
+
+}
+
+/**
+ * @brief Solves a tridiagonal linear system Ax = b with the Thomas algorithm.
+ *
+ * @param lower Pointer to the subdiagonal, lower[i] = A(i, i - 1) (size: n, lower[0] is not read).
+ * @param diagonal Pointer to the diagonal, diagonal[i] = A(i, i) (size: n).
+ * @param upper Pointer to the superdiagonal, upper[i] = A(i, i + 1) (size: n, upper[n - 1] is not read).
+ * @param b Pointer to the right-hand side vector b (size: n).
+ * @param n Dimension of the system (must be positive).
+ *
+ * @return Pointer to the solution vector x on success, or NULL on failure due to invalid
+ *         dimensions, null pointers, a zero pivot or memory allocation errors.
+ */
+
+REAL *FN(solve_tridiagonal_system)(REAL *lower, REAL *diagonal, REAL *upper, REAL *b, index_t n) {
+
+    if (n <= 0) {
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", n);
+        return NULL;
+    }
+
+    REAL *x = malloc(n * sizeof(REAL));
+
+    if (!x) {
+        fprintf(stderr, "Error: Memory allocation failed for solution vector in solve_tridiagonal_system.\n");
+        return NULL;
+    }
+
+    if (FN(solve_tridiagonal_system_into)(lower, diagonal, upper, b, n, x)) {
+        free(x);
+        return NULL;
+    }
+
+    return x;
+
+}
+
+/**
+ * @brief Solves a tridiagonal linear system Ax = b with the Thomas algorithm into a caller-provided vector.
+ *
+ * The system is solved in O(n) time without pivoting, which is stable when A is
+ * diagonally dominant or symmetric positive definite. x may be b (the right-hand
+ * side is overwritten by the solution).
+ *
+ * @param lower Pointer to the subdiagonal, lower[i] = A(i, i - 1) (size: n, lower[0] is not read).
+ * @param diagonal Pointer to the diagonal, diagonal[i] = A(i, i) (size: n).
+ * @param upper Pointer to the superdiagonal, upper[i] = A(i, i + 1) (size: n, upper[n - 1] is not read).
+ * @param b Pointer to the right-hand side vector b (size: n).
+ * @param n Dimension of the system (must be positive).
+ * @param x Pointer to the solution vector x (size: n).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         a zero pivot or memory allocation errors.
+ */
+
+int FN(solve_tridiagonal_system_into)(REAL *lower, REAL *diagonal, REAL *upper, REAL *b, index_t n, REAL *x) {
+
+    if (n <= 0) {
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", n);
+        return -1;
+    }
+
+    if (!lower || !diagonal || !upper || !b || !x) {
+        fprintf(stderr, "Error: Null pointer detected in solve_tridiagonal_system_into.\n");
+        return -1;
+    }
+
+    REAL *c = malloc(n * sizeof(REAL));
+
+    if (!c) {
+        fprintf(stderr, "Error: Memory allocation failed for elimination vector in solve_tridiagonal_system_into.\n");
+        return -1;
+    }
+
+    index_t zero_pivot = thomas(lower, diagonal, upper, b, n, c, x);
+
+    free(c);
+
+    if (zero_pivot >= 0) {
+        fprintf(stderr, "Error: Zero pivot at row %" PRId64 " in solve_tridiagonal_system_into.\n", zero_pivot);
+        return -1;
+    }
+
+    return 0;
+
+}
+
+/**
+ * @brief Solves a batch of independent tridiagonal systems in parallel using OpenMP.
+ *
+ * System s is made of the n elements starting at s * n in lower, diagonal, upper, B
+ * and X. The systems are shared between the threads, each with its own elimination
+ * vector, and each is solved with the Thomas algorithm. X may be B.
+ *
+ * @param lower Pointer to the subdiagonals (size: batch x n, the first element of each system is not read).
+ * @param diagonal Pointer to the diagonals (size: batch x n).
+ * @param upper Pointer to the superdiagonals (size: batch x n, the last element of each system is not read).
+ * @param B Pointer to the right-hand sides (size: batch x n).
+ * @param n Dimension of each system (must be positive).
+ * @param batch Number of systems (must be non-negative).
+ * @param X Pointer to the solutions (size: batch x n).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         a zero pivot in any system or memory allocation errors.
+ */
+
+int FN(batched_solve_tridiagonal_system)(REAL *lower, REAL *diagonal, REAL *upper, REAL *B, index_t n, index_t batch,
+					 REAL *X) {
+
+    if (n <= 0 || batch < 0) {
+        fprintf(stderr, "Error: Invalid dimensions (n=%" PRId64 ", batch=%" PRId64 ").\n", n, batch);
+        return -1;
+    }
+
+    if (batch > 0 && (!lower || !diagonal || !upper || !B || !X)) {
+        fprintf(stderr, "Error: Null pointer detected in batched_solve_tridiagonal_system.\n");
+        return -1;
+    }
+
+    int failed = 0;
+    index_t singular = -1;
+
+#pragma omp parallel if(batch > 1) shared(failed, singular)
+    {
+	REAL *c = malloc(n * sizeof(REAL));
+
+	if (!c) {
+#pragma omp atomic write
+	    failed = 1;
+	}
+
+#pragma omp for schedule(static)
+	for (index_t s = 0; s < batch; s++) {
+	    size_t offset = (size_t) s * n;
+	    if (!c || thomas(lower + offset, diagonal + offset, upper + offset, B + offset, n, c, X + offset) < 0)
+		continue;
+#pragma omp critical(tridiagonal_singular)
+	    if (singular < 0 || s < singular) singular = s;
+	}
+
+	free(c);
+    }
+
+    if (failed) {
+        fprintf(stderr, "Error: Memory allocation failed for elimination vectors in batched_solve_tridiagonal_system.\n");
+        return -1;
+    }
+
+    if (singular >= 0) {
+        fprintf(stderr, "Error: Zero pivot in system %" PRId64 " in batched_solve_tridiagonal_system.\n", singular);
+        return -1;
+    }
+
+    return 0;
+
+}
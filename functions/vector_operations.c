@@ -1,4 +1,4 @@
-#include "LinearAlgebraBasics.h"
+#include "kernels.h"
 
 /**
  * @brief Computes the element-wise addition of two vectors X and Y.
@@ -14,10 +14,10 @@
  *         null pointers, or memory allocation errors.
  */
 
-double *vectors_addition(double *X, double *Y, int dimension) {
+REAL *FN(vectors_addition)(REAL *X, REAL *Y, index_t dimension) {
 
     if (dimension <= 0) {
-        fprintf(stderr, "Error: Invalid dimension (%d). Must be strictly positive.\n", dimension);
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", dimension);
         return NULL;
     }
 
@@ -26,20 +26,51 @@ double *vectors_addition(double *X, double *Y, int dimension) {
         return NULL;
     }
 
-    double *vector = malloc(dimension * sizeof(double));
+    REAL *vector = malloc(dimension * sizeof(REAL));
 
     if (!vector) {
-        fprintf(stderr, "Error: Memory allocation failed for vectors_addition (dimension=%d).\n", dimension);
+        fprintf(stderr, "Error: Memory allocation failed for vectors_addition (dimension=%" PRId64 ").\n", dimension);
         return NULL;
     }
 
-    for (int i = 0; i < dimension; i++)
-	vector[i] = X[i] + Y[i];
+    FN(vectors_addition_into)(X, Y, dimension, vector);
 
     return vector;
     
 }
 
+/**
+ * @brief Computes the element-wise addition of two vectors X and Y into a caller-provided vector.
+ *
+ * Same as vectors_addition, without allocating the result. Z may be X or Y
+ * (in-place addition).
+ *
+ * @param X Pointer to the first input vector (size: dimension).
+ * @param Y Pointer to the second input vector (size: dimension).
+ * @param dimension Dimension of the vectors (must be positive).
+ * @param Z Pointer to the output vector (size: dimension).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimension or null pointers.
+ */
+
+int FN(vectors_addition_into)(REAL *X, REAL *Y, index_t dimension, REAL *Z) {
+
+    if (dimension <= 0) {
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", dimension);
+        return -1;
+    }
+
+    if (!X || !Y || !Z) {
+        fprintf(stderr, "Error: Null pointer detected in vectors_addition_into.\n");
+        return -1;
+    }
+
+    FN(active_kernels)->add(X, Y, Z, dimension);
+
+    return 0;
+
+}
+
 /**
  * @brief Computes the element-wise product of two vectors X and Y.
  *
@@ -54,10 +85,10 @@ double *vectors_addition(double *X, double *Y, int dimension) {
  *         null pointers, or memory allocation errors.
  */
 
-double *scalar_product(double *X, double *Y, int dimension) {
+REAL *FN(scalar_product)(REAL *X, REAL *Y, index_t dimension) {
 
     if (dimension <= 0) {
-        fprintf(stderr, "Error: Invalid dimension (%d). Must be strictly positive.\n", dimension);
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", dimension);
         return NULL;
     }
 
@@ -66,20 +97,51 @@ double *scalar_product(double *X, double *Y, int dimension) {
         return NULL;
     }
 
-    double *vector = malloc(dimension * sizeof(dimension));
+    REAL *vector = malloc(dimension * sizeof(REAL));
 
     if (!vector) {
-        fprintf(stderr, "Error: Memory allocation failed for scalar_product (dimension=%d).\n", dimension);
+        fprintf(stderr, "Error: Memory allocation failed for scalar_product (dimension=%" PRId64 ").\n", dimension);
         return NULL;
     }
     
-    for (int i = 0; i < dimension; i++)
-	vector[i] = X[i] * Y[i];
+    FN(scalar_product_into)(X, Y, dimension, vector);
 
     return vector;
 
 }
 
+/**
+ * @brief Computes the element-wise product of two vectors X and Y into a caller-provided vector.
+ *
+ * Same as scalar_product, without allocating the result. Z may be X or Y
+ * (in-place product).
+ *
+ * @param X Pointer to the first input vector (size: dimension).
+ * @param Y Pointer to the second input vector (size: dimension).
+ * @param dimension Dimension of the vectors (must be positive).
+ * @param Z Pointer to the output vector (size: dimension).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimension or null pointers.
+ */
+
+int FN(scalar_product_into)(REAL *X, REAL *Y, index_t dimension, REAL *Z) {
+
+    if (dimension <= 0) {
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", dimension);
+        return -1;
+    }
+
+    if (!X || !Y || !Z) {
+        fprintf(stderr, "Error: Null pointer detected in scalar_product_into.\n");
+        return -1;
+    }
+
+    FN(active_kernels)->multiply(X, Y, Z, dimension);
+
+    return 0;
+
+}
+
 /**
  * @brief Computes the cross product of two 3-dimensional vectors X and Y.
  *
@@ -93,32 +155,62 @@ double *scalar_product(double *X, double *Y, int dimension) {
  *         or memory allocation errors.
  */
 
-double *vector_product(double *X, double *Y) {
+REAL *FN(vector_product)(REAL *X, REAL *Y) {
 
     // ONLY IN DIMENSION 3
 
-    const int dimension = 3;
+    const index_t dimension = 3;
 
     if (!X || !Y) {
         fprintf(stderr, "Error: Null pointer detected in vector_product.\n");
         return NULL;
     }
 
-    double *vector = malloc(dimension * sizeof(double));
+    REAL *vector = malloc(dimension * sizeof(REAL));
 
     if (!vector) {
         fprintf(stderr, "Error: Memory allocation failed for vector_product.\n");
         return NULL;
     }
 
-    vector[0] = X[1] * Y[2] - X[2] * Y[1];
-    vector[1] = X[2] * Y[0] - X[0] * Y[2];
-    vector[2] = X[0] * Y[1] - X[1] * Y[0];
+    FN(vector_product_into)(X, Y, vector);
 
     return vector;
        
 }
 
+/**
+ * @brief Computes the cross product of two 3-dimensional vectors X and Y into a caller-provided vector.
+ *
+ * Same as vector_product, without allocating the result. Z may be X or Y.
+ *
+ * @param X Pointer to the first input vector (size: 3).
+ * @param Y Pointer to the second input vector (size: 3).
+ * @param Z Pointer to the output vector (size: 3).
+ *
+ * @return 0 on success, or -1 on failure due to null pointers.
+ */
+
+int FN(vector_product_into)(REAL *X, REAL *Y, REAL *Z) {
+
+    if (!X || !Y || !Z) {
+        fprintf(stderr, "Error: Null pointer detected in vector_product_into.\n");
+        return -1;
+    }
+
+    // Components are computed before any store so that Z can alias X or Y
+    REAL z0 = X[1] * Y[2] - X[2] * Y[1];
+    REAL z1 = X[2] * Y[0] - X[0] * Y[2];
+    REAL z2 = X[0] * Y[1] - X[1] * Y[0];
+
+    Z[0] = z0;
+    Z[1] = z1;
+    Z[2] = z2;
+
+    return 0;
+
+}
+
 /**
  * @brief Computes the Euclidean norm (length) of a given vector X.
  *
@@ -132,10 +224,10 @@ double *vector_product(double *X, double *Y) {
  *         or null pointers.
  */
 
-double vector_norm(double *X, int dimension) {
+REAL FN(vector_norm)(REAL *X, index_t dimension) {
 
     if (dimension <= 0) {
-        fprintf(stderr, "Error: Invalid dimension (%d). Must be strictly positive.\n", dimension);
+        fprintf(stderr, "Error: Invalid dimension (%" PRId64 "). Must be strictly positive.\n", dimension);
 	return -1.0; 
     }
 
@@ -144,11 +236,6 @@ double vector_norm(double *X, int dimension) {
         return -1.0; 
     }
 
-    double sum = 0.0;
-
-    for (int i = 0; i < dimension; i++)
-	sum += X[i] * X[i];
-
-    return sqrt(sum);
+    return sqrt(FN(active_kernels)->dot(X, X, dimension));
 
 }
@@ -0,0 +1,2482 @@
+/*
+ * Declarations of the library written once for a generic scalar type.
+ *
+ * This file has no include guard: LinearAlgebraBasics.h includes it once per
+ * precision after defining
+ * - REAL, the scalar type (double or float),
+ * - FN(name), the name of a function or structure in that precision
+ *   (name for double, name_float for float),
+ * - TYPED(name), the name suffixed by the scalar type (name_double or name_float).
+ * Include LinearAlgebraBasics.h, not this file.
+ */
+
+/**
+ * @brief Represents the LU decomposition with partial pivoting of a matrix.
+ *
+ * This structure stores the components of an LU decomposition P A = L U, where:
+ * - A is the original matrix,
+ * - L is the unit lower triangular matrix,
+ * - U is the upper triangular matrix,
+ * - P is the permutation given by the row interchanges: row i was interchanged
+ *   with row pivots[i] at step i.
+ *
+ * @struct LU
+ * @var LU::rows
+ * Number of rows in the matrix.
+ * @var LU::columns
+ * Number of columns in the matrix.
+ * @var LU::A
+ * Pointer to the original matrix (size: rows x columns).
+ * @var LU::L
+ * Pointer to the lower triangular matrix (size: rows x columns).
+ * @var LU::U
+ * Pointer to the upper triangular matrix (size: rows x columns).
+ * @var LU::pivots
+ * Pointer to the row interchanges (size: min(rows, columns)).
+ */
+
+typedef struct FN(LU) {
+
+    index_t rows, columns;
+
+    REAL *A;
+    REAL *L;
+    REAL *U;
+    index_t *pivots;
+
+} FN(LU);
+
+/**
+ * @brief Represents the QR decomposition of a matrix.
+ *
+ * This structure stores the components of a QR decomposition, where:
+ * - A is the original matrix,
+ * - Q is the matrix with orthonormal columns,
+ * - R is the upper triangular matrix.
+ *
+ * @struct QR
+ * @var QR::rows
+ * Number of rows in the matrix.
+ * @var QR::columns
+ * Number of columns in the matrix.
+ * @var QR::A
+ * Pointer to the original matrix (size: rows x columns).
+ * @var QR::Q
+ * Pointer to the orthogonal matrix (size: rows x columns).
+ * @var QR::R
+ * Pointer to the upper triangular matrix (size: columns x columns).
+ */
+
+typedef struct FN(QR) {
+
+    index_t rows, columns;
+
+    REAL *A;
+    REAL *Q;
+    REAL *R;
+
+} FN(QR);
+
+/**
+ * @brief Represents the Cholesky decomposition of a matrix.
+ *
+ * This structure stores the components of a Cholesky decomposition, where:
+ * - A is the original square matrix,
+ * - L is the lower triangular matrix resulting from the decomposition,
+ * - Lᵀ is the transpose of the lower triangular matrix.
+ *
+ * @struct Cholesky
+ * @var Cholesky::size
+ * Dimension of the square matrix A (size x size).
+ * @var Cholesky::A
+ * Pointer to the original square matrix (size: size x size).
+ * @var Cholesky::L
+ * Pointer to the lower triangular matrix resulting from the decomposition (size: size x size).
+ * @var Cholesky::L_t
+ * Pointer to the transpose of the lower triangular matrix (size: size x size).
+ */
+
+typedef struct FN(Cholesky) {
+
+    index_t size;
+
+    REAL *A;
+    REAL *L;
+    REAL *L_t;
+
+} FN(Cholesky);
+
+/**
+ * @brief Represents the LDLT decomposition of a symmetric square matrix.
+ *
+ * This structure stores the components of an LDLT decomposition, where:
+ * - A is the original square matrix,
+ * - L is the lower triangular matrix with unit diagonal entries,
+ * - D is the diagonal matrix containing the diagonal elements of the decomposition,
+ * - Lᵀ is the transpose of the lower triangular matrix.
+ *
+ * The decomposition satisfies \( A = L \cdot D \cdot L^T \).
+ *
+ * @struct LDLT
+ * @var LDLT::size
+ * Dimension of the square matrix A (size x size).
+ * @var LDLT::A
+ * Pointer to the original square matrix (size: size x size).
+ * @var LDLT::L
+ * Pointer to the lower triangular matrix resulting from the decomposition (size: size x size).
+ * @var LDLT::D
+ * Pointer to the diagonal matrix containing diagonal elements (size: size x size).
+ * @var LDLT::L_t
+ * Pointer to the transpose of the lower triangular matrix (size: size x size).
+ */
+
+typedef struct FN(LDLT) {
+
+    index_t size;
+
+    REAL *A;
+    REAL *L;
+    REAL *D;
+    REAL *L_t;
+
+} FN(LDLT);
+
+/**
+ * @brief Represents a sparse matrix in compressed sparse row (CSR) or column (CSC) format.
+ *
+ * Only the nonzeros are stored, slice after slice, a slice being a row in CSR format
+ * and a column in CSC format:
+ * - the nonzeros of slice m are at positions pointers[m] to pointers[m + 1] - 1,
+ * - indices holds their column (CSR) or row (CSC), in increasing order inside a slice,
+ * - values holds their value.
+ *
+ * @struct sparse_matrix
+ * @var sparse_matrix::rows
+ * Number of rows in the matrix.
+ * @var sparse_matrix::columns
+ * Number of columns in the matrix.
+ * @var sparse_matrix::nnz
+ * Number of stored nonzeros.
+ * @var sparse_matrix::format
+ * SPARSE_CSR or SPARSE_CSC.
+ * @var sparse_matrix::pointers
+ * Start of each slice in indices and values (size: rows + 1 in CSR, columns + 1 in CSC).
+ * @var sparse_matrix::indices
+ * Column (CSR) or row (CSC) of each nonzero (size: nnz).
+ * @var sparse_matrix::values
+ * Value of each nonzero (size: nnz).
+ */
+
+typedef struct FN(sparse_matrix) {
+
+    index_t rows, columns, nnz;
+    int format;
+
+    index_t *pointers;
+    index_t *indices;
+    REAL *values;
+
+} FN(sparse_matrix);
+
+/**
+ * @brief Represents a square banded matrix.
+ *
+ * Only the main diagonal, the lower diagonals below it and the upper diagonals above it
+ * are stored, row after row: element (i, j) with -lower <= j - i <= upper is
+ * data[i * (lower + upper + 1) + j - i + lower].
+ *
+ * @struct banded_matrix
+ * @var banded_matrix::size
+ * Dimension of the square matrix (size x size).
+ * @var banded_matrix::lower
+ * Number of diagonals below the main diagonal.
+ * @var banded_matrix::upper
+ * Number of diagonals above the main diagonal.
+ * @var banded_matrix::data
+ * Pointer to the band (size: size x (lower + upper + 1)).
+ */
+
+typedef struct FN(banded_matrix) {
+
+    index_t size, lower, upper;
+
+    REAL *data;
+
+} FN(banded_matrix);
+
+/**
+ * @brief Represents the LU decomposition with partial pivoting of a banded matrix.
+ *
+ * Row i of LU holds the columns i - lower to i + lower + upper, at
+ * LU[i * (2 * lower + upper + 1) + j - i + lower]: the multipliers of L below the
+ * diagonal and U on and above it. Row k was interchanged with row pivots[k] at step k.
+ *
+ * @struct banded_LU
+ * @var banded_LU::size
+ * Dimension of the square matrix.
+ * @var banded_LU::lower
+ * Number of diagonals below the main diagonal of the decomposed matrix.
+ * @var banded_LU::upper
+ * Number of diagonals above the main diagonal of the decomposed matrix.
+ * @var banded_LU::LU
+ * Pointer to the factors (size: size x (2 * lower + upper + 1)).
+ * @var banded_LU::pivots
+ * Pointer to the row interchanges (size: size).
+ */
+
+typedef struct FN(banded_LU) {
+
+    index_t size, lower, upper;
+
+    REAL *LU;
+    index_t *pivots;
+
+} FN(banded_LU);
+
+/**
+ * @brief Represents a symmetric or triangular square matrix in packed storage.
+ *
+ * Only one triangle is stored, row after row, in size * (size + 1) / 2 values:
+ * - TRIANGLE_LOWER: row i holds the columns 0 to i, element (i, j) with j <= i is
+ *   data[i * (i + 1) / 2 + j],
+ * - TRIANGLE_UPPER: row i holds the columns i to size - 1, element (i, j) with j >= i
+ *   is data[i * (2 * size - i + 1) / 2 + j - i].
+ *
+ * A symmetric matrix is fully described by either triangle.
+ *
+ * @struct packed_matrix
+ * @var packed_matrix::size
+ * Dimension of the square matrix (size x size).
+ * @var packed_matrix::triangle
+ * TRIANGLE_LOWER or TRIANGLE_UPPER, the stored triangle.
+ * @var packed_matrix::data
+ * Pointer to the stored triangle (size: size * (size + 1) / 2).
+ */
+
+typedef struct FN(packed_matrix) {
+
+    index_t size;
+    int triangle;
+
+    REAL *data;
+
+} FN(packed_matrix);
+
+/* LDLT_decomposition.c */
+
+/**
+ * @brief Allocates and initializes an LDLT decomposition structure.
+ *
+ * This function creates an LDLT decomposition structure for a given matrix A
+ * and initializes its components (A, L, D, and Lᵀ). The input matrix A is copied
+ * into the structure, and the matrices L, D, and Lᵀ are initialized to zero.
+ *
+ * @param A Pointer to the input square matrix (size: size x size).
+ * @param size Dimension of the square matrix A (must be positive).
+ *
+ * @return Pointer to the LDLT structure on success, or NULL on failure due to
+ *         invalid dimensions or memory allocation errors.
+ */
+
+FN(LDLT) *FN(create_LDLT)(REAL *A, index_t size);
+
+/**
+ * @brief Performs LDLT decomposition on a symmetric square matrix.
+ *
+ * This function decomposes a symmetric square matrix A into:
+ * - L: a lower triangular matrix with unit diagonal,
+ * - D: a diagonal matrix,
+ * - Lᵀ: the transpose of the lower triangular matrix.
+ *
+ * The decomposition satisfies \( A = L \cdot D \cdot L^T \).
+ *
+ * The function checks if the input matrix is symmetric before performing the decomposition.
+ *
+ * @param A Pointer to the input square matrix (size: size x size).
+ * @param size Dimension of the square matrix A (must be positive).
+ *
+ * @return Pointer to the LDLT structure containing matrices A, L, D, and Lᵀ on success,
+ *         or NULL on failure due to invalid dimensions, non-symmetric matrix,
+ *         singularity detection, or memory allocation errors.
+ */
+
+FN(LDLT) *FN(LDLT_decomposition)(REAL *A, index_t size);
+
+/**
+ * @brief Frees all memory associated with an LDLT decomposition structure.
+ *
+ * This function releases the memory allocated for the matrices A, L, D, and Lᵀ,
+ * as well as the LDLT structure itself.
+ *
+ * @param LDLT_decomposition Pointer to the LDLT structure to free.
+ */
+
+void FN(free_LDLT)(FN(LDLT) *LDLT_decomposition);
+
+/* Cholesky_decomposition.c */
+
+/**
+ * @brief Allocates and initializes a Cholesky decomposition structure.
+ *
+ * This function creates a Cholesky decomposition structure for a given matrix A
+ * and initializes its components (A, L, and Lᵀ). The input matrix A is copied into
+ * the structure, and the matrices L and Lᵀ are initialized to zero.
+ *
+ * @param A Pointer to the input square matrix (size: size x size).
+ * @param size Dimension of the square matrix A (must be positive).
+ *
+ * @return Pointer to the Cholesky structure on success, or NULL on failure due to
+ *         invalid dimensions or memory allocation errors.
+ */
+
+FN(Cholesky) *FN(create_Cholesky)(REAL *A, index_t size);
+
+/**
+ * @brief Performs Cholesky decomposition on a symmetric positive-definite matrix.
+ *
+ * This function decomposes a symmetric positive-definite matrix A into a lower triangular matrix L
+ * such that \( A = L \cdot L^T \). The resulting matrices L and Lᵀ are stored in the Cholesky structure.
+ *
+ * The function checks if the input matrix is symmetric and positive definite before performing the decomposition.
+ * The factorization is blocked: each diagonal block is factored, the blocks below it are solved
+ * against it, and the trailing matrix receives a symmetric rank update, the last two carried out
+ * almost entirely by the packed GEMM engine.
+ *
+ * @param A Pointer to the input square matrix (size: size x size).
+ * @param size Dimension of the square matrix A (must be positive).
+ *
+ * @return Pointer to the Cholesky structure containing matrices A, L, and Lᵀ on success,
+ *         or NULL on failure due to invalid dimensions, non-symmetric matrix, non-positive definite matrix,
+ *         or memory allocation errors.
+ */
+
+FN(Cholesky) *FN(Cholesky_decomposition)(REAL *A, index_t size);
+
+/**
+ * @brief Performs parallelized Cholesky decomposition on a symmetric positive-definite matrix using OpenMP.
+ *
+ * Same as Cholesky_decomposition, computed by the tiled factorization: the factorization
+ * of the diagonal tiles, the triangular solves of the tiles below them and the updates
+ * of the trailing tiles by the packed GEMM engine are OpenMP tasks ordered by their
+ * dependencies on the tiles, so the work of successive steps overlaps.
+ *
+ * @param A Pointer to the input square matrix (size: size x size).
+ * @param size Dimension of the square matrix A (must be positive).
+ *
+ * @return Pointer to the Cholesky structure containing matrices A, L, and Lᵀ on success,
+ *         or NULL on failure due to invalid dimensions, non-symmetric matrix, non-positive definite matrix,
+ *         or memory allocation errors.
+ */
+
+FN(Cholesky) *FN(Cholesky_decomposition_parallel)(REAL *A, index_t size);
+
+/**
+ * @brief Performs Cholesky decomposition on a symmetric positive-definite matrix into a single caller-provided matrix.
+ *
+ * This function computes A = L L^T like Cholesky_decomposition, without the copies of A and
+ * L^T of the Cholesky structure: only the lower triangle of A is read (the symmetry of A is
+ * not checked), and L is written with zeros above its diagonal. L may be A, which is then
+ * factored in place and no other matrix is allocated.
+ *
+ * @param A Pointer to the input square matrix (size: size x size).
+ * @param size Dimension of the square matrix A (must be positive).
+ * @param L Pointer to the output lower triangular factor (size: size x size), may be A.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         partially overlapping output, non-positive definite matrix or memory allocation errors.
+ */
+
+int FN(Cholesky_factorization_into)(REAL *A, index_t size, REAL *L);
+
+/**
+ * @brief Performs parallelized Cholesky decomposition into a single caller-provided matrix using OpenMP.
+ *
+ * Same as Cholesky_factorization_into, with the tasks of Cholesky_decomposition_parallel.
+ *
+ * @param A Pointer to the input square matrix (size: size x size).
+ * @param size Dimension of the square matrix A (must be positive).
+ * @param L Pointer to the output lower triangular factor (size: size x size), may be A.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         partially overlapping output, non-positive definite matrix or memory allocation errors.
+ */
+
+int FN(Cholesky_factorization_parallel_into)(REAL *A, index_t size, REAL *L);
+
+/**
+ * @brief Frees all memory associated with a Cholesky decomposition structure.
+ *
+ * This function releases the memory allocated for the matrices A, L, and Lᵀ,
+ * as well as the Cholesky structure itself.
+ *
+ * @param Cholesky_decomposition Pointer to the Cholesky structure to free.
+ */
+
+void FN(free_Cholesky)(FN(Cholesky) *Cholesky_decomposition);
+    
+/* generate_matrix.c */
+
+/**
+ * @brief Generates a matrix with random double values between 0 and DOUBLE.
+ *
+ * This function creates a matrix of size rows x columns, where each element
+ * is a random double value in the range [0, DOUBLE].
+ *
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive).
+ *
+ * @return Pointer to the generated matrix on success, or NULL on failure due to invalid dimensions
+ *         or memory allocation errors.
+ *
+ */
+
+REAL *TYPED(generate_matrix) (index_t rows, index_t columns);
+
+/**
+ * @brief Generates an identity matrix of given dimension.
+ *
+ * This function creates a square identity matrix of size dimension x dimension,
+ * where all diagonal elements are 1.0 and all off-diagonal elements are 0.0.
+ *
+ * @param dimension Dimension of the identity matrix (must be positive).
+ *
+ * @return Pointer to the generated identity matrix on success, or NULL on failure due to invalid dimension
+ *         or memory allocation errors.
+ */
+
+REAL *FN(generate_identity_matrix) (index_t dimension);
+
+/* sequential_matrix_product.c */
+
+/**
+ * @brief Computes the product of two matrices P and Q sequentially.
+ *
+ * This function calculates the matrix product C = P * Q, where P is of size
+ * P_rows x P_columns and Q is of size Q_rows x Q_columns. The computation is
+ * performed sequentially without parallelization by the cache-blocked GEMM
+ * engine: panels of P and Q are packed into contiguous buffers and the result
+ * is accumulated tile by tile in a register-blocked microkernel.
+ *
+ * @param P Pointer to the first input matrix (size: P_rows x P_columns).
+ * @param P_rows Number of rows in matrix P (must be positive).
+ * @param P_columns Number of columns in matrix P (must equal Q_rows).
+ * @param Q Pointer to the second input matrix (size: Q_rows x Q_columns).
+ * @param Q_rows Number of rows in matrix Q (must equal P_columns).
+ * @param Q_columns Number of columns in matrix Q (must be positive).
+ *
+ * @return Pointer to the resulting matrix (size: P_rows x Q_columns) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(sequential_matrix_product)(REAL *P, index_t P_rows, index_t P_columns, REAL *Q, index_t Q_rows, index_t Q_columns);
+
+/**
+ * @brief Computes the product of two matrices P and Q sequentially into a caller-provided matrix.
+ *
+ * Same as sequential_matrix_product, without allocating the result. C must not
+ * overlap P or Q.
+ *
+ * @param P Pointer to the first input matrix (size: P_rows x P_columns).
+ * @param P_rows Number of rows in matrix P (must be positive).
+ * @param P_columns Number of columns in matrix P (must equal Q_rows).
+ * @param Q Pointer to the second input matrix (size: Q_rows x Q_columns).
+ * @param Q_rows Number of rows in matrix Q (must equal P_columns).
+ * @param Q_columns Number of columns in matrix Q (must be positive).
+ * @param C Pointer to the output matrix (size: P_rows x Q_columns).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         aliased output, or memory allocation errors.
+ */
+
+int FN(sequential_matrix_product_into)(REAL *P, index_t P_rows, index_t P_columns, REAL *Q, index_t Q_rows, index_t Q_columns, REAL *C);
+
+/* general_matrix_product.c */
+
+/**
+ * @brief Computes the general matrix product C = alpha * op(A) * op(B) + beta * C sequentially.
+ *
+ * op(X) is X when the flag is OP_NO_TRANSPOSE and X^T when it is OP_TRANSPOSE.
+ * Transposed operands are read in place by the packing stage of the blocked
+ * engine: no transposed copy, temporary product or separate addition is made.
+ * Matrices are row-major and addressed through their leading dimensions, so any
+ * sub-block of a bigger matrix can be used. When beta is 0, C is only written.
+ *
+ * @param transpose_A OP_NO_TRANSPOSE or OP_TRANSPOSE.
+ * @param transpose_B OP_NO_TRANSPOSE or OP_TRANSPOSE.
+ * @param M Number of rows of op(A) and C (must be non-negative).
+ * @param N Number of columns of op(B) and C (must be non-negative).
+ * @param K Number of columns of op(A) and rows of op(B) (must be non-negative).
+ * @param alpha Scalar applied to the product.
+ * @param A Pointer to A (size: M x K, or K x M when transposed).
+ * @param lda Leading dimension of A (at least its number of columns).
+ * @param B Pointer to B (size: K x N, or N x K when transposed).
+ * @param ldb Leading dimension of B (at least its number of columns).
+ * @param beta Scalar applied to C before accumulation.
+ * @param C Pointer to the output matrix (size: M x N), must not overlap A or B.
+ * @param ldc Leading dimension of C (at least N).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         aliased output, or memory allocation errors.
+ */
+
+int FN(general_matrix_product)(int transpose_A, int transpose_B, index_t M, index_t N, index_t K, REAL alpha,
+			   REAL *A, index_t lda, REAL *B, index_t ldb, REAL beta, REAL *C, index_t ldc);
+
+/**
+ * @brief Computes the general matrix product C = alpha * op(A) * op(B) + beta * C in parallel using OpenMP.
+ *
+ * Same as general_matrix_product. C is split into 2D tiles of cache-sized
+ * blocks that a single team of threads shares out dynamically; each thread runs
+ * the packed engine on its tiles with its own packing buffers.
+ *
+ * @param transpose_A OP_NO_TRANSPOSE or OP_TRANSPOSE.
+ * @param transpose_B OP_NO_TRANSPOSE or OP_TRANSPOSE.
+ * @param M Number of rows of op(A) and C (must be non-negative).
+ * @param N Number of columns of op(B) and C (must be non-negative).
+ * @param K Number of columns of op(A) and rows of op(B) (must be non-negative).
+ * @param alpha Scalar applied to the product.
+ * @param A Pointer to A (size: M x K, or K x M when transposed).
+ * @param lda Leading dimension of A (at least its number of columns).
+ * @param B Pointer to B (size: K x N, or N x K when transposed).
+ * @param ldb Leading dimension of B (at least its number of columns).
+ * @param beta Scalar applied to C before accumulation.
+ * @param C Pointer to the output matrix (size: M x N), must not overlap A or B.
+ * @param ldc Leading dimension of C (at least N).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         aliased output, or memory allocation errors.
+ */
+
+int FN(parallel_general_matrix_product)(int transpose_A, int transpose_B, index_t M, index_t N, index_t K, REAL alpha,
+				    REAL *A, index_t lda, REAL *B, index_t ldb, REAL beta, REAL *C, index_t ldc);
+
+/* symmetric_rank_k_update.c */
+
+/**
+ * @brief Symmetric rank-k update of one triangle, C = alpha * op(A) * op(A)^T + beta * C,
+ *        computed blocked and in parallel using OpenMP.
+ *
+ * op(A) is A (N x K, C = alpha * A * A^T + beta * C) for OP_NO_TRANSPOSE and
+ * A^T (A is K x N, C = alpha * A^T * A + beta * C) for OP_TRANSPOSE. Only the
+ * tiles of C on the requested side of the diagonal are computed, each one by
+ * the packed GEMM engine reading A in place, so the update costs about half
+ * the FLOPs of a full product. Diagonal tiles are formed in a per-thread
+ * buffer and only their triangle is written back. The other triangle of C is
+ * left untouched, unless mirror is set: it then receives an exact copy of the
+ * computed one, and C can be given directly to Cholesky_decomposition or
+ * LDLT_decomposition, which require exact symmetry.
+ *
+ * @param triangle TRIANGLE_LOWER or TRIANGLE_UPPER, the triangle of C to compute.
+ * @param transpose OP_NO_TRANSPOSE or OP_TRANSPOSE.
+ * @param N Order of C (must be non-negative).
+ * @param K Rank of the update (must be non-negative).
+ * @param alpha Scalar applied to the product.
+ * @param A Pointer to A (size: N x K, or K x N when transposed).
+ * @param lda Leading dimension of A (at least its number of columns).
+ * @param beta Scalar applied to C before accumulation (C is not read when 0).
+ * @param C Pointer to the output matrix (size: N x N), must not overlap A.
+ * @param ldc Leading dimension of C (at least N).
+ * @param mirror 1 to copy the computed triangle into the other one, 0 otherwise.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         aliased output, or memory allocation errors.
+ */
+
+int FN(symmetric_rank_k_update)(int triangle, int transpose, index_t N, index_t K, REAL alpha, REAL *A, index_t lda,
+			    REAL beta, REAL *C, index_t ldc, int mirror);
+
+/**
+ * @brief Computes the Gram matrix A^T * A of a matrix A.
+ *
+ * The lower triangle is formed by symmetric_rank_k_update and mirrored, so the
+ * result is exactly symmetric and can be passed to Cholesky_decomposition or
+ * LDLT_decomposition as is.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in matrix A (must be positive).
+ * @param columns Number of columns in matrix A (must be positive).
+ *
+ * @return Pointer to the resulting matrix (size: columns x columns) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(gram_matrix)(REAL *A, index_t rows, index_t columns);
+
+/* strassen_matrix_product.c */
+
+/**
+ * @brief Computes the product of two matrices P and Q with the Strassen-Winograd algorithm.
+ *
+ * This function calculates the matrix product C = P * Q with the Winograd variant of
+ * Strassen's algorithm (7 recursive products and 15 additions per level). The seven
+ * subproducts of the first levels run as OpenMP tasks. Below the cutoff the blocked
+ * GEMM engine takes over. Odd and non-power-of-two dimensions are handled by peeling
+ * the last row or column at each level instead of padding.
+ *
+ * The error is bounded normwise rather than componentwise: for n x n matrices and a
+ * cutoff n0, the computed product satisfies (Higham, Accuracy and Stability of
+ * Numerical Algorithms, §23.2.2)
+ *   max|C - Ĉ| <= [ (n / n0)^log2(18) (n0² + 6 n0) - 6 n ] u max|P| max|Q| + O(u²),
+ * where u is the unit roundoff, i.e. about (n / n0)^4.17 n0² u instead of n u for the
+ * conventional product. Small elements of C may therefore lose relative accuracy;
+ * a larger cutoff tightens the bound.
+ *
+ * @param P Pointer to the first input matrix (size: P_rows x P_columns).
+ * @param P_rows Number of rows in matrix P (must be positive).
+ * @param P_columns Number of columns in matrix P (must equal Q_rows).
+ * @param Q Pointer to the second input matrix (size: Q_rows x Q_columns).
+ * @param Q_rows Number of rows in matrix Q (must equal P_columns).
+ * @param Q_columns Number of columns in matrix Q (must be positive).
+ * @param cutoff Dimension under which the recursion stops and the blocked engine is used
+ *        (0 selects STRASSEN_DEFAULT_CUTOFF, otherwise must be at least 2).
+ *
+ * @return Pointer to the resulting matrix (size: P_rows x Q_columns) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(strassen_matrix_product)(REAL *P, index_t P_rows, index_t P_columns, REAL *Q, index_t Q_rows, index_t Q_columns, index_t cutoff);
+
+/**
+ * @brief Computes the product of two matrices P and Q with Strassen-Winograd into a caller-provided matrix.
+ *
+ * Same as strassen_matrix_product, without allocating the result (the recursion
+ * still allocates its temporaries). C must not overlap P or Q.
+ *
+ * @param P Pointer to the first input matrix (size: P_rows x P_columns).
+ * @param P_rows Number of rows in matrix P (must be positive).
+ * @param P_columns Number of columns in matrix P (must equal Q_rows).
+ * @param Q Pointer to the second input matrix (size: Q_rows x Q_columns).
+ * @param Q_rows Number of rows in matrix Q (must equal P_columns).
+ * @param Q_columns Number of columns in matrix Q (must be positive).
+ * @param cutoff Dimension under which the recursion stops and the blocked engine is used
+ *        (0 selects STRASSEN_DEFAULT_CUTOFF, otherwise must be at least 2).
+ * @param C Pointer to the output matrix (size: P_rows x Q_columns).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         aliased output, or memory allocation errors.
+ */
+
+int FN(strassen_matrix_product_into)(REAL *P, index_t P_rows, index_t P_columns, REAL *Q, index_t Q_rows, index_t Q_columns, index_t cutoff, REAL *C);
+
+/* batched_matrix_product.c */
+
+/**
+ * @brief Computes a batch of matrix products C[b] = P[b] * Q[b] given as arrays of pointers.
+ *
+ * All the products of the batch share the same dimensions, which are validated
+ * once for the whole batch. Square products of size 4, 8, 16 and 32 run
+ * size-specialized kernels, other products up to 32 x 32 an unpacked kernel,
+ * and bigger ones the blocked engine. The batch is spread across OpenMP threads.
+ * A C[b] overlapping P[b] or Q[b] is rejected. Overlaps between C[b] and the
+ * operands of the other products of the batch are not checked and are undefined behaviour.
+ *
+ * @param P Array of batch pointers to the first matrices (size: P_rows x P_columns each).
+ * @param P_rows Number of rows of the matrices P[b] (must be positive).
+ * @param P_columns Number of columns of the matrices P[b] (must equal Q_rows).
+ * @param Q Array of batch pointers to the second matrices (size: Q_rows x Q_columns each).
+ * @param Q_rows Number of rows of the matrices Q[b] (must equal P_columns).
+ * @param Q_columns Number of columns of the matrices Q[b] (must be positive).
+ * @param C Array of batch pointers to the output matrices (size: P_rows x Q_columns each).
+ * @param batch Number of products (must be non-negative).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         aliased outputs, or memory allocation errors.
+ */
+
+int FN(batched_matrix_product)(REAL **P, index_t P_rows, index_t P_columns, REAL **Q, index_t Q_rows, index_t Q_columns, REAL **C, index_t batch);
+
+/**
+ * @brief Computes a batch of matrix products C[b] = P[b] * Q[b] stored at constant strides.
+ *
+ * Matrix b of each operand starts b * stride elements after its base pointer.
+ * A stride of 0 for P or Q reuses the same matrix for the whole batch. Kernels
+ * and parallelisation are the same as batched_matrix_product.
+ *
+ * @param P Pointer to the first matrix of the batch (size: P_rows x P_columns each).
+ * @param P_rows Number of rows of the matrices P[b] (must be positive).
+ * @param P_columns Number of columns of the matrices P[b] (must equal Q_rows).
+ * @param P_stride Distance in elements between two consecutive matrices P[b].
+ * @param Q Pointer to the second matrix of the batch (size: Q_rows x Q_columns each).
+ * @param Q_rows Number of rows of the matrices Q[b] (must equal P_columns).
+ * @param Q_columns Number of columns of the matrices Q[b] (must be positive).
+ * @param Q_stride Distance in elements between two consecutive matrices Q[b].
+ * @param C Pointer to the first output matrix (size: P_rows x Q_columns each).
+ * @param C_stride Distance in elements between two consecutive matrices C[b]
+ *        (must be at least P_rows x Q_columns).
+ * @param batch Number of products (must be non-negative).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions or strides, null pointers,
+ *         or memory allocation errors.
+ */
+
+int FN(strided_batched_matrix_product)(REAL *P, index_t P_rows, index_t P_columns, size_t P_stride,
+				   REAL *Q, index_t Q_rows, index_t Q_columns, size_t Q_stride,
+				   REAL *C, size_t C_stride, index_t batch);
+
+/* sequential_vector_matrix_product.c */
+
+/**
+ * @brief Computes the product of a matrix A and a vector X sequentially.
+ *
+ * This function calculates the vector result = A * X, where A is a matrix
+ * and X is a vector. The computation is performed sequentially without parallelization.
+ *
+ * @param A Pointer to the input matrix (size: A_rows x A_columns).
+ * @param A_rows Number of rows in the matrix A (must be positive).
+ * @param A_columns Number of columns in the matrix A (must equal dimension).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal A_columns).
+ *
+ * @return Pointer to the resulting vector (size: A_rows) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(sequential_vector_matrix_product)(REAL *A, index_t A_rows, index_t A_columns, REAL *X, index_t dimension); 
+
+/**
+ * @brief Computes the product of a matrix A and a vector X sequentially into a caller-provided vector.
+ *
+ * Same as sequential_vector_matrix_product, without allocating the result. Y must not overlap A or X.
+ *
+ * @param A Pointer to the input matrix (size: A_rows x A_columns).
+ * @param A_rows Number of rows in the matrix A (must be positive).
+ * @param A_columns Number of columns in the matrix A (must equal dimension).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal A_columns).
+ * @param Y Pointer to the output vector (size: A_rows).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers or aliased output.
+ */
+
+int FN(sequential_vector_matrix_product_into)(REAL *A, index_t A_rows, index_t A_columns, REAL *X, index_t dimension, REAL *Y);
+
+/**
+ * @brief Computes the products of a matrix A with several vectors sequentially, reading A once.
+ *
+ * This function calculates Y_v = A * X_v for v = 0, ..., vectors - 1.
+ * Applying A to all the vectors in one pass costs about the memory traffic of a
+ * single matrix-vector product, which is what bounds iterative methods on large matrices.
+ *
+ * @param A Pointer to the input matrix (size: A_rows x A_columns).
+ * @param A_rows Number of rows in the matrix A (must be positive).
+ * @param A_columns Number of columns in the matrix A (must equal dimension).
+ * @param X Pointer to the input vectors, stored one after the other (size: vectors x dimension).
+ * @param dimension Dimension of each vector X_v (must equal A_columns).
+ * @param vectors Number of vectors (must be positive).
+ * @param Y Pointer to the output vectors, stored one after the other (size: vectors x A_rows).
+ *         Y must not overlap A or X.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers or aliased output.
+ */
+
+int FN(sequential_multi_vector_matrix_product)(REAL *A, index_t A_rows, index_t A_columns, REAL *X, index_t dimension,
+                                              index_t vectors, REAL *Y);
+
+/**
+ * @brief Computes the product of the transpose of a matrix A and a vector X sequentially.
+ *
+ * This function calculates the vector result = A^T * X (equivalently X^T * A) without
+ * forming the transpose: the rows of A are accumulated in the order they are stored.
+ *
+ * @param A Pointer to the input matrix (size: A_rows x A_columns).
+ * @param A_rows Number of rows in the matrix A (must equal dimension).
+ * @param A_columns Number of columns in the matrix A (must be positive).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal A_rows).
+ *
+ * @return Pointer to the resulting vector (size: A_columns) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(sequential_transposed_vector_matrix_product)(REAL *A, index_t A_rows, index_t A_columns, REAL *X, index_t dimension);
+
+/**
+ * @brief Computes the product of the transpose of a matrix A and a vector X sequentially into a caller-provided vector.
+ *
+ * Same as sequential_transposed_vector_matrix_product, without allocating the result. Y must not overlap A or X.
+ *
+ * @param A Pointer to the input matrix (size: A_rows x A_columns).
+ * @param A_rows Number of rows in the matrix A (must equal dimension).
+ * @param A_columns Number of columns in the matrix A (must be positive).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal A_rows).
+ * @param Y Pointer to the output vector (size: A_columns).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers, aliased output.
+ */
+
+int FN(sequential_transposed_vector_matrix_product_into)(REAL *A, index_t A_rows, index_t A_columns, REAL *X, index_t dimension, REAL *Y);
+
+/* parallel_vector_matrix_product.c */
+
+/**
+ * @brief Computes the product of a matrix A and a vector X in parallel using OpenMP.
+ *
+ * This function calculates the vector result = A * X, where A is a matrix
+ * and X is a vector. The computation is parallelized using OpenMP to improve performance.
+ *
+ * @param A Pointer to the input matrix (size: A_rows x A_columns).
+ * @param A_rows Number of rows in the matrix A (must be positive).
+ * @param A_columns Number of columns in the matrix A (must equal dimension).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal A_columns).
+ *
+ * @return Pointer to the resulting vector (size: A_rows) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(parallel_vector_matrix_product)(REAL *A, index_t A_rows, index_t A_columns, REAL *X, index_t dimension);
+
+/**
+ * @brief Computes the product of a matrix A and a vector X in parallel using OpenMP into a caller-provided vector.
+ *
+ * Same as parallel_vector_matrix_product, without allocating the result. Y must not overlap A or X.
+ *
+ * @param A Pointer to the input matrix (size: A_rows x A_columns).
+ * @param A_rows Number of rows in the matrix A (must be positive).
+ * @param A_columns Number of columns in the matrix A (must equal dimension).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal A_columns).
+ * @param Y Pointer to the output vector (size: A_rows).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers or aliased output.
+ */
+
+int FN(parallel_vector_matrix_product_into)(REAL *A, index_t A_rows, index_t A_columns, REAL *X, index_t dimension, REAL *Y);
+
+/**
+ * @brief Computes the products of a matrix A with several vectors in parallel, reading A once.
+ *
+ * This function calculates Y_v = A * X_v for v = 0, ..., vectors - 1.
+ * The rows of A are split in contiguous ranges between the threads, and each
+ * thread applies its range to all the vectors while it is streamed once.
+ *
+ * @param A Pointer to the input matrix (size: A_rows x A_columns).
+ * @param A_rows Number of rows in the matrix A (must be positive).
+ * @param A_columns Number of columns in the matrix A (must equal dimension).
+ * @param X Pointer to the input vectors, stored one after the other (size: vectors x dimension).
+ * @param dimension Dimension of each vector X_v (must equal A_columns).
+ * @param vectors Number of vectors (must be positive).
+ * @param Y Pointer to the output vectors, stored one after the other (size: vectors x A_rows).
+ *         Y must not overlap A or X.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers or aliased output.
+ */
+
+int FN(parallel_multi_vector_matrix_product)(REAL *A, index_t A_rows, index_t A_columns, REAL *X, index_t dimension,
+                                            index_t vectors, REAL *Y);
+
+/**
+ * @brief Computes the product of the transpose of a matrix A and a vector X in parallel using OpenMP.
+ *
+ * This function calculates the vector result = A^T * X (equivalently X^T * A) without
+ * forming the transpose: the rows of A are accumulated in the order they are stored.
+ * Each thread accumulates a contiguous range of rows into its own partial vector,
+ * and the partial vectors are summed at the end.
+ *
+ * @param A Pointer to the input matrix (size: A_rows x A_columns).
+ * @param A_rows Number of rows in the matrix A (must equal dimension).
+ * @param A_columns Number of columns in the matrix A (must be positive).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal A_rows).
+ *
+ * @return Pointer to the resulting vector (size: A_columns) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(parallel_transposed_vector_matrix_product)(REAL *A, index_t A_rows, index_t A_columns, REAL *X, index_t dimension);
+
+/**
+ * @brief Computes the product of the transpose of a matrix A and a vector X in parallel using OpenMP into a caller-provided vector.
+ *
+ * Same as parallel_transposed_vector_matrix_product, without allocating the result. Y must not overlap A or X.
+ *
+ * @param A Pointer to the input matrix (size: A_rows x A_columns).
+ * @param A_rows Number of rows in the matrix A (must equal dimension).
+ * @param A_columns Number of columns in the matrix A (must be positive).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal A_rows).
+ * @param Y Pointer to the output vector (size: A_columns).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers, aliased output, or memory allocation errors.
+ */
+
+int FN(parallel_transposed_vector_matrix_product_into)(REAL *A, index_t A_rows, index_t A_columns, REAL *X, index_t dimension, REAL *Y);
+
+/* parallel_matrix_product.c */
+
+/**
+ * @brief Computes the product of two matrices P and Q in parallel using OpenMP.
+ *
+ * This function calculates the matrix product C = P * Q using parallelization
+ * to improve performance. The resulting matrix is split into 2D tiles of cache-sized
+ * blocks that a single team of threads shares out dynamically (see
+ * parallel_general_matrix_product); each thread runs the packed GEMM engine on its
+ * tiles with its own packing buffers, so there is no nested parallel region and no
+ * shared accumulator.
+ *
+ * @param P Pointer to the first input matrix (size: P_rows x P_columns).
+ * @param P_rows Number of rows in matrix P (must be positive).
+ * @param P_columns Number of columns in matrix P (must equal Q_rows).
+ * @param Q Pointer to the second input matrix (size: Q_rows x Q_columns).
+ * @param Q_rows Number of rows in matrix Q (must equal P_columns).
+ * @param Q_columns Number of columns in matrix Q (must be positive).
+ *
+ * @return Pointer to the resulting matrix (size: P_rows x Q_columns) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(parallel_matrix_product)(REAL *P, index_t P_rows, index_t P_columns, REAL *Q, index_t Q_rows, index_t Q_columns);
+
+/**
+ * @brief Computes the product of two matrices P and Q in parallel into a caller-provided matrix.
+ *
+ * Same as parallel_matrix_product, without allocating the result. C must not
+ * overlap P or Q.
+ *
+ * @param P Pointer to the first input matrix (size: P_rows x P_columns).
+ * @param P_rows Number of rows in matrix P (must be positive).
+ * @param P_columns Number of columns in matrix P (must equal Q_rows).
+ * @param Q Pointer to the second input matrix (size: Q_rows x Q_columns).
+ * @param Q_rows Number of rows in matrix Q (must equal P_columns).
+ * @param Q_columns Number of columns in matrix Q (must be positive).
+ * @param C Pointer to the output matrix (size: P_rows x Q_columns).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         aliased output, or memory allocation errors.
+ */
+
+int FN(parallel_matrix_product_into)(REAL *P, index_t P_rows, index_t P_columns, REAL *Q, index_t Q_rows, index_t Q_columns, REAL *C);
+
+/* vector_operations.c */
+
+/**
+ * @brief Computes the element-wise addition of two vectors X and Y.
+ *
+ * This function calculates the vector result = X + Y, where X and Y are vectors
+ * of the same dimension.
+ *
+ * @param X Pointer to the first input vector (size: dimension).
+ * @param Y Pointer to the second input vector (size: dimension).
+ * @param dimension Dimension of the vectors (must be positive).
+ *
+ * @return Pointer to the resulting vector on success, or NULL on failure due to invalid dimension,
+ *         null pointers, or memory allocation errors.
+ */
+
+REAL *FN(vectors_addition)(REAL *X, REAL *Y, index_t dimension);
+
+/**
+ * @brief Computes the element-wise addition of two vectors X and Y into a caller-provided vector.
+ *
+ * Same as vectors_addition, without allocating the result. Z may be X or Y
+ * (in-place addition).
+ *
+ * @param X Pointer to the first input vector (size: dimension).
+ * @param Y Pointer to the second input vector (size: dimension).
+ * @param dimension Dimension of the vectors (must be positive).
+ * @param Z Pointer to the output vector (size: dimension).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimension or null pointers.
+ */
+
+int FN(vectors_addition_into)(REAL *X, REAL *Y, index_t dimension, REAL *Z);
+
+/**
+ * @brief Computes the element-wise product of two vectors X and Y.
+ *
+ * This function calculates the vector result = X .* Y, where .* denotes
+ * element-wise multiplication.
+ *
+ * @param X Pointer to the first input vector (size: dimension).
+ * @param Y Pointer to the second input vector (size: dimension).
+ * @param dimension Dimension of the vectors (must be positive).
+ *
+ * @return Pointer to the resulting vector on success, or NULL on failure due to invalid dimension,
+ *         null pointers, or memory allocation errors.
+ */
+
+REAL *FN(scalar_product)(REAL *X, REAL *Y, index_t dimension);
+
+/**
+ * @brief Computes the element-wise product of two vectors X and Y into a caller-provided vector.
+ *
+ * Same as scalar_product, without allocating the result. Z may be X or Y
+ * (in-place product).
+ *
+ * @param X Pointer to the first input vector (size: dimension).
+ * @param Y Pointer to the second input vector (size: dimension).
+ * @param dimension Dimension of the vectors (must be positive).
+ * @param Z Pointer to the output vector (size: dimension).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimension or null pointers.
+ */
+
+int FN(scalar_product_into)(REAL *X, REAL *Y, index_t dimension, REAL *Z);
+
+/**
+ * @brief Computes the cross product of two 3-dimensional vectors X and Y.
+ *
+ * This function calculates the vector result = X x Y, where x denotes
+ * the cross product. It assumes that both input vectors are 3-dimensional.
+ *
+ * @param X Pointer to the first input vector (size: 3).
+ * @param Y Pointer to the second input vector (size: 3).
+ *
+ * @return Pointer to the resulting vector (size: 3) on success, or NULL on failure due to null pointers
+ *         or memory allocation errors.
+ */
+
+REAL *FN(vector_product)(REAL *X, REAL *Y);
+
+/**
+ * @brief Computes the cross product of two 3-dimensional vectors X and Y into a caller-provided vector.
+ *
+ * Same as vector_product, without allocating the result. Z may be X or Y.
+ *
+ * @param X Pointer to the first input vector (size: 3).
+ * @param Y Pointer to the second input vector (size: 3).
+ * @param Z Pointer to the output vector (size: 3).
+ *
+ * @return 0 on success, or -1 on failure due to null pointers.
+ */
+
+int FN(vector_product_into)(REAL *X, REAL *Y, REAL *Z);
+
+/**
+ * @brief Computes the Euclidean norm (length) of a given vector X.
+ *
+ * This function calculates the norm ||X|| = sqrt(X_1^2 + X_2^2 + ... + X_n^2),
+ * where n is the dimension of the vector.
+ *
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector (must be positive).
+ *
+ * @return The Euclidean norm of the vector on success, or -1.0 on failure due to invalid dimension
+ *         or null pointers.
+ */
+
+REAL FN(vector_norm)(REAL *X, index_t dimension);
+
+/* matrix_operations.c */
+
+/**
+ * @brief Adds two matrices A and B of the same size (rows x columns).
+ *
+ * This function computes the element-wise sum of two matrices A and B
+ * and stores the result in a new matrix.
+ *
+ * @param A Pointer to the first input matrix (size: rows x columns).
+ * @param B Pointer to the second input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrices (must be positive).
+ * @param columns Number of columns in the matrices (must be positive).
+ *
+ * @return Pointer to the resulting matrix on success, or NULL on failure due to invalid dimensions,
+ *         null pointers, or memory allocation errors.
+ */
+
+REAL *FN(matrices_addition)(REAL *A, REAL *B, index_t rows, index_t columns);
+
+/**
+ * @brief Adds two matrices A and B of the same size into a caller-provided matrix.
+ *
+ * Same as matrices_addition, without allocating the result. C may be A or B
+ * (in-place addition).
+ *
+ * @param A Pointer to the first input matrix (size: rows x columns).
+ * @param B Pointer to the second input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrices (must be positive).
+ * @param columns Number of columns in the matrices (must be positive).
+ * @param C Pointer to the output matrix (size: rows x columns).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions or null pointers.
+ */
+
+int FN(matrices_addition_into)(REAL *A, REAL *B, index_t rows, index_t columns, REAL *C);
+
+/**
+ * @brief Multiplies a matrix A by a scalar value.
+ *
+ * This function multiplies each element of a matrix A by a given scalar value
+ * and stores the result in a new matrix.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive).
+ * @param scalar Scalar value to multiply each element by.
+ *
+ * @return Pointer to the resulting matrix on success, or NULL on failure due to invalid dimensions,
+ *         null pointers, or memory allocation errors.
+ */
+
+REAL *FN(matrix_scalar_multiplication)(REAL *A, index_t rows, index_t columns, int scalar);
+
+/**
+ * @brief Multiplies a matrix A by a scalar value into a caller-provided matrix.
+ *
+ * Same as matrix_scalar_multiplication, without allocating the result. C may
+ * be A (in-place scaling).
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive).
+ * @param scalar Scalar value to multiply each element by.
+ * @param C Pointer to the output matrix (size: rows x columns).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions or null pointers.
+ */
+
+int FN(matrix_scalar_multiplication_into)(REAL *A, index_t rows, index_t columns, int scalar, REAL *C);
+
+/**
+ * @brief Computes the transpose of a given matrix A.
+ *
+ * This function creates a new matrix that is the transpose of the input matrix A.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the input matrix (must be positive).
+ * @param columns Number of columns in the input matrix (must be positive).
+ *
+ * @return Pointer to the transposed matrix on success, or NULL on failure due to invalid dimensions,
+ *         null pointers, or memory allocation errors.
+ */
+
+REAL *FN(matrix_transpose)(REAL *A, index_t rows, index_t columns);
+
+/**
+ * @brief Computes the transpose of a given matrix A into a caller-provided matrix.
+ *
+ * Same as matrix_transpose, without allocating the result. C may be A only when
+ * the matrix is square (in-place transpose); otherwise C must not overlap A.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the input matrix (must be positive).
+ * @param columns Number of columns in the input matrix (must be positive).
+ * @param C Pointer to the output matrix (size: columns x rows).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers or aliased output.
+ */
+
+int FN(matrix_transpose_into)(REAL *A, index_t rows, index_t columns, REAL *C);
+
+/**
+ * @brief Computes the trace of a square matrix A.
+ *
+ * The trace is defined as the sum of the diagonal elements of a square matrix.
+ *
+ * @param A Pointer to the input square matrix (size: dimension x dimension).
+ * @param dimension Dimension of the square matrix (must be positive).
+ *
+ * @return The trace of the matrix on success, or -1.0 on failure due to invalid dimensions
+ *         or null pointers.
+ */
+
+REAL FN(matrix_trace)(REAL *A, index_t dimension);
+
+/**
+ * @brief Computes the 1-norm of a given matrix A.
+ *
+ * The 1-norm is defined as the maximum absolute column sum of a matrix.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the input matrix (must be positive).
+ * @param columns Number of columns in the input matrix (must be positive).
+ *
+ * @return The 1-norm of the matrix on success, or -1.0 on failure due to invalid dimensions,
+ *         null pointers, or memory allocation errors during transposition.
+ */
+
+REAL FN(matrix_norm)(REAL *A, index_t rows, index_t columns);
+
+/**
+ * @brief Computes the Frobenius norm of a given matrix A.
+ *
+ * The Frobenius norm is defined as the square root of the sum of squares
+ * of all elements in a matrix.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the input matrix (must be positive).
+ * @param columns Number of columns in the input matrix (must be positive).
+ *
+ * @return The Frobenius norm of the matrix on success, or -1.0 on failure due to invalid dimensions
+ *         or null pointers.
+ */
+
+REAL FN(frobenius_norm)(REAL *A, index_t rows, index_t columns);
+
+/**
+ * @brief Computes the determinant of a square matrix A using LU decomposition.
+ *
+ * This function calculates the determinant by performing LU decomposition with partial
+ * pivoting into a single compact L\U matrix and multiplying the diagonal elements of U,
+ * with one sign change per row interchange. It checks for singularity during computation.
+ *
+ * @param A Pointer to the input square matrix (size: rows x rows).
+ * @param rows Number of rows in the square matrix (must equal columns and be positive).
+ * @param columns Number of columns in the square matrix (must equal rows and be positive).
+ *
+ * @return The determinant of the matrix on success, or -1.0 on failure due to invalid dimensions,
+ *         null pointers, singularity detection, or LU decomposition failure.
+ */
+
+REAL FN(matrix_determinant)(REAL *A, index_t rows, index_t columns);
+
+/**
+ * @brief Computes the eigenvalues of a square matrix.
+ *
+ * This function reduces a copy of A to upper Hessenberg form once, then runs Francis
+ * double-shift QR steps in O(n^2) each, splitting the active window of the iteration
+ * wherever a subdiagonal element becomes negligible. Complex-conjugate pairs are
+ * represented here by their common real part; matrix_eigenvalues_into also returns
+ * the imaginary parts.
+ *
+ * @param A Pointer to the input square matrix (size: rows x columns).
+ * @param rows Number of rows in the input matrix (must be positive).
+ * @param columns Number of columns in the input matrix (must be positive).
+ * @param max_iter Maximum number of QR steps spent on one eigenvalue or pair (must be positive).
+ * @param tol Relative tolerance under which a subdiagonal element is negligible (must be positive,
+ *            machine epsilon is used when smaller).
+ *
+ * @return Pointer to an array containing the real parts of the eigenvalues on success, or NULL on failure
+ *         due to invalid dimensions, null pointers, memory allocation errors, or lack of convergence
+ *         within max_iter steps.
+ */
+
+REAL *FN(matrix_eigenvalues)(REAL *A, index_t rows, index_t columns, int max_iter, REAL tol);
+
+/**
+ * @brief Computes the eigenvalues of a square matrix into caller-provided vectors.
+ *
+ * Eigenvalue k is real[k] + i imaginary[k]. A complex-conjugate pair occupies two
+ * consecutive entries, the one with the positive imaginary part first. The eigenvalues
+ * come in the order of the diagonal of the real Schur form of A. A is not modified.
+ *
+ * @param A Pointer to the input square matrix (size: rows x columns).
+ * @param rows Number of rows in the input matrix (must be positive).
+ * @param columns Number of columns in the input matrix (must be positive).
+ * @param max_iter Maximum number of QR steps spent on one eigenvalue or pair (must be positive).
+ * @param tol Relative tolerance under which a subdiagonal element is negligible (must be positive,
+ *            machine epsilon is used when smaller).
+ * @param real Pointer to the real parts of the eigenvalues (size: rows).
+ * @param imaginary Pointer to the imaginary parts of the eigenvalues (size: rows), or NULL.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers, memory allocation
+ *         errors, or lack of convergence within max_iter steps.
+ */
+
+int FN(matrix_eigenvalues_into)(REAL *A, index_t rows, index_t columns, int max_iter, REAL tol, REAL *real, REAL *imaginary);
+
+/**
+ * @brief Solves a lower triangular system Lc = b using forward substitution.
+ *
+ * This function computes the solution vector c such that Lc = b for a lower triangular matrix L.
+ *
+ * @param L Pointer to the lower triangular matrix (size: d x d).
+ * @param d Dimension of the square matrix L and vector b (must be positive).
+ * @param b Pointer to the right-hand side vector b (size: d).
+ *
+ * @return Pointer to the solution vector c on success, or NULL on failure due to invalid dimensions,
+ *         null pointers, singular matrix detection, or memory allocation errors.
+ */
+
+REAL *FN(forward_substitution)(REAL *L, index_t d, REAL *b);
+
+/**
+ * @brief Solves a lower triangular system Lc = b using forward substitution into a caller-provided vector.
+ *
+ * Same as forward_substitution, without allocating the solution. c may be b
+ * (the right-hand side is overwritten by the solution).
+ *
+ * @param L Pointer to the lower triangular matrix (size: d x d).
+ * @param d Dimension of the square matrix L and vector b (must be positive).
+ * @param b Pointer to the right-hand side vector b (size: d).
+ * @param c Pointer to the solution vector c (size: d).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers
+ *         or singular matrix detection.
+ */
+
+int FN(forward_substitution_into)(REAL *L, index_t d, REAL *b, REAL *c);
+
+/**
+ * @brief Solves an upper triangular system Ux = c using backward substitution.
+ *
+ * This function computes the solution vector x such that Ux = c for an upper triangular matrix U.
+ *
+ * @param U Pointer to the upper triangular matrix (size: d x d).
+ * @param d Dimension of the square matrix U and vector c (must be positive).
+ * @param c Pointer to the right-hand side vector c (size: d).
+ *
+ * @return Pointer to the solution vector x on success, or NULL on failure due to invalid dimensions,
+ *         null pointers, singular matrix detection, or memory allocation errors.
+ */
+
+REAL *FN(backward_substitution)(REAL *U, index_t d, REAL *c);
+
+/**
+ * @brief Solves an upper triangular system Ux = c using backward substitution into a caller-provided vector.
+ *
+ * Same as backward_substitution, without allocating the solution. x may be c
+ * (the right-hand side is overwritten by the solution).
+ *
+ * @param U Pointer to the upper triangular matrix (size: d x d).
+ * @param d Dimension of the square matrix U and vector c (must be positive).
+ * @param c Pointer to the right-hand side vector c (size: d).
+ * @param x Pointer to the solution vector x (size: d).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers
+ *         or singular matrix detection.
+ */
+
+int FN(backward_substitution_into)(REAL *U, index_t d, REAL *c, REAL *x);
+
+/**
+ * @brief Solves a linear system Ax = b using LU decomposition.
+ *
+ * This function computes the solution vector x for a square matrix A and right-hand side vector b
+ * by performing LU decomposition with partial pivoting (P A = L U) and solving Ly = Pb followed by Ux = y.
+ *
+ * @param A Pointer to the square matrix A (size: d x d).
+ * @param b Pointer to the right-hand side vector b (size: d).
+ * @param d Dimension of the square matrix A and vector b (must be positive).
+ *
+ * @return Pointer to the solution vector x on success, or NULL on failure due to invalid dimensions,
+ *         null pointers, LU decomposition failure, or memory allocation errors.
+ */
+
+REAL *FN(solve_LU_system)(REAL *A, REAL *b, index_t d);
+
+/**
+ * @brief Solves a linear system Ax = b using LU decomposition into a caller-provided vector.
+ *
+ * Same as solve_LU_system, without allocating the solution: A is factored into a
+ * single compact L\U matrix (see LU_factorization_into) and both triangular solves
+ * run in x. x may be b (the right-hand side is overwritten by the solution).
+ *
+ * @param A Pointer to the square matrix A (size: d x d).
+ * @param b Pointer to the right-hand side vector b (size: d).
+ * @param d Dimension of the square matrix A and vector b (must be positive).
+ * @param x Pointer to the solution vector x (size: d).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         aliased output or LU decomposition failure.
+ */
+
+int FN(solve_LU_system_into)(REAL *A, REAL *b, index_t d, REAL *x);
+
+/**
+ * @brief Computes the inverse of a square matrix A using LU decomposition.
+ *
+ * This function calculates the inverse of a square matrix A by solving multiple systems
+ * Ax_i = e_i, where e_i are columns of the identity matrix. The result is stored in a new matrix.
+ *
+ * @param A Pointer to the square matrix A (size: d x d).
+ * @param d Dimension of the square matrix A (must be positive).
+ *
+ * @return Pointer to the inverse matrix on success, or NULL on failure due to invalid dimensions,
+ *         null pointers, LU decomposition failure, or memory allocation errors.
+ */
+
+REAL *FN(matrix_inverse)(REAL *A, index_t n);
+
+/**
+ * @brief Computes the inverse of a square matrix A using LU decomposition into a caller-provided matrix.
+ *
+ * Same as matrix_inverse, without allocating the result: A is factored into a
+ * single compact L\U matrix (see LU_factorization_into), from which all the columns
+ * of the inverse are solved at once. inverse may be A (in-place inversion), since A
+ * is no longer read once factored.
+ *
+ * @param A Pointer to the square matrix A (size: d x d).
+ * @param d Dimension of the square matrix A (must be positive).
+ * @param inverse Pointer to the output matrix (size: d x d).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         LU decomposition failure or memory allocation errors.
+ */
+
+int FN(matrix_inverse_into)(REAL *A, index_t d, REAL *inverse);
+
+/**
+ * @brief Checks if a square matrix H has converged based on a given tolerance.
+ *
+ * This function verifies whether all elements below the main diagonal are smaller than
+ * a specified tolerance value. It assumes H is a square matrix.
+ *
+ * @param H Pointer to the square matrix (size: n x n).
+ * @param n Dimension of the square matrix (must be positive).
+ * @param tol Tolerance for convergence check (must be positive).
+ *
+ * @return 1 if converged, 0 if not converged, or -1 on failure due to invalid dimensions,
+ *         null pointers, or invalid tolerance values.
+ */
+
+int FN(has_converged)(REAL *H, index_t n, REAL tol);
+
+/* LU_decomposition.c */
+
+/**
+ * @brief Allocates and initializes an LU decomposition structure.
+ *
+ * This function creates an LU decomposition structure for a given matrix A
+ * and initializes its components (L, U, pivots and A).
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive).
+ *
+ * @return Pointer to the LU structure containing L, U, pivots and A on success,
+ *         or NULL on failure due to invalid dimensions or memory allocation errors.
+ */
+
+FN(LU) *FN(create_LU)(REAL *A, index_t rows, index_t columns);
+
+/**
+ * @brief Performs LU decomposition with partial pivoting on a given matrix.
+ *
+ * This function decomposes a matrix A into a unit lower triangular matrix L and an
+ * upper triangular matrix U such that P A = L U, where the permutation P is given by
+ * the pivots of the structure. The factorization is blocked: each panel of columns is
+ * factored with partial pivoting, and the rest of the matrix is updated by a
+ * triangular solve and a matrix product run by the packed GEMM engine.
+ *
+ * A singular matrix is factored as well, with zeros on the diagonal of U.
+ * For a rectangular matrix, L is rows x min(rows, columns) and U is min(rows, columns)
+ * x columns, both stored in the top-left part of their rows x columns array.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive).
+ *
+ * @return Pointer to the LU structure containing L, U and pivots on success,
+ *         or NULL on failure due to invalid dimensions or memory allocation errors.
+ */
+
+FN(LU) *FN(LU_decomposition)(REAL *A, index_t rows, index_t columns);
+
+/**
+ * @brief Performs parallelized LU decomposition with partial pivoting on a given matrix using OpenMP.
+ *
+ * Same as LU_decomposition, run as a graph of OpenMP tasks over blocks of columns:
+ * the factorization of each panel depends only on the update of its own block by
+ * the previous panel, so panels and updates of successive steps overlap instead of
+ * being separated by barriers.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive).
+ *
+ * @return Pointer to the LU structure containing L, U and pivots on success,
+ *         or NULL on failure due to invalid dimensions or memory allocation errors.
+ */
+
+FN(LU) *FN(LU_decomposition_parallel)(REAL *A, index_t rows, index_t columns);
+
+/**
+ * @brief Frees all memory associated with an LU decomposition structure.
+ *
+ * This function releases the memory allocated for the matrices L, U, and A,
+ * the pivots, as well as the LU structure itself.
+ *
+ * @param LU_decomposition Pointer to the LU structure to free.
+ */
+
+void FN(LU_free)(FN(LU) *LU_decomposition);
+
+/**
+ * @brief Performs LU decomposition with partial pivoting into a single caller-provided matrix.
+ *
+ * This function computes P A = L U like LU_decomposition, in the compact storage of
+ * LAPACK: the multipliers of the unit lower triangular L are stored below the diagonal
+ * of LU and U on and above it, with the unit diagonal of L implied. Row i was interchanged
+ * with row pivots[i] at step i. LU may be A, which is then factored in place and no other
+ * matrix is allocated. The factors are read directly by solve_LU_factored_system,
+ * LU_factored_determinant and LU_factored_inverse.
+ *
+ * A singular matrix is factored as well, with zeros on the diagonal of U.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive).
+ * @param LU Pointer to the output factors (size: rows x columns), may be A.
+ * @param pivots Pointer to the row interchanges (size: min(rows, columns)).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         partially overlapping output or memory allocation errors.
+ */
+
+int FN(LU_factorization_into)(REAL *A, index_t rows, index_t columns, REAL *LU, index_t *pivots);
+
+/**
+ * @brief Performs parallelized LU decomposition with partial pivoting into a single caller-provided matrix using OpenMP.
+ *
+ * Same as LU_factorization_into, with the tasks of LU_decomposition_parallel.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive).
+ * @param LU Pointer to the output factors (size: rows x columns), may be A.
+ * @param pivots Pointer to the row interchanges (size: min(rows, columns)).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         partially overlapping output or memory allocation errors.
+ */
+
+int FN(LU_factorization_parallel_into)(REAL *A, index_t rows, index_t columns, REAL *LU, index_t *pivots);
+
+/**
+ * @brief Solves a linear system Ax = b from the compact LU factors of A.
+ *
+ * @param LU Pointer to the factors of the square matrix A returned by LU_factorization_into (size: d x d).
+ * @param pivots Pointer to the row interchanges returned by LU_factorization_into (size: d).
+ * @param d Dimension of the square matrix A and vector b (must be positive).
+ * @param b Pointer to the right-hand side vector b (size: d).
+ *
+ * @return Pointer to the solution vector x on success, or NULL on failure due to invalid dimensions,
+ *         null pointers, singular matrix detection or memory allocation errors.
+ */
+
+REAL *FN(solve_LU_factored_system)(const REAL *LU, const index_t *pivots, index_t d, REAL *b);
+
+/**
+ * @brief Solves a linear system Ax = b from the compact LU factors of A into a caller-provided vector.
+ *
+ * Solves L y = P b then U x = y in x, with dot products of the contiguous rows of LU.
+ * x may be b (the right-hand side is overwritten by the solution).
+ *
+ * @param LU Pointer to the factors of the square matrix A returned by LU_factorization_into (size: d x d).
+ * @param pivots Pointer to the row interchanges returned by LU_factorization_into (size: d).
+ * @param d Dimension of the square matrix A and vector b (must be positive).
+ * @param b Pointer to the right-hand side vector b (size: d).
+ * @param x Pointer to the solution vector x (size: d).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         aliased output or singular matrix detection.
+ */
+
+int FN(solve_LU_factored_system_into)(const REAL *LU, const index_t *pivots, index_t d, REAL *b, REAL *x);
+
+/**
+ * @brief Computes the determinant of a square matrix A from its compact LU factors.
+ *
+ * The determinant is the product of the diagonal of U, with one sign change per row
+ * interchange. A singular matrix gives a (nearly) zero determinant.
+ *
+ * @param LU Pointer to the factors of the square matrix A returned by LU_factorization_into (size: d x d).
+ * @param pivots Pointer to the row interchanges returned by LU_factorization_into (size: d).
+ * @param d Dimension of the square matrix A (must be positive).
+ *
+ * @return The determinant of the matrix on success, or -1.0 on failure due to invalid dimensions
+ *         or null pointers.
+ */
+
+REAL FN(LU_factored_determinant)(const REAL *LU, const index_t *pivots, index_t d);
+
+/**
+ * @brief Computes the inverse of a square matrix A from its compact LU factors.
+ *
+ * @param LU Pointer to the factors of the square matrix A returned by LU_factorization_into (size: d x d).
+ * @param pivots Pointer to the row interchanges returned by LU_factorization_into (size: d).
+ * @param d Dimension of the square matrix A (must be positive).
+ *
+ * @return Pointer to the inverse matrix on success, or NULL on failure due to invalid dimensions,
+ *         null pointers, singular matrix detection or memory allocation errors.
+ */
+
+REAL *FN(LU_factored_inverse)(const REAL *LU, const index_t *pivots, index_t d);
+
+/**
+ * @brief Computes the inverse of a square matrix A from its compact LU factors into a caller-provided matrix.
+ *
+ * The inverse is formed in place from the permuted identity P, by solving L U X = P for
+ * all its columns at once: both triangular solves combine whole rows of X, so that the
+ * kernels run on contiguous rows instead of one strided column at a time.
+ *
+ * @param LU Pointer to the factors of the square matrix A returned by LU_factorization_into (size: d x d).
+ * @param pivots Pointer to the row interchanges returned by LU_factorization_into (size: d).
+ * @param d Dimension of the square matrix A (must be positive).
+ * @param inverse Pointer to the output matrix (size: d x d), must not overlap LU.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         aliased output or singular matrix detection.
+ */
+
+int FN(LU_factored_inverse_into)(const REAL *LU, const index_t *pivots, index_t d, REAL *inverse);
+
+/* QR_decomposition.c */
+
+/**
+ * @brief Allocates and initializes a QR decomposition structure.
+ *
+ * This function creates a QR decomposition structure for a given matrix A
+ * and initializes its components (Q, R, and A).
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive).
+ *
+ * @return Pointer to the QR structure containing Q, R, and A matrices on success,
+ *         or NULL on failure due to invalid dimensions or memory allocation errors.
+ */
+
+FN(QR) *FN(create_QR)(REAL *A, index_t rows, index_t columns);
+
+/**
+ * @brief Performs QR decomposition on a given matrix using a blocked Householder QR.
+ *
+ * This function decomposes a matrix A into a matrix Q with orthonormal columns
+ * and an upper triangular matrix R with a nonnegative diagonal such that A = Q * R.
+ * Householder reflectors keep Q orthogonal to working precision; dependent columns
+ * give zeros on the diagonal of R instead of an error.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive and at most rows).
+ *
+ * @return Pointer to the QR structure containing Q and R matrices on success,
+ *         or NULL on failure due to invalid dimensions or memory allocation errors.
+ */
+
+FN(QR) *FN(QR_decomposition)(REAL *A, index_t rows, index_t columns);
+
+/**
+ * @brief Performs parallelized QR decomposition on a given matrix using OpenMP.
+ *
+ * This function decomposes a matrix A into a matrix Q with orthonormal columns
+ * and an upper triangular matrix R with a nonnegative diagonal such that A = Q * R.
+ * Each block reflector is applied to tiles of columns by all the threads of a single
+ * parallel region.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive and at most rows).
+ *
+ * @return Pointer to the QR structure containing Q and R matrices on success,
+ *         or NULL on failure due to invalid dimensions or memory allocation errors.
+ */
+
+FN(QR) *FN(QR_decomposition_parallel)(REAL *A, index_t rows, index_t columns);
+
+/**
+ * @brief Performs QR decomposition into a single caller-provided matrix, with Q kept implicit.
+ *
+ * This function computes A = Q R with the blocked Householder QR of QR_decomposition, in the
+ * compact storage of LAPACK: R is stored on and above the diagonal of QR and the Householder
+ * vectors v_j below it, with v_j[j] = 1 implied, so that Q = H_0 ... H_{s-1} with
+ * H_j = I - tau[j] v_j v_j^T and s = min(rows, columns). Q is never formed: QR_factored_apply_Q
+ * multiplies by Q or Q^T and QR_factored_form_Q forms it on request. QR may be A, which is
+ * then factored in place. The diagonal of R is not made nonnegative.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive).
+ * @param QR Pointer to the output factors (size: rows x columns), may be A.
+ * @param tau Pointer to the scalars of the reflectors (size: min(rows, columns)).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         partially overlapping output or memory allocation errors.
+ */
+
+int FN(QR_factorization_into)(REAL *A, index_t rows, index_t columns, REAL *QR, REAL *tau);
+
+/**
+ * @brief Performs parallelized QR decomposition into a single caller-provided matrix using OpenMP.
+ *
+ * Same as QR_factorization_into, with the block reflectors applied by all the threads
+ * as in QR_decomposition_parallel.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive).
+ * @param QR Pointer to the output factors (size: rows x columns), may be A.
+ * @param tau Pointer to the scalars of the reflectors (size: min(rows, columns)).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         partially overlapping output or memory allocation errors.
+ */
+
+int FN(QR_factorization_parallel_into)(REAL *A, index_t rows, index_t columns, REAL *QR, REAL *tau);
+
+/**
+ * @brief Multiplies a block by Q or Q^T from the compact QR factors of A.
+ *
+ * @param QR Pointer to the factors returned by QR_factorization_into (size: rows x columns).
+ * @param tau Pointer to the scalars returned by QR_factorization_into (size: min(rows, columns)).
+ * @param rows Number of rows of A (must be positive).
+ * @param columns Number of columns of A (must be positive).
+ * @param transpose OP_NO_TRANSPOSE for Q B, OP_TRANSPOSE for Q^T B.
+ * @param B Pointer to the block (size: rows x k), a vector when k is 1.
+ * @param k Number of columns of B (must be positive).
+ *
+ * @return Pointer to the product (size: rows x k) on success, or NULL on failure due to
+ *         invalid arguments or memory allocation errors.
+ */
+
+REAL *FN(QR_factored_apply_Q)(const REAL *QR, const REAL *tau, index_t rows, index_t columns, int transpose,
+			      REAL *B, index_t k);
+
+/**
+ * @brief Multiplies a block by Q or Q^T from the compact QR factors of A into a caller-provided block.
+ *
+ * Q is the full rows x rows orthogonal matrix H_0 ... H_{s-1}: Q^T b gives the coordinates
+ * of b on the columns of A in its first min(rows, columns) elements and the rest of b in
+ * the others (the least-squares residual), and Q x with x zero after its first columns
+ * elements gives the product by the thin Q. Q is never formed: a vector costs 4 rows columns
+ * FLOPs instead of the 2 rows columns^2 of forming Q. Blocks of many columns are multiplied
+ * by block reflectors, tiles of columns on all the threads. C may be B (in place).
+ *
+ * @param QR Pointer to the factors returned by QR_factorization_into (size: rows x columns).
+ * @param tau Pointer to the scalars returned by QR_factorization_into (size: min(rows, columns)).
+ * @param rows Number of rows of A (must be positive).
+ * @param columns Number of columns of A (must be positive).
+ * @param transpose OP_NO_TRANSPOSE for Q B, OP_TRANSPOSE for Q^T B.
+ * @param B Pointer to the block (size: rows x k), a vector when k is 1.
+ * @param k Number of columns of B (must be positive).
+ * @param C Pointer to the product (size: rows x k), may be B.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         an unknown operation, partially overlapping output or memory allocation errors.
+ */
+
+int FN(QR_factored_apply_Q_into)(const REAL *QR, const REAL *tau, index_t rows, index_t columns, int transpose,
+				 REAL *B, index_t k, REAL *C);
+
+/**
+ * @brief Forms the thin Q explicitly from the compact QR factors of A.
+ *
+ * @param QR Pointer to the factors returned by QR_factorization_into (size: rows x columns).
+ * @param tau Pointer to the scalars returned by QR_factorization_into (size: min(rows, columns)).
+ * @param rows Number of rows of A (must be positive).
+ * @param columns Number of columns of A (must be positive).
+ *
+ * @return Pointer to Q (size: rows x min(rows, columns)) on success, or NULL on failure due to
+ *         invalid arguments or memory allocation errors.
+ */
+
+REAL *FN(QR_factored_form_Q)(const REAL *QR, const REAL *tau, index_t rows, index_t columns);
+
+/**
+ * @brief Forms the thin Q explicitly from the compact QR factors of A into a caller-provided matrix.
+ *
+ * Q = H_0 ... H_{s-1} [I; 0] with s = min(rows, columns), built by block reflectors on all the
+ * threads (2 rows s^2 - 2 s^3 / 3 FLOPs). Only needed when Q itself is wanted:
+ * QR_factored_apply_Q multiplies by Q without it.
+ *
+ * @param QR Pointer to the factors returned by QR_factorization_into (size: rows x columns).
+ * @param tau Pointer to the scalars returned by QR_factorization_into (size: min(rows, columns)).
+ * @param rows Number of rows of A (must be positive).
+ * @param columns Number of columns of A (must be positive).
+ * @param Q Pointer to the output matrix (size: rows x min(rows, columns)), must not overlap QR.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         overlapping output or memory allocation errors.
+ */
+
+int FN(QR_factored_form_Q_into)(const REAL *QR, const REAL *tau, index_t rows, index_t columns, REAL *Q);
+
+/**
+ * @brief Performs the QR decomposition of a tall and skinny matrix with TSQR.
+ *
+ * This function decomposes a matrix A into a matrix Q with orthonormal columns
+ * and an upper triangular matrix R with a nonnegative diagonal such that A = Q * R,
+ * with the communication-avoiding TSQR: the threads factor chunks of rows in cache,
+ * then reduce their R factors along a binary tree. Meant for rows >> columns.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive and at most rows).
+ *
+ * @return Pointer to the QR structure containing Q and R matrices on success,
+ *         or NULL on failure due to invalid dimensions or memory allocation errors.
+ */
+
+FN(QR) *FN(TSQR_decomposition)(REAL *A, index_t rows, index_t columns);
+
+/**
+ * @brief Performs the QR decomposition of a tall and skinny matrix with TSQR, into caller-provided storage.
+ *
+ * A is read once, chunk by chunk, by all the OpenMP threads. Q is formed by a second
+ * pass over its rows only when it is requested: Q may be NULL to compute R alone, which
+ * leaves A untouched and needs no memory proportional to rows. Q may be A (A is then
+ * overwritten by Q), which factors matrices too large to be held twice.
+ *
+ * @param A Pointer to the input matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive and at most rows).
+ * @param Q Pointer to the matrix with orthonormal columns (size: rows x columns), or NULL.
+ * @param R Pointer to the upper triangular matrix (size: columns x columns).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         overlapping outputs or memory allocation errors.
+ */
+
+int FN(TSQR_decomposition_into)(REAL *A, index_t rows, index_t columns, REAL *Q, REAL *R);
+
+/**
+ * @brief Frees all memory associated with a QR decomposition structure.
+ *
+ * This function releases the memory allocated for the matrices Q, R, and A,
+ * as well as the QR structure itself.
+ *
+ * @param QR_decomposition Pointer to the QR structure to free.
+ */
+
+void FN(QR_free)(FN(QR) *QR_decomposition);
+
+/* sparse_matrix.c */
+
+/**
+ * @brief Builds a compressed sparse matrix from coordinate (COO) triplets.
+ *
+ * Entry k has value values[k] at (row_indices[k], column_indices[k]). The triplets
+ * may come in any order; duplicated coordinates are summed. Inside each row (CSR)
+ * or column (CSC) the indices of the result are sorted in increasing order.
+ * The construction takes O(nnz + rows + columns) time with two counting sorts.
+ *
+ * @param rows Number of rows of the matrix (must be positive).
+ * @param columns Number of columns of the matrix (must be positive).
+ * @param nnz Number of triplets (must be non-negative).
+ * @param row_indices Row of each triplet, in [0, rows) (size: nnz).
+ * @param column_indices Column of each triplet, in [0, columns) (size: nnz).
+ * @param values Value of each triplet (size: nnz).
+ * @param format SPARSE_CSR or SPARSE_CSC.
+ *
+ * @return Pointer to the sparse matrix on success, or NULL on failure due to invalid
+ *         dimensions or format, out of bounds indices, null pointers or memory allocation errors.
+ */
+
+FN(sparse_matrix) *FN(sparse_from_coo)(index_t rows, index_t columns, index_t nnz, const index_t *row_indices,
+				       const index_t *column_indices, const REAL *values, int format);
+
+/**
+ * @brief Converts a dense row-major matrix to a compressed sparse matrix.
+ *
+ * Elements equal to zero are not stored.
+ *
+ * @param A Pointer to the dense matrix (size: rows x columns).
+ * @param rows Number of rows in the matrix (must be positive).
+ * @param columns Number of columns in the matrix (must be positive).
+ * @param format SPARSE_CSR or SPARSE_CSC.
+ *
+ * @return Pointer to the sparse matrix on success, or NULL on failure due to invalid
+ *         dimensions or format, null pointers or memory allocation errors.
+ */
+
+FN(sparse_matrix) *FN(sparse_from_dense)(REAL *A, index_t rows, index_t columns, int format);
+
+/**
+ * @brief Converts a compressed sparse matrix to a dense row-major matrix.
+ *
+ * @param S Pointer to the sparse matrix.
+ *
+ * @return Pointer to the dense matrix (size: rows x columns) on success,
+ *         or NULL on failure due to a null pointer or memory allocation errors.
+ */
+
+REAL *FN(sparse_to_dense)(const FN(sparse_matrix) *S);
+
+/**
+ * @brief Frees all memory associated with a compressed sparse matrix.
+ *
+ * @param S Pointer to the sparse matrix to free (may be NULL).
+ */
+
+void FN(sparse_free)(FN(sparse_matrix) *S);
+
+/* sparse_vector_matrix_product.c */
+
+/**
+ * @brief Computes the product of a sparse matrix A and a vector X sequentially.
+ *
+ * This function calculates the vector result = A * X, where A is stored in CSR or
+ * CSC format. Only the nonzeros of A are read.
+ *
+ * @param A Pointer to the sparse matrix (size: rows x columns).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal the columns of A).
+ *
+ * @return Pointer to the resulting vector (size: rows of A) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(sequential_sparse_vector_matrix_product)(const FN(sparse_matrix) *A, REAL *X, index_t dimension);
+
+/**
+ * @brief Computes the product of a sparse matrix A and a vector X sequentially into a caller-provided vector.
+ *
+ * Same as sequential_sparse_vector_matrix_product, without allocating the result. Y must not overlap A or X.
+ *
+ * @param A Pointer to the sparse matrix (size: rows x columns).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal the columns of A).
+ * @param Y Pointer to the output vector (size: rows of A).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers or aliased output.
+ */
+
+int FN(sequential_sparse_vector_matrix_product_into)(const FN(sparse_matrix) *A, REAL *X, index_t dimension, REAL *Y);
+
+/**
+ * @brief Computes the product of a sparse matrix A and a vector X in parallel using OpenMP.
+ *
+ * This function calculates the vector result = A * X, where A is stored in CSR or
+ * CSC format. The rows (CSR) or columns (CSC) are split between the threads so that
+ * each thread gets about the same number of nonzeros, which keeps the threads busy
+ * when a few rows hold most of the nonzeros. In CSC format each thread scatters its
+ * columns into its own partial vector, and the partial vectors are summed at the end.
+ *
+ * @param A Pointer to the sparse matrix (size: rows x columns).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal the columns of A).
+ *
+ * @return Pointer to the resulting vector (size: rows of A) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(parallel_sparse_vector_matrix_product)(const FN(sparse_matrix) *A, REAL *X, index_t dimension);
+
+/**
+ * @brief Computes the product of a sparse matrix A and a vector X in parallel using OpenMP into a caller-provided vector.
+ *
+ * Same as parallel_sparse_vector_matrix_product, without allocating the result. Y must not overlap A or X.
+ *
+ * @param A Pointer to the sparse matrix (size: rows x columns).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal the columns of A).
+ * @param Y Pointer to the output vector (size: rows of A).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers, aliased output,
+ *         or memory allocation errors.
+ */
+
+int FN(parallel_sparse_vector_matrix_product_into)(const FN(sparse_matrix) *A, REAL *X, index_t dimension, REAL *Y);
+
+/* sparse_matrix_product.c */
+
+/**
+ * @brief Computes the product of two sparse matrices P and Q sequentially.
+ *
+ * This function calculates the sparse matrix C = P * Q without forming any dense
+ * matrix: the time and memory are proportional to the number of multiplications
+ * P[i, k] * Q[k, j] and to the nonzeros of C, plus a dense accumulator over the
+ * columns of Q. The columns of each row of C are sorted; products that cancel
+ * exactly are kept as stored zeros.
+ *
+ * @param P Pointer to the first sparse matrix, in SPARSE_CSR format.
+ * @param Q Pointer to the second sparse matrix, in SPARSE_CSR format (rows must equal the columns of P).
+ *
+ * @return Pointer to the resulting sparse matrix in SPARSE_CSR format (size: P rows x Q columns) on success,
+ *         or NULL on failure due to invalid dimensions or formats, null pointers, or memory allocation errors.
+ */
+
+FN(sparse_matrix) *FN(sequential_sparse_matrix_product)(const FN(sparse_matrix) *P, const FN(sparse_matrix) *Q);
+
+/**
+ * @brief Computes the product of two sparse matrices P and Q in parallel using OpenMP.
+ *
+ * Same as sequential_sparse_matrix_product, with the rows of C shared dynamically
+ * between the threads. Each thread has its own dense accumulator over the columns of Q.
+ *
+ * @param P Pointer to the first sparse matrix, in SPARSE_CSR format.
+ * @param Q Pointer to the second sparse matrix, in SPARSE_CSR format (rows must equal the columns of P).
+ *
+ * @return Pointer to the resulting sparse matrix in SPARSE_CSR format (size: P rows x Q columns) on success,
+ *         or NULL on failure due to invalid dimensions or formats, null pointers, or memory allocation errors.
+ */
+
+FN(sparse_matrix) *FN(parallel_sparse_matrix_product)(const FN(sparse_matrix) *P, const FN(sparse_matrix) *Q);
+
+/* banded_matrix.c */
+
+/**
+ * @brief Allocates a zero banded matrix.
+ *
+ * @param size Dimension of the square matrix (must be positive).
+ * @param lower Number of diagonals below the main diagonal (must be in [0, size)).
+ * @param upper Number of diagonals above the main diagonal (must be in [0, size)).
+ *
+ * @return Pointer to the banded matrix on success, or NULL on failure due to invalid
+ *         dimensions or memory allocation errors.
+ */
+
+FN(banded_matrix) *FN(create_banded_matrix)(index_t size, index_t lower, index_t upper);
+
+/**
+ * @brief Extracts the band of a dense square matrix.
+ *
+ * Elements of A outside the band are ignored.
+ *
+ * @param A Pointer to the dense matrix (size: size x size).
+ * @param size Dimension of the square matrix (must be positive).
+ * @param lower Number of diagonals below the main diagonal kept (must be in [0, size)).
+ * @param upper Number of diagonals above the main diagonal kept (must be in [0, size)).
+ *
+ * @return Pointer to the banded matrix on success, or NULL on failure due to invalid
+ *         dimensions, null pointers or memory allocation errors.
+ */
+
+FN(banded_matrix) *FN(banded_from_dense)(REAL *A, index_t size, index_t lower, index_t upper);
+
+/**
+ * @brief Expands a banded matrix to a dense square matrix.
+ *
+ * @param A Pointer to the banded matrix.
+ *
+ * @return Pointer to the dense matrix (size: size x size) on success,
+ *         or NULL on failure due to a null pointer or memory allocation errors.
+ */
+
+REAL *FN(banded_to_dense)(const FN(banded_matrix) *A);
+
+/**
+ * @brief Frees all memory associated with a banded matrix.
+ *
+ * @param A Pointer to the banded matrix to free (may be NULL).
+ */
+
+void FN(banded_free)(FN(banded_matrix) *A);
+
+/**
+ * @brief Performs the LU decomposition with partial pivoting of a banded matrix.
+ *
+ * This function computes P A = L U in O(size * lower * (lower + upper)) time and
+ * O(size * (2 * lower + upper)) memory: L has lower diagonals below its unit
+ * diagonal, and U has at most lower + upper diagonals above its diagonal.
+ *
+ * @param A Pointer to the banded matrix to decompose.
+ *
+ * @return Pointer to the banded_LU structure on success, or NULL on failure due to
+ *         null pointers, singular matrix detection or memory allocation errors.
+ */
+
+FN(banded_LU) *FN(banded_LU_decomposition)(const FN(banded_matrix) *A);
+
+/**
+ * @brief Solves a linear system Ax = b from the banded LU decomposition of A.
+ *
+ * @param F Pointer to the banded LU decomposition of A.
+ * @param b Pointer to the right-hand side vector b (size: size).
+ *
+ * @return Pointer to the solution vector x on success, or NULL on failure due to
+ *         null pointers or memory allocation errors.
+ */
+
+REAL *FN(solve_banded_LU_system)(const FN(banded_LU) *F, REAL *b);
+
+/**
+ * @brief Solves a linear system Ax = b from the banded LU decomposition of A.
+ *
+ * x may be b (the right-hand side is overwritten by the solution).
+ *
+ * @param F Pointer to the banded LU decomposition of A.
+ * @param b Pointer to the right-hand side vector b (size: size).
+ * @param x Pointer to the solution vector x (size: size).
+ *
+ * @return 0 on success, or -1 on failure due to null pointers.
+ */
+
+int FN(solve_banded_LU_system_into)(const FN(banded_LU) *F, REAL *b, REAL *x);
+
+/**
+ * @brief Frees all memory associated with a banded LU decomposition.
+ *
+ * @param F Pointer to the banded LU structure to free (may be NULL).
+ */
+
+void FN(banded_LU_free)(FN(banded_LU) *F);
+
+/**
+ * @brief Performs the Cholesky decomposition A = L L^T of a symmetric positive definite banded matrix.
+ *
+ * Only the diagonal and the lower diagonals of A are read. L has the same lower
+ * bandwidth as A, so the decomposition takes O(size * lower^2) time and
+ * O(size * lower) memory.
+ *
+ * @param A Pointer to the symmetric banded matrix (lower must equal upper).
+ *
+ * @return Pointer to the banded lower triangular factor L (upper = 0) on success, or NULL
+ *         on failure due to null pointers, a non-symmetric band, a matrix that is not
+ *         positive definite or memory allocation errors.
+ */
+
+FN(banded_matrix) *FN(banded_Cholesky_decomposition)(const FN(banded_matrix) *A);
+
+/**
+ * @brief Solves a linear system Ax = b from the banded Cholesky factor L of A.
+ *
+ * @param L Pointer to the banded lower triangular factor returned by banded_Cholesky_decomposition.
+ * @param b Pointer to the right-hand side vector b (size: size).
+ *
+ * @return Pointer to the solution vector x on success, or NULL on failure due to
+ *         null pointers, a factor that is not lower triangular or memory allocation errors.
+ */
+
+REAL *FN(solve_banded_Cholesky_system)(const FN(banded_matrix) *L, REAL *b);
+
+/**
+ * @brief Solves a linear system Ax = b from the banded Cholesky factor L of A.
+ *
+ * Solves L y = b then L^T x = y. x may be b (the right-hand side is overwritten by the solution).
+ *
+ * @param L Pointer to the banded lower triangular factor returned by banded_Cholesky_decomposition.
+ * @param b Pointer to the right-hand side vector b (size: size).
+ * @param x Pointer to the solution vector x (size: size).
+ *
+ * @return 0 on success, or -1 on failure due to null pointers or a factor that is not lower triangular.
+ */
+
+int FN(solve_banded_Cholesky_system_into)(const FN(banded_matrix) *L, REAL *b, REAL *x);
+
+/* tridiagonal_system.c */
+
+/**
+ * @brief Solves a tridiagonal linear system Ax = b with the Thomas algorithm.
+ *
+ * @param lower Pointer to the subdiagonal, lower[i] = A(i, i - 1) (size: n, lower[0] is not read).
+ * @param diagonal Pointer to the diagonal, diagonal[i] = A(i, i) (size: n).
+ * @param upper Pointer to the superdiagonal, upper[i] = A(i, i + 1) (size: n, upper[n - 1] is not read).
+ * @param b Pointer to the right-hand side vector b (size: n).
+ * @param n Dimension of the system (must be positive).
+ *
+ * @return Pointer to the solution vector x on success, or NULL on failure due to invalid
+ *         dimensions, null pointers, a zero pivot or memory allocation errors.
+ */
+
+REAL *FN(solve_tridiagonal_system)(REAL *lower, REAL *diagonal, REAL *upper, REAL *b, index_t n);
+
+/**
+ * @brief Solves a tridiagonal linear system Ax = b with the Thomas algorithm into a caller-provided vector.
+ *
+ * The system is solved in O(n) time without pivoting, which is stable when A is
+ * diagonally dominant or symmetric positive definite. x may be b (the right-hand
+ * side is overwritten by the solution).
+ *
+ * @param lower Pointer to the subdiagonal, lower[i] = A(i, i - 1) (size: n, lower[0] is not read).
+ * @param diagonal Pointer to the diagonal, diagonal[i] = A(i, i) (size: n).
+ * @param upper Pointer to the superdiagonal, upper[i] = A(i, i + 1) (size: n, upper[n - 1] is not read).
+ * @param b Pointer to the right-hand side vector b (size: n).
+ * @param n Dimension of the system (must be positive).
+ * @param x Pointer to the solution vector x (size: n).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         a zero pivot or memory allocation errors.
+ */
+
+int FN(solve_tridiagonal_system_into)(REAL *lower, REAL *diagonal, REAL *upper, REAL *b, index_t n, REAL *x);
+
+/**
+ * @brief Solves a batch of independent tridiagonal systems in parallel using OpenMP.
+ *
+ * System s is made of the n elements starting at s * n in lower, diagonal, upper, B
+ * and X. The systems are shared between the threads, each with its own elimination
+ * vector, and each is solved with the Thomas algorithm. X may be B.
+ *
+ * @param lower Pointer to the subdiagonals (size: batch x n, the first element of each system is not read).
+ * @param diagonal Pointer to the diagonals (size: batch x n).
+ * @param upper Pointer to the superdiagonals (size: batch x n, the last element of each system is not read).
+ * @param B Pointer to the right-hand sides (size: batch x n).
+ * @param n Dimension of each system (must be positive).
+ * @param batch Number of systems (must be non-negative).
+ * @param X Pointer to the solutions (size: batch x n).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers,
+ *         a zero pivot in any system or memory allocation errors.
+ */
+
+int FN(batched_solve_tridiagonal_system)(REAL *lower, REAL *diagonal, REAL *upper, REAL *B, index_t n, index_t batch,
+					 REAL *X);
+
+/* packed_matrix.c */
+
+/**
+ * @brief Allocates a zero packed matrix.
+ *
+ * @param size Dimension of the square matrix (must be positive).
+ * @param triangle TRIANGLE_LOWER or TRIANGLE_UPPER, the stored triangle.
+ *
+ * @return Pointer to the packed matrix on success, or NULL on failure due to invalid
+ *         dimensions, an unknown triangle or memory allocation errors.
+ */
+
+FN(packed_matrix) *FN(create_packed_matrix)(index_t size, int triangle);
+
+/**
+ * @brief Packs one triangle of a dense square matrix.
+ *
+ * The elements of A in the other triangle are ignored, so a symmetric matrix
+ * is packed from either of its triangles.
+ *
+ * @param A Pointer to the dense matrix (size: size x size).
+ * @param size Dimension of the square matrix (must be positive).
+ * @param triangle TRIANGLE_LOWER or TRIANGLE_UPPER, the triangle kept.
+ *
+ * @return Pointer to the packed matrix on success, or NULL on failure due to invalid
+ *         dimensions, null pointers or memory allocation errors.
+ */
+
+FN(packed_matrix) *FN(packed_from_dense)(REAL *A, index_t size, int triangle);
+
+/**
+ * @brief Expands a packed matrix to a dense square matrix.
+ *
+ * @param A Pointer to the packed matrix.
+ * @param mirror 1 to copy the stored triangle into the other one (symmetric matrix),
+ *               0 to fill the other triangle with zeros (triangular matrix).
+ *
+ * @return Pointer to the dense matrix (size: size x size) on success,
+ *         or NULL on failure due to a null pointer or memory allocation errors.
+ */
+
+REAL *FN(packed_to_dense)(const FN(packed_matrix) *A, int mirror);
+
+/**
+ * @brief Frees all memory associated with a packed matrix.
+ *
+ * @param A Pointer to the packed matrix to free (may be NULL).
+ */
+
+void FN(packed_free)(FN(packed_matrix) *A);
+
+/**
+ * @brief Performs the Cholesky decomposition of a symmetric positive-definite packed matrix.
+ *
+ * This function computes A = L L^T where A is given by either of its triangles,
+ * and returns L in lower packed storage: the factorisation never holds more than
+ * one triangle, half the memory of Cholesky_decomposition.
+ *
+ * @param A Pointer to the packed symmetric matrix to decompose.
+ *
+ * @return Pointer to the lower triangular factor L on success, or NULL on failure due to
+ *         null pointers, non-positive definite matrix or memory allocation errors.
+ */
+
+FN(packed_matrix) *FN(packed_Cholesky_decomposition)(const FN(packed_matrix) *A);
+
+/**
+ * @brief Solves a linear system Ax = b from the packed Cholesky factor L of A.
+ *
+ * @param L Pointer to the lower packed factor returned by packed_Cholesky_decomposition.
+ * @param b Pointer to the right-hand side vector b (size: size).
+ *
+ * @return Pointer to the solution vector x on success, or NULL on failure due to
+ *         null pointers, a factor that is not lower triangular or memory allocation errors.
+ */
+
+REAL *FN(solve_packed_Cholesky_system)(const FN(packed_matrix) *L, REAL *b);
+
+/**
+ * @brief Solves a linear system Ax = b from the packed Cholesky factor L of A.
+ *
+ * Solves L y = b with dot products of the rows of L, then L^T x = y by subtracting
+ * each solved unknown times its row, so L is read row after row in both passes.
+ * x may be b (the right-hand side is overwritten by the solution).
+ *
+ * @param L Pointer to the lower packed factor returned by packed_Cholesky_decomposition.
+ * @param b Pointer to the right-hand side vector b (size: size).
+ * @param x Pointer to the solution vector x (size: size).
+ *
+ * @return 0 on success, or -1 on failure due to null pointers or a factor that is not lower triangular.
+ */
+
+int FN(solve_packed_Cholesky_system_into)(const FN(packed_matrix) *L, REAL *b, REAL *x);
+
+/* symmetric_matrix_product.c */
+
+/**
+ * @brief Computes the product of a packed symmetric matrix A and a vector X sequentially.
+ *
+ * This function calculates the vector result = A * X, where A is given by one of its
+ * triangles in packed storage. Each stored element is read once and used for both of
+ * its positions in A, so the product streams half the memory of a dense one.
+ *
+ * @param A Pointer to the packed symmetric matrix (size: size x size).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal the size of A).
+ *
+ * @return Pointer to the resulting vector (size: dimension) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(sequential_symmetric_vector_matrix_product)(const FN(packed_matrix) *A, REAL *X, index_t dimension);
+
+/**
+ * @brief Computes the product of a packed symmetric matrix A and a vector X sequentially into a caller-provided vector.
+ *
+ * Same as sequential_symmetric_vector_matrix_product, without allocating the result. Y must not overlap A or X.
+ *
+ * @param A Pointer to the packed symmetric matrix (size: size x size).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal the size of A).
+ * @param Y Pointer to the output vector (size: dimension).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers or aliased output.
+ */
+
+int FN(sequential_symmetric_vector_matrix_product_into)(const FN(packed_matrix) *A, REAL *X, index_t dimension, REAL *Y);
+
+/**
+ * @brief Computes the product of a packed symmetric matrix A and a vector X in parallel using OpenMP.
+ *
+ * This function calculates the vector result = A * X, where A is given by one of its
+ * triangles in packed storage. The stored rows are split between the threads so that
+ * each thread reads about the same share of the triangle, once. A stored element adds
+ * to two entries of the result, so each thread accumulates into its own partial vector
+ * and the partial vectors are summed at the end.
+ *
+ * @param A Pointer to the packed symmetric matrix (size: size x size).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal the size of A).
+ *
+ * @return Pointer to the resulting vector (size: dimension) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(parallel_symmetric_vector_matrix_product)(const FN(packed_matrix) *A, REAL *X, index_t dimension);
+
+/**
+ * @brief Computes the product of a packed symmetric matrix A and a vector X in parallel using OpenMP into a caller-provided vector.
+ *
+ * Same as parallel_symmetric_vector_matrix_product, without allocating the result. Y must not overlap A or X.
+ *
+ * @param A Pointer to the packed symmetric matrix (size: size x size).
+ * @param X Pointer to the input vector (size: dimension).
+ * @param dimension Dimension of the vector X (must equal the size of A).
+ * @param Y Pointer to the output vector (size: dimension).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers, aliased output,
+ *         or memory allocation errors.
+ */
+
+int FN(parallel_symmetric_vector_matrix_product_into)(const FN(packed_matrix) *A, REAL *X, index_t dimension, REAL *Y);
+
+/**
+ * @brief Computes the product of a packed symmetric matrix A and a matrix B sequentially.
+ *
+ * This function calculates C = A * B, where A is given by one of its triangles in packed
+ * storage. The stored triangle is cut into tiles, each copied once from the packed rows
+ * into a small dense buffer and used twice by the packed GEMM engine: as A_IJ for the rows
+ * I of C and as its transpose for the rows J. Every stored element is therefore read
+ * once, and the full matrix is never formed.
+ *
+ * @param A Pointer to the packed symmetric matrix (size: size x size).
+ * @param B Pointer to the right operand (size: B_rows x B_columns).
+ * @param B_rows Number of rows in B (must equal the size of A).
+ * @param B_columns Number of columns in B (must be positive).
+ *
+ * @return Pointer to the resulting matrix (size: B_rows x B_columns) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(sequential_symmetric_matrix_product)(const FN(packed_matrix) *A, REAL *B, index_t B_rows, index_t B_columns);
+
+/**
+ * @brief Computes the product of a packed symmetric matrix A and a matrix B sequentially into a caller-provided matrix.
+ *
+ * Same as sequential_symmetric_matrix_product, without allocating the result. C must not overlap A or B.
+ *
+ * @param A Pointer to the packed symmetric matrix (size: size x size).
+ * @param B Pointer to the right operand (size: B_rows x B_columns).
+ * @param B_rows Number of rows in B (must equal the size of A).
+ * @param B_columns Number of columns in B (must be positive).
+ * @param C Pointer to the output matrix (size: B_rows x B_columns).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers, aliased output,
+ *         or memory allocation errors.
+ */
+
+int FN(sequential_symmetric_matrix_product_into)(const FN(packed_matrix) *A, REAL *B, index_t B_rows, index_t B_columns,
+						 REAL *C);
+
+/**
+ * @brief Computes the product of a packed symmetric matrix A and a matrix B in parallel using OpenMP.
+ *
+ * This function calculates C = A * B, where A is given by one of its triangles in packed
+ * storage. Each thread owns blocks of rows of C: for a block I, it copies the tiles A_IJ
+ * of the whole block row from the packed triangle, reading the stored tile (J, I) when A_IJ
+ * lies in the other triangle, and multiplies them by B with the packed GEMM engine. The
+ * threads never write the same rows, and each stored element is read by at most two threads.
+ *
+ * @param A Pointer to the packed symmetric matrix (size: size x size).
+ * @param B Pointer to the right operand (size: B_rows x B_columns).
+ * @param B_rows Number of rows in B (must equal the size of A).
+ * @param B_columns Number of columns in B (must be positive).
+ *
+ * @return Pointer to the resulting matrix (size: B_rows x B_columns) on success,
+ *         or NULL on failure due to invalid dimensions, null pointers, or memory allocation errors.
+ */
+
+REAL *FN(parallel_symmetric_matrix_product)(const FN(packed_matrix) *A, REAL *B, index_t B_rows, index_t B_columns);
+
+/**
+ * @brief Computes the product of a packed symmetric matrix A and a matrix B in parallel using OpenMP into a caller-provided matrix.
+ *
+ * Same as parallel_symmetric_matrix_product, without allocating the result. C must not overlap A or B.
+ *
+ * @param A Pointer to the packed symmetric matrix (size: size x size).
+ * @param B Pointer to the right operand (size: B_rows x B_columns).
+ * @param B_rows Number of rows in B (must equal the size of A).
+ * @param B_columns Number of columns in B (must be positive).
+ * @param C Pointer to the output matrix (size: B_rows x B_columns).
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers, aliased output,
+ *         or memory allocation errors.
+ */
+
+int FN(parallel_symmetric_matrix_product_into)(const FN(packed_matrix) *A, REAL *B, index_t B_rows, index_t B_columns,
+					       REAL *C);
+
+/* symmetric_eigenvalues.c */
+
+/**
+ * @brief Computes the eigenvalues of a symmetric matrix.
+ *
+ * A is reduced to tridiagonal form by blocked Householder reflectors, whose eigenvalues come
+ * from implicit QL iterations. Only the lower triangle of A is read.
+ *
+ * @param A Pointer to the symmetric matrix (size: size x size).
+ * @param size Dimension of the matrix (must be positive).
+ *
+ * @return Pointer to the eigenvalues in increasing order on success, or NULL on failure due to invalid
+ *         dimensions, null pointers, memory allocation errors or lack of convergence.
+ */
+
+REAL *FN(symmetric_eigenvalues)(REAL *A, index_t size);
+
+/**
+ * @brief Computes the eigenvalues and, optionally, the eigenvectors of a symmetric matrix.
+ *
+ * A = Z diag(eigenvalues) Z^T with Z orthogonal. A is reduced to tridiagonal form T by blocked
+ * Householder reflectors. Without eigenvectors, the eigenvalues of T come from implicit QL
+ * iterations in O(size^2). With them, T is solved by divide and conquer and its eigenvectors are
+ * multiplied by the reflectors. Only the lower triangle of A is read.
+ *
+ * @param A Pointer to the symmetric matrix (size: size x size).
+ * @param size Dimension of the matrix (must be positive).
+ * @param eigenvalues Pointer to the eigenvalues in increasing order (size: size).
+ * @param eigenvectors Pointer to Z (size: size x size), column i being the eigenvector of eigenvalue i,
+ *                     or NULL for the eigenvalues only. May be A.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers, overlapping outputs,
+ *         memory allocation errors or lack of convergence.
+ */
+
+int FN(symmetric_eigen_decomposition_into)(REAL *A, index_t size, REAL *eigenvalues, REAL *eigenvectors);
+
+/**
+ * @brief Computes the eigenvalues and, optionally, the eigenvectors of a symmetric matrix in parallel.
+ *
+ * Same as symmetric_eigen_decomposition_into on all the OpenMP threads: the products of the
+ * tridiagonalization are shared by rows and tiles, the halves of the divide and conquer are solved
+ * as tasks and the reflectors are applied to tiles of columns of the eigenvectors.
+ *
+ * @param A Pointer to the symmetric matrix (size: size x size).
+ * @param size Dimension of the matrix (must be positive).
+ * @param eigenvalues Pointer to the eigenvalues in increasing order (size: size).
+ * @param eigenvectors Pointer to Z (size: size x size), column i being the eigenvector of eigenvalue i,
+ *                     or NULL for the eigenvalues only. May be A.
+ *
+ * @return 0 on success, or -1 on failure due to invalid dimensions, null pointers, overlapping outputs,
+ *         memory allocation errors or lack of convergence.
+ */
+
+int FN(symmetric_eigen_decomposition_parallel_into)(REAL *A, index_t size, REAL *eigenvalues, REAL *eigenvectors);
@@ -0,0 +1,85 @@
+#include "LinearAlgebraBasics.h"
+#include <omp.h>
+
+/*
+ * Random symmetric matrix made positive definite by a diagonal shift of its size.
+ */
+
+static double *generate_positive_definite(int n) {
+
+    double *A = malloc((size_t) n * n * sizeof(double));
+
+    srand(3);
+
+    for (int i = 0; i < n; i++)
+	for (int j = 0; j <= i; j++) {
+	    double value = (double) rand() / RAND_MAX - 0.5 + (i == j ? n : 0.0);
+	    A[i * n + j] = value;
+	    A[j * n + i] = value;
+	}
+
+    return A;
+
+}
+
+int main() {
+
+    int size = 5000;
+    int product_size = 3000;
+
+    double *A = generate_positive_definite(size);
+    double *C = malloc((size_t) product_size * product_size * sizeof(double));
+
+    // Reference rate of the matrix product the tile updates are made of
+
+    double start = omp_get_wtime();
+    parallel_matrix_product_into(A, product_size, product_size, A, product_size, product_size, C);
+    double elapsed = omp_get_wtime() - start;
+
+    printf("parallel_matrix_product, %d x %d : %.3f seconds (%.2f GFLOPS).\n", product_size, product_size, elapsed,
+	   2e-9 * product_size * product_size * product_size / elapsed);
+
+    free(C);
+
+    printf("##################################### TEST CHOLESKY DECOMPOSITION SEQUENTIAL #####################################\n");
+
+    start = omp_get_wtime();
+
+    Cholesky *Cholesky_sequential = Cholesky_decomposition(A, size);
+
+    elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed time : %.3f seconds (%.2f GFLOPS).\n", elapsed, 1e-9 / 3 * size * size * (double) size / elapsed);
+
+    free_Cholesky(Cholesky_sequential);
+
+    printf("##################################### TEST CHOLESKY DECOMPOSITION PARALLEL #####################################\n");
+
+    start = omp_get_wtime();
+
+    Cholesky *Cholesky_parallel = Cholesky_decomposition_parallel(A, size);
+
+    elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed time : %.3f seconds (%.2f GFLOPS).\n", elapsed, 1e-9 / 3 * size * size * (double) size / elapsed);
+
+    free_Cholesky(Cholesky_parallel);
+
+    printf("##################################### TEST CHOLESKY FACTORIZATION IN PLACE #####################################\n");
+
+    // L written over A: no matrix allocated besides A
+
+    start = omp_get_wtime();
+
+    Cholesky_factorization_parallel_into(A, size, A);
+
+    elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed time : %.3f seconds (%.2f GFLOPS), %.1f MB of factor instead of %.1f MB.\n", elapsed,
+	   1e-9 / 3 * size * size * (double) size / elapsed, 8e-6 * size * size, 3 * 8e-6 * size * size);
+
+    free(A);
+
+    return 0;
+
+}
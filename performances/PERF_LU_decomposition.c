@@ -1,4 +1,5 @@
 #include "LinearAlgebraBasics.h"
+#include <omp.h>
 
 int main() {
 
@@ -6,38 +7,61 @@ int main() {
     int columns = 3000;
 
     double *A = generate_matrix_double(rows, columns);
-    
+    double *C = malloc((size_t) rows * columns * sizeof(double));
+
+    // Reference rate of the matrix product the trailing updates are made of
+
+    double start = omp_get_wtime();
+    parallel_matrix_product_into(A, rows, columns, A, rows, columns, C);
+    double elapsed_product = omp_get_wtime() - start;
+
+    printf("parallel_matrix_product : %.3f seconds (%.2f GFLOPS).\n", elapsed_product,
+	   2e-9 * rows * rows * columns / elapsed_product);
+
+    free(C);
+
     printf("##################################### TEST LU DECOMPOSITION SEQUENTIAL #####################################\n");
 
-    time_t begin = time(NULL);
+    start = omp_get_wtime();
     
     LU *LU_sequential = LU_decomposition(A, rows, columns);
     
-    time_t end = time(NULL);
+    double elapsed = omp_get_wtime() - start;
 
-    printf("Elapsed time : %ld seconds.\n", (end - begin));
+    printf("Elapsed time : %.3f seconds (%.2f GFLOPS).\n", elapsed, 2e-9 / 3 * rows * rows * columns / elapsed);
 
-    free(LU_sequential->L);
-    free(LU_sequential->U);
-    free(LU_sequential);
+    LU_free(LU_sequential);
 
     printf("##################################### TEST LU DECOMPOSITION PARALLEL #####################################\n");
 
-    begin = time(NULL);
+    start = omp_get_wtime();
     
     LU *LU_parallel = LU_decomposition_parallel(A, rows, columns);
 
-    end = time(NULL);
+    elapsed = omp_get_wtime() - start;
 
-    printf("Elapsed time : %ld seconds.\n", (end - begin));
+    printf("Elapsed time : %.3f seconds (%.2f GFLOPS).\n", elapsed, 2e-9 / 3 * rows * rows * columns / elapsed);
     
-    free(LU_parallel->L);
-    free(LU_parallel->U);
-    free(LU_parallel);  
+    LU_free(LU_parallel);
+
+    printf("##################################### TEST LU FACTORIZATION IN PLACE #####################################\n");
+
+    // Compact L\U factors written over A: no matrix allocated besides A
+
+    index_t *pivots = malloc(rows * sizeof(index_t));
+
+    start = omp_get_wtime();
+
+    LU_factorization_parallel_into(A, rows, columns, A, pivots);
+
+    elapsed = omp_get_wtime() - start;
+
+    printf("Elapsed time : %.3f seconds (%.2f GFLOPS), %.1f MB of factors instead of %.1f MB.\n", elapsed,
+	   2e-9 / 3 * rows * rows * columns / elapsed, 8e-6 * rows * columns, 3 * 8e-6 * rows * columns);
+
+    free(pivots);
+    free(A);
     
     return 0;
 
 }
-    
-
-    
@@ -1,5 +1,5 @@
 #include "LinearAlgebraBasics.h"
-#include <string.h>
+#include <omp.h>
 
 int main() {
 
@@ -7,40 +7,106 @@ int main() {
     int columns = 2000;
 
     double *A = generate_matrix_double(rows, columns);
-    double *B = malloc((rows * columns) * sizeof(double));
-    memcpy(B, A, rows * columns * sizeof(double));
+
+    // Householder QR (2 m n^2 - 2 n^3 / 3 FLOPs) and the forming of Q (as many)
+    double flops = 4.0 * rows * columns * (double) columns - 4.0 / 3 * columns * columns * (double) columns;
 
     printf("##################################### TEST QR DECOMPOSITION SEQUENTIAL #####################################\n");
 
-    time_t begin = time(NULL);
+    double start = omp_get_wtime();
     
     QR *QR_sequential = QR_decomposition(A, rows, columns);
     
-    time_t end = time(NULL);
+    double elapsed = omp_get_wtime() - start;
 
-    printf("Elapsed time : %ld seconds.\n", (end - begin));
+    printf("Elapsed time : %.3f seconds (%.2f GFLOPS).\n", elapsed, 1e-9 * flops / elapsed);
     
     printf("##################################### TEST QR DECOMPOSITION PARALLEL #####################################\n");
 
-    begin = time(NULL);
+    start = omp_get_wtime();
     
-    QR *QR_parallel = QR_decomposition_parallel(B, rows, columns);
+    QR *QR_parallel = QR_decomposition_parallel(A, rows, columns);
 
-    end = time(NULL);
+    elapsed = omp_get_wtime() - start;
 
-    printf("Elapsed time : %ld seconds.\n", (end - begin));
-    
-    free(B);
+    printf("Elapsed time : %.3f seconds (%.2f GFLOPS).\n", elapsed, 1e-9 * flops / elapsed);
     
-    free(QR_parallel->Q);
-    free(QR_parallel->R);
-    free(QR_parallel);  
+    QR_free(QR_parallel);
+    QR_free(QR_sequential);
+    free(A);
+
+    // Implicit Q: Q^T b from the Householder vectors against forming Q first
+
+    int least_rows = 4000;
+    int least_columns = 1000;
+
+    A = generate_matrix_double(least_rows, least_columns);
+
+    double *tau = malloc(least_columns * sizeof(double));
+    double *b = generate_matrix_double(least_rows, 1);
+    double *y = malloc(least_rows * sizeof(double));
 
+    printf("##################################### TEST IMPLICIT Q %d x %d #####################################\n",
+	   least_rows, least_columns);
+
+    start = omp_get_wtime();
+    QR_factorization_parallel_into(A, least_rows, least_columns, A, tau);
+    elapsed = omp_get_wtime() - start;
+
+    printf("QR_factorization_parallel_into, in place : %.3f seconds.\n", elapsed);
+
+    start = omp_get_wtime();
+    QR_factored_apply_Q_into(A, tau, least_rows, least_columns, OP_TRANSPOSE, b, 1, y);
+    double elapsed_implicit = omp_get_wtime() - start;
+
+    start = omp_get_wtime();
+    double *Q = QR_factored_form_Q(A, tau, least_rows, least_columns);
+    parallel_transposed_vector_matrix_product_into(Q, least_rows, least_columns, b, least_rows, y);
+    elapsed = omp_get_wtime() - start;
+
+    printf("Q^T b, implicit Q : %.4f seconds, explicit Q : %.4f seconds (%.1f MB more), speedup %.1f.\n",
+	   elapsed_implicit, elapsed, 8e-6 * least_rows * least_columns, elapsed / elapsed_implicit);
+
+    free(Q);
+    free(y);
+    free(b);
+    free(tau);
+    free(A);
+
+    // Tall and skinny: one pass of TSQR over the rows against the blocked Householder QR
+
+    int tall_rows = 1000000;
+    int tall_columns = 50;
+
+    A = generate_matrix_double(tall_rows, tall_columns);
+    flops = 2.0 * tall_rows * tall_columns * (double) tall_columns - 2.0 / 3 * tall_columns * tall_columns * (double) tall_columns;
+
+    double *R = malloc((size_t) tall_columns * tall_columns * sizeof(double));
+
+    printf("##################################### TEST TSQR %d x %d #####################################\n", tall_rows,
+	   tall_columns);
+
+    start = omp_get_wtime();
+    TSQR_decomposition_into(A, tall_rows, tall_columns, NULL, R);
+    elapsed = omp_get_wtime() - start;
+
+    printf("TSQR_decomposition_into, R only   : %.3f seconds (%.2f GFLOPS).\n", elapsed, 1e-9 * flops / elapsed);
+
+    start = omp_get_wtime();
+    TSQR_decomposition_into(A, tall_rows, tall_columns, A, R);
+    elapsed = omp_get_wtime() - start;
+
+    printf("TSQR_decomposition_into, Q in A   : %.3f seconds (%.2f GFLOPS).\n", elapsed, 2e-9 * flops / elapsed);
+
+    start = omp_get_wtime();
+    QR_parallel = QR_decomposition_parallel(A, tall_rows, tall_columns);
+    elapsed = omp_get_wtime() - start;
+
+    printf("QR_decomposition_parallel, Q and R : %.3f seconds (%.2f GFLOPS).\n", elapsed, 2e-9 * flops / elapsed);
+
+    QR_free(QR_parallel);
+    free(R);
     free(A);
-    
-    free(QR_sequential->Q);
-    free(QR_sequential->R);
-    free(QR_sequential);
     
     return 0;
 
@@ -0,0 +1,94 @@
+#include "LinearAlgebraBasics.h"
+#include <omp.h>
+
+static double random_value(void) {
+
+    return (double) rand() / RAND_MAX - 0.5;
+
+}
+
+int main() {
+
+    srand(7);
+
+    printf("##################################### TEST BANDED AGAINST DENSE SOLVE #####################################\n");
+
+    // Same pentadiagonal system stored densely and as a band
+
+    int n = 1500, k = 2;
+
+    double *A = calloc((size_t) n * n, sizeof(double));
+    double *b = malloc(n * sizeof(double));
+
+    for (int i = 0; i < n; i++) {
+	for (int j = i - k; j <= i + k; j++)
+	    if (j >= 0 && j < n)
+		A[(size_t) i * n + j] = random_value() + (i == j ? 1.0 : 0.0);
+	b[i] = random_value();
+    }
+
+    double start = omp_get_wtime();
+    double *x_dense = solve_LU_system(A, b, n);
+    double elapsed_dense = omp_get_wtime() - start;
+
+    printf("solve_LU_system, n = %d             : %.4f seconds.\n", n, elapsed_dense);
+
+    banded_matrix *B = banded_from_dense(A, n, k, k);
+
+    start = omp_get_wtime();
+    banded_LU *F = banded_LU_decomposition(B);
+    double *x_banded = solve_banded_LU_system(F, b);
+    double elapsed_banded = omp_get_wtime() - start;
+
+    printf("banded LU solve, n = %d, %d diagonals : %.6f seconds (speedup %.0f).\n", n, 2 * k + 1, elapsed_banded,
+	   elapsed_dense / elapsed_banded);
+
+    free(x_dense);
+    free(x_banded);
+    banded_LU_free(F);
+    banded_free(B);
+    free(A);
+    free(b);
+
+    printf("##################################### TEST LARGE TRIDIAGONAL SYSTEMS #####################################\n");
+
+    index_t size = 10000000;
+
+    double *lower = malloc(size * sizeof(double));
+    double *diagonal = malloc(size * sizeof(double));
+    double *upper = malloc(size * sizeof(double));
+    double *B_batch = malloc(size * sizeof(double));
+    double *X = malloc(size * sizeof(double));
+
+    for (index_t i = 0; i < size; i++) {
+	lower[i] = random_value();
+	upper[i] = random_value();
+	diagonal[i] = 2.0 + random_value();
+	B_batch[i] = random_value();
+    }
+
+    start = omp_get_wtime();
+    solve_tridiagonal_system_into(lower, diagonal, upper, B_batch, size, X);
+    double elapsed_single = omp_get_wtime() - start;
+
+    printf("solve_tridiagonal_system, n = %" PRId64 "            : %.4f seconds (%.1f ns per row).\n", size,
+	   elapsed_single, 1e9 * elapsed_single / size);
+
+    index_t m = 1000, batch = size / m;
+
+    start = omp_get_wtime();
+    batched_solve_tridiagonal_system(lower, diagonal, upper, B_batch, m, batch, X);
+    double elapsed_batch = omp_get_wtime() - start;
+
+    printf("batched_solve_tridiagonal_system, %" PRId64 " x %" PRId64 " : %.4f seconds with %d threads.\n", batch, m,
+	   elapsed_batch, omp_get_max_threads());
+
+    free(lower);
+    free(diagonal);
+    free(upper);
+    free(B_batch);
+    free(X);
+
+    return 0;
+
+}
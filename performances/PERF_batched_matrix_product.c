@@ -0,0 +1,57 @@
+#include "LinearAlgebraBasics.h"
+#include <omp.h>
+
+int main() {
+
+    int sizes[] = {4, 8, 16, 32};
+
+    for (int t = 0; t < 4; t++) {
+
+	int d = sizes[t];
+
+	// Same memory footprint (32 MB per operand) for every size
+	int batch = 4000000 / (d * d);
+
+	double *P = generate_matrix_double(batch * d, d);
+	double *Q = generate_matrix_double(batch * d, d);
+	double *C = malloc((size_t) batch * d * d * sizeof(double));
+
+	// First touch of C outside the timed region
+	for (size_t i = 0; i < (size_t) batch * d * d; i++)
+	    C[i] = 0.0;
+
+	printf("##################################### TEST %d x %d MATRICES (BATCH OF %d) #####################################\n", d, d, batch);
+
+	// One call per product: validation and allocation paid every time
+
+	double start = omp_get_wtime();
+
+	for (int b = 0; b < batch; b++) {
+	    double *product = sequential_matrix_product(P + (size_t) b * d * d, d, d, Q + (size_t) b * d * d, d, d);
+	    free(product);
+	}
+
+	double elapsed_loop = omp_get_wtime() - start;
+
+	start = omp_get_wtime();
+
+	strided_batched_matrix_product(P, d, d, d * d, Q, d, d, d * d, C, d * d, batch);
+
+	double elapsed_batched = omp_get_wtime() - start;
+
+	double flops = 2.0 * batch * d * d * d;
+
+	printf("sequential_matrix_product loop   : %.4f seconds, %.2f GFLOP/s, %.2f Mproducts/s\n", elapsed_loop,
+	       flops / elapsed_loop * 1e-9, batch / elapsed_loop * 1e-6);
+	printf("strided_batched_matrix_product   : %.4f seconds, %.2f GFLOP/s, %.2f Mproducts/s (speedup %.2f)\n",
+	       elapsed_batched, flops / elapsed_batched * 1e-9, batch / elapsed_batched * 1e-6, elapsed_loop / elapsed_batched);
+
+	free(P);
+	free(Q);
+	free(C);
+
+    }
+
+    return 0;
+
+}
@@ -0,0 +1,161 @@
+#include "LinearAlgebraBasics.h"
+#include <omp.h>
+
+/*
+ * Single-precision copy of a double matrix, so both precisions work on the same values.
+ */
+
+static float *to_float(double *X, size_t n) {
+
+    float *Y = malloc(n * sizeof(float));
+
+    for (size_t i = 0; i < n; i++)
+	Y[i] = (float) X[i];
+
+    return Y;
+
+}
+
+static void report(const char *name, double elapsed_double, double elapsed_float, double flops) {
+
+    printf("%-32s double : %.4f seconds, %.2f GFLOP/s\n", name, elapsed_double, flops / elapsed_double * 1e-9);
+    printf("%-32s float  : %.4f seconds, %.2f GFLOP/s (speedup %.2f)\n", name, elapsed_float,
+	   flops / elapsed_float * 1e-9, elapsed_double / elapsed_float);
+
+}
+
+int main() {
+
+    int n = 2000;
+
+    double *P = generate_matrix_double(n, n);
+    double *Q = generate_matrix_double(n, n);
+    float *P_float = to_float(P, (size_t) n * n);
+    float *Q_float = to_float(Q, (size_t) n * n);
+
+    printf("##################################### TEST MATRIX PRODUCT %d x %d #####################################\n", n, n);
+
+    double start = omp_get_wtime();
+    double *C = sequential_matrix_product(P, n, n, Q, n, n);
+    double elapsed_double = omp_get_wtime() - start;
+
+    start = omp_get_wtime();
+    float *C_float = sequential_matrix_product_float(P_float, n, n, Q_float, n, n);
+    double elapsed_float = omp_get_wtime() - start;
+
+    report("sequential_matrix_product", elapsed_double, elapsed_float, 2.0 * n * n * n);
+
+    free(C);
+    free(C_float);
+
+    start = omp_get_wtime();
+    C = parallel_matrix_product(P, n, n, Q, n, n);
+    elapsed_double = omp_get_wtime() - start;
+
+    start = omp_get_wtime();
+    C_float = parallel_matrix_product_float(P_float, n, n, Q_float, n, n);
+    elapsed_float = omp_get_wtime() - start;
+
+    report("parallel_matrix_product", elapsed_double, elapsed_float, 2.0 * n * n * n);
+
+    free(C);
+    free(C_float);
+
+    printf("##################################### TEST VECTOR MATRIX PRODUCT #####################################\n");
+
+    // Memory-bound: float halves the bytes streamed from the matrix
+
+    int rows = 10000, columns = 10000, repetitions = 10;
+
+    double *A = generate_matrix_double(rows, columns);
+    float *A_float = to_float(A, (size_t) rows * columns);
+    double *X = generate_matrix_double(columns, 1);
+    float *X_float = to_float(X, columns);
+
+    double *Y = malloc(rows * sizeof(double));
+    float *Y_float = malloc(rows * sizeof(float));
+
+    start = omp_get_wtime();
+    for (int r = 0; r < repetitions; r++)
+	parallel_vector_matrix_product_into(A, rows, columns, X, columns, Y);
+    elapsed_double = omp_get_wtime() - start;
+
+    start = omp_get_wtime();
+    for (int r = 0; r < repetitions; r++)
+	parallel_vector_matrix_product_into_float(A_float, rows, columns, X_float, columns, Y_float);
+    elapsed_float = omp_get_wtime() - start;
+
+    report("parallel_vector_matrix_product", elapsed_double, elapsed_float, 2.0 * repetitions * rows * columns);
+
+    free(A);
+    free(A_float);
+    free(X);
+    free(X_float);
+    free(Y);
+    free(Y_float);
+
+    printf("##################################### TEST DECOMPOSITIONS %d x %d #####################################\n", n / 2, n / 2);
+
+    int d = n / 2;
+
+    double *M = generate_matrix_double(d, d);
+
+    for (int i = 0; i < d; i++)
+	M[i * d + i] += 100.0 * d;
+
+    float *M_float = to_float(M, (size_t) d * d);
+
+    start = omp_get_wtime();
+    LU *LU_double = LU_decomposition_parallel(M, d, d);
+    elapsed_double = omp_get_wtime() - start;
+
+    start = omp_get_wtime();
+    LU_float *LU_single = LU_decomposition_parallel_float(M_float, d, d);
+    elapsed_float = omp_get_wtime() - start;
+
+    report("LU_decomposition_parallel", elapsed_double, elapsed_float, 2.0 / 3.0 * d * d * d);
+
+    LU_free(LU_double);
+    LU_free_float(LU_single);
+
+    start = omp_get_wtime();
+    QR *QR_double = QR_decomposition_parallel(M, d, d);
+    elapsed_double = omp_get_wtime() - start;
+
+    start = omp_get_wtime();
+    QR_float *QR_single = QR_decomposition_parallel_float(M_float, d, d);
+    elapsed_float = omp_get_wtime() - start;
+
+    report("QR_decomposition_parallel", elapsed_double, elapsed_float, 2.0 * d * d * d);
+
+    QR_free(QR_double);
+    QR_free_float(QR_single);
+
+    double *S = gram_matrix(M, d, d);
+    float *S_float = gram_matrix_float(M_float, d, d);
+
+    start = omp_get_wtime();
+    Cholesky *cholesky = Cholesky_decomposition(S, d);
+    elapsed_double = omp_get_wtime() - start;
+
+    start = omp_get_wtime();
+    Cholesky_float *cholesky_float = Cholesky_decomposition_float(S_float, d);
+    elapsed_float = omp_get_wtime() - start;
+
+    report("Cholesky_decomposition", elapsed_double, elapsed_float, 1.0 / 3.0 * d * d * d);
+
+    free_Cholesky(cholesky);
+    free_Cholesky_float(cholesky_float);
+
+    free(S);
+    free(S_float);
+    free(M);
+    free(M_float);
+    free(P);
+    free(Q);
+    free(P_float);
+    free(Q_float);
+
+    return 0;
+
+}
@@ -0,0 +1,43 @@
+#include "LinearAlgebraBasics.h"
+#include <omp.h>
+
+int main() {
+
+    int sizes[] = {500, 1000, 2000};
+
+    for (int s = 0; s < 3; s++) {
+
+	index_t n = sizes[s];
+	double *A = generate_matrix_double(n, n);
+	double *real = malloc(n * sizeof(double)), *imaginary = malloc(n * sizeof(double));
+
+	for (index_t i = 0; i < n * n; i++)
+	    A[i] -= 0.5;
+
+	printf("##################################### TEST EIGENVALUES %" PRId64 " x %" PRId64 " #####################################\n",
+	       n, n);
+
+	double start = omp_get_wtime();
+
+	int status = matrix_eigenvalues_into(A, n, n, 100, 1e-15, real, imaginary);
+
+	double elapsed = omp_get_wtime() - start;
+
+	int pairs = 0;
+
+	for (index_t i = 0; i < n; i++)
+	    if (imaginary[i] > 0.0) pairs++;
+
+	// Usual operation count of the eigenvalues of a nonsymmetric matrix: 10 n^3 FLOPs
+	printf("matrix_eigenvalues_into : %.3f seconds (%.2f GFLOPS), status %d, %d conjugate pairs.\n", elapsed,
+	       1e-8 * n * n * (double) n / elapsed, status, pairs);
+
+	free(real);
+	free(imaginary);
+	free(A);
+
+    }
+
+    return 0;
+
+}
@@ -1,4 +1,5 @@
 #include "LinearAlgebraBasics.h"
+#include <omp.h>
 
 int main() {
 
@@ -30,10 +31,105 @@ int main() {
 
     printf("Elapsed time : %ld seconds.\n", (end - begin));
 
-    free(P);
-    free(Q);
+    printf("##################################### TEST STRASSEN MATRIX PRODUCT #####################################\n");
+
+    begin = time(NULL);
+
+    double *X_strassen = strassen_matrix_product(P, P_rows, P_columns, Q, Q_rows, Q_columns, 0);
+
+    end = time(NULL);
+
+    printf("Elapsed time : %ld seconds.\n", (end - begin));
+
     free(X_sequential);
     free(X_parallel);
+    free(X_strassen);
+
+    printf("##################################### TEST PARALLEL MATRIX PRODUCT SCALING #####################################\n");
+
+    int max_threads = omp_get_max_threads();
+    double reference = 0.0;
+
+    for (int threads = 1; ; threads *= 2) {
+
+	if (threads > max_threads) threads = max_threads;
+
+	omp_set_num_threads(threads);
+
+	double start = omp_get_wtime();
+
+	double *X_scaling = parallel_matrix_product(P, P_rows, P_columns, Q, Q_rows, Q_columns);
+
+	double elapsed = omp_get_wtime() - start;
+
+	if (threads == 1) reference = elapsed;
+
+	printf("%3d thread(s) : %.3f seconds, %.2f GFLOP/s, speedup %.2f\n", threads, elapsed,
+	       2.0 * P_rows * P_columns * Q_columns / elapsed * 1e-9, reference / elapsed);
+
+	free(X_scaling);
+
+	if (threads == max_threads) break;
+
+    }
+
+    omp_set_num_threads(max_threads);
+
+    printf("##################################### TEST FUSED C = P^T * Q + C #####################################\n");
+
+    double *C = generate_matrix_double(P_columns, Q_columns);
+
+    // Three allocating passes: transpose, product, addition
+
+    double start = omp_get_wtime();
+
+    double *P_transpose = matrix_transpose(P, P_rows, P_columns);
+    double *product = parallel_matrix_product(P_transpose, P_columns, P_rows, Q, Q_rows, Q_columns);
+    double *sum = matrices_addition(product, C, P_columns, Q_columns);
+
+    double elapsed = omp_get_wtime() - start;
+
+    printf("matrix_transpose + parallel_matrix_product + matrices_addition : %.3f seconds.\n", elapsed);
+
+    start = omp_get_wtime();
+
+    parallel_general_matrix_product(OP_TRANSPOSE, OP_NO_TRANSPOSE, P_columns, Q_columns, P_rows, 1.0,
+				    P, P_columns, Q, Q_columns, 1.0, C, Q_columns);
+
+    elapsed = omp_get_wtime() - start;
+
+    printf("parallel_general_matrix_product                                : %.3f seconds.\n", elapsed);
+
+    free(P_transpose);
+    free(product);
+    free(sum);
+    free(C);
+
+    printf("##################################### TEST GRAM MATRIX P^T * P #####################################\n");
+
+    start = omp_get_wtime();
+
+    P_transpose = matrix_transpose(P, P_rows, P_columns);
+    product = parallel_matrix_product(P_transpose, P_columns, P_rows, P, P_rows, P_columns);
+
+    elapsed = omp_get_wtime() - start;
+
+    printf("matrix_transpose + parallel_matrix_product : %.3f seconds.\n", elapsed);
+
+    start = omp_get_wtime();
+
+    double *gram = gram_matrix(P, P_rows, P_columns);
+
+    elapsed = omp_get_wtime() - start;
+
+    printf("gram_matrix                                : %.3f seconds.\n", elapsed);
+
+    free(P_transpose);
+    free(product);
+    free(gram);
+
+    free(P);
+    free(Q);
     
     return 0;
     
@@ -0,0 +1,63 @@
+#include "LinearAlgebraBasics.h"
+#include <omp.h>
+
+/*
+ * Adjacency-like matrix: each row links to nnz_per_row random columns.
+ */
+
+static sparse_matrix *generate_graph(index_t n, int nnz_per_row) {
+
+    index_t nnz = n * nnz_per_row;
+    index_t *row_indices = malloc(nnz * sizeof(index_t));
+    index_t *column_indices = malloc(nnz * sizeof(index_t));
+    double *values = malloc(nnz * sizeof(double));
+
+    srand(5);
+
+    for (index_t k = 0; k < nnz; k++) {
+	row_indices[k] = k / nnz_per_row;
+	column_indices[k] = (index_t) rand() % n;
+	values[k] = (double) rand() / RAND_MAX;
+    }
+
+    sparse_matrix *A = sparse_from_coo(n, n, nnz, row_indices, column_indices, values, SPARSE_CSR);
+
+    free(row_indices);
+    free(column_indices);
+    free(values);
+
+    return A;
+
+}
+
+int main() {
+
+    index_t n = 1000000;
+
+    sparse_matrix *A = generate_graph(n, 6);
+
+    printf("##################################### TEST SPARSE MATRIX PRODUCT %" PRId64 " x %" PRId64 ", %" PRId64 " nonzeros #####################################\n",
+	   n, n, A->nnz);
+
+    double start = omp_get_wtime();
+    sparse_matrix *C_sequential = sequential_sparse_matrix_product(A, A);
+    double elapsed_sequential = omp_get_wtime() - start;
+
+    printf("sequential_sparse_matrix_product : %.4f seconds, %" PRId64 " nonzeros in A * A.\n", elapsed_sequential,
+	   C_sequential->nnz);
+
+    sparse_free(C_sequential);
+
+    start = omp_get_wtime();
+    sparse_matrix *C_parallel = parallel_sparse_matrix_product(A, A);
+    double elapsed_parallel = omp_get_wtime() - start;
+
+    printf("parallel_sparse_matrix_product   : %.4f seconds (speedup %.2f).\n", elapsed_parallel,
+	   elapsed_sequential / elapsed_parallel);
+
+    sparse_free(C_parallel);
+    sparse_free(A);
+
+    return 0;
+
+}
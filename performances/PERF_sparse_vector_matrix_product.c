@@ -0,0 +1,98 @@
+#include "LinearAlgebraBasics.h"
+#include <omp.h>
+
+/*
+ * Random sparse matrix in COO form with about nnz_per_row nonzeros per row, except
+ * every 1000th row which is dense over its first 20000 columns.
+ */
+
+static index_t generate_coo(index_t rows, index_t columns, int nnz_per_row, index_t **row_indices,
+			    index_t **column_indices, double **values) {
+
+    index_t capacity = rows * nnz_per_row + (rows / 1000 + 1) * 20000;
+
+    *row_indices = malloc(capacity * sizeof(index_t));
+    *column_indices = malloc(capacity * sizeof(index_t));
+    *values = malloc(capacity * sizeof(double));
+
+    index_t nnz = 0;
+
+    srand(11);
+
+    for (index_t i = 0; i < rows; i++) {
+	int count = (i % 1000 == 0) ? 20000 : nnz_per_row;
+	for (int k = 0; k < count; k++) {
+	    (*row_indices)[nnz] = i;
+	    (*column_indices)[nnz] = (i % 1000 == 0) ? k : (index_t) rand() % columns;
+	    (*values)[nnz] = (double) rand() / RAND_MAX;
+	    nnz++;
+	}
+    }
+
+    return nnz;
+
+}
+
+int main() {
+
+    index_t rows = 500000, columns = 500000;
+    int repetitions = 20;
+
+    index_t *row_indices, *column_indices;
+    double *values;
+
+    index_t triplets = generate_coo(rows, columns, 20, &row_indices, &column_indices, &values);
+
+    double *X = generate_matrix_double(columns, 1);
+    double *Y = malloc(rows * sizeof(double));
+
+    printf("##################################### TEST CONSTRUCTION %" PRId64 " x %" PRId64 " #####################################\n",
+	   rows, columns);
+
+    double start = omp_get_wtime();
+    sparse_matrix *CSR = sparse_from_coo(rows, columns, triplets, row_indices, column_indices, values, SPARSE_CSR);
+    printf("sparse_from_coo (CSR), %" PRId64 " triplets : %.4f seconds.\n", triplets, omp_get_wtime() - start);
+
+    start = omp_get_wtime();
+    sparse_matrix *CSC = sparse_from_coo(rows, columns, triplets, row_indices, column_indices, values, SPARSE_CSC);
+    printf("sparse_from_coo (CSC), %" PRId64 " triplets : %.4f seconds.\n", triplets, omp_get_wtime() - start);
+
+    printf("##################################### TEST SPARSE VECTOR MATRIX PRODUCT #####################################\n");
+
+    // Bytes of the values and indices streamed per product
+    double bytes = (double) CSR->nnz * (sizeof(double) + sizeof(index_t));
+
+    sparse_matrix *matrices[] = {CSR, CSC};
+    const char *names[] = {"CSR", "CSC"};
+
+    for (int f = 0; f < 2; f++) {
+
+	start = omp_get_wtime();
+	for (int r = 0; r < repetitions; r++)
+	    sequential_sparse_vector_matrix_product_into(matrices[f], X, columns, Y);
+	double elapsed = (omp_get_wtime() - start) / repetitions;
+
+	printf("sequential_sparse_vector_matrix_product (%s) : %.4f seconds, %.2f GB/s\n", names[f], elapsed,
+	       bytes / elapsed * 1e-9);
+
+	start = omp_get_wtime();
+	for (int r = 0; r < repetitions; r++)
+	    parallel_sparse_vector_matrix_product_into(matrices[f], X, columns, Y);
+	elapsed = (omp_get_wtime() - start) / repetitions;
+
+	printf("parallel_sparse_vector_matrix_product (%s)   : %.4f seconds, %.2f GB/s\n", names[f], elapsed,
+	       bytes / elapsed * 1e-9);
+
+    }
+
+    sparse_free(CSR);
+    sparse_free(CSC);
+    free(row_indices);
+    free(column_indices);
+    free(values);
+    free(X);
+    free(Y);
+
+    return 0;
+
+}
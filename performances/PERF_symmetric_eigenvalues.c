@@ -0,0 +1,80 @@
+#include "LinearAlgebraBasics.h"
+#include <omp.h>
+#include <string.h>
+
+int main() {
+
+    int sizes[] = {500, 1000, 2000};
+
+    for (int s = 0; s < 3; s++) {
+
+	index_t n = sizes[s];
+	double *A = generate_matrix_double(n, n);
+	double *copy = malloc(n * n * sizeof(double)), *eigenvectors = malloc(n * n * sizeof(double));
+	double *real = malloc(n * sizeof(double)), *imaginary = malloc(n * sizeof(double)), *eigenvalues = malloc(n * sizeof(double));
+
+	for (index_t i = 0; i < n; i++)
+	    for (index_t j = 0; j <= i; j++)
+		A[i * n + j] = A[j * n + i] = 0.5 * (A[i * n + j] + A[j * n + i]);
+
+	memcpy(copy, A, n * n * sizeof(double));
+
+	printf("##################################### TEST SYMMETRIC EIGENVALUES %" PRId64 " x %" PRId64 " #####################################\n",
+	       n, n);
+
+	double start = omp_get_wtime();
+
+	int status = matrix_eigenvalues_into(copy, n, n, 100, 1e-15, real, imaginary);
+
+	double general = omp_get_wtime() - start;
+
+	printf("matrix_eigenvalues_into : %.3f seconds, status %d.\n", general, status);
+
+	start = omp_get_wtime();
+
+	double *values = symmetric_eigenvalues(A, n);
+
+	double elapsed = omp_get_wtime() - start;
+
+	// Tridiagonalization: 4/3 n^3 FLOPs, the QL iterations are O(n^2)
+	printf("symmetric_eigenvalues : %.3f seconds (%.2f GFLOPS), %.1fx faster than matrix_eigenvalues_into.\n", elapsed,
+	       4e-9 / 3.0 * n * n * (double) n / elapsed, general / elapsed);
+
+	start = omp_get_wtime();
+
+	status = symmetric_eigen_decomposition_into(A, n, eigenvalues, eigenvectors);
+
+	elapsed = omp_get_wtime() - start;
+
+	printf("symmetric_eigen_decomposition_into (eigenvectors) : %.3f seconds, status %d, %.1fx faster than matrix_eigenvalues_into.\n",
+	       elapsed, status, general / elapsed);
+
+	start = omp_get_wtime();
+
+	status = symmetric_eigen_decomposition_parallel_into(A, n, eigenvalues, eigenvectors);
+
+	elapsed = omp_get_wtime() - start;
+
+	printf("symmetric_eigen_decomposition_parallel_into (eigenvectors, %d threads) : %.3f seconds, status %d.\n",
+	       omp_get_max_threads(), elapsed, status);
+
+	double difference = 0.0;
+
+	for (index_t i = 0; values && i < n; i++)
+	    difference = fmax(difference, fabs(values[i] - eigenvalues[i]));
+
+	printf("Largest difference between the eigenvalues with and without eigenvectors : %e\n", difference);
+
+	free(values);
+	free(real);
+	free(imaginary);
+	free(eigenvalues);
+	free(eigenvectors);
+	free(copy);
+	free(A);
+
+    }
+
+    return 0;
+
+}
@@ -0,0 +1,91 @@
+#include "LinearAlgebraBasics.h"
+#include <omp.h>
+
+/*
+ * Random symmetric matrix.
+ */
+
+static double *generate_symmetric(index_t n) {
+
+    double *A = malloc((size_t) n * n * sizeof(double));
+
+    srand(9);
+
+    for (index_t i = 0; i < n; i++)
+	for (index_t j = 0; j <= i; j++) {
+	    double value = (double) rand() / RAND_MAX - 0.5;
+	    A[i * n + j] = value;
+	    A[j * n + i] = value;
+	}
+
+    return A;
+
+}
+
+int main() {
+
+    index_t n = 12000;
+    int repetitions = 10;
+
+    double *A = generate_symmetric(n);
+    packed_matrix *P = packed_from_dense(A, n, TRIANGLE_LOWER);
+    double *X = generate_matrix_double(n, 1);
+    double *Y = malloc(n * sizeof(double));
+
+    printf("##################################### TEST SYMMETRIC MATRIX-VECTOR PRODUCT %" PRId64 " x %" PRId64 " #####################################\n",
+	   n, n);
+
+    double start = omp_get_wtime();
+    for (int r = 0; r < repetitions; r++)
+	parallel_vector_matrix_product_into(A, n, n, X, n, Y);
+    double elapsed_dense = (omp_get_wtime() - start) / repetitions;
+
+    printf("parallel_vector_matrix_product, dense            : %.4f seconds, %.1f MB read (%.2f GB/s).\n",
+	   elapsed_dense, 8e-6 * n * n, 8e-9 * n * n / elapsed_dense);
+
+    start = omp_get_wtime();
+    for (int r = 0; r < repetitions; r++)
+	parallel_symmetric_vector_matrix_product_into(P, X, n, Y);
+    double elapsed_packed = (omp_get_wtime() - start) / repetitions;
+
+    printf("parallel_symmetric_vector_matrix_product, packed : %.4f seconds, %.1f MB read (speedup %.2f).\n",
+	   elapsed_packed, 4e-6 * n * (n + 1), elapsed_dense / elapsed_packed);
+
+    free(X);
+    free(Y);
+    packed_free(P);
+    free(A);
+
+    index_t m = 3000;
+
+    printf("##################################### TEST SYMMETRIC MATRIX PRODUCT %" PRId64 " x %" PRId64 " #####################################\n",
+	   m, m);
+
+    A = generate_symmetric(m);
+    P = packed_from_dense(A, m, TRIANGLE_LOWER);
+
+    double *B = generate_matrix_double(m, m);
+    double *C = malloc((size_t) m * m * sizeof(double));
+
+    start = omp_get_wtime();
+    parallel_matrix_product_into(A, m, m, B, m, m, C);
+    elapsed_dense = omp_get_wtime() - start;
+
+    printf("parallel_matrix_product, dense            : %.4f seconds (%.2f GFLOPS).\n", elapsed_dense,
+	   2e-9 * m * m * m / elapsed_dense);
+
+    start = omp_get_wtime();
+    parallel_symmetric_matrix_product_into(P, B, m, m, C);
+    elapsed_packed = omp_get_wtime() - start;
+
+    printf("parallel_symmetric_matrix_product, packed : %.4f seconds (%.2f GFLOPS) with half the storage for A.\n",
+	   elapsed_packed, 2e-9 * m * m * m / elapsed_packed);
+
+    free(B);
+    free(C);
+    packed_free(P);
+    free(A);
+
+    return 0;
+
+}
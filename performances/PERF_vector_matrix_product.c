@@ -1,50 +1,97 @@
 #include "LinearAlgebraBasics.h"
-#define DOUBLE 100.0
+#include <omp.h>
+
+/*
+ * A matrix-vector product is bound by the bandwidth at which A is read, so the
+ * rates below are given in GB/s of A streamed from memory.
+ */
+
+static void report(const char *name, double elapsed, double bytes) {
+
+    printf("%-44s : %.4f seconds, %.2f GB/s\n", name, elapsed, bytes / elapsed * 1e-9);
+
+}
 
 int main() {
 
-    int A_rows = 40000;
-    int A_columns = 40000;
-    int dimension = 40000;
+    index_t A_rows = 16000;
+    index_t A_columns = 16000;
+    index_t dimension = 16000;
+    int repetitions = 10, vectors = 8;
 
-    /* I can't test with more, otherwise I exceed the memory size of an integer when I allocate the 
-       matrix with a (rows x columns) size */
-    
     double *A = generate_matrix_double(A_rows, A_columns);
-    double *X = malloc(dimension * sizeof(double));
-
-    srand(time(NULL));
+    double *X = generate_matrix_double(vectors, dimension);
+    double *Y = malloc((size_t) vectors * A_rows * sizeof(double));
 
-    for (int i = 0; i < dimension; i++)
-	X[i] = (double) (rand()) / RAND_MAX * DOUBLE;
+    double bytes = (double) A_rows * A_columns * sizeof(double);
 
     printf("##################################### TEST SEQUENTIAL VECTOR MATRIX PRODUCT #####################################\n");
-    
-    time_t begin = time(NULL);
-    
-    double *vector_sequential = sequential_vector_matrix_product(A, A_rows, A_columns, X, dimension);
 
-    time_t end = time(NULL);
+    double start = omp_get_wtime();
+    for (int r = 0; r < repetitions; r++)
+	sequential_vector_matrix_product_into(A, A_rows, A_columns, X, dimension, Y);
+    double elapsed = (omp_get_wtime() - start) / repetitions;
+
+    report("sequential_vector_matrix_product", elapsed, bytes);
 
-    printf("Elapsed time : %ld seconds.\n", (end - begin));
-    
-    free(vector_sequential);
-    
     printf("##################################### TEST PARALLEL VECTOR MATRIX PRODUCT #####################################\n");
 
-    begin = time(NULL);
-    
-    double *vector_parallel = parallel_vector_matrix_product(A, A_rows, A_columns, X, dimension);
+    start = omp_get_wtime();
+    for (int r = 0; r < repetitions; r++)
+	parallel_vector_matrix_product_into(A, A_rows, A_columns, X, dimension, Y);
+    elapsed = (omp_get_wtime() - start) / repetitions;
+
+    report("parallel_vector_matrix_product", elapsed, bytes);
+
+    printf("##################################### TEST %d VECTORS #####################################\n", vectors);
+
+    // One product per vector streams A once per vector; the multi-vector product streams it once
+
+    start = omp_get_wtime();
+    for (int v = 0; v < vectors; v++)
+	parallel_vector_matrix_product_into(A, A_rows, A_columns, X + (size_t) v * dimension, dimension,
+					    Y + (size_t) v * A_rows);
+    double elapsed_separate = omp_get_wtime() - start;
 
-    end = time(NULL);
+    start = omp_get_wtime();
+    parallel_multi_vector_matrix_product(A, A_rows, A_columns, X, dimension, vectors, Y);
+    double elapsed_multi = omp_get_wtime() - start;
 
-    printf("Elapsed time : %ld seconds.\n", (end - begin));
-    
-    free(vector_parallel);
+    report("parallel_vector_matrix_product, one per vector", elapsed_separate, vectors * bytes);
+    report("parallel_multi_vector_matrix_product", elapsed_multi, bytes);
+    printf("Speedup of the multi-vector product : %.2f\n", elapsed_separate / elapsed_multi);
 
+    printf("##################################### TEST TRANSPOSED VECTOR MATRIX PRODUCT #####################################\n");
+
+    // Native X^T * A against forming the transpose first
+
+    start = omp_get_wtime();
+    double *A_t = matrix_transpose(A, A_rows, A_columns);
+    parallel_vector_matrix_product_into(A_t, A_columns, A_rows, X, dimension, Y);
+    elapsed = omp_get_wtime() - start;
+
+    free(A_t);
+
+    report("matrix_transpose + parallel product", elapsed, bytes);
+
+    start = omp_get_wtime();
+    for (int r = 0; r < repetitions; r++)
+	sequential_transposed_vector_matrix_product_into(A, A_rows, A_columns, X, dimension, Y);
+    elapsed = (omp_get_wtime() - start) / repetitions;
+
+    report("sequential_transposed_vector_matrix_product", elapsed, bytes);
+
+    start = omp_get_wtime();
+    for (int r = 0; r < repetitions; r++)
+	parallel_transposed_vector_matrix_product_into(A, A_rows, A_columns, X, dimension, Y);
+    elapsed = (omp_get_wtime() - start) / repetitions;
+
+    report("parallel_transposed_vector_matrix_product", elapsed, bytes);
+
+    free(Y);
     free(X);
     free(A);
-    
+
     return 0;
 
 }
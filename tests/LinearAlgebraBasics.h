@@ -0,0 +1,99 @@
+#ifndef __LinearAlgebraBasics_
+#define __LinearAlgebraBasics_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <math.h>
+#include <inttypes.h>
+
+/**
+ * @brief Integer type of the dimensions and indices of vectors and matrices.
+ *
+ * Dimensions, leading dimensions and every offset such as i * columns + j are
+ * computed in 64 bits, so a matrix may hold more than 2^31 elements (beyond about
+ * 46341 x 46341) and a dimension may exceed 2^31 - 1. Print it with PRId64.
+ */
+
+typedef int64_t index_t;
+
+/* simd_kernels.c */
+
+/**
+ * @brief Returns the name of the instruction set used by the kernels.
+ *
+ * The widest instruction set supported by the CPU (AVX-512, AVX2 with FMA, SSE2,
+ * or generic C code) is detected with cpuid when the library is loaded. The
+ * LINEAR_ALGEBRA_BASICS_ISA environment variable can request another one.
+ *
+ * @return "generic", "sse2", "avx2" or "avx512".
+ */
+
+const char *simd_instruction_set(void);
+
+/**
+ * @brief Selects the instruction set used by the kernels.
+ *
+ * The selection applies to every subsequent call of the library. It should not be
+ * changed while another thread is running a kernel.
+ *
+ * @param name Name of the instruction set ("generic", "sse2", "avx2" or "avx512").
+ *
+ * @return 0 on success, or -1 on failure when the name is unknown or the CPU does not
+ *         support the instruction set.
+ */
+
+int simd_select_instruction_set(const char *name);
+
+/**
+ * @brief Flags selecting op(X) = X or op(X) = X^T in the general matrix products.
+ */
+
+#define OP_NO_TRANSPOSE 0
+#define OP_TRANSPOSE 1
+
+/**
+ * @brief Flags selecting the triangle of a symmetric matrix that is computed or read.
+ */
+
+#define TRIANGLE_LOWER 0
+#define TRIANGLE_UPPER 1
+
+/**
+ * @brief Default dimension under which the Strassen recursion falls back to the blocked engine.
+ */
+
+#define STRASSEN_DEFAULT_CUTOFF 512
+
+/**
+ * @brief Storage formats of a sparse matrix: compressed sparse rows or compressed sparse columns.
+ */
+
+#define SPARSE_CSR 0
+#define SPARSE_CSC 1
+
+/*
+ * Every function and structure exists in double precision under its plain name
+ * (LU, sequential_matrix_product, ...) and in single precision with a "_float"
+ * suffix (LU_float, sequential_matrix_product_float, ...), with float replacing
+ * double in every argument. Both sets are generated from the same sources.
+ */
+
+#define REAL double
+#define FN(name) name
+#define TYPED(name) name##_double
+#include "LinearAlgebraReal.h"
+#undef REAL
+#undef FN
+#undef TYPED
+
+#define REAL float
+#define FN(name) name##_float
+#define TYPED(name) name##_float
+#include "LinearAlgebraReal.h"
+#undef REAL
+#undef FN
+#undef TYPED
+
+#endif
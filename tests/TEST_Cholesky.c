@@ -1,5 +1,47 @@
 #include "LinearAlgebraBasics.h"
 
+/*
+ * Random symmetric matrix made positive definite by a diagonal shift of its size.
+ */
+
+static double *generate_positive_definite(int n) {
+
+    double *A = malloc((size_t) n * n * sizeof(double));
+
+    for (int i = 0; i < n; i++)
+	for (int j = 0; j <= i; j++) {
+	    double value = (double) rand() / RAND_MAX - 0.5 + (i == j ? n : 0.0);
+	    A[i * n + j] = value;
+	    A[j * n + i] = value;
+	}
+
+    return A;
+
+}
+
+/*
+ * Relative error max |A - L L^T| / max |A|, also checking that L is lower triangular and L_t its transpose.
+ */
+
+static double Cholesky_error(Cholesky *C, double *A) {
+
+    int n = C->size;
+    double error = 0.0, norm = 0.0;
+
+    for (int i = 0; i < n; i++)
+	for (int j = 0; j < n; j++) {
+	    double sum = 0.0;
+	    for (int k = 0; k <= (i < j ? i : j); k++)
+		sum += C->L[i * n + k] * C->L[j * n + k];
+	    error = fmax(error, fabs(A[i * n + j] - sum));
+	    norm = fmax(norm, fabs(A[i * n + j]));
+	    if ((j > i && C->L[i * n + j] != 0.0) || C->L_t[j * n + i] != C->L[i * n + j]) return INFINITY;
+	}
+
+    return error / norm;
+
+}
+
 int main() {
 
     double A[] = {1.0, 1.0, 1.0, 1.0,
@@ -33,6 +75,75 @@ int main() {
 
     free_Cholesky(Cholesky_test);
 
+    printf("############################# TEST CHOLESKY PARALLEL #############################\n");
+
+    // Tiled factorization across one, several and partial tiles
+
+    srand(5);
+
+    int sizes[] = {1, 7, 256, 300, 700};
+
+    for (int s = 0; s < 5; s++) {
+
+	int n = sizes[s];
+	double *M = generate_positive_definite(n);
+
+	Cholesky *C_sequential = Cholesky_decomposition(M, n);
+	Cholesky *C_parallel = Cholesky_decomposition_parallel(M, n);
+	double error_sequential = Cholesky_error(C_sequential, M), error_parallel = Cholesky_error(C_parallel, M);
+
+	printf("Cholesky_decomposition / Cholesky_decomposition_parallel, n = %d : max relative error %e / %e (%s)\n", n,
+	       error_sequential, error_parallel, (error_sequential < 1e-14 && error_parallel < 1e-14) ? "OK" : "FAILED");
+
+	free_Cholesky(C_sequential);
+	free_Cholesky(C_parallel);
+
+	// A negative eigenvalue only revealed by the trailing updates, in the last tile
+	for (int i = 0; n > 1 && i < n; i++)
+	    M[i * n + n - 1] = M[(n - 1) * n + i] = (i == n - 1) ? 1.0 : 2.0;
+
+	if (n > 1)
+	    printf("Matrix that is not positive definite rejected by Cholesky_decomposition_parallel (%s)\n",
+		   Cholesky_decomposition_parallel(M, n) == NULL ? "OK" : "FAILED");
+
+	free(M);
+
+    }
+
+    printf("############################# TEST CHOLESKY INTO #############################\n");
+
+    // Single-matrix factorizations, in place and into another matrix
+
+    int n = 600;
+    double *M = generate_positive_definite(n);
+    double *L_in_place = malloc((size_t) n * n * sizeof(double));
+    double *L = malloc((size_t) n * n * sizeof(double));
+
+    for (int k = 0; k < n * n; k++)
+	L_in_place[k] = M[k];
+
+    int status = Cholesky_factorization_into(L_in_place, n, L_in_place);
+    status |= Cholesky_factorization_parallel_into(M, n, L);
+
+    Cholesky *reference = Cholesky_decomposition(M, n);
+    int same = 1;
+
+    for (int k = 0; k < n * n; k++)
+	same &= L[k] == reference->L[k] && L_in_place[k] == reference->L[k];
+
+    printf("Cholesky_factorization_into in place and Cholesky_factorization_parallel_into : same factor as Cholesky_decomposition (%s)\n",
+	   (!status && same) ? "OK" : "FAILED");
+
+    M[0] = -1.0;
+
+    printf("Matrix that is not positive definite rejected by Cholesky_factorization_into (%s)\n",
+	   Cholesky_factorization_into(M, n, L) == -1 ? "OK" : "FAILED");
+
+    free_Cholesky(reference);
+    free(L);
+    free(L_in_place);
+    free(M);
+
     return 0;
     
 }
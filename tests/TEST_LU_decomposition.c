@@ -1,5 +1,44 @@
 #include "LinearAlgebraBasics.h"
 
+/*
+ * Relative error max |P A - L U| / max |A| of an LU decomposition with partial pivoting,
+ * and largest multiplier in L (at most 1 with partial pivoting).
+ */
+
+static double LU_error(LU *F, double *A, double *largest_multiplier) {
+
+    index_t m = F->rows, n = F->columns, steps = m < n ? m : n;
+    double *PA = malloc((size_t) m * n * sizeof(double));
+    double error = 0.0, norm = 0.0;
+
+    for (index_t k = 0; k < m * n; k++)
+	PA[k] = A[k];
+
+    for (index_t i = 0; i < steps; i++)
+	for (index_t j = 0; j < n; j++) {
+	    double swap = PA[i * n + j];
+	    PA[i * n + j] = PA[F->pivots[i] * n + j];
+	    PA[F->pivots[i] * n + j] = swap;
+	}
+
+    *largest_multiplier = 0.0;
+
+    for (index_t i = 0; i < m; i++)
+	for (index_t j = 0; j < n; j++) {
+	    double sum = 0.0;
+	    for (index_t k = 0; k <= (i < j ? i : j) && k < steps; k++)
+		sum += F->L[i * n + k] * F->U[k * n + j];
+	    error = fmax(error, fabs(PA[i * n + j] - sum));
+	    norm = fmax(norm, fabs(A[i * n + j]));
+	    if (j < i) *largest_multiplier = fmax(*largest_multiplier, fabs(F->L[i * n + j]));
+	}
+
+    free(PA);
+
+    return error / norm;
+
+}
+
 int main() {
     
     printf("##################################### TEST LU DECOMPOSITION 1 #####################################\n");
@@ -103,6 +142,137 @@ int main() {
 
     LU_free(LU_test_parallel2);
     
+    printf("##################################### TEST LU DECOMPOSITION 3 #####################################\n");
+
+    // P A = L U on matrices spanning several panels, square and rectangular
+
+    int shapes[][2] = {{1, 1}, {7, 7}, {300, 300}, {517, 517}, {400, 150}, {150, 400}};
+
+    for (int s = 0; s < 6; s++) {
+
+	int m = shapes[s][0], n = shapes[s][1];
+	double *M = generate_matrix_double(m, n);
+
+	for (int parallel = 0; parallel < 2; parallel++) {
+
+	    LU *F = parallel ? LU_decomposition_parallel(M, m, n) : LU_decomposition(M, m, n);
+	    double largest_multiplier;
+	    double error = LU_error(F, M, &largest_multiplier);
+
+	    printf("%s, %d x %d : max relative error of P A - L U %e, largest multiplier %f (%s)\n",
+		   parallel ? "LU_decomposition_parallel" : "LU_decomposition", m, n, error, largest_multiplier,
+		   (error < 1e-13 && largest_multiplier <= 1.0) ? "OK" : "FAILED");
+
+	    LU_free(F);
+
+	}
+
+	free(M);
+
+    }
+
+    printf("##################################### TEST LU DECOMPOSITION 4 #####################################\n");
+
+    // A zero leading element needs a row interchange
+
+    double C[] = {0.0, 1.0, 1.0, 1.0};
+    double c[] = {2.0, 3.0};
+    double *x = solve_LU_system(C, c, 2);
+
+    printf("solve_LU_system with a zero pivot in the unpivoted factorization : x = (%f, %f) (%s)\n", x[0], x[1],
+	   (x[0] == 1.0 && x[1] == 2.0) ? "OK" : "FAILED");
+    printf("matrix_determinant of the same matrix : %f (%s)\n", matrix_determinant(C, 2, 2),
+	   matrix_determinant(C, 2, 2) == -1.0 ? "OK" : "FAILED");
+
+    free(x);
+
+    printf("##################################### TEST LU DECOMPOSITION 5 #####################################\n");
+
+    // Compact L\U factors, in place and into another matrix, against LU_decomposition
+
+    int n = 300;
+    double *M = generate_matrix_double(n, n);
+    double *LU_in_place = malloc((size_t) n * n * sizeof(double));
+    double *LU_compact = malloc((size_t) n * n * sizeof(double));
+    index_t *pivots_in_place = malloc(n * sizeof(index_t)), *pivots = malloc(n * sizeof(index_t));
+
+    for (int k = 0; k < n * n; k++)
+	LU_in_place[k] = M[k];
+
+    int status = LU_factorization_into(LU_in_place, n, n, LU_in_place, pivots_in_place);
+    status |= LU_factorization_parallel_into(M, n, n, LU_compact, pivots);
+
+    LU *F = LU_decomposition(M, n, n);
+    int same = 1;
+
+    for (int i = 0; i < n; i++) {
+	same &= pivots[i] == F->pivots[i] && pivots_in_place[i] == F->pivots[i];
+	for (int j = 0; j < n; j++) {
+	    double expected = j < i ? F->L[i * n + j] : F->U[i * n + j];
+	    same &= LU_compact[i * n + j] == expected && LU_in_place[i * n + j] == expected;
+	}
+    }
+
+    printf("LU_factorization_into in place and LU_factorization_parallel_into : same factors as LU_decomposition (%s)\n",
+	   (!status && same) ? "OK" : "FAILED");
+
+    LU_free(F);
+
+    // Solve, determinant and inverse from the factors
+
+    double *rhs = generate_matrix_double(n, 1);
+    double *reference = solve_LU_system(M, rhs, n);
+    double *solution = solve_LU_factored_system(LU_compact, pivots, n, rhs);
+    double error = 0.0, norm = 0.0;
+
+    for (int i = 0; i < n; i++) {
+	error = fmax(error, fabs(solution[i] - reference[i]));
+	norm = fmax(norm, fabs(reference[i]));
+    }
+
+    printf("solve_LU_factored_system : max relative error %e (%s)\n", error / norm, error / norm < 1e-12 ? "OK" : "FAILED");
+
+    // Small enough for the determinant not to overflow
+    double small[400];
+    index_t small_pivots[20];
+
+    for (int k = 0; k < 400; k++)
+	small[k] = M[k];
+
+    status = LU_factorization_into(small, 20, 20, small, small_pivots);
+
+    double determinant = LU_factored_determinant(small, small_pivots, 20);
+    double reference_determinant = matrix_determinant(M, 20, 20);
+
+    printf("LU_factored_determinant : relative error %e (%s)\n", fabs(determinant / reference_determinant - 1.0),
+	   (!status && fabs(determinant / reference_determinant - 1.0) < 1e-12) ? "OK" : "FAILED");
+
+    double *inverse = LU_factored_inverse(LU_compact, pivots, n);
+    error = 0.0;
+
+    for (int i = 0; i < n; i++)
+	for (int j = 0; j < n; j++) {
+	    double sum = 0.0;
+	    for (int k = 0; k < n; k++)
+		sum += M[i * n + k] * inverse[k * n + j];
+	    error = fmax(error, fabs(sum - (i == j ? 1.0 : 0.0)));
+	}
+
+    printf("LU_factored_inverse : max error of A A^-1 - I %e (%s)\n", error, error < 1e-10 ? "OK" : "FAILED");
+
+    printf("Inverse overlapping the factors rejected (%s)\n",
+	   LU_factored_inverse_into(LU_compact, pivots, n, LU_compact) == -1 ? "OK" : "FAILED");
+
+    free(inverse);
+    free(rhs);
+    free(reference);
+    free(solution);
+    free(pivots);
+    free(pivots_in_place);
+    free(LU_compact);
+    free(LU_in_place);
+    free(M);
+
     return 0;
 
 }
@@ -1,4 +1,47 @@
 #include "LinearAlgebraBasics.h"
+#include <omp.h>
+
+/*
+ * Largest residual |A - Q R| relative to the largest element of A, and largest departure of Q^T Q
+ * from the identity. R must be upper triangular with a nonnegative diagonal.
+ */
+
+static void QR_errors(QR *F, double *A, double *residual, double *orthogonality) {
+
+    int m = F->rows, n = F->columns;
+    double norm = 0.0;
+
+    *residual = 0.0;
+    *orthogonality = 0.0;
+
+    for (int i = 0; i < m; i++)
+	for (int j = 0; j < n; j++) {
+	    double sum = 0.0;
+	    for (int k = 0; k <= j; k++)
+		sum += F->Q[i * n + k] * F->R[k * n + j];
+	    *residual = fmax(*residual, fabs(A[i * n + j] - sum));
+	    norm = fmax(norm, fabs(A[i * n + j]));
+	}
+
+    *residual /= norm;
+
+    // Q^T Q accumulated row after row of Q
+    double *G = calloc((size_t) n * n, sizeof(double));
+
+    for (int k = 0; k < m; k++)
+	for (int i = 0; i < n; i++)
+	    for (int j = 0; j < n; j++)
+		G[i * n + j] += F->Q[k * n + i] * F->Q[k * n + j];
+
+    for (int i = 0; i < n; i++)
+	for (int j = 0; j < n; j++) {
+	    *orthogonality = fmax(*orthogonality, fabs(G[i * n + j] - (i == j)));
+	    if ((i > j && F->R[i * n + j] != 0.0) || (i == j && F->R[i * n + i] < 0.0)) *orthogonality = INFINITY;
+	}
+
+    free(G);
+
+}
 
 int main() {
 
@@ -51,6 +94,284 @@ int main() {
 
     QR_free(QR_test);
     QR_free(QR_parallel_test);
+
+    printf("##################################### TEST QR ACCURACY #####################################\n");
+
+    // Square and tall matrices over several panels and, in parallel, several tiles of columns
+
+    int shapes[][2] = {{1, 1}, {7, 3}, {300, 300}, {517, 130}, {700, 600}};
+
+    for (int s = 0; s < 5; s++) {
+
+	int m = shapes[s][0], n = shapes[s][1];
+	double *B = generate_matrix_double(m, n);
+
+	QR *sequential = QR_decomposition(B, m, n);
+	QR *parallel = QR_decomposition_parallel(B, m, n);
+
+	double residual, orthogonality, residual_parallel, orthogonality_parallel;
+
+	QR_errors(sequential, B, &residual, &orthogonality);
+	QR_errors(parallel, B, &residual_parallel, &orthogonality_parallel);
+
+	printf("QR_decomposition, %d x %d : residual %e, orthogonality %e (%s)\n", m, n, residual, orthogonality,
+	       residual < 1e-12 && orthogonality < 1e-12 ? "OK" : "FAILED");
+	printf("QR_decomposition_parallel, %d x %d : residual %e, orthogonality %e (%s)\n", m, n, residual_parallel,
+	       orthogonality_parallel, residual_parallel < 1e-12 && orthogonality_parallel < 1e-12 ? "OK" : "FAILED");
+
+	QR_free(sequential);
+	QR_free(parallel);
+	free(B);
+
+    }
+
+    printf("##################################### TEST QR RANK DEFICIENT #####################################\n");
+
+    // A repeated column and a zero column: Gram-Schmidt stopped on them, Householder gives zeros on the diagonal of R
+
+    int m = 200, n = 100;
+    double *B = generate_matrix_double(m, n);
+
+    for (int i = 0; i < m; i++) {
+	B[i * n + 50] = B[i * n + 10];
+	B[i * n + 70] = 0.0;
+    }
+
+    QR *deficient = QR_decomposition_parallel(B, m, n);
+    double residual = INFINITY, orthogonality = INFINITY;
+
+    if (deficient) QR_errors(deficient, B, &residual, &orthogonality);
+
+    printf("QR_decomposition_parallel, rank %d of %d columns : residual %e, orthogonality %e, R[50][50] = %e, R[70][70] = %e (%s)\n",
+	   n - 2, n, residual, orthogonality, deficient ? deficient->R[50 * n + 50] : NAN,
+	   deficient ? deficient->R[70 * n + 70] : NAN,
+	   deficient && residual < 1e-12 && orthogonality < 1e-12 && fabs(deficient->R[50 * n + 50]) < 1e-12 &&
+	   fabs(deficient->R[70 * n + 70]) < 1e-12 ? "OK" : "FAILED");
+
+    printf("More columns than rows rejected (%s)\n", QR_decomposition(B, 50, 100) == NULL ? "OK" : "FAILED");
+
+    QR_free(deficient);
+    free(B);
+
+    printf("##################################### TEST QR IMPLICIT Q #####################################\n");
+
+    // Compact factors: Q^T A gives [R; 0], Q undoes Q^T on vectors and on blocks of few and many columns
+
+    m = 400;
+    n = 150;
+    B = generate_matrix_double(m, n);
+
+    double *factors = malloc((size_t) m * n * sizeof(double));
+    double *tau = malloc(n * sizeof(double));
+    int status = QR_factorization_into(B, m, n, factors, tau);
+
+    double *QTA = QR_factored_apply_Q(factors, tau, m, n, OP_TRANSPOSE, B, n);
+    double error = 0.0, norm = 0.0;
+
+    for (int i = 0; QTA && i < m; i++)
+	for (int j = 0; j < n; j++) {
+	    error = fmax(error, fabs(QTA[i * n + j] - (j >= i ? factors[i * n + j] : 0.0)));
+	    norm = fmax(norm, fabs(factors[i * n + j]));
+	}
+
+    printf("QR_factored_apply_Q, Q^T A = [R; 0] : max relative error %e (%s)\n", error / norm,
+	   !status && QTA && error / norm < 1e-12 ? "OK" : "FAILED");
+
+    int blocks[] = {1, 3, 40, 300};
+
+    for (int s = 0; s < 4; s++) {
+
+	int k = blocks[s];
+	double *X = generate_matrix_double(m, k);
+	double *Y = malloc((size_t) m * k * sizeof(double));
+
+	status = QR_factored_apply_Q_into(factors, tau, m, n, OP_TRANSPOSE, X, k, Y);
+
+	double norm_X = 0.0, norm_Y = 0.0;
+
+	for (int i = 0; i < m * k; i++) {
+	    norm_X += X[i] * X[i];
+	    norm_Y += Y[i] * Y[i];
+	}
+
+	status = status || QR_factored_apply_Q_into(factors, tau, m, n, OP_NO_TRANSPOSE, Y, k, Y);
+
+	error = 0.0;
+	norm = 0.0;
+
+	for (int i = 0; i < m * k; i++) {
+	    error = fmax(error, fabs(Y[i] - X[i]));
+	    norm = fmax(norm, fabs(X[i]));
+	}
+
+	printf("QR_factored_apply_Q_into, %d x %d block : Q Q^T B = B with max relative error %e, norm kept to %e (%s)\n",
+	       m, k, error / norm, fabs(norm_Y / norm_X - 1.0),
+	       !status && error / norm < 1e-13 && fabs(norm_Y / norm_X - 1.0) < 1e-13 ? "OK" : "FAILED");
+
+	free(X);
+	free(Y);
+
+    }
+
+    // The explicit thin Q, formed on request, against Q^T b
+
+    double *Q = QR_factored_form_Q(factors, tau, m, n);
+    double *b = generate_matrix_double(m, 1);
+    double *QTb = QR_factored_apply_Q(factors, tau, m, n, OP_TRANSPOSE, b, 1);
+
+    error = 0.0;
+    norm = 0.0;
+
+    for (int j = 0; Q && QTb && j < n; j++) {
+	double sum = 0.0;
+	for (int i = 0; i < m; i++)
+	    sum += Q[i * n + j] * b[i];
+	error = fmax(error, fabs(sum - QTb[j]));
+	norm = fmax(norm, fabs(QTb[j]));
+    }
+
+    printf("QR_factored_form_Q, thin Q^T b against QR_factored_apply_Q : max relative error %e (%s)\n", error / norm,
+	   Q && QTb && error / norm < 1e-13 ? "OK" : "FAILED");
+
+    printf("Unknown operation rejected (%s)\n", QR_factored_apply_Q(factors, tau, m, n, 2, b, 1) == NULL ? "OK" : "FAILED");
+
+    free(Q);
+    free(QTb);
+    free(b);
+    free(QTA);
+    free(tau);
+    free(factors);
+
+    // Wide matrix factored in place: Q (m x m) times the upper trapezoid R gives A back
+
+    m = 150;
+    n = 400;
+
+    double *W = generate_matrix_double(m, n);
+
+    factors = malloc((size_t) m * n * sizeof(double));
+    tau = malloc(m * sizeof(double));
+
+    for (int i = 0; i < m * n; i++)
+	factors[i] = W[i];
+
+    status = QR_factorization_parallel_into(factors, m, n, factors, tau);
+    Q = QR_factored_form_Q(factors, tau, m, n);
+
+    error = 0.0;
+    norm = 0.0;
+
+    for (int i = 0; Q && i < m; i++)
+	for (int j = 0; j < n; j++) {
+	    double sum = 0.0;
+	    for (int k = 0; k < m && k <= j; k++)
+		sum += Q[i * m + k] * factors[k * n + j];
+	    error = fmax(error, fabs(sum - W[i * n + j]));
+	    norm = fmax(norm, fabs(W[i * n + j]));
+	}
+
+    printf("QR_factorization_parallel_into in place, %d x %d : max relative error %e (%s)\n", m, n, error / norm,
+	   !status && Q && error / norm < 1e-12 ? "OK" : "FAILED");
+
+    free(Q);
+    free(tau);
+    free(factors);
+    free(W);
+
+    printf("##################################### TEST TSQR #####################################\n");
+
+    // Four threads whatever the machine, so that the reduction tree has several levels
+
+    omp_set_num_threads(4);
+
+    int tall[][2] = {{50, 50}, {3001, 130}, {60000, 5}, {40000, 50}};
+
+    for (int s = 0; s < 4; s++) {
+
+	m = tall[s][0];
+	n = tall[s][1];
+	B = generate_matrix_double(m, n);
+
+	QR *tsqr = TSQR_decomposition(B, m, n);
+	QR *householder = QR_decomposition(B, m, n);
+
+	double residual, orthogonality, difference = 0.0;
+
+	QR_errors(tsqr, B, &residual, &orthogonality);
+
+	for (int k = 0; k < n * n; k++)
+	    difference = fmax(difference, fabs(tsqr->R[k] - householder->R[k]) / fabs(householder->R[0]));
+
+	// The residual relative to the largest element of A grows with the number of rows
+	printf("TSQR_decomposition, %d x %d : residual %e, orthogonality %e, R against QR_decomposition %e (%s)\n", m, n,
+	       residual, orthogonality, difference, residual < 1e-11 && orthogonality < 1e-12 && difference < 1e-12 ? "OK" : "FAILED");
+
+	// R alone leaves A untouched, Q in place of A gives the same factors
+
+	double *R = malloc((size_t) n * n * sizeof(double));
+	int same = !TSQR_decomposition_into(B, m, n, NULL, R);
+
+	for (int k = 0; same && k < n * n; k++)
+	    same = R[k] == tsqr->R[k];
+	for (int k = 0; same && k < m * n; k++)
+	    same = B[k] == tsqr->A[k];
+
+	same = same && !TSQR_decomposition_into(B, m, n, B, R);
+
+	for (int k = 0; same && k < m * n; k++)
+	    same = B[k] == tsqr->Q[k];
+
+	printf("TSQR_decomposition_into, %d x %d : R alone and Q in place of A (%s)\n", m, n, same ? "OK" : "FAILED");
+
+	free(R);
+	QR_free(tsqr);
+	QR_free(householder);
+	free(B);
+
+    }
+
+    // Teams smaller than omp_get_max_threads(): a call from a parallel region (nested parallelism
+    // off) and dynamic adjustment of a request for more threads than the machine runs
+
+    m = 20000;
+    n = 20;
+    B = generate_matrix_double(m, n);
+
+    QR *householder = QR_decomposition(B, m, n);
+
+    for (int dynamic = 0; dynamic < 2; dynamic++) {
+
+	QR *tsqr = NULL;
+
+	if (dynamic) {
+	    omp_set_dynamic(1);
+	    omp_set_num_threads(64);
+	    tsqr = TSQR_decomposition(B, m, n);
+	    omp_set_dynamic(0);
+	    omp_set_num_threads(4);
+	} else {
+#pragma omp parallel num_threads(2)
+#pragma omp single
+	    tsqr = TSQR_decomposition(B, m, n);
+	}
+
+	double residual, orthogonality, difference = 0.0;
+
+	QR_errors(tsqr, B, &residual, &orthogonality);
+
+	for (int k = 0; k < n * n; k++)
+	    difference = fmax(difference, fabs(tsqr->R[k] - householder->R[k]) / fabs(householder->R[0]));
+
+	printf("TSQR_decomposition, %s : residual %e, orthogonality %e, R against QR_decomposition %e (%s)\n",
+	       dynamic ? "dynamic team of up to 64 threads" : "inside a parallel region", residual, orthogonality, difference,
+	       residual < 1e-11 && orthogonality < 1e-12 && difference < 1e-12 ? "OK" : "FAILED");
+
+	QR_free(tsqr);
+
+    }
+
+    QR_free(householder);
+    free(B);
     
     return 0;
 
@@ -0,0 +1,210 @@
+#include "LinearAlgebraBasics.h"
+
+/*
+ * Relative residual ||A x - b|| / ||b|| of a dense system.
+ */
+
+static double residual(double *A, double *x, double *b, int n) {
+
+    double *Ax = sequential_vector_matrix_product(A, n, n, x, n);
+    double difference = 0.0, norm = 0.0;
+
+    for (int i = 0; i < n; i++) {
+	difference += (Ax[i] - b[i]) * (Ax[i] - b[i]);
+	norm += b[i] * b[i];
+    }
+
+    free(Ax);
+
+    return sqrt(difference / norm);
+
+}
+
+static double random_value(void) {
+
+    return (double) rand() / RAND_MAX - 0.5;
+
+}
+
+int main() {
+
+    srand(3);
+
+    printf("##################################### TEST 1 #####################################\n");
+
+    // Tridiagonal system with the Thomas algorithm, diagonally dominant
+
+    int n = 1000;
+
+    double *lower = malloc(n * sizeof(double));
+    double *diagonal = malloc(n * sizeof(double));
+    double *upper = malloc(n * sizeof(double));
+    double *b = malloc(n * sizeof(double));
+
+    for (int i = 0; i < n; i++) {
+	lower[i] = random_value();
+	upper[i] = random_value();
+	diagonal[i] = 2.0 + random_value();
+	b[i] = random_value();
+    }
+
+    double *x = solve_tridiagonal_system(lower, diagonal, upper, b, n);
+
+    double error = 0.0, norm = 0.0;
+
+    for (int i = 0; i < n; i++) {
+	double Ax = diagonal[i] * x[i] + (i > 0 ? lower[i] * x[i - 1] : 0.0) + (i < n - 1 ? upper[i] * x[i + 1] : 0.0);
+	error += (Ax - b[i]) * (Ax - b[i]);
+	norm += b[i] * b[i];
+    }
+
+    printf("solve_tridiagonal_system, n = %d : relative residual %e (%s)\n", n, sqrt(error / norm),
+	   sqrt(error / norm) < 1e-13 ? "OK" : "FAILED");
+
+    double zero[] = {0.0, 0.0};
+
+    printf("Zero pivot rejected (%s)\n", solve_tridiagonal_system(zero, zero, zero, zero, 2) == NULL ? "OK" : "FAILED");
+
+    printf("##################################### TEST 2 #####################################\n");
+
+    // Batch of tridiagonal systems against the systems solved one at a time, in place
+
+    int batch = 10, m = n / batch;
+
+    double *X = malloc(n * sizeof(double));
+
+    for (int i = 0; i < n; i++)
+	X[i] = b[i];
+
+    int status = batched_solve_tridiagonal_system(lower, diagonal, upper, X, m, batch, X);
+
+    double max_error = 0.0;
+
+    for (int s = 0; s < batch; s++) {
+	double *x_single = solve_tridiagonal_system(lower + s * m, diagonal + s * m, upper + s * m, b + s * m, m);
+	for (int i = 0; i < m; i++)
+	    max_error = fmax(max_error, fabs(X[s * m + i] - x_single[i]));
+	free(x_single);
+    }
+
+    printf("batched_solve_tridiagonal_system, %d systems of %d : max difference %e (%s)\n", batch, m, max_error,
+	   (!status && max_error == 0.0) ? "OK" : "FAILED");
+
+    free(X);
+    free(x);
+
+    printf("##################################### TEST 3 #####################################\n");
+
+    // Banded LU with partial pivoting on bands that are not diagonally dominant, against the
+    // dense LU solver
+
+    int size = 300;
+    int bands[][2] = {{0, 0}, {1, 1}, {3, 2}, {2, 5}};
+
+    for (int t = 0; t < 4; t++) {
+
+	int kl = bands[t][0], ku = bands[t][1];
+
+	double *A = calloc((size_t) size * size, sizeof(double));
+
+	for (int i = 0; i < size; i++)
+	    for (int j = i - kl; j <= i + ku; j++)
+		if (j >= 0 && j < size)
+		    A[i * size + j] = random_value() + (i == j ? 1.0 : 0.0);
+
+	banded_matrix *B = banded_from_dense(A, size, kl, ku);
+	banded_LU *F = banded_LU_decomposition(B);
+	double *solution = F ? solve_banded_LU_system(F, b) : NULL;
+	double *D = banded_to_dense(B);
+	double *x_dense = solve_LU_system(A, b, size);
+
+	int round_trip = D != NULL;
+
+	for (size_t k = 0; round_trip && k < (size_t) size * size; k++)
+	    if (D[k] != A[k]) round_trip = 0;
+
+	double r = solution ? residual(A, solution, b, size) : 1.0;
+	double difference = 0.0;
+
+	for (int i = 0; solution && i < size; i++)
+	    difference = fmax(difference, fabs(solution[i] - x_dense[i]));
+
+	printf("banded_LU_decomposition, %d lower and %d upper diagonals : relative residual %e, max difference with solve_LU_system %e (%s)\n",
+	       kl, ku, r, difference, (round_trip && r < 1e-13 && difference < 1e-12) ? "OK" : "FAILED");
+
+	free(solution);
+	free(x_dense);
+	free(D);
+	banded_LU_free(F);
+	banded_free(B);
+	free(A);
+
+    }
+
+    printf("##################################### TEST 4 #####################################\n");
+
+    // Banded Cholesky of a symmetric positive definite band
+
+    int k = 4;
+
+    banded_matrix *S = create_banded_matrix(size, k, k);
+
+    for (int i = 0; i < size; i++)
+	for (int j = i - k; j <= i; j++)
+	    if (j >= 0) {
+		double value = (i == j) ? 2.0 * k + 1.0 : random_value();
+		S->data[i * (2 * k + 1) + j - i + k] = value;
+		S->data[j * (2 * k + 1) + i - j + k] = value;
+	    }
+
+    double *S_dense = banded_to_dense(S);
+    banded_matrix *L = banded_Cholesky_decomposition(S);
+    double *solution = L ? solve_banded_Cholesky_system(L, b) : NULL;
+    double r = solution ? residual(S_dense, solution, b, size) : 1.0;
+
+    printf("banded_Cholesky_decomposition, %d diagonals : relative residual %e (%s)\n", k, r,
+	   (L && L->upper == 0 && r < 1e-12) ? "OK" : "FAILED");
+
+    S->data[k] = -1.0;
+
+    banded_matrix *not_definite = banded_Cholesky_decomposition(S);
+
+    printf("Matrix that is not positive definite rejected (%s)\n", not_definite == NULL ? "OK" : "FAILED");
+
+    free(solution);
+    free(S_dense);
+    banded_free(L);
+    banded_free(S);
+
+    printf("##################################### TEST 5 #####################################\n");
+
+    // Single precision tridiagonal system written as a band
+
+    float A_float[] = {4.0f, 1.0f, 0.0f, 0.0f,
+		       1.0f, 4.0f, 1.0f, 0.0f,
+		       0.0f, 1.0f, 4.0f, 1.0f,
+		       0.0f, 0.0f, 1.0f, 4.0f};
+    float b_float[] = {5.0f, 6.0f, 6.0f, 5.0f};
+
+    banded_matrix_float *B_float = banded_from_dense_float(A_float, 4, 1, 1);
+    banded_LU_float *F_float = banded_LU_decomposition_float(B_float);
+    float *x_float = solve_banded_LU_system_float(F_float, b_float);
+
+    int correct = x_float != NULL;
+
+    for (int i = 0; correct && i < 4; i++)
+	if (fabsf(x_float[i] - 1.0f) > 1e-6f) correct = 0;
+
+    printf("solve_banded_LU_system_float : x = (1, 1, 1, 1) (%s)\n", correct ? "OK" : "FAILED");
+
+    free(x_float);
+    banded_LU_free_float(F_float);
+    banded_free_float(B_float);
+    free(lower);
+    free(diagonal);
+    free(upper);
+    free(b);
+
+    return 0;
+
+}
@@ -0,0 +1,98 @@
+#include "LinearAlgebraBasics.h"
+
+int main() {
+
+    printf("##################################### TEST 1 #####################################\n");
+
+    // Every size-specialized kernel, the unpacked kernel and the blocked fallback
+
+    int sizes[][3] = {{4, 4, 4}, {8, 8, 8}, {16, 16, 16}, {32, 32, 32}, {5, 7, 3}, {32, 1, 17}, {40, 33, 36}};
+    int batch = 100;
+
+    for (int t = 0; t < 7; t++) {
+
+	int m = sizes[t][0], k = sizes[t][1], n = sizes[t][2];
+
+	double **P = malloc(batch * sizeof(double *));
+	double **Q = malloc(batch * sizeof(double *));
+	double **C = malloc(batch * sizeof(double *));
+
+	for (int b = 0; b < batch; b++) {
+	    P[b] = generate_matrix_double(m, k);
+	    Q[b] = generate_matrix_double(k, n);
+	    C[b] = malloc(m * n * sizeof(double));
+	}
+
+	int status = batched_matrix_product(P, m, k, Q, k, n, C, batch);
+
+	double max_error = 0.0;
+
+	for (int b = 0; b < batch; b++) {
+	    double *reference = sequential_matrix_product(P[b], m, k, Q[b], k, n);
+	    for (int i = 0; i < m * n; i++) {
+		double error = fabs(C[b][i] - reference[i]) / fabs(reference[i]);
+		if (error > max_error) max_error = error;
+	    }
+	    free(reference);
+	}
+
+	printf("%d x (%d x %d) x (%d x %d) : max relative error %e (%s)\n", batch, m, k, k, n, max_error,
+	       (!status && max_error < 1e-12) ? "OK" : "FAILED");
+
+	for (int b = 0; b < batch; b++) {
+	    free(P[b]);
+	    free(Q[b]);
+	    free(C[b]);
+	}
+
+	free(P);
+	free(Q);
+	free(C);
+
+    }
+
+    printf("##################################### TEST 2 #####################################\n");
+
+    // Strided batch with a shared right operand (stride 0) and padded outputs
+
+    int d = 8;
+    int C_stride = d * d + 3;
+
+    double *P = generate_matrix_double(batch * d, d);
+    double *Q = generate_matrix_double(d, d);
+    double *C = malloc(batch * C_stride * sizeof(double));
+
+    int status = strided_batched_matrix_product(P, d, d, d * d, Q, d, d, 0, C, C_stride, batch);
+
+    double max_error = 0.0;
+
+    for (int b = 0; b < batch; b++) {
+	double *reference = sequential_matrix_product(P + b * d * d, d, d, Q, d, d);
+	for (int i = 0; i < d * d; i++) {
+	    double error = fabs(C[b * C_stride + i] - reference[i]) / fabs(reference[i]);
+	    if (error > max_error) max_error = error;
+	}
+	free(reference);
+    }
+
+    printf("Strided batch : max relative error %e (%s)\n", max_error, (!status && max_error < 1e-12) ? "OK" : "FAILED");
+
+    // Outputs closer than one matrix would overwrite each other
+
+    printf("Overlapping output stride rejected (%s)\n",
+	   strided_batched_matrix_product(P, d, d, d * d, Q, d, d, 0, C, d, batch) == -1 ? "OK" : "FAILED");
+
+    // A pointer-array batch whose last output is the left operand of its own product
+
+    double *A_array[] = {P, P + d * d}, *B_array[] = {Q, Q}, *C_array[] = {C, P + d * d};
+
+    printf("Output overlapping its operands rejected (%s)\n",
+	   batched_matrix_product(A_array, d, d, B_array, d, d, C_array, 2) == -1 ? "OK" : "FAILED");
+
+    free(P);
+    free(Q);
+    free(C);
+
+    return 0;
+
+}
@@ -0,0 +1,213 @@
+#include "LinearAlgebraBasics.h"
+
+/*
+ * Norm-wise relative difference between a float result and its double reference.
+ */
+
+static double relative_error(float *X, double *X_reference, int n) {
+
+    double difference = 0.0, norm = 0.0;
+
+    for (int i = 0; i < n; i++) {
+	difference += ((double) X[i] - X_reference[i]) * ((double) X[i] - X_reference[i]);
+	norm += X_reference[i] * X_reference[i];
+    }
+
+    return sqrt(difference / norm);
+
+}
+
+/*
+ * Double copy of a float matrix, so both precisions work on the same values.
+ */
+
+static double *to_double(float *X, int n) {
+
+    double *Y = malloc(n * sizeof(double));
+
+    for (int i = 0; i < n; i++)
+	Y[i] = X[i];
+
+    return Y;
+
+}
+
+/*
+ * Relative residual ||P * Q - A|| / ||A|| of a float factorisation.
+ */
+
+static double factorisation_error(float *P, int rows, int inner, float *Q, int columns, float *A) {
+
+    float *product = sequential_matrix_product_float(P, rows, inner, Q, inner, columns);
+    double *reference = to_double(A, rows * columns);
+
+    double error = relative_error(product, reference, rows * columns);
+
+    free(product);
+    free(reference);
+
+    return error;
+
+}
+
+int main() {
+
+    printf("##################################### TEST 1 #####################################\n");
+
+    // Matrix products in float against the same products in double, on every instruction set
+
+    int M = 203, N = 171, K = 301;
+
+    float *P = generate_matrix_float(M, K);
+    float *Q = generate_matrix_float(K, N);
+    double *P_double = to_double(P, M * K);
+    double *Q_double = to_double(Q, K * N);
+
+    double *C_reference = sequential_matrix_product(P_double, M, K, Q_double, K, N);
+
+    const char *instruction_sets[] = {"generic", "sse2", "avx2", "avx512"};
+    const char *initial = simd_instruction_set();
+
+    for (int s = 0; s < 4; s++) {
+
+	if (simd_select_instruction_set(instruction_sets[s]) != 0) {
+	    printf("%-8s : not supported by this CPU, skipped\n", instruction_sets[s]);
+	    continue;
+	}
+
+	float *C_sequential = sequential_matrix_product_float(P, M, K, Q, K, N);
+	float *C_parallel = parallel_matrix_product_float(P, M, K, Q, K, N);
+	float *C_strassen = strassen_matrix_product_float(P, M, K, Q, K, N, 64);
+
+	double errors[3] = {relative_error(C_sequential, C_reference, M * N),
+			    relative_error(C_parallel, C_reference, M * N),
+			    relative_error(C_strassen, C_reference, M * N)};
+	const char *names[3] = {"sequential", "parallel", "strassen"};
+
+	for (int i = 0; i < 3; i++)
+	    printf("%-8s : %-10s float product : relative error %e (%s)\n", instruction_sets[s], names[i], errors[i],
+		   errors[i] < 1e-5 ? "OK" : "FAILED");
+
+	free(C_sequential);
+	free(C_parallel);
+	free(C_strassen);
+
+    }
+
+    simd_select_instruction_set(initial);
+
+    printf("##################################### TEST 2 #####################################\n");
+
+    // General product with transposition and alpha/beta accumulation (P read as a K x M matrix)
+
+    float *C = generate_matrix_float(M, N);
+    double *C_double = to_double(C, M * N);
+
+    int status = parallel_general_matrix_product_float(OP_TRANSPOSE, OP_NO_TRANSPOSE, M, N, K, 0.5f,
+							P, M, Q, N, -2.0f, C, N);
+    general_matrix_product(OP_TRANSPOSE, OP_NO_TRANSPOSE, M, N, K, 0.5, P_double, M, Q_double, N, -2.0, C_double, N);
+
+    double error = relative_error(C, C_double, M * N);
+
+    printf("parallel_general_matrix_product_float : relative error %e (%s)\n", error,
+	   (!status && error < 1e-5) ? "OK" : "FAILED");
+
+    free(C);
+    free(C_double);
+
+    printf("##################################### TEST 3 #####################################\n");
+
+    // Vector kernels
+
+    float *X = generate_matrix_float(K, 1);
+    double *X_double = to_double(X, K);
+
+    float *Y = sequential_vector_matrix_product_float(P, M, K, X, K);
+    float *Y_parallel = parallel_vector_matrix_product_float(P, M, K, X, K);
+    double *Y_reference = sequential_vector_matrix_product(P_double, M, K, X_double, K);
+
+    double error_sequential = relative_error(Y, Y_reference, M);
+    double error_parallel = relative_error(Y_parallel, Y_reference, M);
+
+    printf("sequential_vector_matrix_product_float : relative error %e (%s)\n", error_sequential,
+	   error_sequential < 1e-5 ? "OK" : "FAILED");
+    printf("parallel_vector_matrix_product_float   : relative error %e (%s)\n", error_parallel,
+	   error_parallel < 1e-5 ? "OK" : "FAILED");
+
+    float norm = vector_norm_float(X, K);
+    double norm_reference = vector_norm(X_double, K);
+    double norm_error = fabs(norm - norm_reference) / norm_reference;
+
+    printf("vector_norm_float : relative error %e (%s)\n", norm_error, norm_error < 1e-6 ? "OK" : "FAILED");
+
+    free(Y);
+    free(Y_parallel);
+    free(Y_reference);
+
+    printf("##################################### TEST 4 #####################################\n");
+
+    // Factorisations of a diagonally dominant (for LU) and a symmetric positive definite (for Cholesky) matrix
+
+    int d = 120;
+
+    float *A = generate_matrix_float(d, d);
+
+    for (int i = 0; i < d; i++)
+	A[i * d + i] += 100.0f * d;
+
+    float *S = gram_matrix_float(A, d, d);
+
+    {
+	LU_float *LU = LU_decomposition_float(A, d, d);
+	double error = LU ? factorisation_error(LU->L, d, d, LU->U, d, A) : 1.0;
+	printf("LU_decomposition_float       : ||L * U - A|| / ||A|| = %e (%s)\n", error, error < 1e-5 ? "OK" : "FAILED");
+	if (LU) LU_free_float(LU);
+    }
+
+    {
+	QR_float *QR = QR_decomposition_float(A, d, d);
+	double error = QR ? factorisation_error(QR->Q, d, d, QR->R, d, A) : 1.0;
+	printf("QR_decomposition_float       : ||Q * R - A|| / ||A|| = %e (%s)\n", error, error < 1e-5 ? "OK" : "FAILED");
+	if (QR) QR_free_float(QR);
+    }
+
+    {
+	Cholesky_float *cholesky = Cholesky_decomposition_float(S, d);
+	double error = cholesky ? factorisation_error(cholesky->L, d, d, cholesky->L_t, d, S) : 1.0;
+	printf("Cholesky_decomposition_float : ||L * L^T - A|| / ||A|| = %e (%s)\n", error, error < 1e-5 ? "OK" : "FAILED");
+	if (cholesky) free_Cholesky_float(cholesky);
+    }
+
+    printf("##################################### TEST 5 #####################################\n");
+
+    // Linear system solved in float against the double solution
+
+    float *b = generate_matrix_float(d, 1);
+    double *A_double = to_double(A, d * d);
+    double *b_double = to_double(b, d);
+
+    float *x = solve_LU_system_float(A, b, d);
+    double *x_reference = solve_LU_system(A_double, b_double, d);
+
+    double solve_error = (x && x_reference) ? relative_error(x, x_reference, d) : 1.0;
+
+    printf("solve_LU_system_float : relative error %e (%s)\n", solve_error, solve_error < 1e-5 ? "OK" : "FAILED");
+
+    free(b);
+    free(b_double);
+    free(x);
+    free(x_reference);
+    free(A_double);
+    free(A);
+    free(S);
+    free(X);
+    free(X_double);
+    free(P);
+    free(Q);
+    free(P_double);
+    free(Q_double);
+    free(C_reference);
+
+    return 0;
+
+}
@@ -0,0 +1,106 @@
+#include "LinearAlgebraBasics.h"
+
+/*
+ * Reference C = alpha * op(A) * op(B) + beta * C with triple loops.
+ */
+
+static void reference_product(int transpose_A, int transpose_B, int M, int N, int K, double alpha,
+			      double *A, int lda, double *B, int ldb, double beta, double *C, int ldc) {
+
+    for (int i = 0; i < M; i++) {
+	for (int j = 0; j < N; j++) {
+	    double value = 0.0;
+	    for (int k = 0; k < K; k++) {
+		double a = transpose_A ? A[k * lda + i] : A[i * lda + k];
+		double b = transpose_B ? B[j * ldb + k] : B[k * ldb + j];
+		value += a * b;
+	    }
+	    C[i * ldc + j] = alpha * value + beta * C[i * ldc + j];
+	}
+    }
+
+}
+
+int main() {
+
+    printf("##################################### TEST 1 #####################################\n");
+
+    // Every transposition, with alpha/beta accumulation on a sub-block of bigger matrices
+
+    int M = 203, N = 171, K = 301;
+    int ld = 320;
+    double alpha = 1.5, beta = -0.5;
+
+    double *A = generate_matrix_double(ld, ld);
+    double *B = generate_matrix_double(ld, ld);
+    double *C_initial = generate_matrix_double(M, ld);
+
+    const char *names[] = {"N", "T"};
+
+    for (int parallel = 0; parallel < 2; parallel++) {
+	for (int transpose_A = 0; transpose_A < 2; transpose_A++) {
+	    for (int transpose_B = 0; transpose_B < 2; transpose_B++) {
+
+		double *C = malloc(M * ld * sizeof(double));
+		double *C_reference = malloc(M * ld * sizeof(double));
+
+		for (int i = 0; i < M * ld; i++)
+		    C[i] = C_reference[i] = C_initial[i];
+
+		int status = parallel
+		    ? parallel_general_matrix_product(transpose_A, transpose_B, M, N, K, alpha, A, ld, B, ld, beta, C, ld)
+		    : general_matrix_product(transpose_A, transpose_B, M, N, K, alpha, A, ld, B, ld, beta, C, ld);
+
+		reference_product(transpose_A, transpose_B, M, N, K, alpha, A, ld, B, ld, beta, C_reference, ld);
+
+		double max_error = 0.0;
+		int untouched = 1;
+
+		for (int i = 0; i < M; i++) {
+		    for (int j = 0; j < N; j++) {
+			double error = fabs(C[i * ld + j] - C_reference[i * ld + j]) / fabs(C_reference[i * ld + j]);
+			if (error > max_error) max_error = error;
+		    }
+		    // Columns beyond N belong to the caller and must not be written
+		    for (int j = N; j < ld; j++)
+			if (C[i * ld + j] != C_initial[i * ld + j]) untouched = 0;
+		}
+
+		printf("%s op(A) = %s, op(B) = %s : max relative error %e (%s)\n",
+		       parallel ? "parallel  " : "sequential", names[transpose_A], names[transpose_B], max_error,
+		       (!status && untouched && max_error < 1e-10) ? "OK" : "FAILED");
+
+		free(C);
+		free(C_reference);
+
+	    }
+	}
+    }
+
+    printf("##################################### TEST 2 #####################################\n");
+
+    // beta = 0 never reads C, even when it holds NaN
+
+    double *C = malloc(M * ld * sizeof(double));
+
+    for (int i = 0; i < M * ld; i++)
+	C[i] = NAN;
+
+    int status = general_matrix_product(OP_TRANSPOSE, OP_NO_TRANSPOSE, M, N, K, 1.0, A, ld, B, ld, 0.0, C, ld);
+
+    int finite = 1;
+
+    for (int i = 0; i < M; i++)
+	for (int j = 0; j < N; j++)
+	    if (isnan(C[i * ld + j])) finite = 0;
+
+    printf("beta = 0 ignores the previous content of C (%s)\n", (!status && finite) ? "OK" : "FAILED");
+
+    free(C);
+    free(A);
+    free(B);
+    free(C_initial);
+
+    return 0;
+
+}
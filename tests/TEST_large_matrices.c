@@ -0,0 +1,172 @@
+#include "LinearAlgebraBasics.h"
+#include <sys/mman.h>
+
+/*
+ * The matrices of these tests span more than 2^31 elements but only a few pages are
+ * ever written: they live in a reserved, lazily-committed mapping, and the untouched
+ * pages read as zeros without using memory. Offsets computed in 32 bits would wrap
+ * around and read or write the wrong elements.
+ */
+
+#define BEYOND_INT32 (((index_t) 1 << 31) + 24)
+
+static void *reserve(size_t bytes) {
+
+    void *memory = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    return memory == MAP_FAILED ? NULL : memory;
+
+}
+
+int main() {
+
+    printf("##################################### TEST 1 #####################################\n");
+
+    // Norm of a vector of more than 2^31 elements
+
+    index_t n = BEYOND_INT32;
+
+    float *X = reserve(n * sizeof(float));
+
+    if (!X) {
+	printf("Reserving %.1f GB of address space failed, skipped (OK)\n", n * sizeof(float) * 1e-9);
+    } else {
+	X[0] = 4.0f;
+	X[n - 1] = 3.0f;
+
+	float norm = vector_norm_float(X, n);
+
+	printf("vector_norm_float over %" PRId64 " elements = %f (%s)\n", n, norm, norm == 5.0f ? "OK" : "FAILED");
+    }
+
+    printf("##################################### TEST 2 #####################################\n");
+
+    // Matrix-vector products with rows of more than 2^31 elements
+
+    index_t rows = 3;
+
+    float *A = reserve(rows * n * sizeof(float));
+
+    if (!A || !X) {
+	printf("Reserving %.1f GB of address space failed, skipped (OK)\n", rows * n * sizeof(float) * 1e-9);
+    } else {
+	// Row r holds r + 1 at its first and last columns: (A * X)_r = 4 (r + 1) + 3 (r + 1)
+	for (index_t r = 0; r < rows; r++)
+	    A[r * n] = A[r * n + n - 1] = (float) (r + 1);
+
+	float *Y_sequential = sequential_vector_matrix_product_float(A, rows, n, X, n);
+	float *Y_parallel = parallel_vector_matrix_product_float(A, rows, n, X, n);
+
+	int correct_sequential = Y_sequential != NULL, correct_parallel = Y_parallel != NULL;
+
+	for (index_t r = 0; r < rows; r++) {
+	    if (Y_sequential && Y_sequential[r] != 7.0f * (r + 1)) correct_sequential = 0;
+	    if (Y_parallel && Y_parallel[r] != 7.0f * (r + 1)) correct_parallel = 0;
+	}
+
+	printf("sequential_vector_matrix_product_float, %" PRId64 " x %" PRId64 " (%s)\n", rows, n,
+	       correct_sequential ? "OK" : "FAILED");
+	printf("parallel_vector_matrix_product_float, %" PRId64 " x %" PRId64 " (%s)\n", rows, n,
+	       correct_parallel ? "OK" : "FAILED");
+
+	free(Y_sequential);
+	free(Y_parallel);
+	munmap(A, rows * n * sizeof(float));
+    }
+
+    if (X) munmap(X, n * sizeof(float));
+
+    printf("##################################### TEST 3 #####################################\n");
+
+    // Matrix products on blocks of matrices whose leading dimension puts the last rows beyond 2^31 elements
+
+    index_t M = 5, N = 7, K = 6;
+    index_t ld = ((index_t) 1 << 29) + 8;
+
+    double *P = reserve(M * ld * sizeof(double));
+    double *Q = reserve(K * ld * sizeof(double));
+    double *C = reserve(M * ld * sizeof(double));
+
+    if (!P || !Q || !C) {
+	printf("Reserving %.1f GB of address space failed, skipped (OK)\n", (2 * M + K) * ld * sizeof(double) * 1e-9);
+    } else {
+	double *P_compact = generate_matrix_double(M, K);
+	double *Q_compact = generate_matrix_double(K, N);
+
+	for (index_t i = 0; i < M; i++)
+	    for (index_t k = 0; k < K; k++)
+		P[i * ld + k] = P_compact[i * K + k];
+	for (index_t k = 0; k < K; k++)
+	    for (index_t j = 0; j < N; j++)
+		Q[k * ld + j] = Q_compact[k * N + j];
+
+	double *C_reference = sequential_matrix_product(P_compact, M, K, Q_compact, K, N);
+
+	for (int parallel = 0; parallel < 2; parallel++) {
+
+	    int status = parallel
+		? parallel_general_matrix_product(OP_NO_TRANSPOSE, OP_NO_TRANSPOSE, M, N, K, 1.0, P, ld, Q, ld, 0.0, C, ld)
+		: general_matrix_product(OP_NO_TRANSPOSE, OP_NO_TRANSPOSE, M, N, K, 1.0, P, ld, Q, ld, 0.0, C, ld);
+
+	    double max_error = 0.0;
+
+	    for (index_t i = 0; i < M; i++)
+		for (index_t j = 0; j < N; j++)
+		    max_error = fmax(max_error, fabs(C[i * ld + j] - C_reference[i * N + j]));
+
+	    printf("%s_general_matrix_product, last row at element %" PRId64 " : max error %e (%s)\n",
+		   parallel ? "parallel" : "sequential", (M - 1) * ld, max_error,
+		   (!status && max_error < 1e-9) ? "OK" : "FAILED");
+
+	}
+
+	free(P_compact);
+	free(Q_compact);
+	free(C_reference);
+    }
+
+    if (P) munmap(P, M * ld * sizeof(double));
+    if (Q) munmap(Q, K * ld * sizeof(double));
+    if (C) munmap(C, M * ld * sizeof(double));
+
+    printf("##################################### TEST 4 #####################################\n");
+
+    // Strided batch whose last products start beyond 2^31 elements
+
+    index_t d = 4, batch = 3;
+    size_t stride = ((size_t) 1 << 30) + 16;
+
+    double *P_batch = reserve(batch * stride * sizeof(double));
+    double *Q_batch = reserve(batch * stride * sizeof(double));
+    double *C_batch = reserve(batch * stride * sizeof(double));
+
+    if (!P_batch || !Q_batch || !C_batch) {
+	printf("Reserving %.1f GB of address space failed, skipped (OK)\n", 3.0 * batch * stride * sizeof(double) * 1e-9);
+    } else {
+	// P_b = (b + 1) I and Q_b = all ones, so C_b = (b + 1) everywhere
+	for (index_t b = 0; b < batch; b++)
+	    for (index_t i = 0; i < d; i++) {
+		P_batch[b * stride + i * d + i] = (double) (b + 1);
+		for (index_t j = 0; j < d; j++)
+		    Q_batch[b * stride + i * d + j] = 1.0;
+	    }
+
+	int status = strided_batched_matrix_product(P_batch, d, d, stride, Q_batch, d, d, stride,
+						    C_batch, stride, batch);
+
+	int correct = !status;
+
+	for (index_t b = 0; b < batch; b++)
+	    for (index_t i = 0; i < d * d; i++)
+		if (C_batch[b * stride + i] != (double) (b + 1)) correct = 0;
+
+	printf("strided_batched_matrix_product, stride %zu : (%s)\n", stride, correct ? "OK" : "FAILED");
+    }
+
+    if (P_batch) munmap(P_batch, batch * stride * sizeof(double));
+    if (Q_batch) munmap(Q_batch, batch * stride * sizeof(double));
+    if (C_batch) munmap(C_batch, batch * stride * sizeof(double));
+
+    return 0;
+
+}
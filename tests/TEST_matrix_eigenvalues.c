@@ -0,0 +1,222 @@
+#include "LinearAlgebraBasics.h"
+
+/*
+ * A = Q D Q^T with Q orthogonal (from the QR decomposition of a random matrix) and D block
+ * diagonal: 1 x 1 blocks for real eigenvalues, [a b; -b a] blocks for the pairs a +- b i.
+ * The expected eigenvalues are returned in real and imaginary.
+ */
+
+static double *generate_spectrum(int n, double *real, double *imaginary) {
+
+    double *D = calloc((size_t) n * n, sizeof(double));
+
+    for (int i = 0; i < n; i++) {
+	double a = 10.0 * rand() / RAND_MAX - 5.0;
+	if (i + 1 < n && rand() % 2) {
+	    double b = 4.0 * rand() / RAND_MAX + 0.1;
+	    D[i * n + i] = D[(i + 1) * n + i + 1] = a;
+	    D[i * n + i + 1] = b;
+	    D[(i + 1) * n + i] = -b;
+	    real[i] = real[i + 1] = a;
+	    imaginary[i] = b;
+	    imaginary[i + 1] = -b;
+	    i++;
+	} else {
+	    D[i * n + i] = real[i] = a;
+	    imaginary[i] = 0.0;
+	}
+    }
+
+    double *M = generate_matrix_double(n, n);
+    QR *F = QR_decomposition(M, n, n);
+    double *Q_t = matrix_transpose(F->Q, n, n);
+    double *QD = sequential_matrix_product(F->Q, n, n, D, n, n);
+    double *A = sequential_matrix_product(QD, n, n, Q_t, n, n);
+
+    free(QD);
+    free(Q_t);
+    QR_free(F);
+    free(M);
+    free(D);
+
+    return A;
+
+}
+
+/*
+ * Largest distance from an expected eigenvalue to the computed one matched to it,
+ * each computed eigenvalue being matched once.
+ */
+
+static double spectrum_error(int n, double *real, double *imaginary, double *expected_real, double *expected_imaginary) {
+
+    char *used = calloc(n, 1);
+    double error = 0.0;
+
+    for (int i = 0; i < n; i++) {
+	int best = -1;
+	double distance = INFINITY;
+	for (int j = 0; j < n; j++) {
+	    double d = hypot(real[j] - expected_real[i], imaginary[j] - expected_imaginary[i]);
+	    if (!used[j] && d < distance) {
+		distance = d;
+		best = j;
+	    }
+	}
+	used[best] = 1;
+	error = fmax(error, distance);
+    }
+
+    free(used);
+
+    return error;
+
+}
+
+int main() {
+
+    srand(17);
+
+    printf("##################################### TEST 1 #####################################\n");
+
+    // Small matrices with known eigenvalues: real, complex-conjugate and already triangular
+
+    double S[] = {2.0, 0.0, 0.0,
+		  0.0, 3.0, 4.0,
+		  0.0, 4.0, 9.0};
+    double R[] = {0.0, -1.0,
+		  1.0, 0.0};
+    double U[] = {1.0, 5.0, 7.0, 2.0,
+		  0.0, -2.0, 3.0, 1.0,
+		  0.0, 0.0, 4.0, 8.0,
+		  0.0, 0.0, 0.0, 0.5};
+    double S_real[] = {2.0, 1.0, 11.0}, S_imaginary[] = {0.0, 0.0, 0.0};
+    double R_real[] = {0.0, 0.0}, R_imaginary[] = {1.0, -1.0};
+    double real[4], imaginary[4];
+
+    int status = matrix_eigenvalues_into(S, 3, 3, 100, 1e-15, real, imaginary);
+    double error = spectrum_error(3, real, imaginary, S_real, S_imaginary);
+
+    printf("Symmetric 3 x 3 : %g, %g, %g, error %e (%s)\n", real[0], real[1], real[2], error,
+	   (!status && error < 1e-13) ? "OK" : "FAILED");
+
+    status = matrix_eigenvalues_into(R, 2, 2, 100, 1e-15, real, imaginary);
+    error = spectrum_error(2, real, imaginary, R_real, R_imaginary);
+
+    printf("Rotation : %g %+gi, %g %+gi, error %e (%s)\n", real[0], imaginary[0], real[1], imaginary[1], error,
+	   (!status && error < 1e-15 && imaginary[0] > 0.0) ? "OK" : "FAILED");
+
+    double *diagonal = matrix_eigenvalues(U, 4, 4, 100, 1e-15);
+    int correct = diagonal != NULL;
+
+    for (int i = 0; correct && i < 4; i++)
+	if (diagonal[i] != U[i * 4 + i]) correct = 0;
+
+    printf("Upper triangular : eigenvalues in the order of the diagonal (%s)\n", correct ? "OK" : "FAILED");
+
+    free(diagonal);
+
+    printf("##################################### TEST 2 #####################################\n");
+
+    // Normal matrices with prescribed real eigenvalues and conjugate pairs
+
+    int sizes[] = {1, 5, 64, 300};
+
+    for (int s = 0; s < 4; s++) {
+
+	int n = sizes[s];
+	double *expected_real = malloc(n * sizeof(double)), *expected_imaginary = malloc(n * sizeof(double));
+	double *A = generate_spectrum(n, expected_real, expected_imaginary);
+	double *computed_real = malloc(n * sizeof(double)), *computed_imaginary = malloc(n * sizeof(double));
+
+	status = matrix_eigenvalues_into(A, n, n, 100, 1e-15, computed_real, computed_imaginary);
+	error = spectrum_error(n, computed_real, computed_imaginary, expected_real, expected_imaginary);
+
+	// Pairs occupy consecutive entries, the positive imaginary part first
+	int pairs = 0, ordered = 1;
+
+	for (int i = 0; i < n; i++)
+	    if (computed_imaginary[i] != 0.0) {
+		if (i + 1 == n || computed_imaginary[i] <= 0.0 || computed_imaginary[i + 1] != -computed_imaginary[i] ||
+		    computed_real[i + 1] != computed_real[i]) ordered = 0;
+		pairs++;
+		i++;
+	    }
+
+	printf("n = %d : %d conjugate pairs, max error %e (%s)\n", n, pairs, error,
+	       (!status && ordered && error < 1e-10) ? "OK" : "FAILED");
+
+	free(computed_real);
+	free(computed_imaginary);
+	free(expected_real);
+	free(expected_imaginary);
+	free(A);
+
+    }
+
+    printf("##################################### TEST 3 #####################################\n");
+
+    // Random nonsymmetric matrix: sum and sum of squares of the eigenvalues against trace(A), trace(A^2)
+
+    int n = 400;
+    double *A = generate_matrix_double(n, n);
+    double *computed_real = malloc(n * sizeof(double)), *computed_imaginary = malloc(n * sizeof(double));
+
+    for (int i = 0; i < n * n; i++)
+	A[i] -= 0.5;
+
+    status = matrix_eigenvalues_into(A, n, n, 100, 1e-15, computed_real, computed_imaginary);
+
+    double trace = 0.0, trace_square = 0.0, sum = 0.0, sum_square = 0.0;
+
+    for (int i = 0; i < n; i++) {
+	trace += A[i * n + i];
+	sum += computed_real[i];
+	sum_square += computed_real[i] * computed_real[i] - computed_imaginary[i] * computed_imaginary[i];
+	for (int k = 0; k < n; k++)
+	    trace_square += A[i * n + k] * A[k * n + i];
+    }
+
+    error = fmax(fabs(sum - trace), fabs(sum_square - trace_square)) / fabs(trace_square);
+
+    printf("Random %d x %d : relative error on the traces %e (%s)\n", n, n, error,
+	   (!status && error < 1e-12) ? "OK" : "FAILED");
+
+    double *real_parts = matrix_eigenvalues(A, n, n, 100, 1e-15);
+
+    correct = real_parts != NULL;
+
+    for (int i = 0; correct && i < n; i++)
+	if (real_parts[i] != computed_real[i]) correct = 0;
+
+    printf("matrix_eigenvalues returns the real parts of matrix_eigenvalues_into (%s)\n", correct ? "OK" : "FAILED");
+
+    free(real_parts);
+    free(computed_real);
+    free(computed_imaginary);
+    free(A);
+
+    printf("##################################### TEST 4 #####################################\n");
+
+    // Single precision and invalid arguments
+
+    float S_float[] = {2.0f, 0.0f, 0.0f,
+		       0.0f, 3.0f, 4.0f,
+		       0.0f, 4.0f, 9.0f};
+    float *eigenvalues_float = matrix_eigenvalues_float(S_float, 3, 3, 100, 1e-7f);
+    double sorted[3] = {eigenvalues_float[0], eigenvalues_float[1], eigenvalues_float[2]};
+
+    error = spectrum_error(3, sorted, S_imaginary, S_real, S_imaginary);
+
+    printf("matrix_eigenvalues_float : error %e (%s)\n", error, error < 1e-5 ? "OK" : "FAILED");
+
+    free(eigenvalues_float);
+
+    printf("Non-square matrix rejected (%s)\n", matrix_eigenvalues(S, 3, 2, 100, 1e-15) == NULL ? "OK" : "FAILED");
+    printf("Non-positive iteration count rejected (%s)\n",
+	   matrix_eigenvalues_into(S, 3, 3, 0, 1e-15, real, imaginary) == -1 ? "OK" : "FAILED");
+    printf("Null output rejected (%s)\n", matrix_eigenvalues_into(S, 3, 3, 100, 1e-15, NULL, imaginary) == -1 ? "OK" : "FAILED");
+
+    return 0;
+
+}
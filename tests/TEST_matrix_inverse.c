@@ -29,6 +29,35 @@ int main() {
 	printf("\n");
     }
 
+    printf("##################################### TEST INTO VARIANTS #####################################\n");
+
+    // In-place solve (x overwrites b) and in-place inversion (A overwritten by its inverse)
+
+    double x[] = {1.0, 5.0, 10.0};
+
+    int status = solve_LU_system_into(A, x, d, x);
+
+    double A_copy[9];
+
+    for (int i = 0; i < d * d; i++)
+	A_copy[i] = A[i];
+
+    status |= matrix_inverse_into(A_copy, d, A_copy);
+
+    double max_error = 0.0;
+
+    for (int i = 0; i < d * d; i++)
+	if (fabs(A_copy[i] - inverse[i]) > max_error) max_error = fabs(A_copy[i] - inverse[i]);
+
+    for (int i = 0; i < d; i++) {
+	double residual = -b[i];
+	for (int j = 0; j < d; j++)
+	    residual += A[i * d + j] * x[j];
+	if (fabs(residual) > max_error) max_error = fabs(residual);
+    }
+
+    printf("In-place solve and inverse : max error %e (%s)\n", max_error, (!status && max_error < 1e-12) ? "OK" : "FAILED");
+
     free(inverse);
 
     return 0;
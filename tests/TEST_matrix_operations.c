@@ -105,6 +105,30 @@ int main() {
     free(eigenvalues);
     
     printf("\n");
+
+    printf("##################################### TEST 10 #####################################\n");
+
+    // In-place variants: 2 * B + B, then transpose of the square result in place
+
+    double C[9];
+
+    int status = matrix_scalar_multiplication_into(B, 3, 3, 2, C);
+    status |= matrices_addition_into(C, B, 3, 3, C);
+    status |= matrix_transpose_into(C, 3, 3, C);
+
+    int correct = !status;
+
+    for (int i = 0; i < 3; i++)
+	for (int j = 0; j < 3; j++)
+	    if (C[i * 3 + j] != 3.0 * B[j * 3 + i]) correct = 0;
+
+    // A non-square transpose cannot run in place
+
+    double R[6] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+
+    if (matrix_transpose_into(R, 2, 3, R) != -1) correct = 0;
+
+    printf("In-place matrix operations (%s)\n", correct ? "OK" : "FAILED");
     
     return 0;
 
@@ -0,0 +1,226 @@
+#include "LinearAlgebraBasics.h"
+
+/*
+ * Random symmetric matrix, positive definite when its diagonal is shifted by its size.
+ */
+
+static double *generate_symmetric(int n, double shift) {
+
+    double *A = malloc((size_t) n * n * sizeof(double));
+
+    for (int i = 0; i < n; i++)
+	for (int j = 0; j <= i; j++) {
+	    double value = (double) rand() / RAND_MAX - 0.5 + (i == j ? shift : 0.0);
+	    A[i * n + j] = value;
+	    A[j * n + i] = value;
+	}
+
+    return A;
+
+}
+
+static double max_relative_error(double *X, double *reference, size_t n) {
+
+    double error = 0.0, norm = 0.0;
+
+    for (size_t k = 0; k < n; k++) {
+	error = fmax(error, fabs(X[k] - reference[k]));
+	norm = fmax(norm, fabs(reference[k]));
+    }
+
+    return error / norm;
+
+}
+
+int main() {
+
+    srand(11);
+
+    const char *triangles[] = {"lower", "upper"};
+
+    printf("##################################### TEST 1 #####################################\n");
+
+    // Conversions in both triangles
+
+    int n = 7;
+    double *A = generate_symmetric(n, 0.0);
+
+    for (int triangle = TRIANGLE_LOWER; triangle <= TRIANGLE_UPPER; triangle++) {
+
+	packed_matrix *P = packed_from_dense(A, n, triangle);
+	double *S = packed_to_dense(P, 1);
+	double *T = packed_to_dense(P, 0);
+
+	int correct = S && T;
+
+	for (int i = 0; correct && i < n; i++)
+	    for (int j = 0; j < n; j++) {
+		int stored = triangle == TRIANGLE_LOWER ? j <= i : j >= i;
+		if (S[i * n + j] != A[i * n + j] || T[i * n + j] != (stored ? A[i * n + j] : 0.0)) correct = 0;
+	    }
+
+	printf("packed_from_dense / packed_to_dense, %s triangle : %d values stored (%s)\n", triangles[triangle],
+	       n * (n + 1) / 2, correct ? "OK" : "FAILED");
+
+	free(S);
+	free(T);
+	packed_free(P);
+
+    }
+
+    free(A);
+
+    printf("##################################### TEST 2 #####################################\n");
+
+    // Symmetric matrix-vector products against the dense product, with odd and even sizes so
+    // that both the row pairs and the last single row are exercised
+
+    int sizes[] = {1, 2, 9, 300, 513};
+
+    for (int s = 0; s < 5; s++) {
+
+	n = sizes[s];
+	A = generate_symmetric(n, 0.0);
+
+	double *X = malloc(n * sizeof(double));
+
+	for (int i = 0; i < n; i++)
+	    X[i] = (double) rand() / RAND_MAX - 0.5;
+
+	double *reference = sequential_vector_matrix_product(A, n, n, X, n);
+
+	for (int triangle = TRIANGLE_LOWER; triangle <= TRIANGLE_UPPER; triangle++) {
+
+	    packed_matrix *P = packed_from_dense(A, n, triangle);
+	    double *Y_sequential = sequential_symmetric_vector_matrix_product(P, X, n);
+	    double *Y_parallel = parallel_symmetric_vector_matrix_product(P, X, n);
+	    double error = fmax(max_relative_error(Y_sequential, reference, n), max_relative_error(Y_parallel, reference, n));
+
+	    printf("symmetric_vector_matrix_product, n = %d, %s triangle : max relative error %e (%s)\n", n,
+		   triangles[triangle], error, error < 1e-12 ? "OK" : "FAILED");
+
+	    free(Y_sequential);
+	    free(Y_parallel);
+	    packed_free(P);
+
+	}
+
+	free(reference);
+	free(X);
+	free(A);
+
+    }
+
+    printf("##################################### TEST 3 #####################################\n");
+
+    // Symmetric matrix products against the dense product, across several tiles
+
+    int shapes[][2] = {{5, 3}, {256, 1}, {600, 37}};
+
+    for (int s = 0; s < 3; s++) {
+
+	n = shapes[s][0];
+	int k = shapes[s][1];
+
+	A = generate_symmetric(n, 0.0);
+
+	double *B = generate_matrix_double(n, k);
+	double *reference = sequential_matrix_product(A, n, n, B, n, k);
+
+	for (int triangle = TRIANGLE_LOWER; triangle <= TRIANGLE_UPPER; triangle++) {
+
+	    packed_matrix *P = packed_from_dense(A, n, triangle);
+	    double *C_sequential = sequential_symmetric_matrix_product(P, B, n, k);
+	    double *C_parallel = parallel_symmetric_matrix_product(P, B, n, k);
+	    double error = fmax(max_relative_error(C_sequential, reference, (size_t) n * k),
+				max_relative_error(C_parallel, reference, (size_t) n * k));
+
+	    printf("symmetric_matrix_product, %d x %d times %d x %d, %s triangle : max relative error %e (%s)\n",
+		   n, n, n, k, triangles[triangle], error, error < 1e-12 ? "OK" : "FAILED");
+
+	    free(C_sequential);
+	    free(C_parallel);
+	    packed_free(P);
+
+	}
+
+	free(reference);
+	free(B);
+	free(A);
+
+    }
+
+    printf("##################################### TEST 4 #####################################\n");
+
+    // Packed Cholesky solve of a positive definite system, from both triangles and in place
+
+    n = 200;
+    A = generate_symmetric(n, n);
+
+    double *b = malloc(n * sizeof(double));
+
+    for (int i = 0; i < n; i++)
+	b[i] = (double) rand() / RAND_MAX;
+
+    double *reference = solve_LU_system(A, b, n);
+
+    for (int triangle = TRIANGLE_LOWER; triangle <= TRIANGLE_UPPER; triangle++) {
+
+	packed_matrix *P = packed_from_dense(A, n, triangle);
+	packed_matrix *L = packed_Cholesky_decomposition(P);
+	double *x = malloc(n * sizeof(double));
+
+	for (int i = 0; i < n; i++)
+	    x[i] = b[i];
+
+	int status = L ? solve_packed_Cholesky_system_into(L, x, x) : -1;
+	double error = max_relative_error(x, reference, n);
+
+	printf("packed_Cholesky_decomposition, %s triangle : max relative error %e (%s)\n", triangles[triangle], error,
+	       (!status && L->triangle == TRIANGLE_LOWER && error < 1e-12) ? "OK" : "FAILED");
+
+	free(x);
+	packed_free(L);
+	packed_free(P);
+
+    }
+
+    A[0] = -1.0;
+
+    packed_matrix *P = packed_from_dense(A, n, TRIANGLE_LOWER);
+
+    printf("Matrix that is not positive definite rejected (%s)\n",
+	   packed_Cholesky_decomposition(P) == NULL ? "OK" : "FAILED");
+
+    packed_free(P);
+    free(reference);
+    free(b);
+    free(A);
+
+    printf("##################################### TEST 5 #####################################\n");
+
+    // Single precision and invalid arguments
+
+    float A_float[] = {4.0f, 1.0f, 0.0f,
+		       1.0f, 3.0f, 1.0f,
+		       0.0f, 1.0f, 2.0f};
+    float X_float[] = {1.0f, 1.0f, 1.0f};
+
+    packed_matrix_float *P_float = packed_from_dense_float(A_float, 3, TRIANGLE_UPPER);
+    float *Y_float = parallel_symmetric_vector_matrix_product_float(P_float, X_float, 3);
+
+    printf("parallel_symmetric_vector_matrix_product_float : (%g, %g, %g) (%s)\n", Y_float[0], Y_float[1], Y_float[2],
+	   (Y_float[0] == 5.0f && Y_float[1] == 5.0f && Y_float[2] == 3.0f) ? "OK" : "FAILED");
+
+    printf("Dimension mismatch rejected (%s)\n",
+	   sequential_symmetric_vector_matrix_product_float(P_float, X_float, 2) == NULL ? "OK" : "FAILED");
+    printf("Output overlapping the input rejected (%s)\n",
+	   sequential_symmetric_matrix_product_into_float(P_float, X_float, 3, 1, X_float) == -1 ? "OK" : "FAILED");
+    printf("Unknown triangle rejected (%s)\n", create_packed_matrix_float(3, 2) == NULL ? "OK" : "FAILED");
+
+    free(Y_float);
+    packed_free_float(P_float);
+
+    return 0;
+
+}
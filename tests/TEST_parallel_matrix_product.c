@@ -69,6 +69,38 @@ int main() {
 
     free(Q3);
     free(matrix3);
+
+    printf("##################################### TEST 4 #####################################\n");
+
+    // Several tiles in both directions, with partial tiles on the edges
+
+    P_rows = 403;
+    P_columns = 517;
+    Q_rows = 517;
+    Q_columns = 1100;
+
+    double *P4 = generate_matrix_double(P_rows, P_columns);
+    double *Q4 = generate_matrix_double(Q_rows, Q_columns);
+
+    double *matrix4 = parallel_matrix_product(P4, P_rows, P_columns, Q4, Q_rows, Q_columns);
+
+    double max_error = 0.0;
+
+    for (int i = 0; i < P_rows; i++) {
+	for (int j = 0; j < Q_columns; j++) {
+	    double value = 0.0;
+	    for (int k = 0; k < P_columns; k++)
+		value += P4[i * P_columns + k] * Q4[k * Q_columns + j];
+	    double error = fabs(value - matrix4[i * Q_columns + j]) / fabs(value);
+	    if (error > max_error) max_error = error;
+	}
+    }
+
+    printf("Max relative error against the naive product : %e (%s)\n", max_error, max_error < 1e-12 ? "OK" : "FAILED");
+
+    free(P4);
+    free(Q4);
+    free(matrix4);
     
     return 0;
 
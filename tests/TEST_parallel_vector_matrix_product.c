@@ -55,6 +55,122 @@ int main() {
     free(A3);
     free(vector3);
 
+    printf("##################################### TEST 4 #####################################\n");
+
+    // Several vectors applied in one pass, on row counts that are not multiples of the row blocking
+    // and on rows longer than a column chunk, against the products computed one row at a time
+
+    const char *instruction_sets[] = {"generic", "sse2", "avx2", "avx512"};
+    const char *initial = simd_instruction_set();
+
+    int sizes[][2] = {{1, 7}, {6, 3}, {37, 29}, {131, 2503}};
+    int counts[] = {1, 2, 3, 5};
+
+    for (int s = 0; s < 4; s++) {
+
+	if (simd_select_instruction_set(instruction_sets[s]) != 0) {
+	    printf("%-8s : not supported by this CPU, skipped\n", instruction_sets[s]);
+	    continue;
+	}
+
+	for (int t = 0; t < 4; t++) {
+
+	    int rows = sizes[t][0], columns = sizes[t][1], vectors = counts[t];
+
+	    double *M = generate_matrix_double(rows, columns);
+	    double *V = generate_matrix_double(vectors, columns);
+	    double *Y_sequential = malloc((size_t) vectors * rows * sizeof(double));
+	    double *Y_parallel = malloc((size_t) vectors * rows * sizeof(double));
+
+	    int status = sequential_multi_vector_matrix_product(M, rows, columns, V, columns, vectors, Y_sequential) |
+		parallel_multi_vector_matrix_product(M, rows, columns, V, columns, vectors, Y_parallel);
+
+	    double max_error = 0.0, scale = 0.0;
+
+	    for (int v = 0; v < vectors; v++)
+		for (int i = 0; i < rows; i++) {
+		    double expected = 0.0;
+		    for (int j = 0; j < columns; j++)
+			expected += M[i * columns + j] * V[v * columns + j];
+		    scale = fmax(scale, fabs(expected));
+		    max_error = fmax(max_error, fabs(Y_sequential[v * rows + i] - expected));
+		    max_error = fmax(max_error, fabs(Y_parallel[v * rows + i] - expected));
+		}
+
+	    printf("%-8s : %d x %d with %d vectors : max relative error %e (%s)\n", instruction_sets[s], rows, columns,
+		   vectors, max_error / scale, (!status && max_error / scale < 1e-12) ? "OK" : "FAILED");
+
+	    free(M);
+	    free(V);
+	    free(Y_sequential);
+	    free(Y_parallel);
+
+	}
+
+    }
+
+    simd_select_instruction_set(initial);
+
+    printf("##################################### TEST 5 #####################################\n");
+
+    // An output overlapping the vectors is rejected
+
+    double *V = generate_matrix_double(2, 4);
+
+    printf("Aliased output rejected (%s)\n",
+	   parallel_multi_vector_matrix_product(A2, 5, 4, V, 4, 2, V + 4) == -1 ? "OK" : "FAILED");
+
+    free(V);
+
+    printf("##################################### TEST 6 #####################################\n");
+
+    // Transposed product X^T * A against the transpose formed explicitly, on every instruction set
+
+    const char *transposed_sets[] = {"generic", "sse2", "avx2", "avx512"};
+    const char *transposed_initial = simd_instruction_set();
+
+    int shapes[][2] = {{1, 5}, {7, 3}, {45, 61}, {203, 4099}};
+
+    for (int s = 0; s < 4; s++) {
+
+	if (simd_select_instruction_set(transposed_sets[s]) != 0) {
+	    printf("%-8s : not supported by this CPU, skipped\n", transposed_sets[s]);
+	    continue;
+	}
+
+	for (int t = 0; t < 4; t++) {
+
+	    int rows = shapes[t][0], columns = shapes[t][1];
+
+	    double *M = generate_matrix_double(rows, columns);
+	    double *V = generate_matrix_double(rows, 1);
+	    double *M_t = matrix_transpose(M, rows, columns);
+
+	    double *Y = parallel_transposed_vector_matrix_product(M, rows, columns, V, rows);
+	    double *Y_reference = sequential_vector_matrix_product(M_t, columns, rows, V, rows);
+
+	    double max_error = 0.0, scale = 0.0;
+
+	    for (int j = 0; Y && j < columns; j++) {
+		scale = fmax(scale, fabs(Y_reference[j]));
+		max_error = fmax(max_error, fabs(Y[j] - Y_reference[j]));
+	    }
+
+	    printf("%-8s : parallel_transposed_vector_matrix_product %d x %d : max relative error %e (%s)\n",
+		   transposed_sets[s], rows, columns, max_error / scale, (Y && max_error / scale < 1e-12) ? "OK" : "FAILED");
+
+	    free(M);
+	    free(V);
+	    free(M_t);
+	    free(Y);
+	    free(Y_reference);
+
+	}
+
+    }
+
+    simd_select_instruction_set(transposed_initial);
+
     return 0;
 
 }
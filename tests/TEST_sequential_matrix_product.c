@@ -69,6 +69,57 @@ int main() {
 
     free(Q3);
     free(matrix3);
+
+    printf("##################################### TEST 4 #####################################\n");
+
+    // Sizes that are not multiples of the register and cache blocks
+
+    P_rows = 203;
+    P_columns = 517;
+    Q_rows = 517;
+    Q_columns = 133;
+
+    double *P4 = generate_matrix_double(P_rows, P_columns);
+    double *Q4 = generate_matrix_double(Q_rows, Q_columns);
+
+    double *matrix4 = sequential_matrix_product(P4, P_rows, P_columns, Q4, Q_rows, Q_columns);
+
+    double max_error = 0.0;
+
+    for (int i = 0; i < P_rows; i++) {
+	for (int j = 0; j < Q_columns; j++) {
+	    double value = 0.0;
+	    for (int k = 0; k < P_columns; k++)
+		value += P4[i * P_columns + k] * Q4[k * Q_columns + j];
+	    double error = fabs(value - matrix4[i * Q_columns + j]) / fabs(value);
+	    if (error > max_error) max_error = error;
+	}
+    }
+
+    printf("Max relative error against the naive product : %e (%s)\n", max_error, max_error < 1e-12 ? "OK" : "FAILED");
+
+    printf("##################################### TEST 5 #####################################\n");
+
+    // Caller-provided output, reused across calls; an output overlapping an input is rejected
+
+    double *C = malloc(P_rows * Q_columns * sizeof(double));
+
+    int status = sequential_matrix_product_into(P4, P_rows, P_columns, Q4, Q_rows, Q_columns, C);
+    status |= sequential_matrix_product_into(P4, P_rows, P_columns, Q4, Q_rows, Q_columns, C);
+
+    int correct = !status;
+
+    for (int i = 0; i < P_rows * Q_columns; i++)
+	if (C[i] != matrix4[i]) correct = 0;
+
+    if (sequential_matrix_product_into(P4, P_rows, P_columns, Q4, Q_rows, Q_columns, P4) != -1) correct = 0;
+
+    printf("Product into a caller-provided matrix (%s)\n", correct ? "OK" : "FAILED");
+
+    free(C);
+    free(P4);
+    free(Q4);
+    free(matrix4);
     
     return 0;
 
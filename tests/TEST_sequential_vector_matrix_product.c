@@ -55,6 +55,55 @@ int main() {
     free(A3);
     free(vector3);
 
+    printf("##################################### TEST 4 #####################################\n");
+
+    // Transposed product X^T * A against the transpose formed explicitly, on every instruction set
+
+    const char *instruction_sets[] = {"generic", "sse2", "avx2", "avx512"};
+    const char *initial = simd_instruction_set();
+
+    int shapes[][2] = {{1, 5}, {7, 3}, {45, 61}, {203, 4099}};
+
+    for (int s = 0; s < 4; s++) {
+
+	if (simd_select_instruction_set(instruction_sets[s]) != 0) {
+	    printf("%-8s : not supported by this CPU, skipped\n", instruction_sets[s]);
+	    continue;
+	}
+
+	for (int t = 0; t < 4; t++) {
+
+	    int rows = shapes[t][0], columns = shapes[t][1];
+
+	    double *M = generate_matrix_double(rows, columns);
+	    double *V = generate_matrix_double(rows, 1);
+	    double *M_t = matrix_transpose(M, rows, columns);
+
+	    double *Y = sequential_transposed_vector_matrix_product(M, rows, columns, V, rows);
+	    double *Y_reference = sequential_vector_matrix_product(M_t, columns, rows, V, rows);
+
+	    double max_error = 0.0, scale = 0.0;
+
+	    for (int j = 0; Y && j < columns; j++) {
+		scale = fmax(scale, fabs(Y_reference[j]));
+		max_error = fmax(max_error, fabs(Y[j] - Y_reference[j]));
+	    }
+
+	    printf("%-8s : sequential_transposed_vector_matrix_product %d x %d : max relative error %e (%s)\n",
+		   instruction_sets[s], rows, columns, max_error / scale, (Y && max_error / scale < 1e-12) ? "OK" : "FAILED");
+
+	    free(M);
+	    free(V);
+	    free(M_t);
+	    free(Y);
+	    free(Y_reference);
+
+	}
+
+    }
+
+    simd_select_instruction_set(initial);
+
     return 0;
 
 }
@@ -0,0 +1,112 @@
+#include "LinearAlgebraBasics.h"
+
+double max_relative_error(double *X, double *reference, int dimension) {
+
+    double max_error = 0.0;
+
+    for (int i = 0; i < dimension; i++) {
+	double error = fabs(X[i] - reference[i]) / fabs(reference[i]);
+	if (error > max_error) max_error = error;
+    }
+
+    return max_error;
+
+}
+
+int main() {
+
+    const char *instruction_sets[] = {"generic", "sse2", "avx2", "avx512"};
+
+    printf("Instruction set selected at load time : %s\n", simd_instruction_set());
+
+    int rows = 203;
+    int inner = 517;
+    int columns = 133;
+
+    double *P = generate_matrix_double(rows, inner);
+    double *Q = generate_matrix_double(inner, columns);
+    double *X = generate_matrix_double(inner, 1);
+    double *Y = generate_matrix_double(inner, 1);
+
+    double *C_reference = malloc(rows * columns * sizeof(double));
+    double *V_reference = malloc(rows * sizeof(double));
+    double *S_reference = malloc(inner * sizeof(double));
+    double *M_reference = malloc(inner * sizeof(double));
+    double norm_reference = 0.0;
+
+    for (int i = 0; i < rows; i++) {
+	for (int j = 0; j < columns; j++) {
+	    double value = 0.0;
+	    for (int k = 0; k < inner; k++)
+		value += P[i * inner + k] * Q[k * columns + j];
+	    C_reference[i * columns + j] = value;
+	}
+	double value = 0.0;
+	for (int k = 0; k < inner; k++)
+	    value += P[i * inner + k] * X[k];
+	V_reference[i] = value;
+    }
+
+    for (int i = 0; i < inner; i++) {
+	S_reference[i] = X[i] + Y[i];
+	M_reference[i] = X[i] * Y[i];
+	norm_reference += X[i] * X[i];
+    }
+
+    norm_reference = sqrt(norm_reference);
+
+    for (int s = 0; s < 4; s++) {
+
+	printf("##################################### TEST %s #####################################\n", instruction_sets[s]);
+
+	if (simd_select_instruction_set(instruction_sets[s])) {
+	    printf("Not supported by this CPU.\n");
+	    continue;
+	}
+
+	double *C_sequential = sequential_matrix_product(P, rows, inner, Q, inner, columns);
+	double *C_parallel = parallel_matrix_product(P, rows, inner, Q, inner, columns);
+	double *V_sequential = sequential_vector_matrix_product(P, rows, inner, X, inner);
+	double *V_parallel = parallel_vector_matrix_product(P, rows, inner, X, inner);
+	double *S = vectors_addition(X, Y, inner);
+	double *M = scalar_product(X, Y, inner);
+	double norm = vector_norm(X, inner);
+
+	double errors[] = {
+	    max_relative_error(C_sequential, C_reference, rows * columns),
+	    max_relative_error(C_parallel, C_reference, rows * columns),
+	    max_relative_error(V_sequential, V_reference, rows),
+	    max_relative_error(V_parallel, V_reference, rows),
+	    max_relative_error(S, S_reference, inner),
+	    max_relative_error(M, M_reference, inner),
+	    fabs(norm - norm_reference) / norm_reference
+	};
+
+	const char *names[] = {"sequential_matrix_product", "parallel_matrix_product",
+	    "sequential_vector_matrix_product", "parallel_vector_matrix_product",
+	    "vectors_addition", "scalar_product", "vector_norm"};
+
+	for (int i = 0; i < 7; i++)
+	    printf("%-35s max relative error : %e (%s)\n", names[i], errors[i], errors[i] < 1e-12 ? "OK" : "FAILED");
+
+	free(C_sequential);
+	free(C_parallel);
+	free(V_sequential);
+	free(V_parallel);
+	free(S);
+	free(M);
+
+    }
+
+    free(P);
+    free(Q);
+    free(X);
+    free(Y);
+    free(C_reference);
+    free(V_reference);
+    free(S_reference);
+    free(M_reference);
+
+    return 0;
+
+}
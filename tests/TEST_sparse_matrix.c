@@ -0,0 +1,154 @@
+#include "LinearAlgebraBasics.h"
+
+/*
+ * Random matrix with about density * rows * columns nonzeros, and a few dense rows
+ * that a partition by row count would give to a single thread.
+ */
+
+static double *generate_sparse(int rows, int columns, double density) {
+
+    double *A = calloc((size_t) rows * columns, sizeof(double));
+
+    srand(7);
+
+    for (int i = 0; i < rows; i++)
+	for (int j = 0; j < columns; j++)
+	    if (i % 97 == 3 || rand() < density * RAND_MAX)
+		A[(size_t) i * columns + j] = (double) rand() / RAND_MAX - 0.5;
+
+    return A;
+
+}
+
+int main() {
+
+    printf("##################################### TEST 1 #####################################\n");
+
+    // COO triplets in any order with a duplicated coordinate, in both formats
+
+    index_t row_indices[] = {2, 0, 1, 2, 0, 2};
+    index_t column_indices[] = {3, 1, 0, 0, 1, 3};
+    double values[] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+    double expected[] = {0.0, 7.0, 0.0, 0.0,
+			 3.0, 0.0, 0.0, 0.0,
+			 4.0, 0.0, 0.0, 7.0};
+
+    for (int format = SPARSE_CSR; format <= SPARSE_CSC; format++) {
+
+	sparse_matrix *S = sparse_from_coo(3, 4, 6, row_indices, column_indices, values, format);
+	double *D = sparse_to_dense(S);
+
+	int correct = S && D && S->nnz == 4;
+
+	for (int k = 0; correct && k < 12; k++)
+	    if (D[k] != expected[k]) correct = 0;
+
+	for (index_t m = 0; correct && m < (format == SPARSE_CSR ? 3 : 4); m++)
+	    for (index_t p = S->pointers[m] + 1; p < S->pointers[m + 1]; p++)
+		if (S->indices[p - 1] >= S->indices[p]) correct = 0;
+
+	printf("sparse_from_coo (%s) : %" PRId64 " nonzeros (%s)\n", format == SPARSE_CSR ? "CSR" : "CSC",
+	       S ? S->nnz : 0, correct ? "OK" : "FAILED");
+
+	free(D);
+	sparse_free(S);
+
+    }
+
+    index_t out_of_bounds[] = {0, 4};
+
+    printf("Out of bounds triplet rejected (%s)\n",
+	   sparse_from_coo(3, 4, 2, out_of_bounds, out_of_bounds, values, SPARSE_CSR) == NULL ? "OK" : "FAILED");
+
+    printf("##################################### TEST 2 #####################################\n");
+
+    // Dense to sparse round trip and products against the dense products
+
+    int rows = 1000, columns = 700;
+
+    double *A = generate_sparse(rows, columns, 0.01);
+    double *X = generate_matrix_double(columns, 1);
+    double *Y_reference = sequential_vector_matrix_product(A, rows, columns, X, columns);
+
+    for (int format = SPARSE_CSR; format <= SPARSE_CSC; format++) {
+
+	sparse_matrix *S = sparse_from_dense(A, rows, columns, format);
+	double *D = sparse_to_dense(S);
+
+	int round_trip = S && D;
+
+	for (size_t k = 0; round_trip && k < (size_t) rows * columns; k++)
+	    if (D[k] != A[k]) round_trip = 0;
+
+	double *Y_sequential = sequential_sparse_vector_matrix_product(S, X, columns);
+	double *Y_parallel = parallel_sparse_vector_matrix_product(S, X, columns);
+
+	double max_error = 0.0;
+
+	for (int i = 0; Y_sequential && Y_parallel && i < rows; i++) {
+	    max_error = fmax(max_error, fabs(Y_sequential[i] - Y_reference[i]));
+	    max_error = fmax(max_error, fabs(Y_parallel[i] - Y_reference[i]));
+	}
+
+	const char *name = format == SPARSE_CSR ? "CSR" : "CSC";
+
+	printf("sparse_from_dense (%s) : %" PRId64 " nonzeros, round trip (%s)\n", name, S ? S->nnz : 0,
+	       round_trip ? "OK" : "FAILED");
+	printf("sparse_vector_matrix_product (%s) : max error %e (%s)\n", name, max_error,
+	       (Y_sequential && Y_parallel && max_error < 1e-9) ? "OK" : "FAILED");
+
+	free(D);
+	free(Y_sequential);
+	free(Y_parallel);
+	sparse_free(S);
+
+    }
+
+    printf("##################################### TEST 3 #####################################\n");
+
+    // Single precision and an empty matrix
+
+    float *A_float = malloc((size_t) rows * columns * sizeof(float));
+    float *X_float = malloc(columns * sizeof(float));
+
+    for (size_t k = 0; k < (size_t) rows * columns; k++)
+	A_float[k] = (float) A[k];
+    for (int j = 0; j < columns; j++)
+	X_float[j] = (float) X[j];
+
+    sparse_matrix_float *S_float = sparse_from_dense_float(A_float, rows, columns, SPARSE_CSR);
+    float *Y_float = parallel_sparse_vector_matrix_product_float(S_float, X_float, columns);
+
+    double max_error = 0.0, scale = 0.0;
+
+    for (int i = 0; Y_float && i < rows; i++) {
+	scale = fmax(scale, fabs(Y_reference[i]));
+	max_error = fmax(max_error, fabs(Y_float[i] - Y_reference[i]));
+    }
+
+    printf("parallel_sparse_vector_matrix_product_float : max relative error %e (%s)\n", max_error / scale,
+	   (Y_float && max_error / scale < 1e-5) ? "OK" : "FAILED");
+
+    sparse_matrix *empty = sparse_from_coo(rows, columns, 0, NULL, NULL, NULL, SPARSE_CSC);
+    double *Y_empty = parallel_sparse_vector_matrix_product(empty, X, columns);
+
+    int zero = Y_empty != NULL;
+
+    for (int i = 0; zero && i < rows; i++)
+	if (Y_empty[i] != 0.0) zero = 0;
+
+    printf("Empty matrix times a vector is zero (%s)\n", zero ? "OK" : "FAILED");
+
+    free(Y_empty);
+    sparse_free(empty);
+    free(Y_float);
+    sparse_free_float(S_float);
+    free(A_float);
+    free(X_float);
+    free(Y_reference);
+    free(X);
+    free(A);
+
+    return 0;
+
+}
@@ -0,0 +1,115 @@
+#include "LinearAlgebraBasics.h"
+
+/*
+ * Random dense matrix in which about density of the elements are nonzero.
+ */
+
+static double *generate_sparse(int rows, int columns, double density, unsigned seed) {
+
+    double *A = calloc((size_t) rows * columns, sizeof(double));
+
+    srand(seed);
+
+    for (size_t k = 0; k < (size_t) rows * columns; k++)
+	if (rand() < density * RAND_MAX)
+	    A[k] = (double) rand() / RAND_MAX - 0.5;
+
+    return A;
+
+}
+
+int main() {
+
+    printf("##################################### TEST 1 #####################################\n");
+
+    // Products of random sparse matrices against the dense product, from rows gathered in
+    // small hash tables to rows gathered in the dense accumulator
+
+    int M = 300, K = 200, N = 250;
+    double densities[] = {0.002, 0.02, 0.2, 0.5};
+
+    for (int d = 0; d < 4; d++) {
+
+	double *P = generate_sparse(M, K, densities[d], 1 + d);
+	double *Q = generate_sparse(K, N, densities[d], 11 + d);
+	double *C_reference = sequential_matrix_product(P, M, K, Q, K, N);
+
+	sparse_matrix *P_sparse = sparse_from_dense(P, M, K, SPARSE_CSR);
+	sparse_matrix *Q_sparse = sparse_from_dense(Q, K, N, SPARSE_CSR);
+
+	for (int parallel = 0; parallel < 2; parallel++) {
+
+	    sparse_matrix *C = parallel ? parallel_sparse_matrix_product(P_sparse, Q_sparse)
+		: sequential_sparse_matrix_product(P_sparse, Q_sparse);
+	    double *C_dense = sparse_to_dense(C);
+
+	    double max_error = 0.0;
+	    int sorted = C != NULL;
+
+	    for (size_t k = 0; C_dense && k < (size_t) M * N; k++)
+		max_error = fmax(max_error, fabs(C_dense[k] - C_reference[k]));
+
+	    for (index_t i = 0; sorted && i < M; i++)
+		for (index_t p = C->pointers[i] + 1; p < C->pointers[i + 1]; p++)
+		    if (C->indices[p - 1] >= C->indices[p]) sorted = 0;
+
+	    printf("%s_sparse_matrix_product, density %.3f : %" PRId64 " nonzeros, max error %e (%s)\n",
+		   parallel ? "parallel" : "sequential", densities[d], C ? C->nnz : 0, max_error,
+		   (C_dense && sorted && max_error < 1e-12) ? "OK" : "FAILED");
+
+	    free(C_dense);
+	    sparse_free(C);
+
+	}
+
+	sparse_free(P_sparse);
+	sparse_free(Q_sparse);
+	free(P);
+	free(Q);
+	free(C_reference);
+
+    }
+
+    printf("##################################### TEST 2 #####################################\n");
+
+    // Identity times a matrix, in single precision
+
+    index_t diagonal[] = {0, 1, 2, 3};
+    float ones[] = {1.0f, 1.0f, 1.0f, 1.0f};
+    float A[] = {1.0f, 0.0f, 2.0f,
+		 0.0f, 0.0f, 0.0f,
+		 3.0f, 4.0f, 0.0f,
+		 0.0f, 0.0f, 5.0f};
+
+    sparse_matrix_float *I = sparse_from_coo_float(4, 4, 4, diagonal, diagonal, ones, SPARSE_CSR);
+    sparse_matrix_float *A_sparse = sparse_from_dense_float(A, 4, 3, SPARSE_CSR);
+    sparse_matrix_float *C = parallel_sparse_matrix_product_float(I, A_sparse);
+    float *C_dense = sparse_to_dense_float(C);
+
+    int correct = C && C->nnz == 5;
+
+    for (int k = 0; correct && k < 12; k++)
+	if (C_dense[k] != A[k]) correct = 0;
+
+    printf("parallel_sparse_matrix_product_float, I * A = A (%s)\n", correct ? "OK" : "FAILED");
+
+    printf("##################################### TEST 3 #####################################\n");
+
+    // Invalid products
+
+    sparse_matrix_float *A_csc = sparse_from_dense_float(A, 4, 3, SPARSE_CSC);
+
+    printf("Dimension mismatch rejected (%s)\n",
+	   sequential_sparse_matrix_product_float(A_sparse, I) == NULL ? "OK" : "FAILED");
+    printf("CSC operand rejected (%s)\n",
+	   parallel_sparse_matrix_product_float(I, A_csc) == NULL ? "OK" : "FAILED");
+
+    free(C_dense);
+    sparse_free_float(C);
+    sparse_free_float(I);
+    sparse_free_float(A_sparse);
+    sparse_free_float(A_csc);
+
+    return 0;
+
+}
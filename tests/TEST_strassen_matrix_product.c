@@ -0,0 +1,69 @@
+#include "LinearAlgebraBasics.h"
+
+int main() {
+
+    int P_rows = 3;
+    int P_columns = 3;
+
+    int Q_rows = 3;
+    int Q_columns = 2;
+
+    double P[] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0};
+    double Q[] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+
+    // A cutoff of 2 forces the recursion and the peeling even on tiny matrices
+    
+    double *matrix = strassen_matrix_product(P, P_rows, P_columns, Q, Q_rows, Q_columns, 2);
+
+    printf("##################################### TEST 1 #####################################\n");
+    
+    for (int i = 0; i < P_rows; i++) {
+	for (int j = 0; j < Q_columns; j++) {
+	    printf("%lf\t", matrix[i * Q_columns + j]);
+	}
+	printf("\n");
+    }
+
+    free(matrix);
+
+    printf("##################################### TEST 2 #####################################\n");
+
+    // Odd, non-power-of-two sizes over several levels of recursion
+
+    int sizes[][3] = {{257, 255, 259}, {300, 301, 302}, {129, 640, 67}};
+
+    for (int t = 0; t < 3; t++) {
+
+	int m = sizes[t][0], k = sizes[t][1], n = sizes[t][2];
+
+	double *A = generate_matrix_double(m, k);
+	double *B = generate_matrix_double(k, n);
+
+	double *C_strassen = strassen_matrix_product(A, m, k, B, k, n, 16);
+	double *C_reference = sequential_matrix_product(A, m, k, B, k, n);
+
+	double max_A = 0.0, max_B = 0.0, max_error = 0.0;
+
+	for (int i = 0; i < m * k; i++)
+	    if (fabs(A[i]) > max_A) max_A = fabs(A[i]);
+	for (int i = 0; i < k * n; i++)
+	    if (fabs(B[i]) > max_B) max_B = fabs(B[i]);
+	for (int i = 0; i < m * n; i++)
+	    if (fabs(C_strassen[i] - C_reference[i]) > max_error) max_error = fabs(C_strassen[i] - C_reference[i]);
+
+	// Normwise error relative to max|A| max|B|, far below the documented bound
+	double relative_error = max_error / (max_A * max_B);
+
+	printf("(%d x %d) x (%d x %d) : max|C - C_ref| / (max|A| max|B|) = %e (%s)\n", m, k, k, n,
+	       relative_error, relative_error < 1e-11 ? "OK" : "FAILED");
+
+	free(A);
+	free(B);
+	free(C_strassen);
+	free(C_reference);
+
+    }
+
+    return 0;
+
+}
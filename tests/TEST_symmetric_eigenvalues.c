@@ -0,0 +1,312 @@
+#include "LinearAlgebraBasics.h"
+#include <omp.h>
+#include <string.h>
+
+/*
+ * Random symmetric matrix with entries in [-1, 1].
+ */
+
+static double *generate_symmetric(int n) {
+
+    double *A = malloc((size_t) n * n * sizeof(double));
+
+    for (int i = 0; i < n; i++)
+	for (int j = 0; j <= i; j++)
+	    A[i * n + j] = A[j * n + i] = 2.0 * rand() / RAND_MAX - 1.0;
+
+    return A;
+
+}
+
+/*
+ * A = Q diag(D) Q^T with Q orthogonal (from the QR decomposition of a random matrix).
+ */
+
+static double *generate_spectrum(int n, const double *D) {
+
+    double *M = generate_matrix_double(n, n);
+    QR *F = QR_decomposition(M, n, n);
+    double *A = calloc((size_t) n * n, sizeof(double));
+
+    for (int i = 0; i < n; i++)
+	for (int j = 0; j < n; j++)
+	    for (int k = 0; k < n; k++)
+		A[i * n + j] += F->Q[i * n + k] * D[k] * F->Q[j * n + k];
+
+    QR_free(F);
+    free(M);
+
+    return A;
+
+}
+
+/*
+ * Largest of the residual max |A Z - Z diag(lambda)| / |A| and of the loss of orthogonality
+ * max |Z^T Z - I|, and whether the eigenvalues are increasing.
+ */
+
+static double decomposition_error(int n, const double *A, const double *lambda, const double *Z, int *sorted) {
+
+    double norm = 0.0, residual = 0.0, orthogonality = 0.0;
+
+    for (int i = 0; i < n * n; i++)
+	norm = fmax(norm, fabs(A[i]));
+
+    if (norm == 0.0) norm = 1.0;
+
+    for (int i = 0; i < n; i++)
+	for (int j = 0; j < n; j++) {
+	    double product = -Z[i * n + j] * lambda[j], gram = i == j ? -1.0 : 0.0;
+	    for (int k = 0; k < n; k++) {
+		product += A[i * n + k] * Z[k * n + j];
+		gram += Z[k * n + i] * Z[k * n + j];
+	    }
+	    residual = fmax(residual, fabs(product) / norm);
+	    orthogonality = fmax(orthogonality, fabs(gram));
+	}
+
+    *sorted = 1;
+
+    for (int i = 1; i < n; i++)
+	if (lambda[i - 1] > lambda[i]) *sorted = 0;
+
+    return fmax(residual, orthogonality);
+
+}
+
+static int compare(const void *a, const void *b) {
+
+    double x = *(const double *) a, y = *(const double *) b;
+
+    return (x > y) - (x < y);
+
+}
+
+int main() {
+
+    srand(23);
+
+    printf("##################################### TEST 1 #####################################\n");
+
+    // Small matrices with known eigenvalues
+
+    double S[] = {2.0, 0.0, 0.0,
+		  0.0, 3.0, 4.0,
+		  0.0, 4.0, 9.0};
+    double S_expected[] = {1.0, 2.0, 11.0};
+    double one[] = {-3.0}, lambda[3], Z[9];
+
+    double *values = symmetric_eigenvalues(S, 3);
+    double error = 0.0;
+
+    for (int i = 0; i < 3; i++)
+	error = fmax(error, fabs(values[i] - S_expected[i]));
+
+    printf("symmetric_eigenvalues 3 x 3 : %g, %g, %g, error %e (%s)\n", values[0], values[1], values[2], error,
+	   error < 1e-14 ? "OK" : "FAILED");
+
+    free(values);
+
+    int sorted, status = symmetric_eigen_decomposition_into(S, 3, lambda, Z);
+
+    error = decomposition_error(3, S, lambda, Z, &sorted);
+
+    printf("symmetric_eigen_decomposition_into 3 x 3 : error %e (%s)\n", error,
+	   (!status && sorted && error < 1e-14) ? "OK" : "FAILED");
+
+    status = symmetric_eigen_decomposition_into(one, 1, lambda, Z);
+
+    printf("1 x 1 : %g, eigenvector %g (%s)\n", lambda[0], Z[0], (!status && lambda[0] == -3.0 && Z[0] == 1.0) ? "OK" : "FAILED");
+
+    printf("##################################### TEST 2 #####################################\n");
+
+    // Random symmetric matrices across the panel width and the divide and conquer base case
+
+    int sizes[] = {2, 31, 32, 33, 100, 300};
+
+    for (int s = 0; s < 6; s++) {
+
+	int n = sizes[s];
+	double *A = generate_symmetric(n);
+	double *eigenvalues = malloc(n * sizeof(double)), *eigenvectors = malloc((size_t) n * n * sizeof(double));
+	double *real = malloc(n * sizeof(double)), *imaginary = malloc(n * sizeof(double));
+
+	status = symmetric_eigen_decomposition_into(A, n, eigenvalues, eigenvectors);
+	error = decomposition_error(n, A, eigenvalues, eigenvectors, &sorted);
+
+	// Same eigenvalues without eigenvectors (QL) and from the general eigensolver
+	double *only = symmetric_eigenvalues(A, n), difference = 0.0, general = 0.0;
+
+	matrix_eigenvalues_into(A, n, n, 100, 1e-15, real, imaginary);
+	qsort(real, n, sizeof(double), compare);
+
+	for (int i = 0; i < n; i++) {
+	    difference = fmax(difference, fabs(only[i] - eigenvalues[i]));
+	    general = fmax(general, fabs(real[i] - eigenvalues[i]));
+	}
+
+	printf("n = %d : decomposition error %e, values only %e, against matrix_eigenvalues %e (%s)\n", n, error,
+	       difference, general, (!status && sorted && error < 1e-12 && difference < 1e-12 && general < 1e-10) ? "OK" : "FAILED");
+
+	free(only);
+	free(real);
+	free(imaginary);
+	free(eigenvalues);
+	free(eigenvectors);
+	free(A);
+
+    }
+
+    printf("##################################### TEST 3 #####################################\n");
+
+    // Repeated and clustered eigenvalues (deflation of the merges), diagonal and zero matrices
+
+    int n = 200;
+    double *D = malloc(n * sizeof(double));
+
+    for (int i = 0; i < n; i++)
+	D[i] = i % 4 == 0 ? 1.0 : (i % 4 == 1 ? -2.0 : 3.0 + 1e-10 * i);
+
+    double *A = generate_spectrum(n, D);
+    double *eigenvalues = malloc(n * sizeof(double)), *eigenvectors = malloc((size_t) n * n * sizeof(double));
+
+    qsort(D, n, sizeof(double), compare);
+    status = symmetric_eigen_decomposition_into(A, n, eigenvalues, eigenvectors);
+    error = decomposition_error(n, A, eigenvalues, eigenvectors, &sorted);
+
+    double spectrum = 0.0;
+
+    for (int i = 0; i < n; i++)
+	spectrum = fmax(spectrum, fabs(eigenvalues[i] - D[i]));
+
+    printf("Clustered spectrum : decomposition error %e, eigenvalue error %e (%s)\n", error, spectrum,
+	   (!status && sorted && error < 1e-12 && spectrum < 1e-12) ? "OK" : "FAILED");
+
+    free(A);
+    A = calloc((size_t) n * n, sizeof(double));
+
+    for (int i = 0; i < n; i++)
+	A[i * n + i] = (i * 37) % 11 - 5.0;
+
+    status = symmetric_eigen_decomposition_into(A, n, eigenvalues, eigenvectors);
+    error = decomposition_error(n, A, eigenvalues, eigenvectors, &sorted);
+
+    printf("Diagonal matrix : decomposition error %e (%s)\n", error, (!status && sorted && error < 1e-14) ? "OK" : "FAILED");
+
+    memset(A, 0, (size_t) n * n * sizeof(double));
+    status = symmetric_eigen_decomposition_into(A, n, eigenvalues, eigenvectors);
+    error = decomposition_error(n, A, eigenvalues, eigenvectors, &sorted);
+
+    printf("Zero matrix : decomposition error %e (%s)\n", error, (!status && eigenvalues[n - 1] == 0.0 && error < 1e-14) ? "OK" : "FAILED");
+
+    // Rank-deficient matrices, eigenvalues only: the diagonal of the tridiagonal matrix vanishes
+    // along with its off-diagonal, so negligible elements must be judged against the whole matrix
+    for (int i = 0; i < n; i++)
+	D[i] = i % 3;
+
+    free(A);
+    A = generate_spectrum(n, D);
+    qsort(D, n, sizeof(double), compare);
+    spectrum = 0.0;
+
+    for (int parallel = 0; parallel < 2; parallel++) {
+	status = parallel ? symmetric_eigen_decomposition_parallel_into(A, n, eigenvalues, NULL)
+			  : symmetric_eigen_decomposition_into(A, n, eigenvalues, NULL);
+	for (int i = 0; !status && i < n; i++)
+	    spectrum = fmax(spectrum, fabs(eigenvalues[i] - D[i]));
+	if (status) spectrum = INFINITY;
+    }
+
+    printf("Spectrum {0, 1, 2}, eigenvalues only : eigenvalue error %e (%s)\n", spectrum, spectrum < 1e-12 ? "OK" : "FAILED");
+
+    free(D);
+    free(A);
+    free(eigenvalues);
+    free(eigenvectors);
+
+    n = 300;
+    A = malloc((size_t) n * n * sizeof(double));
+    D = malloc(n * sizeof(double));
+
+    double square = 0.0;
+
+    for (int i = 0; i < n; i++) {
+	D[i] = 2.0 * rand() / RAND_MAX - 1.0;
+	square += D[i] * D[i];
+    }
+
+    for (int i = 0; i < n; i++)
+	for (int j = 0; j < n; j++)
+	    A[i * n + j] = D[i] * D[j];
+
+    values = symmetric_eigenvalues(A, n);
+    spectrum = values ? fabs(values[n - 1] - square) / square : INFINITY;
+
+    for (int i = 0; values && i < n - 1; i++)
+	spectrum = fmax(spectrum, fabs(values[i]) / square);
+
+    printf("Rank one v v^T, eigenvalues only : relative eigenvalue error %e (%s)\n", spectrum, spectrum < 1e-13 ? "OK" : "FAILED");
+
+    free(values);
+    free(D);
+    free(A);
+
+    printf("##################################### TEST 4 #####################################\n");
+
+    // Parallel variant, eigenvectors written over A, upper triangle ignored
+
+    omp_set_num_threads(4);
+    n = 300;
+    A = generate_symmetric(n);
+
+    double *copy = malloc((size_t) n * n * sizeof(double)), *expected = malloc(n * sizeof(double));
+
+    memcpy(copy, A, (size_t) n * n * sizeof(double));
+    eigenvalues = malloc(n * sizeof(double));
+    symmetric_eigen_decomposition_into(A, n, expected, NULL);
+
+    for (int i = 0; i < n; i++)
+	for (int j = i + 1; j < n; j++)
+	    A[i * n + j] = NAN;
+
+    status = symmetric_eigen_decomposition_parallel_into(A, n, eigenvalues, A);
+    error = decomposition_error(n, copy, eigenvalues, A, &sorted);
+
+    double difference = 0.0;
+
+    for (int i = 0; i < n; i++)
+	difference = fmax(difference, fabs(eigenvalues[i] - expected[i]));
+
+    printf("Parallel, in place : decomposition error %e, against sequential %e (%s)\n", error, difference,
+	   (!status && sorted && error < 1e-12 && difference < 1e-12) ? "OK" : "FAILED");
+
+    free(copy);
+    free(expected);
+    free(eigenvalues);
+    free(A);
+
+    printf("##################################### TEST 5 #####################################\n");
+
+    // Single precision and invalid arguments
+
+    float S_float[] = {2.0f, 0.0f, 0.0f,
+		       0.0f, 3.0f, 4.0f,
+		       0.0f, 4.0f, 9.0f};
+    float lambda_float[3], Z_float[9];
+
+    status = symmetric_eigen_decomposition_into_float(S_float, 3, lambda_float, Z_float);
+    error = 0.0;
+
+    for (int i = 0; i < 3; i++)
+	error = fmax(error, fabs(lambda_float[i] - S_expected[i]));
+
+    printf("symmetric_eigen_decomposition_into_float : error %e (%s)\n", error, (!status && error < 1e-5) ? "OK" : "FAILED");
+
+    printf("Non-positive size rejected (%s)\n", symmetric_eigenvalues(S, 0) == NULL ? "OK" : "FAILED");
+    printf("Null eigenvalues rejected (%s)\n", symmetric_eigen_decomposition_into(S, 3, NULL, Z) == -1 ? "OK" : "FAILED");
+    printf("Eigenvalues overlapping the eigenvectors rejected (%s)\n",
+	   symmetric_eigen_decomposition_into(S, 3, Z + 1, Z) == -1 ? "OK" : "FAILED");
+
+    return 0;
+
+}
@@ -0,0 +1,93 @@
+#include "LinearAlgebraBasics.h"
+
+int main() {
+
+    printf("##################################### TEST 1 #####################################\n");
+
+    // Both triangles and both orientations, with accumulation, over several tiles
+
+    int N = 317, K = 129;
+    double alpha = 2.0, beta = 0.5;
+
+    double *A = generate_matrix_double(N, N);
+    double *C_initial = generate_matrix_double(N, N);
+
+    const char *triangles[] = {"lower", "upper"};
+    const char *operations[] = {"A * A^T", "A^T * A"};
+
+    for (int triangle = 0; triangle < 2; triangle++) {
+	for (int transpose = 0; transpose < 2; transpose++) {
+
+	    double *C = malloc(N * N * sizeof(double));
+
+	    for (int i = 0; i < N * N; i++)
+		C[i] = C_initial[i];
+
+	    // A is N x K (lda = N) or K x N
+	    int status = symmetric_rank_k_update(triangle, transpose, N, K, alpha, A, N, beta, C, N, 0);
+
+	    double max_error = 0.0;
+	    int untouched = 1;
+
+	    for (int i = 0; i < N; i++) {
+		for (int j = 0; j < N; j++) {
+		    int computed = (triangle == TRIANGLE_LOWER) ? j <= i : j >= i;
+		    if (!computed) {
+			if (C[i * N + j] != C_initial[i * N + j]) untouched = 0;
+			continue;
+		    }
+		    double value = 0.0;
+		    for (int k = 0; k < K; k++)
+			value += transpose ? A[k * N + i] * A[k * N + j] : A[i * N + k] * A[j * N + k];
+		    value = alpha * value + beta * C_initial[i * N + j];
+		    double error = fabs(C[i * N + j] - value) / fabs(value);
+		    if (error > max_error) max_error = error;
+		}
+	    }
+
+	    printf("%s triangle of %s : max relative error %e (%s)\n", triangles[triangle], operations[transpose],
+		   max_error, (!status && untouched && max_error < 1e-12) ? "OK" : "FAILED");
+
+	    free(C);
+
+	}
+    }
+
+    printf("##################################### TEST 2 #####################################\n");
+
+    // Gram matrix straight into the Cholesky decomposition
+
+    int rows = 400, columns = 150;
+
+    double *B = generate_matrix_double(rows, columns);
+    double *G = gram_matrix(B, rows, columns);
+
+    Cholesky *decomposition = Cholesky_decomposition(G, columns);
+
+    double max_error = 0.0;
+    int factored = decomposition != NULL;
+
+    if (factored) {
+	for (int i = 0; i < columns; i++) {
+	    for (int j = 0; j < columns; j++) {
+		double value = 0.0;
+		for (int k = 0; k < columns; k++)
+		    value += decomposition->L[i * columns + k] * decomposition->L[j * columns + k];
+		double error = fabs(value - G[i * columns + j]) / fabs(G[i * columns + j]);
+		if (error > max_error) max_error = error;
+	    }
+	}
+	free_Cholesky(decomposition);
+    }
+
+    printf("Cholesky of gram_matrix : max relative error of L * L^T %e (%s)\n", max_error,
+	   (factored && max_error < 1e-10) ? "OK" : "FAILED");
+
+    free(A);
+    free(B);
+    free(G);
+    free(C_initial);
+
+    return 0;
+
+}
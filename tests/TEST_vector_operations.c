@@ -46,6 +46,31 @@ int main() {
 
     printf("Norm = %lf\n", norm);
 
+    printf("##################################### TEST 5 #####################################\n");
+
+    // In-place variants: Z = X + Y, Z = Z .* Y, Z = Z x Y
+
+    double Z[3], expected[3];
+
+    int status = vectors_addition_into(X, Y, dimension, Z);
+    status |= scalar_product_into(Z, Y, dimension, Z);
+
+    for (int i = 0; i < dimension; i++)
+	expected[i] = (X[i] + Y[i]) * Y[i];
+
+    double cross[3] = {expected[1] * Y[2] - expected[2] * Y[1],
+		       expected[2] * Y[0] - expected[0] * Y[2],
+		       expected[0] * Y[1] - expected[1] * Y[0]};
+
+    status |= vector_product_into(Z, Y, Z);
+
+    int correct = !status;
+
+    for (int i = 0; i < dimension; i++)
+	if (Z[i] != cross[i]) correct = 0;
+
+    printf("In-place vector operations (%s)\n", correct ? "OK" : "FAILED");
+
     return 0;
 
 }
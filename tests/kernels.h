@@ -0,0 +1,334 @@
+#ifndef __LinearAlgebraKernels_
+#define __LinearAlgebraKernels_
+
+#include "precision.h"
+#include <stdint.h>
+
+/*
+ * Internal kernels shared by the translation units of functions/.
+ * This header is not installed next to LinearAlgebraBasics.so.
+ */
+
+/**
+ * @brief Largest register block of the GEMM microkernels (rows of P x columns of Q).
+ *
+ * Each instruction set has its own microkernel shape (see simd_kernels.c);
+ * these bounds size the buffers shared by all of them. A register holds twice
+ * as many floats as doubles, so the single-precision tiles are twice as wide.
+ */
+
+#define GEMM_MR_MAX 8
+#ifdef SINGLE_PRECISION
+#define GEMM_NR_MAX 32
+#else
+#define GEMM_NR_MAX 16
+#endif
+
+/**
+ * @brief Cache blocking of the GEMM engine.
+ *
+ * GEMM_KC x NR values of packed Q stay in L1, GEMM_MC x GEMM_KC values
+ * of packed P stay in L2 and GEMM_KC x GEMM_NC values of packed Q stay in L3.
+ * GEMM_MC and GEMM_NC are multiples of every microkernel shape.
+ */
+
+#define GEMM_MC 144
+#define GEMM_KC 256
+#define GEMM_NC 2048
+
+/**
+ * @brief Alignment (in bytes) of the packing buffers.
+ */
+
+#define GEMM_ALIGNMENT 64
+
+/**
+ * @brief Number of values of the packing buffers of an M x N x K product.
+ */
+
+#define GEMM_P_BUFFER_SIZE(M, K) ((size_t) (((M) < GEMM_MC ? (M) : GEMM_MC) + GEMM_MR_MAX) * ((K) < GEMM_KC ? (K) : GEMM_KC))
+#define GEMM_Q_BUFFER_SIZE(N, K) ((size_t) (((N) < GEMM_NC ? (N) : GEMM_NC) + GEMM_NR_MAX) * ((K) < GEMM_KC ? (K) : GEMM_KC))
+
+/**
+ * @brief Tells whether two ranges of values share memory.
+ *
+ * Used by the "_into" functions to reject outputs that alias inputs when the
+ * computation cannot run in place.
+ *
+ * @return 1 if [X, X + nx) and [Y, Y + ny) overlap, 0 otherwise.
+ */
+
+static inline int ranges_overlap(const REAL *X, size_t nx, const REAL *Y, size_t ny) {
+
+    uintptr_t x = (uintptr_t) X, y = (uintptr_t) Y;
+
+    return x < y + ny * sizeof(REAL) && y < x + nx * sizeof(REAL);
+
+}
+
+/**
+ * @brief Set of kernels written for one instruction set.
+ *
+ * Each translation unit sees the set of its own precision (REAL).
+ *
+ * @struct simd_kernels
+ * @var simd_kernels::name
+ * Name of the instruction set ("generic", "sse2", "avx2" or "avx512").
+ * @var simd_kernels::mr
+ * Number of rows of the microkernel register block.
+ * @var simd_kernels::nr
+ * Number of columns of the microkernel register block.
+ * @var simd_kernels::microkernel
+ * Computes C = alpha * a * b + beta * C for an mr x nr tile from a packed
+ * panel a (kc x mr, column after column) and a packed panel b (kc x nr, row after row).
+ * Only the rows x columns top-left part of the tile is stored.
+ * @var simd_kernels::dot
+ * Returns the dot product of X and Y.
+ * @var simd_kernels::add
+ * Computes Z = X + Y element-wise (Z may alias X or Y).
+ * @var simd_kernels::multiply
+ * Computes Z = X .* Y element-wise (Z may alias X or Y).
+ * @var simd_kernels::axpy
+ * Computes Y = alpha * X + Y.
+ */
+
+typedef struct simd_kernels {
+
+    const char *name;
+
+    int mr, nr;
+
+    void (*microkernel)(int kc, const REAL *a, const REAL *b, REAL *C, index_t ldc,
+			REAL alpha, REAL beta, int rows, int columns);
+    REAL (*dot)(const REAL *X, const REAL *Y, index_t n);
+    void (*add)(const REAL *X, const REAL *Y, REAL *Z, index_t n);
+    void (*multiply)(const REAL *X, const REAL *Y, REAL *Z, index_t n);
+    void (*axpy)(REAL alpha, const REAL *X, REAL *Y, index_t n);
+
+} simd_kernels;
+
+/* simd_kernels.c */
+
+/**
+ * @brief Kernels of the instruction set selected when the library was loaded.
+ */
+
+extern const simd_kernels *FN(active_kernels);
+
+/**
+ * @brief Selects the kernels of the translation unit precision for an instruction set.
+ *
+ * @return 0 on success, or -1 when the name is unknown or the CPU does not support it.
+ */
+
+int FN(select_kernels)(const char *name);
+
+#ifndef SINGLE_PRECISION
+int select_kernels_float(const char *name);
+#endif
+
+/* blocked_matrix_product.c */
+
+/**
+ * @brief Allocates a buffer aligned on GEMM_ALIGNMENT bytes.
+ *
+ * @param bytes Size of the buffer in bytes.
+ *
+ * @return Pointer to the buffer (to release with free) on success, or NULL on failure.
+ */
+
+void *aligned_buffer(size_t bytes);
+
+/**
+ * @brief Computes C = alpha * P * Q + beta * C with a cache-blocked, packed GEMM engine.
+ *
+ * P, Q and C are row-major matrices addressed through their leading dimensions,
+ * so the engine can work on sub-blocks of bigger matrices. When beta is 0, C is
+ * only written, never read.
+ *
+ * @param M Number of rows of P and C.
+ * @param N Number of columns of Q and C.
+ * @param K Number of columns of P and rows of Q.
+ * @param alpha Scalar applied to the product.
+ * @param P Pointer to the first matrix (size: M x K, leading dimension ldp).
+ * @param ldp Leading dimension of P (must be >= K).
+ * @param Q Pointer to the second matrix (size: K x N, leading dimension ldq).
+ * @param ldq Leading dimension of Q (must be >= N).
+ * @param beta Scalar applied to C before accumulation.
+ * @param C Pointer to the output matrix (size: M x N, leading dimension ldc).
+ * @param ldc Leading dimension of C (must be >= N).
+ *
+ * @return 0 on success, or -1 on failure due to memory allocation errors.
+ */
+
+int FN(blocked_matrix_product)(index_t M, index_t N, index_t K, REAL alpha, const REAL *P, index_t ldp,
+			   const REAL *Q, index_t ldq, REAL beta, REAL *C, index_t ldc);
+
+/**
+ * @brief Computes C = alpha * P * Q + beta * C with caller-provided packing buffers.
+ *
+ * Same as blocked_matrix_product, without any allocation: P_packed must hold
+ * GEMM_P_BUFFER_SIZE(M, K) values and Q_packed GEMM_Q_BUFFER_SIZE(N, K) values,
+ * both aligned on GEMM_ALIGNMENT bytes. Threads that multiply many blocks
+ * allocate their buffers once and reuse them.
+ */
+
+void FN(blocked_matrix_product_packed)(index_t M, index_t N, index_t K, REAL alpha, const REAL *P, index_t ldp,
+				   const REAL *Q, index_t ldq, REAL beta, REAL *C, index_t ldc,
+				   REAL *P_packed, REAL *Q_packed);
+
+/**
+ * @brief Computes C = alpha * op(P) * op(Q) + beta * C with caller-provided packing buffers.
+ *
+ * op(X) is X, or X^T when the matching transpose flag is set: the transposed
+ * operands are read in place by the packing routines, never formed. P is
+ * M x K (K x M when transposed) and Q is K x N (N x K when transposed).
+ */
+
+void FN(blocked_general_product_packed)(int transpose_P, int transpose_Q, index_t M, index_t N, index_t K,
+				    REAL alpha, const REAL *P, index_t ldp, const REAL *Q, index_t ldq,
+				    REAL beta, REAL *C, index_t ldc, REAL *P_packed, REAL *Q_packed);
+
+/**
+ * @brief Computes C = alpha * op(P) * op(Q) + beta * C, allocating the packing buffers.
+ *
+ * @return 0 on success, or -1 on failure due to memory allocation errors.
+ */
+
+int FN(blocked_general_product)(int transpose_P, int transpose_Q, index_t M, index_t N, index_t K,
+			    REAL alpha, const REAL *P, index_t ldp, const REAL *Q, index_t ldq,
+			    REAL beta, REAL *C, index_t ldc);
+
+/* blocked_vector_matrix_product.c */
+
+/**
+ * @brief Rows of A accumulated together by the matrix-vector kernels.
+ *
+ * Parallel callers split the rows in multiples of GEMV_ROWS.
+ */
+
+#define GEMV_ROWS 4
+
+/**
+ * @brief Computes Y_v = A * X_v for several vectors, streaming A once.
+ *
+ * Vector v starts at X + v * ldx and its result at Y + v * ldy. Y must not
+ * overlap A or X.
+ */
+
+void FN(blocked_vector_matrix_product)(index_t rows, index_t columns, const REAL *A, index_t lda,
+				       const REAL *X, index_t ldx, index_t vectors, REAL *Y, index_t ldy);
+
+/**
+ * @brief Computes Y = A^T * X for a rows x columns block A with leading dimension lda.
+ *
+ * Y (size: columns) is overwritten and must not overlap A or X.
+ */
+
+void FN(blocked_transposed_vector_matrix_product)(index_t rows, index_t columns, const REAL *A, index_t lda,
+						  const REAL *X, REAL *Y);
+
+/* sparse_matrix.c */
+
+/**
+ * @brief Allocates a rows x columns sparse matrix in the given format with room for nnz nonzeros.
+ *
+ * The pointers are zeroed; the indices and values are left uninitialised.
+ */
+
+FN(sparse_matrix) *FN(create_sparse_matrix)(index_t rows, index_t columns, index_t nnz, int format);
+
+/* Cholesky_decomposition.c */
+
+/**
+ * @brief Factors the lower triangle of the n x n symmetric matrix A in place as L L^T with a tiled Cholesky.
+ *
+ * On return, the lower triangle of A holds L and the strictly upper triangle holds
+ * meaningless values. The factorization, solves and updates of the tiles are OpenMP
+ * tasks ordered by dependencies; with parallel set, they run on all the threads.
+ *
+ * @return 0 on success, or -1 on failure due to a matrix that is not positive definite
+ *         or memory allocation errors.
+ */
+
+int FN(tiled_Cholesky_factorization)(index_t n, REAL *A, index_t lda, int parallel);
+
+/* LU_decomposition.c */
+
+/**
+ * @brief Factors the m x n matrix A in place as P A = L U with a blocked right-looking LU.
+ *
+ * On return, the strictly lower part of A holds the multipliers of the unit lower
+ * trapezoid L and its upper part holds U. Row i was interchanged with row pivots[i]
+ * at step i (min(m, n) steps). A zero pivot does not stop the factorization: U then
+ * has a zero on its diagonal, which the caller detects. The panels and the updates
+ * of the blocks of columns are OpenMP tasks ordered by dependencies; with parallel
+ * set, they run on all the threads and the panels overlap the updates.
+ *
+ * @return 0 on success, or -1 on failure due to memory allocation errors.
+ */
+
+int FN(blocked_LU_factorization)(index_t m, index_t n, REAL *A, index_t lda, index_t *pivots, int parallel);
+
+/* QR_decomposition.c */
+
+/**
+ * @brief Factors the m x n matrix A in place as A = Q R with a blocked Householder QR (compact WY).
+ *
+ * On return, R is stored on and above the diagonal of A and the Householder vectors
+ * below it, with an implied unit first element: Q = H_0 ... H_{s-1} with
+ * H_k = I - tau[k] v_k v_k^T and s = min(m, n), as in LAPACK. With parallel set,
+ * the block reflectors are applied to tiles of the trailing matrix by all the threads.
+ *
+ * @return 0 on success, or -1 on failure due to memory allocation errors.
+ */
+
+int FN(blocked_QR_factorization)(index_t m, index_t n, REAL *A, index_t lda, REAL *tau, int parallel);
+
+/**
+ * @brief Forms the m x n matrix Q = H_0 ... H_{n-1} [I; 0] from the output of blocked_QR_factorization (n <= m).
+ *
+ * @return 0 on success, or -1 on failure due to memory allocation errors.
+ */
+
+int FN(blocked_QR_form_Q)(index_t m, index_t n, const REAL *A, index_t lda, const REAL *tau, REAL *Q, index_t ldq,
+			  int parallel);
+
+/**
+ * @brief Multiplies the m x n block B by Q (OP_NO_TRANSPOSE) or Q^T (OP_TRANSPOSE) from the k reflectors
+ *        stored in A by blocked_QR_factorization.
+ *
+ * @return 0 on success, or -1 on failure due to memory allocation errors.
+ */
+
+int FN(blocked_QR_apply_Q)(int transpose, index_t m, index_t n, index_t k, const REAL *A, index_t lda, const REAL *tau,
+			   REAL *B, index_t ldb, int parallel);
+
+/**
+ * @brief Applies the block reflector H = I - V T V^T to the m x n block C from the left.
+ *
+ * V is m x nb (leading dimension nb) with explicit unit diagonal and zeros above it,
+ * T is the nb x nb upper triangular factor. C = H^T C when transpose is OP_TRANSPOSE,
+ * C = H C otherwise. W holds nb x n values; the packing buffers hold
+ * GEMM_P_BUFFER_SIZE(max(m, nb), max(m, nb)) and GEMM_Q_BUFFER_SIZE(n, max(m, nb)) values.
+ */
+
+void FN(apply_block_reflector)(int transpose, index_t m, index_t n, index_t nb, const REAL *V, const REAL *T,
+			      REAL *C, index_t ldc, REAL *W, REAL *P_packed, REAL *Q_packed,
+			      const simd_kernels *kernels);
+
+/* packed_matrix.c */
+
+/**
+ * @brief Position of element (i, j) of the stored triangle of an n x n packed matrix.
+ *
+ * j <= i for TRIANGLE_LOWER and j >= i for TRIANGLE_UPPER.
+ */
+
+static inline size_t packed_index(index_t n, int triangle, index_t i, index_t j) {
+
+    return triangle == TRIANGLE_LOWER ? (size_t) i * (i + 1) / 2 + j : (size_t) i * (2 * n - i + 1) / 2 + j - i;
+
+}
+
+#endif